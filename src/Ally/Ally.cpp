@@ -11,6 +11,7 @@
 #include "Tools/Registry.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/PowerEfficiency.hpp"
+#include "Tools/PhaseTracer.hpp"
 #include "App/AppConstants.hpp"
 #include "Ally.hpp"
 #include "Ally/Services.hpp"
@@ -28,6 +29,7 @@ namespace Ally
         static int supported = -1;
         if (supported == -1)
         {
+            AnyFSE::Tools::PhaseTracer::Scope trace("Ally HID lookup", "ally");
             supported = FindHIDDevice() ? 1 : 0;
 
             log.Trace("Ally HID is %ssupported", supported ? "" : "not ");
@@ -191,6 +193,13 @@ namespace Ally
 
         log.Trace("Starting Ally HID sink window");
 
+        // The listener runs until sign-out, its part of the boot is written once it listens
+        AnyFSE::Tools::PhaseTracer::Instance().Instant("Ally listener ready", "ally");
+        if (Config::LogLevel != LogLevels::Disabled)
+        {
+            AnyFSE::Tools::PhaseTracer::Instance().Write(Config::LogPath + L"\\AnyFSE.AllyHID.trace.json", GetCurrentProcessId(), "AnyFSE/AllyHID");
+        }
+
         MSG msg;
 
         bool bModePressed = false;
@@ -28,6 +28,7 @@
 #include <tchar.h>
 #include <commctrl.h>
 #include <strsafe.h>
+#include <thread>
 
 #include "Logging/LogManager.hpp"
 #include "Configuration/Config.hpp"
@@ -36,12 +37,15 @@
 #include "Tools/Registry.hpp"
 #include "Tools/Localization.hpp"
 #include "Tools/Unicode.hpp"
+#include "Tools/PhaseTracer.hpp"
 
 #include "App/App.hpp"
 #include "App/AppConstants.hpp"
+#include "App/BootRecord.hpp"
 #include "App/GamingExperience.hpp"
 #include "App/ExitFSE.hpp"
 #include "App/MainWindow.hpp"
+#include "App/SplashPreroll.hpp"
 #include "App/Launchers.hpp"
 #include "App/JumpList.hpp"
 #include "Ally/Ally.hpp"
@@ -61,6 +65,63 @@ namespace AnyFSE::App
 {
     static Logger log = LogManager::GetLogger("Application");
 
+    namespace
+    {
+        // Boot phases since the process was created, kept until logging is up
+        struct BootMark
+        {
+            const char *phase;
+            ULONGLONG time;
+        };
+
+        BootMark BootMarks[16];
+        size_t BootMarkCount = 0;
+
+        ULONGLONG ToTime(const FILETIME &time)
+        {
+            return ((ULONGLONG)time.dwHighDateTime << 32) | time.dwLowDateTime;
+        }
+
+        void MarkBoot(const char *phase)
+        {
+            Tools::PhaseTracer::Instance().Instant(phase, "boot");
+            if (BootMarkCount < _countof(BootMarks))
+            {
+                FILETIME now;
+                GetSystemTimePreciseAsFileTime(&now);
+                BootMarks[BootMarkCount++] = { phase, ToTime(now) };
+            }
+        }
+
+        void LogBootMarks()
+        {
+            FILETIME creation, exit, kernel, user;
+            if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            {
+                for (size_t i = 0; i < BootMarkCount; ++i)
+                {
+                    log.Info("Boot: %-24s %8.1f ms", BootMarks[i].phase, (double)(BootMarks[i].time - ToTime(creation)) / 10000.0);
+                }
+            }
+            BootMarkCount = 0;
+        }
+
+        // The boot timeline for chrome://tracing, next to the logs
+        void WriteTrace(const wchar_t *fileName, const char *processName)
+        {
+            if (Config::LogLevel == LogLevels::Disabled)
+            {
+                return;
+            }
+
+            std::wstring path = Config::LogPath + L"\\" + fileName;
+            if (!Tools::PhaseTracer::Instance().Write(path, GetCurrentProcessId(), processName))
+            {
+                log.Warn("Can't write boot trace to %s", Unicode::to_string(path).c_str());
+            }
+        }
+    }
+
     int App::CallLibrary(const WCHAR * library, HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
     {
         HMODULE hModuleDll = NULL;
@@ -190,16 +251,65 @@ namespace AnyFSE::App
         return false;
     }
 
+    bool App::FastBoot(LPSTR lpCmdLine)
+    {
+        // Whatever the launcher start logs is written once the configuration gives the log path
+        AnyFSE::Logging::LogManager::BufferUntilInitialized();
+
+        // Only for the gamingapp:// start right after sign-in, anything else takes the full path
+        if (strlen(lpCmdLine) == 0 || AsAllyHid(lpCmdLine) || AsFSE(lpCmdLine)
+            || GlobalFindAtom(AppConstants::PackageAtomName) || FindWindow(AppConstants::MainWindowClass, NULL))
+        {
+            return false;
+        }
+
+        for (char *a = lpCmdLine; *a; a++)
+        {
+            if (_strnicmp(a, "/Settings", 9) == 0)
+            {
+                return false;
+            }
+        }
+
+        BootRecord::Record record;
+        if (!BootRecord::Read(record)
+            || _wcsicmp(Registry::ReadString(AppConstants::GamingHomeAppRegKey, AppConstants::GamingHomeAppRegValue).c_str(),
+                        AppConstants::AppUserModelId) != 0)
+        {
+            return false;
+        }
+        MarkBoot("Boot record read");
+
+        Config::Launcher.Type = record.type;
+        Config::Launcher.StartCommand = record.startCommand;
+        Config::Launcher.StartArg = record.startArg;
+        Config::CleanupFailedStart = record.cleanupFailedStart;
+
+        // ShellExecute needs COM for DelegateExecute protocol handlers, the full path has it from the jump list
+        CoInitializeEx(NULL, COINIT_MULTITHREADED);
+
+        Launchers::LauncherOnBoot();
+        Launchers::StartLauncher();
+        MarkBoot("Launcher started");
+        return true;
+    }
+
     int WINAPI App::WinMain(HINSTANCE hInstance,
                     HINSTANCE hPrevInstance,
                     LPSTR lpCmdLine,
                     int nCmdShow)
     {
+        MarkBoot("WinMain");
+
+        // The launcher goes first, the rest of the boot runs while it starts
+        bool fastBoot = FastBoot(lpCmdLine);
+
         Config::Load();
         AnyFSE::Tools::Localization::Initialize(Config::Locale);
+        MarkBoot("Config loaded");
 
         AnyFSE::Logging::LogManager::Initialize("AnyFSE", Config::LogLevel, Config::LogPath);
-        log.Debug("Application is started (hInstance=%08x) args: [%s]", hInstance, lpCmdLine);
+        log.Debug("Application is started (hInstance=%08x) args: [%s]%s", hInstance, lpCmdLine, fastBoot ? " fast boot" : "");
 
         if (Ally::IsSupported() && Config::AllyHidEnable)
         {
@@ -223,6 +333,7 @@ namespace AnyFSE::App
         }
 
         AnyFSE::Logging::LogManager::Initialize("AnyFSE", Config::LogLevel, Config::LogPath);
+        MarkBoot("Ally checked");
 
         if (FindWindow(AppConstants::MainWindowClass, NULL))
         {
@@ -230,7 +341,15 @@ namespace AnyFSE::App
             return 0;
         }
 
-        AnyFSE::App::JumpList::RegisterJumpList();
+        if (fastBoot)
+        {
+            // This process lives on with the splash, the jump list does not hold it up
+            std::thread(AnyFSE::App::JumpList::RegisterJumpList).detach();
+        }
+        else
+        {
+            AnyFSE::App::JumpList::RegisterJumpList();
+        }
 
         int exitCode = -1;
         SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
@@ -250,6 +369,7 @@ namespace AnyFSE::App
         }
 
         log.Debug("Compatibility checks passed");
+        MarkBoot("Compatibility checked");
 
         bool bFirstLaunch = false;
 
@@ -280,7 +400,8 @@ namespace AnyFSE::App
             return 0;
         }
 
-        if (Launchers::IsLauncherActiveOrMinimized())
+        // A launcher started by the fast boot may already show its window
+        if (!fastBoot && Launchers::IsLauncherActiveOrMinimized())
         {
             Launchers::FocusLauncher();
             ExitFSE::WaitHomeAppExit();
@@ -292,6 +413,9 @@ namespace AnyFSE::App
             return 0;
         }
 
+        // The splash shows from here on, its video opens while the launcher starts
+        Window::SplashPreroll::Instance().Start(Window::MainWindow::FindSplashVideo());
+
         bool restartDetected = false;
 
         if ((Config::Launcher.Type == LauncherType::PlayniteDesktop
@@ -315,8 +439,14 @@ namespace AnyFSE::App
             {
                 Launchers::LaunchStartupApps();
             };
-            Launchers::LauncherOnBoot();
-            Launchers::StartLauncher();
+
+            if (!fastBoot)
+            {
+                Launchers::LauncherOnBoot();
+                Launchers::StartLauncher();
+                MarkBoot("Launcher started");
+            }
+            BootRecord::Write();
         }
         else
         {
@@ -332,11 +462,14 @@ namespace AnyFSE::App
             }
 
             mainWindow.Show();
+            MarkBoot("Splash shown");
+            LogBootMarks();
 
             exitCode = Window::MainWindow::RunLoop();
         }
 
         log.Debug("Splash window loop finished.");
+        WriteTrace(L"AnyFSE.trace.json", "AnyFSE");
 
         ExitFSE::WaitHomeAppExit();
 
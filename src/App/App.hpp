@@ -36,6 +36,7 @@ namespace AnyFSE::App
     {
         static int CallLibrary(const WCHAR *library, HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow);
         static int MainApp(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow);
+        static bool FastBoot(LPSTR lpCmdLine);
     public:
         static int ShowSettings();
         static void InitCustomControls();
@@ -27,6 +27,7 @@ namespace AnyFSE::AppConstants
     inline constexpr wchar_t UninstallAnyFseRegKey[] = L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\AnyFSE";
     inline constexpr wchar_t GamingHomeAppRegKey[] = L"HKEY_CURRENT_USER\\Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration";
     inline constexpr wchar_t GamingHomeAppRegValue[] = L"GamingHomeApp";
+    inline constexpr wchar_t BootRecordRegKey[] = L"HKEY_CURRENT_USER\\Software\\AnyFSE\\BootRecord";
 
     // Installer / updater assets
     inline constexpr wchar_t PublisherCertFile[] = L"Artem.Shpynov.cer";
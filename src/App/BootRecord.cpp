@@ -0,0 +1,106 @@
+#include <string>
+
+#include "App/BootRecord.hpp"
+#include "App/AppConstants.hpp"
+#include "Tools/Paths.hpp"
+#include "Tools/Registry.hpp"
+#include "Tools/Unicode.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace AnyFSE::App::BootRecord
+{
+    static Logger log = LogManager::GetLogger("BootRecord");
+
+    namespace
+    {
+        const DWORD Version = 1;
+
+        bool GetWriteTime(const std::wstring &file, ULONGLONG &time)
+        {
+            WIN32_FILE_ATTRIBUTE_DATA data;
+            if (file.empty() || !GetFileAttributesExW(file.c_str(), GetFileExInfoStandard, &data))
+            {
+                return false;
+            }
+            time = ((ULONGLONG)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+            return true;
+        }
+    }
+
+    bool Read(Record &record)
+    {
+        std::vector<RegistryValue> values = Registry::ReadValues(AppConstants::BootRecordRegKey,
+            { L"Version", L"ConfigFile", L"ConfigTime", L"Type", L"StartCommand", L"StartArg", L"CleanupFailedStart" });
+
+        if (values[0].AsDWORD() != Version)
+        {
+            return false;
+        }
+
+        record.configFile = values[1].AsString();
+        record.configTime = wcstoull(values[2].AsString().c_str(), nullptr, 10);
+        record.type = (LauncherType)values[3].AsDWORD(LauncherType::None);
+        record.startCommand = values[4].AsString();
+        record.startArg = values[5].AsString();
+        record.cleanupFailedStart = values[6].AsDWORD(1) != 0;
+
+        ULONGLONG configTime;
+        return GetWriteTime(record.configFile, configTime)
+            && configTime == record.configTime
+            && !record.startCommand.empty()
+            && record.type != LauncherType::None
+            && record.type != LauncherType::Native;
+    }
+
+    void Write()
+    {
+        Record record;
+        record.configFile = Tools::Paths::GetConfigPath() + L"\\AnyFSE.json";
+        record.type = Config::Launcher.Type;
+        record.startCommand = Config::Launcher.StartCommand;
+        record.startArg = Config::Launcher.StartArg;
+        record.cleanupFailedStart = Config::CleanupFailedStart;
+
+        if (!GetWriteTime(record.configFile, record.configTime)
+            || record.startCommand.empty()
+            || record.type == LauncherType::None
+            || record.type == LauncherType::Native)
+        {
+            Clear();
+            return;
+        }
+
+        Record current;
+        if (Read(current)
+            && current.configFile == record.configFile && current.configTime == record.configTime
+            && current.type == record.type && current.startCommand == record.startCommand
+            && current.startArg == record.startArg && current.cleanupFailedStart == record.cleanupFailedStart)
+        {
+            return;
+        }
+
+        // Version last, a record cut short by a crash is not taken
+        Registry::WriteDWORD(AppConstants::BootRecordRegKey, L"Version", 0);
+        bool written = Registry::WriteString(AppConstants::BootRecordRegKey, L"ConfigFile", record.configFile)
+            && Registry::WriteString(AppConstants::BootRecordRegKey, L"ConfigTime", std::to_wstring(record.configTime))
+            && Registry::WriteDWORD(AppConstants::BootRecordRegKey, L"Type", (DWORD)record.type)
+            && Registry::WriteString(AppConstants::BootRecordRegKey, L"StartCommand", record.startCommand)
+            && Registry::WriteString(AppConstants::BootRecordRegKey, L"StartArg", record.startArg)
+            && Registry::WriteBool(AppConstants::BootRecordRegKey, L"CleanupFailedStart", record.cleanupFailedStart)
+            && Registry::WriteDWORD(AppConstants::BootRecordRegKey, L"Version", Version);
+
+        if (!written)
+        {
+            log.Error(log.APIError(), "Can't write boot record");
+        }
+        else
+        {
+            log.Debug("Boot record written for %s", Unicode::to_string(record.startCommand).c_str());
+        }
+    }
+
+    void Clear()
+    {
+        Registry::DeleteKey(AppConstants::BootRecordRegKey);
+    }
+}
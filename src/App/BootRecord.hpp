@@ -0,0 +1,27 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include "Configuration/Config.hpp"
+
+namespace AnyFSE::App::BootRecord
+{
+    // What the first start after sign-in needs to run the launcher, written by a full boot that got as far as
+    // starting it. Only valid while AnyFSE.json keeps the write time it had then.
+    struct Record
+    {
+        std::wstring configFile;
+        ULONGLONG configTime = 0;
+        LauncherType type = LauncherType::None;
+        std::wstring startCommand;
+        std::wstring startArg;
+        bool cleanupFailedStart = true;
+    };
+
+    // Registry and file attributes only, no WinRT and no JSON
+    bool Read(Record &record);
+
+    // From the loaded Config
+    void Write();
+    void Clear();
+}
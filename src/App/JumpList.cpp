@@ -15,11 +15,11 @@ namespace AnyFSE::App::JumpList
         auto jumpList = winrt::Windows::UI::StartScreen::JumpList::LoadCurrentAsync().get();
 
         auto fseItem = winrt::Windows::UI::StartScreen::JumpListItem::CreateWithArguments(
-            L"/FSE", Translate(L"jumpListEnterFse"));
+            L"/FSE", Translate(KeyId::jumpListEnterFse));
         fseItem.Logo(winrt::Windows::Foundation::Uri(L"ms-appx:///Assets/fullscreen-icon.png"));
 
         auto settingsItem = winrt::Windows::UI::StartScreen::JumpListItem::CreateWithArguments(
-            L"/Settings", Translate(L"jumpListSettings"));
+            L"/Settings", Translate(KeyId::jumpListSettings));
         settingsItem.Logo(winrt::Windows::Foundation::Uri(L"ms-appx:///Assets/settings-icon.png"));
 
 
@@ -30,6 +30,7 @@
 #include "Tools/Process.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/Packages.hpp"
+#include "Tools/PhaseTracer.hpp"
 #include "App/GamingExperience.hpp"
 
 
@@ -141,6 +142,8 @@ namespace AnyFSE::App::Launchers
 
     void StartLauncher()
     {
+        Tools::PhaseTracer::Scope trace("StartLauncher", "launcher");
+
         log.Debug("Start Launcher: %s params: %s",
             Unicode::to_string(Config::Launcher.StartCommand).c_str(),
             Unicode::to_string(Config::Launcher.StartArg).c_str()
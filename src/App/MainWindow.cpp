@@ -31,6 +31,8 @@
 #include "Configuration/Config.hpp"
 #include "Tools/Icon.hpp"
 #include "Tools/Unicode.hpp"
+#include "Tools/PhaseTracer.hpp"
+#include "App/SplashPreroll.hpp"
 #include "FluentDesign/Theme.hpp"
 #include "FluentDesign/Popup.hpp"
 #include "App/App.hpp"
@@ -79,6 +81,8 @@ namespace AnyFSE::App::Window
 
     bool MainWindow::Create(LPCWSTR className, HINSTANCE hInstance, LPCTSTR windowName)
     {
+        Tools::PhaseTracer::Scope trace("MainWindow::Create", "splash");
+
         WC.lpszClassName = className;
         WC.hInstance = hInstance;
         WC.lpfnWndProc = MainWndProc;
@@ -102,6 +106,10 @@ namespace AnyFSE::App::Window
             NULL, NULL, hInstance, this);
 
         m_bLauncherWasActive = Launchers::IsLauncherActiveOrMinimized();
+        if (m_bLauncherWasActive)
+        {
+            Tools::PhaseTracer::Instance().Instant("Launcher window found", "launcher");
+        }
         m_hLauncherCheckTimer = SetTimer(m_hWnd, m_launcherCheckTimerId, CHECK_INTERVAL_MS, NULL);
 
         if (!IsWindow(m_hWnd))
@@ -113,6 +121,7 @@ namespace AnyFSE::App::Window
         log.Debug("Window is created (hWnd=%08x)", m_hWnd);
 
         SelectNextVideo();
+        SplashPreroll::Instance().NotifyWhenReady(m_hWnd, WM_POSTER_READY);
         m_videoPlayer.Load(m_currentVideo.c_str(), Config::SplashVideoMute, Config::SplashVideoLoop, Config::SplashVideoPause, m_hWnd);
 
         return true;
@@ -246,6 +255,9 @@ namespace AnyFSE::App::Window
         case WM_SIZE:
             m_videoPlayer.Resize();
             break;
+        case WM_POSTER_READY:
+            OnPosterReady();
+            return 0;
         case WM_ACTIVATE:
             if (wParam == 0
                 && GamingExperience::IsFullscreenMode()
@@ -277,7 +289,8 @@ namespace AnyFSE::App::Window
 
     void MainWindow::OnPaint()
     {
-        if (!m_empty && (Config::SplashShowAnimation || Config::SplashShowLogo || Config::SplashShowText))
+        if (!m_empty && (Config::SplashShowAnimation || Config::SplashShowLogo || Config::SplashShowText
+                         || SplashPreroll::Instance().HasPoster(m_currentVideo)))
         {
             OnPaintAnimated();
         }
@@ -295,14 +308,39 @@ namespace AnyFSE::App::Window
         PostQuitMessage(m_result);
     }
 
-    void MainWindow::SelectNextVideo()
+    void MainWindow::OnPosterReady()
     {
+        // The background layer is rendered again, now with the poster under the text
+        if (SplashPreroll::Instance().HasPoster(m_currentVideo))
+        {
+            log.Debug("Splash poster painted at %.1f ms", SplashPreroll::SinceProcessStart());
+            m_compositor.Invalidate();
+            InvalidateRect(m_hWnd, NULL, FALSE);
+        }
+    }
 
+    void MainWindow::SelectNextVideo()
+    {
         if (!Config::SplashShowVideo)
         {
             return;
         }
-        m_currentVideo = L"";
+
+        // The first splash plays what the preroll has opened already
+        m_currentVideo = SplashPreroll::Instance().TakeVideo();
+        if (m_currentVideo.empty())
+        {
+            m_currentVideo = FindSplashVideo();
+        }
+    }
+
+    // static
+    std::wstring MainWindow::FindSplashVideo()
+    {
+        if (!Config::SplashShowVideo)
+        {
+            return std::wstring();
+        }
 
         namespace fs = std::filesystem;
         std::wstring mediaPath = Config::SplashVideoPath.empty() ? Tools::Paths::GetSplashDefaultPath() : Config::SplashVideoPath;
@@ -321,7 +359,7 @@ namespace AnyFSE::App::Window
             if (!fs::exists(mediaPath) || !fs::is_directory(mediaPath))
             {
                 log.Error("Error: Directory does not exist or is not a directory: %s", Unicode::to_string(mediaPath).c_str());
-                return;
+                return std::wstring();
             }
 
             // Iterate through all files in the directory
@@ -357,10 +395,10 @@ namespace AnyFSE::App::Window
         if (!videoFiles.size())
         {
             log.Warn("No video files found");
-            return;
+            return std::wstring();
         }
 
-        m_currentVideo = videoFiles[GetTickCount64() % videoFiles.size()].wstring().c_str();
+        return videoFiles[GetTickCount64() % videoFiles.size()].wstring();
     }
 
     void MainWindow::Suspend(bool bSuspend)
@@ -27,9 +27,11 @@
 #include <windows.h>
 #include <string>
 #include "VideoPlayer.hpp"
+#include "SplashCompositor.hpp"
 #include "Tools/Event.hpp"
+#include "Tools/Tween.hpp"
 
-namespace Gdiplus { class Image; }
+namespace Gdiplus { class Image; class Font; class SolidBrush; class StringFormat; }
 
 namespace AnyFSE::App::Window
 {
@@ -62,6 +64,7 @@ namespace AnyFSE::App::Window
         void OnUpdateCheck();
         void ScheduleCheck(int delay = 60);
         void SelectNextVideo();
+        void OnPosterReady();
 
         LRESULT CALLBACK HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam);
 
@@ -75,6 +78,9 @@ namespace AnyFSE::App::Window
         bool Create(LPCWSTR className, HINSTANCE hInstance, LPCTSTR windowName);
         static int RunLoop();
 
+        // The video the splash plays next, empty if video is off or none is found
+        static std::wstring FindSplashVideo();
+
         bool IsVisible();
         int ExitOnError();
         HWND GetHwnd() { return m_hWnd; }
@@ -85,30 +91,44 @@ namespace AnyFSE::App::Window
 
     private: // Animation
 
-        UINT_PTR m_animationTimerId = 1;
         UINT_PTR m_updateTimerId = 2;
         UINT_PTR m_launcherCheckTimerId = 3;
-        UINT_PTR m_hAnimationTimer = NULL;
+        UINT m_animationId = 0;
         UINT_PTR m_hUpdateTimer = NULL;
         UINT_PTR m_hLauncherCheckTimer = NULL;
         bool m_bLauncherWasActive = false;
 
         const int CHECK_INTERVAL_MS = 500;
-        const int ZOOM_INTERVAL_MS = 20;
+        const int ZOOM_GROW_MS = 240;
+        const int ZOOM_SHRINK_MS = 1200;
+        const int ZOOM_STEPS = 16;
+        const float LOGO_SIZE = 150;
 
         float m_currentZoom = 0.96f;
-        float m_zoomStep = 0.002f;
         float m_zoomDelta = 0.06f;
+        AnyFSE::Tools::Tween m_zoomTween;
+        SplashCompositor m_compositor { 1 - m_zoomDelta, 1 + m_zoomDelta, ZOOM_STEPS };
 
         ULONG_PTR m_gdiplusToken;
 
         Gdiplus::Image * m_pLogoImage;
+
+        // Splash paint resources, created once instead of on every animation frame
+        Gdiplus::SolidBrush * m_pBackgroundBrush = nullptr;
+        Gdiplus::SolidBrush * m_pTextBrush = nullptr;
+        Gdiplus::StringFormat * m_pTextFormat = nullptr;
+        Gdiplus::Font * m_pTextFont = nullptr;
+        UINT m_textFontDpi = 0;
         const COLORREF THEME_BACKGROUND_COLOR = RGB(22,22,22);
+        static const UINT WM_POSTER_READY = WM_APP + 1;
 
 
         bool InitAnimationResources();
         BOOL LoadLogoImage();
         void OnPaintAnimated();
+        void RenderBackground(Gdiplus::Graphics &graphics, const RECT &client);
+        RECT GetLogoRect(float zoom);
+        bool OnAnimationFrame(double now);
         void OnTimer(UINT_PTR timerId);
         BOOL FreeAnimationResources();
         BOOL StartAnimation();
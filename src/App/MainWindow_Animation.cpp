@@ -30,8 +30,10 @@
 #include "Configuration/Config.hpp"
 #include "Tools/Icon.hpp"
 #include "Tools/GdiPlus.hpp"
-#include "Tools/DoubleBufferedPaint.hpp"
+#include "Tools/AnimationClock.hpp"
+#include "Tools/PhaseTracer.hpp"
 #include "App/Launchers.hpp"
+#include "App/SplashPreroll.hpp"
 
 #pragma comment(lib, "Gdiplus.lib")
 
@@ -43,6 +45,19 @@ namespace AnyFSE::App::Window
         Gdiplus::GdiplusStartupInput gdiplusStartupInput;
         GdiplusStartup(&m_gdiplusToken, &gdiplusStartupInput, NULL);
         LoadLogoImage();
+
+        m_pBackgroundBrush = new Gdiplus::SolidBrush(THEME_BACKGROUND_COLOR);
+        m_pTextBrush = new Gdiplus::SolidBrush(Gdiplus::Color::White);
+        m_pTextFormat = new Gdiplus::StringFormat();
+        m_pTextFormat->SetAlignment(Gdiplus::StringAlignmentCenter);
+        m_pTextFormat->SetLineAlignment(Gdiplus::StringAlignmentCenter);
+
+        m_compositor.SetBackground([this](Gdiplus::Graphics &graphics, const RECT &client)
+        {
+            RenderBackground(graphics, client);
+        });
+        m_compositor.SetLogo(
+            (m_pLogoImage && m_pLogoImage->GetLastStatus() == Gdiplus::Ok) ? m_pLogoImage : nullptr, LOGO_SIZE);
         return TRUE;
     }
 
@@ -59,79 +74,92 @@ namespace AnyFSE::App::Window
             return FALSE;
         }
 
-        if (HICON hIcon = Icon::LoadIcon(Config::Launcher.IconFile))
-        {
-            m_pLogoImage = new Gdiplus::Bitmap(hIcon);
-            DestroyIcon(hIcon);
-        }
+        m_pLogoImage = Icon::LoadBitmapFromIcon(Config::Launcher.IconFile);
+        Icon::FlushCache();
 
         return (m_pLogoImage && m_pLogoImage->GetLastStatus() == Gdiplus::Status::Ok);
     }
 
     void MainWindow::OnPaintAnimated()
     {
-        using namespace Gdiplus;
-        FluentDesign::DoubleBuferedPaint paint(m_hWnd);
-        Graphics graphics(paint.MemDC());
+        PAINTSTRUCT ps;
+        HDC hdc = BeginPaint(m_hWnd, &ps);
 
-        graphics.SetSmoothingMode(SmoothingModeAntiAlias);
-        // Fill background
-        Color backgroundColor;
-        backgroundColor.SetFromCOLORREF(THEME_BACKGROUND_COLOR);
-        SolidBrush backgroundBrush(THEME_BACKGROUND_COLOR);
+        RECT client;
+        GetClientRect(m_hWnd, &client);
+        m_compositor.Paint(hdc, client, GetDpiForWindow(m_hWnd), ps.rcPaint, m_currentZoom);
 
-        RectF rect = ToRectF(paint.ClientRect());
-        graphics.FillRectangle(&backgroundBrush, 0.0f, 0.0f, rect.Width, rect.Height);
+        EndPaint(m_hWnd, &ps);
+    }
 
-        float dpi = (float)GetDpiForWindow(m_hWnd);
+    void MainWindow::RenderBackground(Gdiplus::Graphics &graphics, const RECT &client)
+    {
+        using namespace Gdiplus;
+
+        RectF rect = ToRectF(client);
+        graphics.FillRectangle(m_pBackgroundBrush, 0.0f, 0.0f, rect.Width, rect.Height);
 
-        if (Config::SplashShowLogo && m_pLogoImage && m_pLogoImage->GetLastStatus() == Gdiplus::Ok)
+        // The first video frame fills the window the way the player crops the video, playback takes over in place
+        SplashPreroll::Instance().UsePoster(m_currentVideo, [&](const SplashPreroll::Poster &poster)
         {
-            REAL imageWidth = 150 /*pLogoImage->GetWidth()*/ * m_currentZoom * dpi / 96;
-            REAL imageHeight = 150 /*pLogoImage->GetHeight()*/ * m_currentZoom * dpi / 96;
-            REAL xPos = (rect.Width - imageWidth) / 2;
-            REAL yPos = (rect.Height - imageHeight) / 2;
+            Bitmap frame((INT)poster.width, (INT)poster.height, (INT)poster.width * 4, PixelFormat32bppRGB, (BYTE *)poster.pixels.data());
+            float scale = max(rect.Width / poster.width, rect.Height / poster.height);
+            float width = poster.width * scale;
+            float height = poster.height * scale;
 
-            // Draw centered image
-            graphics.DrawImage(m_pLogoImage, xPos, yPos, imageWidth, imageHeight);
-        }
+            graphics.SetInterpolationMode(InterpolationModeBilinear);
+            graphics.DrawImage(&frame, (rect.Width - width) / 2, (rect.Height - height) / 2, width, height);
+        });
+
+        UINT windowDpi = GetDpiForWindow(m_hWnd);
+        float dpi = (float)windowDpi;
 
         if (Config::SplashShowText)
         {
-            // Display text
-            Font font(L"Segoe UI", 14 * dpi / 96);
-            SolidBrush textBrush(Gdiplus::Color::White);
+            // Display text, the font is recreated only when the window moves to another DPI
+            if (!m_pTextFont || m_textFontDpi != windowDpi)
+            {
+                delete m_pTextFont;
+                m_pTextFont = new Font(L"Segoe UI", 14 * dpi / 96);
+                m_textFontDpi = windowDpi;
+            }
             std::wstring name = Config::SplashCustomText.empty()
                 ? std::wstring(L"Launching ") + Config::Launcher.Name
                 : Config::SplashCustomText;
 
-            // Use StringFormat for precise centering
-            StringFormat format;
-            format.SetAlignment(Gdiplus::StringAlignmentCenter);
-            format.SetLineAlignment(Gdiplus::StringAlignmentCenter);
-
             Gdiplus::RectF textArea = rect;
             textArea.Y = textArea.Height * 0.8f;
             textArea.Height = 50 * dpi / 96;
-            graphics.DrawString(name.c_str(), -1, &font, textArea, &format, &textBrush);
+            graphics.DrawString(name.c_str(), -1, m_pTextFont, textArea, m_pTextFormat, m_pTextBrush);
         }
     }
 
-    void MainWindow::OnTimer(UINT_PTR timerId)
+    RECT MainWindow::GetLogoRect(float zoom)
     {
-        if (timerId == m_animationTimerId)
-        {
-            m_currentZoom += (m_zoomStep > 0 ? m_zoomStep * 5 : m_zoomStep);
-            if (m_currentZoom > 1 + m_zoomDelta && m_zoomStep > 0
-                || (m_currentZoom < 1 - m_zoomDelta && m_zoomStep < 0))
-            {
-                m_zoomStep = -m_zoomStep;
-            }
+        RECT client;
+        GetClientRect(m_hWnd, &client);
+        return m_compositor.GetLogoRect(client, GetDpiForWindow(m_hWnd), zoom);
+    }
+
+    bool MainWindow::OnAnimationFrame(double now)
+    {
+        float zoom = (float)m_zoomTween.Value(now);
 
-            // Force repaint
-            InvalidateRect(m_hWnd, NULL, FALSE);
+        // Frames exist per zoom step only, there is nothing new to show until the step changes
+        if (m_compositor.QuantizeZoom(zoom) != m_compositor.QuantizeZoom(m_currentZoom))
+        {
+            RECT dirty = GetLogoRect(m_currentZoom);
+            RECT logo = GetLogoRect(zoom);
+            UnionRect(&dirty, &dirty, &logo);
+            InvalidateRect(m_hWnd, &dirty, FALSE);
         }
-        else if (timerId == m_launcherCheckTimerId)
+        m_currentZoom = zoom;
+        return true;
+    }
+
+    void MainWindow::OnTimer(UINT_PTR timerId)
+    {
+        if (timerId == m_launcherCheckTimerId)
         {
             bool isActive = Launchers::IsLauncherActiveOrMinimized();
             if (isActive || m_bLauncherWasActive)
@@ -144,10 +172,12 @@ namespace AnyFSE::App::Window
                     {
                         Launchers::FocusLauncher();
                     }
+                    Tools::PhaseTracer::Instance().Instant("Splash closed", "splash");
                     DestroyWindow(m_hWnd);
                 }
                 if (!m_bLauncherWasActive && isActive)
                 {
+                    Tools::PhaseTracer::Instance().Instant("Launcher window found", "launcher");
                     Launchers::LauncherOnStarted();
                 }
                 m_bLauncherWasActive = true;
@@ -157,30 +187,50 @@ namespace AnyFSE::App::Window
 
     BOOL MainWindow::FreeAnimationResources()
     {
+        m_compositor.LogCounters();
+        m_compositor.SetLogo(nullptr, LOGO_SIZE);
+
         if (m_pLogoImage)
         {
             delete m_pLogoImage;
             m_pLogoImage = NULL;
         }
+        delete m_pTextFont;
+        delete m_pTextFormat;
+        delete m_pTextBrush;
+        delete m_pBackgroundBrush;
+        m_pTextFont = nullptr;
+        m_pTextFormat = nullptr;
+        m_pTextBrush = nullptr;
+        m_pBackgroundBrush = nullptr;
+        m_textFontDpi = 0;
         Gdiplus::GdiplusShutdown(m_gdiplusToken);
         return TRUE;
     }
 
     BOOL MainWindow::StartAnimation()
     {
-        if (Config::SplashShowAnimation && Config::SplashShowLogo && !m_hAnimationTimer && m_pLogoImage)
+        if (Config::SplashShowAnimation && Config::SplashShowLogo && !m_animationId && m_pLogoImage)
         {
-            m_hAnimationTimer = SetTimer(m_hWnd, m_animationTimerId, ZOOM_INTERVAL_MS, NULL);
+            using namespace AnyFSE::Tools;
+            AnimationClock &clock = AnimationClock::Instance();
+
+            // Quick swell, slow settle
+            m_zoomTween = Tween(1 - m_zoomDelta, 1 + m_zoomDelta, ZOOM_GROW_MS, Easing::InOutSine);
+            m_zoomTween.SetRepeat(Tween::Repeat::PingPong, ZOOM_SHRINK_MS);
+            m_zoomTween.Start(clock.Now());
+
+            m_animationId = clock.Add(m_hWnd, [this](double now) { return OnAnimationFrame(now); });
         }
         return TRUE;
     }
 
     BOOL MainWindow::StopAnimation()
     {
-        if (m_hAnimationTimer)
+        if (m_animationId)
         {
-            KillTimer(m_hWnd, m_animationTimerId);
-            m_hAnimationTimer = NULL;
+            AnyFSE::Tools::AnimationClock::Instance().Remove(m_animationId);
+            m_animationId = 0;
         }
         return TRUE;
     }
@@ -0,0 +1,233 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+
+#include "SplashCompositor.hpp"
+#include "Logging/LogManager.hpp"
+#include "Tools/GdiPlus.hpp"
+
+namespace AnyFSE::App::Window
+{
+    static Logger log = LogManager::GetLogger("SplashCompositor");
+
+    bool SplashCompositor::Layer::Create(HDC hdcTarget, const RECT &layerRect)
+    {
+        Free();
+
+        int width = max(1, (int)(layerRect.right - layerRect.left));
+        int height = max(1, (int)(layerRect.bottom - layerRect.top));
+
+        hdc = CreateCompatibleDC(hdcTarget);
+        hBitmap = CreateCompatibleBitmap(hdcTarget, width, height);
+        if (!hdc || !hBitmap)
+        {
+            log.Error(log.APIError(), "Can't create %dx%d splash layer", width, height);
+            Free();
+            return false;
+        }
+
+        hOldBitmap = SelectObject(hdc, hBitmap);
+        rect = layerRect;
+        return true;
+    }
+
+    void SplashCompositor::Layer::Free()
+    {
+        if (hdc && hOldBitmap)
+        {
+            SelectObject(hdc, hOldBitmap);
+        }
+        if (hBitmap)
+        {
+            DeleteObject(hBitmap);
+        }
+        if (hdc)
+        {
+            DeleteDC(hdc);
+        }
+        hdc = NULL;
+        hBitmap = NULL;
+        hOldBitmap = NULL;
+        rect = RECT{};
+    }
+
+    SplashCompositor::SplashCompositor(float minZoom, float maxZoom, int zoomSteps)
+        : m_minZoom(minZoom)
+        , m_maxZoom(maxZoom)
+        , m_zoomSteps(max(2, zoomSteps))
+        , m_logoFrames(max(2, zoomSteps))
+    {
+        QueryPerformanceFrequency(&m_frequency);
+    }
+
+    SplashCompositor::~SplashCompositor()
+    {
+        Invalidate();
+    }
+
+    void SplashCompositor::SetBackground(RenderFunc render)
+    {
+        m_renderBackground = render;
+        Invalidate();
+    }
+
+    void SplashCompositor::SetLogo(Gdiplus::Image *logo, float designSize)
+    {
+        m_logo = logo;
+        m_logoDesignSize = designSize;
+        Invalidate();
+    }
+
+    void SplashCompositor::Invalidate()
+    {
+        m_background.Free();
+        for (Layer &frame : m_logoFrames)
+        {
+            frame.Free();
+        }
+    }
+
+    int SplashCompositor::ZoomStep(float zoom) const
+    {
+        float position = (zoom - m_minZoom) / (m_maxZoom - m_minZoom) * (m_zoomSteps - 1);
+        return std::clamp((int)std::lround(position), 0, m_zoomSteps - 1);
+    }
+
+    float SplashCompositor::QuantizeZoom(float zoom) const
+    {
+        return m_minZoom + (m_maxZoom - m_minZoom) * ZoomStep(zoom) / (m_zoomSteps - 1);
+    }
+
+    void SplashCompositor::LogoBounds(const RECT &client, UINT dpi, float zoom, float &x, float &y, float &size) const
+    {
+        size = m_logoDesignSize * QuantizeZoom(zoom) * dpi / 96;
+        x = client.left + (client.right - client.left - size) / 2;
+        y = client.top + (client.bottom - client.top - size) / 2;
+    }
+
+    RECT SplashCompositor::GetLogoRect(const RECT &client, UINT dpi, float zoom) const
+    {
+        float x, y, size;
+        LogoBounds(client, dpi, zoom, x, y, size);
+
+        // Pixels touched by the anti-aliased edges belong to the frame as well
+        return RECT
+        {
+            (LONG)std::floor(x) - 1,
+            (LONG)std::floor(y) - 1,
+            (LONG)std::ceil(x + size) + 1,
+            (LONG)std::ceil(y + size) + 1
+        };
+    }
+
+    bool SplashCompositor::RenderBackground(HDC hdc, const RECT &client)
+    {
+        if (!m_background.Create(hdc, client))
+        {
+            return false;
+        }
+
+        if (m_renderBackground)
+        {
+            Gdiplus::Graphics graphics(m_background.hdc);
+            graphics.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+            m_renderBackground(graphics, RECT{ 0, 0, client.right - client.left, client.bottom - client.top });
+        }
+        m_counters.layersRendered++;
+        return true;
+    }
+
+    bool SplashCompositor::RenderLogoFrame(HDC hdc, const RECT &client, UINT dpi, int step)
+    {
+        float zoom = m_minZoom + (m_maxZoom - m_minZoom) * step / (m_zoomSteps - 1);
+        RECT rect = GetLogoRect(client, dpi, zoom);
+
+        Layer &frame = m_logoFrames[step];
+        if (!frame.Create(hdc, rect))
+        {
+            return false;
+        }
+
+        // Composed over the background here, so painting it is a plain copy
+        BitBlt(frame.hdc, 0, 0, rect.right - rect.left, rect.bottom - rect.top,
+            m_background.hdc, rect.left - client.left, rect.top - client.top, SRCCOPY);
+
+        float x, y, size;
+        LogoBounds(client, dpi, zoom, x, y, size);
+
+        Gdiplus::Graphics graphics(frame.hdc);
+        graphics.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+        graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
+        graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHalf);
+        graphics.DrawImage(m_logo, x - rect.left, y - rect.top, size, size);
+
+        m_counters.layersRendered++;
+        return true;
+    }
+
+    void SplashCompositor::Paint(HDC hdc, const RECT &client, UINT dpi, const RECT &paint, float zoom)
+    {
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        SIZE clientSize{ client.right - client.left, client.bottom - client.top };
+        if (clientSize.cx != m_clientSize.cx || clientSize.cy != m_clientSize.cy || dpi != m_dpi)
+        {
+            Invalidate();
+            m_clientSize = clientSize;
+            m_dpi = dpi;
+        }
+
+        if (!m_background.hdc && !RenderBackground(hdc, client))
+        {
+            return;
+        }
+
+        Layer *frame = nullptr;
+        if (m_logo)
+        {
+            int step = ZoomStep(zoom);
+            if (m_logoFrames[step].hdc || RenderLogoFrame(hdc, client, dpi, step))
+            {
+                frame = &m_logoFrames[step];
+            }
+        }
+
+        // Background ring and logo frame never overlap, nothing on screen is painted twice
+        int saved = SaveDC(hdc);
+        if (frame)
+        {
+            ExcludeClipRect(hdc, frame->rect.left, frame->rect.top, frame->rect.right, frame->rect.bottom);
+        }
+        BitBlt(hdc, paint.left, paint.top, paint.right - paint.left, paint.bottom - paint.top,
+            m_background.hdc, paint.left - client.left, paint.top - client.top, SRCCOPY);
+        RestoreDC(hdc, saved);
+
+        if (frame)
+        {
+            BitBlt(hdc, frame->rect.left, frame->rect.top,
+                frame->rect.right - frame->rect.left, frame->rect.bottom - frame->rect.top,
+                frame->hdc, 0, 0, SRCCOPY);
+        }
+
+        LARGE_INTEGER end;
+        QueryPerformanceCounter(&end);
+        double microseconds = (double)(end.QuadPart - start.QuadPart) * 1000000.0 / (double)m_frequency.QuadPart;
+
+        m_counters.frames++;
+        m_counters.totalMicroseconds += microseconds;
+        m_counters.maxMicroseconds = max(m_counters.maxMicroseconds, microseconds);
+    }
+
+    void SplashCompositor::LogCounters() const
+    {
+        if (!m_counters.frames)
+        {
+            return;
+        }
+
+        log.Debug("Splash frames: %llu, average %.1f us, max %.1f us, layers rendered: %llu",
+            m_counters.frames, m_counters.totalMicroseconds / m_counters.frames,
+            m_counters.maxMicroseconds, m_counters.layersRendered);
+    }
+}
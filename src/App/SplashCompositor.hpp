@@ -0,0 +1,77 @@
+#pragma once
+
+#include <windows.h>
+#include <functional>
+#include <vector>
+
+namespace Gdiplus { class Image; class Graphics; }
+
+namespace AnyFSE::App::Window
+{
+    // Splash built from pre-rendered layers. The background with the text is rendered once per client
+    // size and DPI, the logo once per zoom step, already composed over the background. Painting a frame
+    // is one BitBlt of the logo frame and one of the background ring around it, nothing is scaled or
+    // laid out while the zoom animates.
+    class SplashCompositor
+    {
+    public:
+        typedef std::function<void(Gdiplus::Graphics &graphics, const RECT &client)> RenderFunc;
+
+        struct Counters
+        {
+            unsigned long long frames = 0;
+            unsigned long long layersRendered = 0;
+            double totalMicroseconds = 0;
+            double maxMicroseconds = 0;
+        };
+
+        SplashCompositor(float minZoom, float maxZoom, int zoomSteps);
+        ~SplashCompositor();
+
+        void SetBackground(RenderFunc render);
+        void SetLogo(Gdiplus::Image *logo, float designSize);
+        void Invalidate();
+
+        // Zoom snapped to the nearest pre-rendered step
+        float QuantizeZoom(float zoom) const;
+        RECT GetLogoRect(const RECT &client, UINT dpi, float zoom) const;
+
+        void Paint(HDC hdc, const RECT &client, UINT dpi, const RECT &paint, float zoom);
+
+        const Counters &GetCounters() const { return m_counters; }
+        void LogCounters() const;
+
+    private:
+        struct Layer
+        {
+            HDC hdc = NULL;
+            HBITMAP hBitmap = NULL;
+            HGDIOBJ hOldBitmap = NULL;
+            RECT rect{};
+
+            bool Create(HDC hdcTarget, const RECT &layerRect);
+            void Free();
+        };
+
+        float m_minZoom;
+        float m_maxZoom;
+        int m_zoomSteps;
+
+        RenderFunc m_renderBackground;
+        Gdiplus::Image *m_logo = nullptr;
+        float m_logoDesignSize = 0;
+
+        SIZE m_clientSize{};
+        UINT m_dpi = 0;
+        Layer m_background;
+        std::vector<Layer> m_logoFrames;
+
+        LARGE_INTEGER m_frequency{};
+        Counters m_counters;
+
+        int ZoomStep(float zoom) const;
+        void LogoBounds(const RECT &client, UINT dpi, float zoom, float &x, float &y, float &size) const;
+        bool RenderBackground(HDC hdc, const RECT &client);
+        bool RenderLogoFrame(HDC hdc, const RECT &client, UINT dpi, int step);
+    };
+}
@@ -0,0 +1,435 @@
+#include <windows.h>
+#include <mfapi.h>
+#include <mfidl.h>
+#include <mfreadwrite.h>
+#include <cstdlib>
+#include <filesystem>
+
+#include "App/SplashPreroll.hpp"
+#include "Logging/LogManager.hpp"
+#include "Tools/IconAtlas.hpp"
+#include "Tools/Paths.hpp"
+#include "Tools/PhaseTracer.hpp"
+#include "Tools/Unicode.hpp"
+
+#pragma comment(lib, "mfplat.lib")
+#pragma comment(lib, "mfreadwrite.lib")
+#pragma comment(lib, "mfuuid.lib")
+
+namespace AnyFSE::App::Window
+{
+    static Logger log = LogManager::GetLogger("SplashPreroll");
+
+    namespace
+    {
+        // A poster only stands in for a few hundred ms, larger videos are scaled down to keep the file small
+        const uint32_t MaxPosterWidth = 1920;
+        const size_t MaxPosters = 4;
+
+        std::wstring PosterCachePath()
+        {
+            return Tools::Paths::GetCachePath() + L"\\SplashPoster.bin";
+        }
+
+        // Changes when the video is replaced or edited
+        bool GetVideoStamp(const std::wstring &videoFile, uint64_t &stamp)
+        {
+            WIN32_FILE_ATTRIBUTE_DATA data;
+            if (!GetFileAttributesExW(videoFile.c_str(), GetFileExInfoStandard, &data))
+            {
+                return false;
+            }
+            uint64_t written = ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+            uint64_t size = ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+            stamp = written ^ (size * 0x9E3779B97F4A7C15ull);
+            return true;
+        }
+
+        // Maps the cache file, calls use with the reader and unmaps it
+        bool ReadPosterCache(const std::function<void(const Tools::IconAtlas::Reader &reader)> &use)
+        {
+            std::wstring path = PosterCachePath();
+            HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            bool opened = false;
+            LARGE_INTEGER fileSize{};
+            HANDLE hMapping = NULL;
+            const uint8_t *view = nullptr;
+            if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0)
+            {
+                hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+                view = hMapping ? (const uint8_t *)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            }
+
+            Tools::IconAtlas::Reader reader;
+            if (view && reader.Open(view, (size_t)fileSize.QuadPart))
+            {
+                use(reader);
+                opened = true;
+            }
+            reader.Close();
+
+            if (view)
+            {
+                UnmapViewOfFile(view);
+            }
+            if (hMapping)
+            {
+                CloseHandle(hMapping);
+            }
+            CloseHandle(hFile);
+            return opened;
+        }
+
+        bool LoadPoster(const std::string &key, uint64_t stamp, SplashPreroll::Poster &poster)
+        {
+            bool found = false;
+            ReadPosterCache([&](const Tools::IconAtlas::Reader &reader)
+            {
+                Tools::IconAtlas::Image image;
+                if (reader.Find(key, 0, stamp, image))
+                {
+                    poster.width = image.width;
+                    poster.height = image.height;
+                    poster.pixels.assign(image.pixels, image.pixels + (size_t)image.width * image.height * 4);
+                    found = true;
+                }
+            });
+            return found;
+        }
+
+        void SavePoster(const std::string &key, uint64_t stamp, const SplashPreroll::Poster &poster)
+        {
+            Tools::IconAtlas::Writer writer;
+            writer.Add(key, 0, stamp, poster.width, poster.height, poster.pixels.data());
+
+            // A folder of videos keeps the posters of the last few, one video keeps just its own
+            ReadPosterCache([&](const Tools::IconAtlas::Reader &reader)
+            {
+                if (reader.Count() < MaxPosters)
+                {
+                    writer.Merge(reader);
+                }
+            });
+
+            std::vector<uint8_t> data = writer.Serialize();
+            std::wstring path = PosterCachePath();
+            std::wstring tempPath = path + L".tmp";
+
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+            HANDLE hFile = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                log.Warn(log.APIError(), "Can't create poster cache %s", Tools::Unicode::to_string(tempPath).c_str());
+                return;
+            }
+
+            DWORD written = 0;
+            BOOL success = WriteFile(hFile, data.data(), (DWORD)data.size(), &written, NULL) && written == data.size();
+            CloseHandle(hFile);
+
+            if (!success || !MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+            {
+                log.Warn(log.APIError(), "Can't write poster cache %s", Tools::Unicode::to_string(path).c_str());
+                DeleteFileW(tempPath.c_str());
+            }
+        }
+
+        // RGB32 rows into opaque top-down BGRA, averaged over factor x factor blocks
+        void CopyFrame(const BYTE *data, LONG stride, UINT32 width, UINT32 height, SplashPreroll::Poster &poster)
+        {
+            uint32_t factor = (width + MaxPosterWidth - 1) / MaxPosterWidth;
+            poster.width = width / factor;
+            poster.height = height / factor;
+            poster.pixels.resize((size_t)poster.width * poster.height * 4);
+
+            // A negative stride is a bottom-up frame, data points at its top row either way
+            uint8_t *out = poster.pixels.data();
+            for (uint32_t y = 0; y < poster.height; ++y)
+            {
+                for (uint32_t x = 0; x < poster.width; ++x)
+                {
+                    uint32_t sum[3] = {};
+                    for (uint32_t dy = 0; dy < factor; ++dy)
+                    {
+                        const BYTE *row = data + (ptrdiff_t)stride * (y * factor + dy);
+                        for (uint32_t dx = 0; dx < factor; ++dx)
+                        {
+                            const BYTE *pixel = row + (size_t)(x * factor + dx) * 4;
+                            sum[0] += pixel[0];
+                            sum[1] += pixel[1];
+                            sum[2] += pixel[2];
+                        }
+                    }
+                    uint32_t count = factor * factor;
+                    *out++ = (uint8_t)(sum[0] / count);
+                    *out++ = (uint8_t)(sum[1] / count);
+                    *out++ = (uint8_t)(sum[2] / count);
+                    *out++ = 0xFF;
+                }
+            }
+        }
+
+        // The first frame as RGB32 from a source reader, the same decoders the player will use
+        bool DecodePoster(const std::wstring &videoFile, SplashPreroll::Poster &poster)
+        {
+            IMFAttributes *pAttributes = nullptr;
+            IMFSourceReader *pReader = nullptr;
+            IMFMediaType *pType = nullptr;
+            IMFSample *pSample = nullptr;
+            IMFMediaBuffer *pBuffer = nullptr;
+            bool decoded = false;
+
+            do
+            {
+                if (FAILED(MFCreateAttributes(&pAttributes, 1))
+                    || FAILED(pAttributes->SetUINT32(MF_SOURCE_READER_ENABLE_VIDEO_PROCESSING, TRUE)))
+                {
+                    break;
+                }
+
+                HRESULT hr = MFCreateSourceReaderFromURL(videoFile.c_str(), pAttributes, &pReader);
+                if (FAILED(hr))
+                {
+                    log.Warn(log.APIError((DWORD)hr), "Can't open %s for the poster", Tools::Unicode::to_string(videoFile).c_str());
+                    break;
+                }
+
+                pReader->SetStreamSelection((DWORD)MF_SOURCE_READER_ALL_STREAMS, FALSE);
+                pReader->SetStreamSelection((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, TRUE);
+
+                if (FAILED(MFCreateMediaType(&pType))
+                    || FAILED(pType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Video))
+                    || FAILED(pType->SetGUID(MF_MT_SUBTYPE, MFVideoFormat_RGB32))
+                    || FAILED(pReader->SetCurrentMediaType((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, NULL, pType)))
+                {
+                    log.Warn("Video can't be decoded to RGB32 for the poster");
+                    break;
+                }
+                pType->Release();
+                pType = nullptr;
+
+                UINT32 width = 0, height = 0;
+                if (FAILED(pReader->GetCurrentMediaType((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, &pType))
+                    || FAILED(MFGetAttributeSize(pType, MF_MT_FRAME_SIZE, &width, &height))
+                    || !width || !height)
+                {
+                    break;
+                }
+                LONG stride = (LONG)MFGetAttributeUINT32(pType, MF_MT_DEFAULT_STRIDE, width * 4);
+
+                // Decoders may give a few empty reads before the first frame
+                for (int attempt = 0; attempt < 16 && !pSample; ++attempt)
+                {
+                    DWORD flags = 0;
+                    LONGLONG timestamp = 0;
+                    hr = pReader->ReadSample((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, 0, NULL, &flags, &timestamp, &pSample);
+                    if (FAILED(hr) || (flags & MF_SOURCE_READERF_ENDOFSTREAM))
+                    {
+                        break;
+                    }
+                }
+                if (!pSample || FAILED(pSample->ConvertToContiguousBuffer(&pBuffer)))
+                {
+                    break;
+                }
+
+                BYTE *data = nullptr;
+                DWORD length = 0;
+                if (FAILED(pBuffer->Lock(&data, NULL, &length)))
+                {
+                    break;
+                }
+                if (length >= (DWORD)std::abs(stride) * height)
+                {
+                    CopyFrame(stride < 0 ? data + (size_t)(-stride) * (height - 1) : data, stride, width, height, poster);
+                    decoded = true;
+                }
+                pBuffer->Unlock();
+            } while (false);
+
+            if (pBuffer) pBuffer->Release();
+            if (pSample) pSample->Release();
+            if (pType) pType->Release();
+            if (pReader) pReader->Release();
+            if (pAttributes) pAttributes->Release();
+            return decoded;
+        }
+
+        // Opens the file and decodes its first sample to the decoder's own format, which loads the decoder and
+        // reads the headers without converting a full RGB32 frame that nobody shows
+        void WarmUp(const std::wstring &videoFile)
+        {
+            IMFSourceReader *pReader = nullptr;
+            IMFMediaType *pType = nullptr;
+            IMFSample *pSample = nullptr;
+
+            if (SUCCEEDED(MFCreateSourceReaderFromURL(videoFile.c_str(), NULL, &pReader)))
+            {
+                pReader->SetStreamSelection((DWORD)MF_SOURCE_READER_ALL_STREAMS, FALSE);
+                pReader->SetStreamSelection((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, TRUE);
+
+                if (SUCCEEDED(MFCreateMediaType(&pType))
+                    && SUCCEEDED(pType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Video))
+                    && SUCCEEDED(pType->SetGUID(MF_MT_SUBTYPE, MFVideoFormat_NV12)))
+                {
+                    // Compressed samples are read when the decoder can't give NV12, the file is read either way
+                    pReader->SetCurrentMediaType((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, NULL, pType);
+                }
+
+                DWORD flags = 0;
+                LONGLONG timestamp = 0;
+                pReader->ReadSample((DWORD)MF_SOURCE_READER_FIRST_VIDEO_STREAM, 0, NULL, &flags, &timestamp, &pSample);
+            }
+
+            if (pSample) pSample->Release();
+            if (pType) pType->Release();
+            if (pReader) pReader->Release();
+        }
+    }
+
+    SplashPreroll &SplashPreroll::Instance()
+    {
+        static SplashPreroll preroll;
+        return preroll;
+    }
+
+    SplashPreroll::~SplashPreroll()
+    {
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+    }
+
+    double SplashPreroll::SinceProcessStart()
+    {
+        FILETIME creation, exit, kernel, user, now;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        {
+            return 0;
+        }
+        GetSystemTimePreciseAsFileTime(&now);
+
+        ULONGLONG created = ((ULONGLONG)creation.dwHighDateTime << 32) | creation.dwLowDateTime;
+        ULONGLONG current = ((ULONGLONG)now.dwHighDateTime << 32) | now.dwLowDateTime;
+        return (double)(current - created) / 10000.0;
+    }
+
+    void SplashPreroll::Start(const std::wstring &videoFile)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_worker.joinable() || videoFile.empty())
+        {
+            return;
+        }
+
+        m_video = videoFile;
+        m_worker = std::thread(&SplashPreroll::Run, this, videoFile);
+    }
+
+    std::wstring SplashPreroll::TakeVideo()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_videoTaken)
+        {
+            return std::wstring();
+        }
+        m_videoTaken = true;
+        return m_video;
+    }
+
+    void SplashPreroll::NotifyWhenReady(HWND hWnd, UINT message)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_hNotify = hWnd;
+        m_notifyMessage = message;
+        if (m_ready)
+        {
+            PostMessage(hWnd, message, 0, 0);
+        }
+    }
+
+    bool SplashPreroll::HasPoster(const std::wstring &videoFile)
+    {
+        return UsePoster(videoFile, [](const Poster &) {});
+    }
+
+    bool SplashPreroll::UsePoster(const std::wstring &videoFile, const std::function<void(const Poster &poster)> &use)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (!m_ready || m_poster.pixels.empty() || videoFile != m_video)
+        {
+            return false;
+        }
+        use(m_poster);
+        return true;
+    }
+
+    void SplashPreroll::Ready(Poster &&poster)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_poster = std::move(poster);
+        m_ready = true;
+        if (m_hNotify)
+        {
+            PostMessage(m_hNotify, m_notifyMessage, 0, 0);
+        }
+    }
+
+    void SplashPreroll::Run(std::wstring videoFile)
+    {
+        Tools::PhaseTracer::Scope trace("Splash preroll", "video");
+        double started = SinceProcessStart();
+
+        HRESULT hrCom = CoInitializeEx(NULL, COINIT_MULTITHREADED);
+        HRESULT hrStartup = MFStartup(MF_VERSION);
+
+        std::string key = Tools::Unicode::to_string(videoFile);
+        uint64_t stamp = 0;
+        Poster poster;
+
+        if (!GetVideoStamp(videoFile, stamp))
+        {
+            log.Warn(log.APIError(), "Splash video %s is not accessible", key.c_str());
+        }
+        else if (LoadPoster(key, stamp, poster))
+        {
+            Ready(std::move(poster));
+            Tools::PhaseTracer::Instance().Instant("Splash poster ready", "video");
+            log.Info("Splash poster from cache at %.1f ms, in %.1f ms", SinceProcessStart(), SinceProcessStart() - started);
+
+            // Opened anyway, the player finds the file read and its decoders loaded
+            WarmUp(videoFile);
+        }
+        else if (DecodePoster(videoFile, poster))
+        {
+            // Shown first, saved for the next boot after
+            Ready(Poster(poster));
+            Tools::PhaseTracer::Instance().Instant("Splash poster ready", "video");
+            log.Info("Splash poster decoded at %.1f ms, in %.1f ms", SinceProcessStart(), SinceProcessStart() - started);
+            SavePoster(key, stamp, poster);
+        }
+
+        // The player keeps its own startup, this one is only for the worker
+        if (FAILED(hrStartup))
+        {
+            log.Warn(log.APIError((DWORD)hrStartup), "Media Foundation can't start");
+        }
+        else
+        {
+            MFShutdown();
+        }
+        if (SUCCEEDED(hrCom))
+        {
+            CoUninitialize();
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AnyFSE::App::Window
+{
+    // Gets the splash video ready from the start of the boot, while the launcher starts. A worker opens the
+    // video, which loads its decoders and reads its headers before the player asks for them, and takes its
+    // first frame as the poster. Posters are kept decoded in SplashPoster.bin, the next boot shows one from
+    // the mapped file before the splash window is even created. The splash paints the poster until the video
+    // shows the same frame over it.
+    class SplashPreroll
+    {
+    public:
+        struct Poster
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<uint8_t> pixels;    // BGRA, opaque, top-down rows of width * 4 bytes
+        };
+
+        static SplashPreroll &Instance();
+
+        ~SplashPreroll();
+
+        void Start(const std::wstring &videoFile);
+
+        // The prerolled video for the first splash, empty afterwards
+        std::wstring TakeVideo();
+
+        // Posts the message to the window when the poster is ready, at once if it is already
+        void NotifyWhenReady(HWND hWnd, UINT message);
+
+        bool HasPoster(const std::wstring &videoFile);
+
+        // Calls use with the poster of the video, under the lock
+        bool UsePoster(const std::wstring &videoFile, const std::function<void(const Poster &poster)> &use);
+
+        // Milliseconds since the process was created
+        static double SinceProcessStart();
+
+    private:
+        std::mutex m_lock;
+        std::thread m_worker;
+        std::wstring m_video;
+        bool m_videoTaken = false;
+
+        Poster m_poster;
+        bool m_ready = false;
+        HWND m_hNotify = NULL;
+        UINT m_notifyMessage = 0;
+
+        SplashPreroll() = default;
+
+        void Run(std::wstring videoFile);
+        void Ready(Poster &&poster);
+    };
+}
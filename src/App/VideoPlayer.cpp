@@ -24,6 +24,8 @@
 #include "Logging/LogManager.hpp"
 #include "VideoPlayer.hpp"
 #include "Tools/Unicode.hpp"
+#include "Tools/PhaseTracer.hpp"
+#include "App/SplashPreroll.hpp"
 
 #include <filesystem>
 #include <algorithm>
@@ -82,6 +84,7 @@ namespace AnyFSE::App::Window
         {
             case MFP_EVENT_TYPE_MEDIAITEM_CREATED:
             {
+                Tools::PhaseTracer::Instance().Instant("Video item created", "video");
                 MFP_MEDIAITEM_CREATED_EVENT* pEvent = (MFP_MEDIAITEM_CREATED_EVENT*)pEventHeader;
                 if (pEventHeader->pMediaPlayer && pEvent->pMediaItem)
                 {
@@ -95,6 +98,7 @@ namespace AnyFSE::App::Window
             break;
             case MFP_EVENT_TYPE_MEDIAITEM_SET:
             {
+                Tools::PhaseTracer::Instance().Instant("Video item set", "video");
                 log.Debug("Video is loaded and ready to play");
                 SIZE screenSize, videoSize;
                 pEventHeader->pMediaPlayer->GetIdealVideoSize(nullptr, &screenSize);
@@ -122,8 +126,7 @@ namespace AnyFSE::App::Window
                 if (m_desiredState == MFP_MEDIAPLAYER_STATE_PLAYING)
                 {
                     pEventHeader->pMediaPlayer->Play();
-                    log.Debug("Show in MFP_EVENT_TYPE_MEDIAITEM_SET");
-                    ShowVideo(true);
+                    log.Debug("Play in MFP_EVENT_TYPE_MEDIAITEM_SET");
                 }
                 else if (m_desiredState == MFP_MEDIAPLAYER_STATE_PAUSED)
                 {
@@ -132,6 +135,26 @@ namespace AnyFSE::App::Window
                 }
             }
             break;
+            case MFP_EVENT_TYPE_PLAY:
+            {
+                // Shown once it plays, until then the splash paints the poster of the same frame. Every loop
+                // restart plays again, the window is already up then.
+                if (SUCCEEDED(pEventHeader->hrEvent) && m_desiredState == MFP_MEDIAPLAYER_STATE_PLAYING)
+                {
+                    if (!m_videoShown)
+                    {
+                        ShowVideo(true);
+                    }
+                    if (!m_firstFrameLogged)
+                    {
+                        m_firstFrameLogged = true;
+                        double now = SplashPreroll::SinceProcessStart();
+                        Tools::PhaseTracer::Instance().Instant("First video frame", "video");
+                        log.Info("Time to first video frame: %.1f ms since start, %.1f ms since load", now, now - m_loadedAt);
+                    }
+                }
+            }
+            break;
             case MFP_EVENT_TYPE_PLAYBACK_ENDED:
             {
                 log.Debug("Video Completed");
@@ -182,6 +205,9 @@ namespace AnyFSE::App::Window
         , m_endLoop(0)
         , m_startLoop(0)
         , m_desiredState(MFP_MEDIAPLAYER_STATE_EMPTY)
+        , m_loadedAt(0)
+        , m_firstFrameLogged(false)
+        , m_videoShown(false)
     {
         CoInitializeEx(NULL, COINIT_MULTITHREADED);
         InitializeCriticalSection(&m_cs);
@@ -225,6 +251,7 @@ namespace AnyFSE::App::Window
     HRESULT SimpleVideoPlayer::Load(const WCHAR *videoFile, bool mute, bool loop, bool pause, HWND hwndParent)
     {
         CriticalSectionLock lock(&m_cs);
+        Tools::PhaseTracer::Scope trace("Video load", "video");
 
         m_playCount = 0;
 
@@ -249,6 +276,9 @@ namespace AnyFSE::App::Window
 
         m_loop = loop;
         m_pause = pause;
+        m_loadedAt = SplashPreroll::SinceProcessStart();
+        m_firstFrameLogged = false;
+        m_videoShown = false;
 
         ParseLoopTimings(videoFile);
 
@@ -330,8 +360,11 @@ namespace AnyFSE::App::Window
         }
 
         hr = m_pPlayer->Play();
-        log.Debug("Show in Play");
-        ShowVideo(true);
+        if (state == MFP_MEDIAPLAYER_STATE_PLAYING)
+        {
+            log.Debug("Show in Play");
+            ShowVideo(true);
+        }
 
         if (FAILED(hr))
         {
@@ -505,9 +538,11 @@ namespace AnyFSE::App::Window
         m_pPlayer->GetVideoWindow(&hVideoWin);
         if (hVideoWin)
         {
+            m_videoShown = bShow;
             if (bShow)
             {
                 log.Debug("Show Video Window");
+                Tools::PhaseTracer::Instance().Instant("Video shown", "video");
                 Resize();
                 ShowWindow(hVideoWin, SW_SHOW);
             }
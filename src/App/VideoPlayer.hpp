@@ -65,6 +65,11 @@ namespace AnyFSE::App::Window
 
         int m_playCount;
 
+        // Since the process started, for the time to the first frame
+        double m_loadedAt;
+        bool m_firstFrameLogged;
+        bool m_videoShown;
+
         std::wstring m_loadedVideo;
 
         volatile long m_refCount;
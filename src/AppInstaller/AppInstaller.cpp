@@ -35,6 +35,7 @@
 #include "AppInstaller.hpp"
 #include "Logging/LogManager.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
+#include "FluentDesign/Palette.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/Window.hpp"
 #include "Tools/Process.hpp"
@@ -198,8 +199,8 @@ namespace AnyFSE
         if (!GamingExperience::ApiIsAvailable)
         {
             ShowErrorPage(
-                Translate(L"notSupportedCaption"),
-                Translate(L"notSupportedDescription"),
+                Translate(KeyId::notSupportedCaption),
+                Translate(KeyId::notSupportedDescription),
                 Icon_Error
             );
         }
@@ -207,8 +208,8 @@ namespace AnyFSE
         )
         {
             ShowErrorPage(
-                Translate(L"insufficientPermissionsCaption"),
-                Translate(L"insufficientPermissionsDescription"),
+                Translate(KeyId::insufficientPermissionsCaption),
+                Translate(KeyId::insufficientPermissionsDescription),
                 Icon_Permission);
         }
         else
@@ -220,7 +221,7 @@ namespace AnyFSE
     void AppInstaller::UpdateDialogTitle()
     {
         std::wstring title = TranslateF(
-            m_isUpdate ? L"updaterWindowTitle" : L"installerWindowTitle",
+            m_isUpdate ? KeyId::updaterWindowTitle : KeyId::installerWindowTitle,
             Unicode::to_wstring(APP_VERSION).c_str());
         SetWindowText(m_hDialog, title.c_str());
     }
@@ -277,15 +278,14 @@ namespace AnyFSE
         RectF panelRect = rect;
         panelRect.Height = rect.Height - footerHeight + 1;
 
-        SolidBrush panelBrush(m_theme.GetColor(Theme::Colors::Dialog));
-        graphics.FillRectangle(&panelBrush, panelRect);
+        std::shared_ptr<const FluentDesign::Palette> palette = m_theme.GetPalette();
+        graphics.FillRectangle(palette->Brush(Theme::Colors::Dialog), panelRect);
 
         RectF footerRect = rect;
         footerRect.Y = panelRect.GetBottom() - 1;
         footerRect.Height = footerHeight;
 
-        SolidBrush footerBrush(m_theme.GetColor(Theme::Colors::Footer));
-        graphics.FillRectangle(&footerBrush, footerRect);
+        graphics.FillRectangle(palette->Brush(Theme::Colors::Footer), footerRect);
 
         for (auto &a : m_designedPositions)
         {
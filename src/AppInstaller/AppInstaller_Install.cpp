@@ -62,23 +62,23 @@ namespace AnyFSE
 
 #ifdef OFFLINE_INSTALLER
             // Extract resource file
-            SetCurrentProgress(Translate(L"progressUnpackFiles"));
+            SetCurrentProgress(Translate(KeyId::progressUnpackFiles));
             CheckSuccess(ExtractEmbeddedZip(path));
 #else
-            SetCurrentProgress(Translate(L"progressDownloadFiles"));
+            SetCurrentProgress(Translate(KeyId::progressDownloadFiles));
             CheckSuccess(DownloadFiles(path));
 #endif
 
             std::wstring oldPath = Registry::ReadString(registryPath, L"InstallLocation");
             if (!oldPath.empty())
             {
-                SetCurrentProgress(Translate(L"progressRemoveOldVersion"));
+                SetCurrentProgress(Translate(KeyId::progressRemoveOldVersion));
                 CheckSuccess(DeleteOldVersion() && DeleteOldFiles(oldPath));
             }
 
             if (!devModeWasEnabled)
             {
-                SetCurrentProgress(Translate(L"progressEnableDeveloperMode"));
+                SetCurrentProgress(Translate(KeyId::progressEnableDeveloperMode));
                 EnableDeveloperMode(true);
                 CheckSuccess(true);
             }
@@ -90,17 +90,17 @@ namespace AnyFSE
 
             if (true)
             {
-                SetCurrentProgress(Translate(L"progressInstallPublisherCertificate"));
+                SetCurrentProgress(Translate(KeyId::progressInstallPublisherCertificate));
                 CheckSuccess(ToolsEx::Certificate::InstallRootCertificate(path.wstring() + L"/" + AppConstants::PublisherCertFile));
             }
 
             if (IsNeedEnableAsusOptimization())
             {
-                SetCurrentProgress(Translate(L"progressRestoreAsusOptimizationService"));
+                SetCurrentProgress(Translate(KeyId::progressRestoreAsusOptimizationService));
                 CheckSuccess(EnableAsusOptimization());
             }
 
-            SetCurrentProgress(Translate(L"progressInstallPackage"));
+            SetCurrentProgress(Translate(KeyId::progressInstallPackage));
             CopyFiles(path, Tools::Paths::GetInstallPath());
 
             CheckSuccess(Tools::Packages::InstallPackage(
@@ -113,16 +113,16 @@ namespace AnyFSE
 
             if (acseServiceWasRunning)
             {
-                SetCurrentProgress(Translate(L"progressStartAcseInjectorService"));
+                SetCurrentProgress(Translate(KeyId::progressStartAcseInjectorService));
                 CheckSuccess(EnableInjectorService());
             }
 
-            SetCurrentProgress(Translate(L"progressCleanupFiles"));
+            SetCurrentProgress(Translate(KeyId::progressCleanupFiles));
             CheckSuccess(true);
 
             if (!devModeWasEnabled)
             {
-                SetCurrentProgress(Translate(L"progressDisableDeveloperMode"));
+                SetCurrentProgress(Translate(KeyId::progressDisableDeveloperMode));
                 EnableDeveloperMode(false);
                 CheckSuccess(true);
             }
@@ -141,7 +141,7 @@ namespace AnyFSE
         catch (const std::exception& e)
         {
             log.Error(e, "Installation fail:");
-            ShowErrorPage(Translate(L"installationErrorCaption"), GetProgressText(4) + Unicode::to_wstring(e.what()));
+            ShowErrorPage(Translate(KeyId::installationErrorCaption), GetProgressText(4) + Unicode::to_wstring(e.what()));
 
             // Best-effort service recovery after failed update.
             if (acseServiceWasRunning)
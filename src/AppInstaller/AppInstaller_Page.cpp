@@ -127,7 +127,7 @@ namespace AnyFSE
                 rc.bottom - m_theme.DpiScale(Layout_ButtonHeight),
                 m_theme.DpiScale(Layout_ButtonHeight * 2),
                 m_theme.DpiScale(Layout_ButtonHeight))
-            //.SetText(Translate(L"language"))
+            //.SetText(Translate(KeyId::language))
             .SetIcon(L"\xE164")
             .SetFlat(true)
             .GetHwnd()
@@ -190,19 +190,19 @@ namespace AnyFSE
         if (m_isUpdate)
         {
             ShowPage(L"",
-                Translate(L"updaterWelcomeCaption"),
-                TranslateF(L"updaterWelcomeDescription", Unicode::to_wstring(APP_VERSION).c_str()),
-                Translate(L"cancelBtn"), delegate(OnCancel),
-                Translate(L"updateBtn"), delegate(OnInstall)
+                Translate(KeyId::updaterWelcomeCaption),
+                TranslateF(KeyId::updaterWelcomeDescription, Unicode::to_wstring(APP_VERSION).c_str()),
+                Translate(KeyId::cancelBtn), delegate(OnCancel),
+                Translate(KeyId::updateBtn), delegate(OnInstall)
             );
         }
         else
         {
             ShowPage(L"",
-                Translate(L"installerWelcomeCaption"),
-                TranslateF(L"installerWelcomeDescription", Unicode::to_wstring(APP_VERSION).c_str()),
-                Translate(L"cancelBtn"), delegate(OnCancel),
-                Translate(L"nextBtn"), delegate(ShowLicensePage)
+                Translate(KeyId::installerWelcomeCaption),
+                TranslateF(KeyId::installerWelcomeDescription, Unicode::to_wstring(APP_VERSION).c_str()),
+                Translate(KeyId::cancelBtn), delegate(OnCancel),
+                Translate(KeyId::nextBtn), delegate(ShowLicensePage)
             );
         }
     }
@@ -211,12 +211,12 @@ namespace AnyFSE
     {
         m_languageButton.Show(false);
         ShowPage(Icon_EULA,
-            Translate(L"licenseCaption"),
+            Translate(KeyId::licenseCaption),
 
-            Translate(L"licenseDescription"),
+            Translate(KeyId::licenseDescription),
 
-            Translate(L"cancelBtn"), delegate(OnCancel),
-            Translate(L"acceptBtn"), delegate(OnInstall)
+            Translate(KeyId::cancelBtn), delegate(OnCancel),
+            Translate(KeyId::acceptBtn), delegate(OnInstall)
         );
     }
 
@@ -224,8 +224,8 @@ namespace AnyFSE
     {
         m_languageButton.Show(false);
         ShowPage(Icon_Progress,
-            m_isUpdate ? Translate(L"updaterProgressCaption") : Translate(L"installerProgressCaption"),
-            Translate(L"progressPreparation"),
+            m_isUpdate ? Translate(KeyId::updaterProgressCaption) : Translate(KeyId::installerProgressCaption),
+            Translate(KeyId::progressPreparation),
             L"", delegate(OnCancel));
     }
 
@@ -235,18 +235,18 @@ namespace AnyFSE
         if (m_isUpdate)
         {
             ShowPage(Icon_Done,
-                Translate(L"doneBtn"),
-                Translate(L"updaterDoneDescription"),
-                Translate(L"doneBtn"), delegate(OnDone)
+                Translate(KeyId::doneBtn),
+                Translate(KeyId::updaterDoneDescription),
+                Translate(KeyId::doneBtn), delegate(OnDone)
             );
         }
         else
         {
             ShowPage(Icon_Done,
-                Translate(L"doneBtn"),
-                Translate(L"installerDoneDescription"),
-                Translate(L"configureBtn"), delegate(OnSettings),
-                IsConfigured() ? Translate(L"doneBtn") : L"", delegate(OnDone)
+                Translate(KeyId::doneBtn),
+                Translate(KeyId::installerDoneDescription),
+                Translate(KeyId::configureBtn), delegate(OnSettings),
+                IsConfigured() ? Translate(KeyId::doneBtn) : L"", delegate(OnDone)
             );
         }
     }
@@ -262,7 +262,7 @@ namespace AnyFSE
         ShowPage(icon.empty() ? Icon_Error : icon,
                  caption,
                  text,
-                 Translate(L"closeBtn"), delegate(OnCancel));
+                 Translate(KeyId::closeBtn), delegate(OnCancel));
     }
 
     void AppInstaller::PopulateLanguageMenu()
@@ -35,6 +35,7 @@
 #include "AppUninstaller.hpp"
 #include "Logging/LogManager.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
+#include "FluentDesign/Palette.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/Window.hpp"
 #include "AppInstaller/Admin.hpp"
@@ -229,8 +230,8 @@ namespace AnyFSE
         )
         {
             ShowErrorPage(
-                Translate(L"uninstallerInsufficientPermissionsCaption"),
-                Translate(L"uninstallerInsufficientPermissionsDescription"),
+                Translate(KeyId::uninstallerInsufficientPermissionsCaption),
+                Translate(KeyId::uninstallerInsufficientPermissionsDescription),
                 Icon_Permission);
         }
         else
@@ -291,15 +292,14 @@ namespace AnyFSE
         RectF panelRect = rect;
         panelRect.Height = rect.Height - footerHeight + 1;
 
-        SolidBrush panelBrush(m_theme.GetColor(Theme::Colors::Dialog));
-        graphics.FillRectangle(&panelBrush, panelRect);
+        std::shared_ptr<const FluentDesign::Palette> palette = m_theme.GetPalette();
+        graphics.FillRectangle(palette->Brush(Theme::Colors::Dialog), panelRect);
 
         RectF footerRect = rect;
         footerRect.Y = panelRect.GetBottom() - 1;
         footerRect.Height = footerHeight;
 
-        SolidBrush footerBrush(m_theme.GetColor(Theme::Colors::Footer));
-        graphics.FillRectangle(&footerBrush, footerRect);
+        graphics.FillRectangle(palette->Brush(Theme::Colors::Footer), footerRect);
 
         for (auto &a : m_designedPositions)
         {
@@ -417,10 +417,10 @@ namespace AnyFSE
     {
         m_languageButton.Show(true);
         ShowPage(Icon_Delete,
-            Translate(L"uninstallerWelcomeCaption"),
-            Translate(L"uninstallerWelcomeDescription"),
-            Translate(L"cancelBtn"), delegate(OnCancel),
-            Translate(L"uninstallBtn"), delegate(OnUninstall)
+            Translate(KeyId::uninstallerWelcomeCaption),
+            Translate(KeyId::uninstallerWelcomeDescription),
+            Translate(KeyId::cancelBtn), delegate(OnCancel),
+            Translate(KeyId::uninstallBtn), delegate(OnUninstall)
         );
     }
 
@@ -428,9 +428,9 @@ namespace AnyFSE
     {
         m_languageButton.Show(false);
         ShowPage(Icon_Done,
-            Translate(L"doneBtn"),
-            Translate(L"uninstallerDoneDescription"),
-            Translate(L"doneBtn"), delegate(OnDone)
+            Translate(KeyId::doneBtn),
+            Translate(KeyId::uninstallerDoneDescription),
+            Translate(KeyId::doneBtn), delegate(OnDone)
         );
     }
 
@@ -465,12 +465,12 @@ namespace AnyFSE
         ShowPage(icon.empty() ? Icon_Error : icon,
                  caption,
                  text,
-                 Translate(L"closeBtn"), delegate(OnCancel));
+                 Translate(KeyId::closeBtn), delegate(OnCancel));
     }
 
     void AppUninstaller::UpdateDialogTitle()
     {
-        SetWindowText(m_hDialog, Translate(L"uninstallerWindowTitle").c_str());
+        SetWindowText(m_hDialog, Translate(KeyId::uninstallerWindowTitle).c_str());
     }
 
     void AppUninstaller::PopulateLanguageMenu()
@@ -531,7 +531,7 @@ namespace AnyFSE
         }
         catch(const std::exception& e)
         {
-            ShowErrorPage(Translate(L"uninstallationErrorCaption"), Unicode::to_wstring(e.what()));
+            ShowErrorPage(Translate(KeyId::uninstallationErrorCaption), Unicode::to_wstring(e.what()));
             return;
         }
         ShowCompletePage();
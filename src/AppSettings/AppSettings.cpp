@@ -23,11 +23,16 @@
 
 
 #include <windows.h>
+#include "App/AppConstants.hpp"
 #include "Logging/LogManager.hpp"
 #include "Configuration/Config.hpp"
 #include "Tools/Process.hpp"
 #include "Tools/Localization.hpp"
 #include "Tools/Paths.hpp"
+#include "Tools/Registry.hpp"
+#include "Tools/PhaseTracer.hpp"
+#include "Tools/AnimationClock.hpp"
+#include "Tools/IconLoader.hpp"
 
 #include "AppSettings/SettingsDialog.hpp"
 
@@ -53,6 +58,9 @@ int WINAPI Main(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, i
     }
 
     Config::Load();
+
+    // The gaming configuration is read several times per launcher check, keep its values until the key changes
+    AnyFSE::Tools::Registry::CacheValues(AnyFSE::AppConstants::GamingHomeAppRegKey);
     Config::GetStartupConfigured();
     AnyFSE::Logging::LogManager::Initialize("AnyFSE.Settings", Config::LogLevel, Config::LogPath);
     AnyFSE::Tools::Localization::Initialize(Config::Locale);
@@ -64,6 +72,16 @@ int WINAPI Main(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, i
     {
         result = (int)AnyFSE::App::AppSettings::Settings::SettingsDialog().Show(hInstance);
     } while (result == IDRETRY);
+
+    // FreeLibrary follows, static destructors would join the workers under the loader lock
+    AnyFSE::Tools::AnimationClock::Instance().Shutdown();
+    AnyFSE::Tools::IconLoader::Instance().Shutdown();
+
+    // The library has its own tracer, the update check runs here
+    if (Config::LogLevel != LogLevels::Disabled)
+    {
+        AnyFSE::Tools::PhaseTracer::Instance().Write(Config::LogPath + L"\\AnyFSE.Settings.trace.json", GetCurrentProcessId(), "AnyFSE.Settings");
+    }
     return result;
 };
 
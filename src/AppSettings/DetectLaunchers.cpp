@@ -31,6 +31,7 @@
 #include "Tools/List.hpp"
 #include "Configuration/Config.hpp"
 #include "Tools/Paths.hpp"
+#include "Tools/UninstallRegistry.hpp"
 #include "App/AppConstants.hpp"
 
 
@@ -38,6 +39,15 @@ namespace AnyFSE::Configuration
 {
     namespace fs = std::filesystem;
 
+    namespace
+    {
+        // Served from the registry cache, Main has the key's values cached
+        std::wstring ReadGamingHomeApp()
+        {
+            return Registry::ReadString(AppConstants::GamingHomeAppRegKey, AppConstants::GamingHomeAppRegValue);
+        }
+    }
+
     void Config::GetStartupConfigured()
     {
         FseOnStartup = IsFseOnStartupConfigured();
@@ -59,6 +69,15 @@ namespace AnyFSE::Configuration
         std::list<std::wstring> installed;
 
         FindInstalledLaunchers(installed);
+        UpdatePortableLauncher(out, installed);
+    }
+
+    void Config::UpdatePortableLauncher(LauncherConfig & out, const std::list<std::wstring> &installed)
+    {
+        if (out.Type == None || !out.AppUserModelID.empty())
+        {
+            return;
+        }
 
         if (!std::any_of(installed.begin(), installed.end(),
             [&command = Unicode::to_lower(out.StartCommand) ](const std::wstring& p)
@@ -74,34 +93,25 @@ namespace AnyFSE::Configuration
 
     bool Config::IsFseOnStartupConfigured()
     {
-        return 1 == Registry::ReadDWORD(
-            L"Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration",
-            L"StartupToGamingHome"
-        );
+        return 1 == Registry::ReadDWORD(AppConstants::GamingHomeAppRegKey, L"StartupToGamingHome");
     }
 
     bool Config::IsNativeConfigured()
     {
-        std::wstring appPackageId = Registry::ReadString(
-            L"Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration",
-            AppConstants::GamingHomeAppRegValue);
+        std::wstring appPackageId = ReadGamingHomeApp();
         return !IsAnyFSEConfigured() && !Packages::GetAppxInstallLocation(appPackageId).empty();
     }
 
     bool Config::IsAnyFSEConfigured()
     {
-        return Registry::ReadString(
-            L"Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration",
-            AppConstants::GamingHomeAppRegValue) == AppConstants::AppUserModelId;
+        return ReadGamingHomeApp() == AppConstants::AppUserModelId;
     }
 
     std::wstring Config::GetNativePath(const std::wstring& launcher)
     {
         if (IsNativeConfigured())
         {
-            return Registry::ReadString(
-                L"Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration",
-                AppConstants::GamingHomeAppRegValue);
+            return ReadGamingHomeApp();
         }
         return launcher;
     }
@@ -144,7 +154,11 @@ namespace AnyFSE::Configuration
     {
         std::list<std::wstring> executables;
         FindInstalledLaunchers(executables);
+        return FindNotInstalledLaunchers(executables, found);
+    }
 
+    bool Config::FindNotInstalledLaunchers(const std::list<std::wstring> &executables, std::list<std::wstring>& found)
+    {
         std::set<std::wstring> installed;
 
         for (auto it : executables)
@@ -239,6 +253,13 @@ namespace AnyFSE::Configuration
 
 
     void Config::FindNativeLaunchers(std::list<std::wstring> &found)
+    {
+        std::list<LauncherConfig> natives;
+        FindNativeLaunchers(found, GetKnownAppUserModelIDs(), natives);
+        AddNativeLaunchers(natives);
+    }
+
+    void Config::FindNativeLaunchers(std::list<std::wstring> &found, const std::set<std::wstring> &known, std::list<LauncherConfig> &natives)
     {
         auto launchers = Packages::GetNativeLaunchers();
         for (auto appUserModelId : launchers)
@@ -246,9 +267,10 @@ namespace AnyFSE::Configuration
             if (appUserModelId == AppConstants::AppUserModelId)
                 continue;
 
-            if (List::npos == List::index_of_if(
-                Config::LauncherConfigs,
-                [&appUserModelId](const LauncherConfig& l){return l.AppUserModelID == appUserModelId;}
+            if (known.find(appUserModelId) == known.end()
+                && List::npos == List::index_of_if(
+                    natives,
+                    [&appUserModelId](const LauncherConfig& l){return l.AppUserModelID == appUserModelId;}
             ))
             {
                 LauncherConfig Native;
@@ -256,7 +278,7 @@ namespace AnyFSE::Configuration
                 Native.Name = Packages::GetAppDisplayName(appUserModelId);
                 Native.StartCommand = appUserModelId;
                 Native.AppUserModelID = appUserModelId;
-                Config::LauncherConfigs.push_back(Native);
+                natives.push_back(Native);
             }
 
             if (List::npos == List::index_of(found, appUserModelId))
@@ -264,7 +286,33 @@ namespace AnyFSE::Configuration
                 found.push_back(appUserModelId);
             }
         }
+    }
 
+    void Config::AddNativeLaunchers(const std::list<LauncherConfig> &natives)
+    {
+        for (const LauncherConfig &native : natives)
+        {
+            if (List::npos == List::index_of_if(
+                Config::LauncherConfigs,
+                [&native](const LauncherConfig& l){return l.AppUserModelID == native.AppUserModelID;}
+            ))
+            {
+                Config::LauncherConfigs.push_back(native);
+            }
+        }
+    }
+
+    std::set<std::wstring> Config::GetKnownAppUserModelIDs()
+    {
+        std::set<std::wstring> known;
+        for (const LauncherConfig &launcher : Config::LauncherConfigs)
+        {
+            if (!launcher.AppUserModelID.empty())
+            {
+                known.insert(launcher.AppUserModelID);
+            }
+        }
+        return known;
     }
 
     std::wstring Config::GetPathFromCommand(const std::wstring &uninstallCommand)
@@ -349,86 +397,25 @@ namespace AnyFSE::Configuration
 
     std::wstring Config::GetInstallPath(const std::wstring &displayName)
     {
-        std::vector<std::wstring> registryPaths = {
-            L"HKCU\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall",
-            L"HKCU\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall",
-            L"HKLM\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall",
-            L"HKLM\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall"};
-
-        std::wstring exactDisplayName = Unicode::to_lower(displayName);
-
-        for (const auto &path : registryPaths)
+        for (const UninstallEntry &entry : UninstallRegistry::Instance().Find(displayName))
         {
-            std::wstring actualPath;
-            HKEY root = Registry::GetRootKey(path, actualPath);
-
-            HKEY hKey;
-            if (RegOpenKeyExW(root, actualPath.c_str(), 0, KEY_READ, &hKey) != ERROR_SUCCESS)
+            if (entry.hasInstallLocation)
             {
+                if (fs::exists(entry.installLocation))
+                {
+                    return entry.installLocation;
+                }
                 continue;
             }
 
-            DWORD subkeyIndex = 0;
-            WCHAR subkeyName[255];
-            DWORD subkeyNameSize = 255;
-
-            while (RegEnumKeyExW(hKey, subkeyIndex, subkeyName, &subkeyNameSize, NULL, NULL, NULL, NULL) == ERROR_SUCCESS)
+            if (!entry.uninstallString.empty())
             {
-                HKEY hSubKey;
-                std::wstring subkeyPath = actualPath + L"\\" + subkeyName;
-
-                if (RegOpenKeyExW(root, subkeyPath.c_str(), 0, KEY_READ, &hSubKey) == ERROR_SUCCESS)
+                std::wstring binary = GetPathFromCommand(entry.uninstallString);
+                if (fs::exists(binary))
                 {
-                    WCHAR displayName[1024];
-                    WCHAR uninstallString[1024];
-                    WCHAR installLocationString[1024];
-                    DWORD dataSize = sizeof(displayName);
-                    DWORD type;
-
-                    if (RegQueryValueExW(hSubKey, L"DisplayName", NULL, &type,
-                                        (LPBYTE)displayName, &dataSize) == ERROR_SUCCESS
-                        && type == REG_SZ
-                        && exactDisplayName == Unicode::to_lower(displayName))
-                    {
-
-                        dataSize = sizeof(installLocationString);
-                        if (RegQueryValueExW(hSubKey, L"InstallLocation", NULL, &type,
-                                            (LPBYTE)installLocationString, &dataSize) == ERROR_SUCCESS
-                            && type == REG_SZ
-                        )
-                        {
-                            if ( !fs::exists(installLocationString))
-                            {
-                                continue;
-                            }
-                            RegCloseKey(hSubKey);
-                            RegCloseKey(hKey);
-                            return installLocationString;
-                        }
-
-                        dataSize = sizeof(uninstallString);
-                        if (RegQueryValueExW(hSubKey, L"UninstallString", NULL, &type,
-                                            (LPBYTE)uninstallString, &dataSize) == ERROR_SUCCESS
-                            && type == REG_SZ
-                        )
-                        {
-                            std::wstring binary = GetPathFromCommand(uninstallString);
-                            if ( !fs::exists(binary))
-                            {
-                                continue;
-                            }
-                            RegCloseKey(hSubKey);
-                            RegCloseKey(hKey);
-                            return fs::path(binary).parent_path().wstring();
-                        }
-                    }
-                    RegCloseKey(hSubKey);
+                    return fs::path(binary).parent_path().wstring();
                 }
-
-                subkeyIndex++;
-                subkeyNameSize = 255;
             }
-            RegCloseKey(hKey);
         }
 
         return L"";
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "AppSettings/GamepadButtons.hpp"
+
+namespace AnyFSE::App::AppSettings::Input
+{
+    GamepadButtons::GamepadButtons(const std::vector<Binding> &bindings, size_t slots)
+        : GamepadButtons(bindings, slots, Options())
+    {
+    }
+
+    GamepadButtons::GamepadButtons(const std::vector<Binding> &bindings, size_t slots, const Options &options)
+        : m_bindings(bindings)
+        , m_slots(slots)
+        , m_options(options)
+    {
+        m_options.stickThreshold = std::max(m_options.stickThreshold, m_options.stickDeadzone);
+        m_options.minRepeatMs = std::max<uint32_t>(1, std::min(m_options.minRepeatMs, m_options.repeatMs));
+
+        for (Slot &slot : m_slots)
+        {
+            slot.repeats.resize(m_bindings.size());
+        }
+    }
+
+    uint16_t GamepadButtons::StickDirection(int32_t x, int32_t y, uint16_t current, const Options &options)
+    {
+        // Squared, the deadzone is round and no square root is taken per sample
+        int64_t magnitude = (int64_t)x * x + (int64_t)y * y;
+        int64_t limit = current ? options.stickDeadzone : options.stickThreshold;
+        if (magnitude <= limit * limit)
+        {
+            return 0;
+        }
+
+        int32_t ax = std::abs(x);
+        int32_t ay = std::abs(y);
+        bool horizontal = ax > ay;
+
+        // Near the diagonal the held axis wins until the other one is half again as far
+        if (current == DPadLeft || current == DPadRight)
+        {
+            horizontal = (int64_t)ay * 2 <= (int64_t)ax * 3;
+        }
+        else if (current == DPadUp || current == DPadDown)
+        {
+            horizontal = (int64_t)ax * 2 > (int64_t)ay * 3;
+        }
+
+        return horizontal ? (x > 0 ? DPadRight : DPadLeft)
+                          : (y > 0 ? DPadUp : DPadDown);
+    }
+
+    void GamepadButtons::Update(size_t slot, const Sample &sample, uint64_t nowMs, std::vector<KeyEvent> &events)
+    {
+        Slot &state = m_slots[slot];
+        state.stick = StickDirection(sample.thumbX, sample.thumbY, state.stick, m_options);
+        Apply(state, sample.buttons | state.stick, nowMs, events);
+    }
+
+    void GamepadButtons::Apply(Slot &state, uint16_t buttons, uint64_t nowMs, std::vector<KeyEvent> &events)
+    {
+        for (size_t i = 0; i < m_bindings.size(); ++i)
+        {
+            const Binding &binding = m_bindings[i];
+            Repeat &repeat = state.repeats[i];
+            bool pressed = (buttons & binding.mask) != 0;
+            bool wasPressed = (state.buttons & binding.mask) != 0;
+
+            if (pressed && !wasPressed)
+            {
+                events.push_back({ binding.key, true, false });
+                repeat.next = binding.repeat ? nowMs + m_options.initialDelayMs : Never;
+                repeat.interval = m_options.repeatMs;
+            }
+            else if (!pressed && wasPressed)
+            {
+                events.push_back({ binding.key, false, false });
+                repeat.next = Never;
+            }
+            else if (pressed && nowMs >= repeat.next)
+            {
+                // A late sample gives one repeat, not the ones it missed
+                events.push_back({ binding.key, true, true });
+                repeat.next = std::max(repeat.next + repeat.interval, nowMs + 1);
+                repeat.interval = std::max(m_options.minRepeatMs, repeat.interval * m_options.accelerationPercent / 100);
+            }
+        }
+        state.buttons = buttons;
+    }
+
+    void GamepadButtons::Release(size_t slot, std::vector<KeyEvent> &events)
+    {
+        Slot &state = m_slots[slot];
+        state.stick = 0;
+        Apply(state, 0, 0, events);
+    }
+
+    bool GamepadButtons::IsHeld(size_t slot) const
+    {
+        return m_slots[slot].buttons != 0;
+    }
+
+    uint64_t GamepadButtons::NextRepeat() const
+    {
+        uint64_t next = Never;
+        for (const Slot &slot : m_slots)
+        {
+            for (const Repeat &repeat : slot.repeats)
+            {
+                next = std::min(next, repeat.next);
+            }
+        }
+        return next;
+    }
+}
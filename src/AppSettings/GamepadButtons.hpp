@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnyFSE::App::AppSettings::Input
+{
+    // Turns sampled controller states into key downs and ups. The left stick past its threshold acts as the D-pad,
+    // held directions repeat like a keyboard does and speed up the longer they are held. Times are passed in by the
+    // caller so the same samples always give the same keys.
+    class GamepadButtons
+    {
+    public:
+        // XInput wButtons bits
+        static constexpr uint16_t DPadUp    = 0x0001;
+        static constexpr uint16_t DPadDown  = 0x0002;
+        static constexpr uint16_t DPadLeft  = 0x0004;
+        static constexpr uint16_t DPadRight = 0x0008;
+        static constexpr uint16_t A         = 0x1000;
+        static constexpr uint16_t B         = 0x2000;
+
+        struct Binding
+        {
+            uint16_t mask;
+            uint16_t key;
+            bool repeat;
+        };
+
+        struct KeyEvent
+        {
+            uint16_t key;
+            bool down;
+            bool repeat;
+        };
+
+        struct Sample
+        {
+            uint16_t buttons = 0;
+            int16_t thumbX = 0;     // Left stick, up and right are positive
+            int16_t thumbY = 0;
+        };
+
+        struct Options
+        {
+            uint32_t initialDelayMs = 400;
+            uint32_t repeatMs = 80;
+            uint32_t minRepeatMs = 30;
+            uint32_t accelerationPercent = 85;  // Each repeat comes this much sooner than the one before
+            int32_t stickDeadzone = 7849;       // XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE, a held direction is let go below
+            int32_t stickThreshold = 16000;     // A direction is taken above
+        };
+
+        static constexpr uint64_t Never = UINT64_MAX;
+
+        GamepadButtons(const std::vector<Binding> &bindings, size_t slots);
+        GamepadButtons(const std::vector<Binding> &bindings, size_t slots, const Options &options);
+
+        // Appends the keys for the sample of the slot taken at nowMs
+        void Update(size_t slot, const Sample &sample, uint64_t nowMs, std::vector<KeyEvent> &events);
+
+        // Ups for everything the slot holds, when it is disconnected
+        void Release(size_t slot, std::vector<KeyEvent> &events);
+
+        bool IsHeld(size_t slot) const;
+
+        // When Update has a repeat to give, Never without held repeating buttons
+        uint64_t NextRepeat() const;
+
+        // The D-pad bit the stick points to, current is kept until the other axis clearly takes over
+        static uint16_t StickDirection(int32_t x, int32_t y, uint16_t current, const Options &options);
+
+    private:
+        struct Repeat
+        {
+            uint64_t next = Never;
+            uint32_t interval = 0;
+        };
+
+        struct Slot
+        {
+            uint16_t buttons = 0;
+            uint16_t stick = 0;
+            std::vector<Repeat> repeats;  // Per binding
+        };
+
+        std::vector<Binding> m_bindings;
+        std::vector<Slot> m_slots;
+        Options m_options;
+
+        void Apply(Slot &state, uint16_t buttons, uint64_t nowMs, std::vector<KeyEvent> &events);
+    };
+}
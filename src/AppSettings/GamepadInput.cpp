@@ -21,13 +21,57 @@
 // SOFTWARE.
 //
 
+#include <algorithm>
+#include <chrono>
 #include "GamepadInput.hpp"
+#include "AppSettings/GamepadPolling.hpp"
+#include "Configuration/Config.hpp"
 #include "Logging/LogManager.hpp"
 
 namespace AnyFSE::App::AppSettings::Input
 {
     static Logger log = LogManager::GetLogger("GamepadInput");
 
+    namespace
+    {
+        // D-pad and left stick navigate and repeat while held, A is Space and B is Escape
+        const std::vector<GamepadButtons::Binding> Bindings =
+        {
+            { GamepadButtons::DPadUp,    VK_UP,     true },
+            { GamepadButtons::DPadDown,  VK_DOWN,   true },
+            { GamepadButtons::DPadLeft,  VK_LEFT,   true },
+            { GamepadButtons::DPadRight, VK_RIGHT,  true },
+            { GamepadButtons::A,         VK_SPACE,  false },
+            { GamepadButtons::B,         VK_ESCAPE, false },
+        };
+
+        // XInput controllers show up as XUSB devices, Bluetooth ones as HID devices
+        const GUID ArrivalInterfaces[] =
+        {
+            { 0xEC87F1E3, 0xC13B, 0x4100, { 0xB5, 0xF7, 0x8B, 0x84, 0xD5, 0x42, 0x60, 0xCB } },
+            { 0x4D1E55B2, 0xF16F, 0x11CF, { 0x88, 0xCB, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30 } },
+        };
+
+        // The /Gamepad values are edited by hand. A negative number wraps into a huge DWORD, read back as
+        // int it lands on the low bound like any other value out of range.
+        GamepadButtons::Options LoadOptions()
+        {
+            GamepadButtons::Options options;
+            options.initialDelayMs = (uint32_t)std::clamp((int32_t)Config::GamepadRepeatDelay, 100, 2000);
+            options.repeatMs = (uint32_t)std::clamp((int32_t)Config::GamepadRepeatInterval, 16, 1000);
+            options.minRepeatMs = (uint32_t)std::clamp((int32_t)Config::GamepadRepeatMinInterval, 16, (int32_t)options.repeatMs);
+            options.stickDeadzone = std::clamp(Config::GamepadStickDeadzone, 0, 32767);
+            options.stickThreshold = std::clamp(Config::GamepadStickThreshold, options.stickDeadzone, 32767);
+            return options;
+        }
+
+        uint64_t NowMs()
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
     GamepadInputListener::GamepadInputListener(HWND hDialog)
         : m_hDialog(hDialog)
     {
@@ -45,6 +89,17 @@ namespace AnyFSE::App::AppSettings::Input
             return true;
         }
 
+        m_hStopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        m_hArrivalEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (!m_hStopEvent || !m_hArrivalEvent)
+        {
+            log.Error(log.APIError(), "Failed to create listener events");
+            Stop();
+            return false;
+        }
+
+        RegisterArrival();
+
         m_isActive = true;
         m_listenerThread = std::make_unique<std::thread>(&GamepadInputListener::ListenerThreadFunc, this);
 
@@ -61,97 +116,156 @@ namespace AnyFSE::App::AppSettings::Input
 
     void GamepadInputListener::Stop()
     {
-        if (!m_isActive)
+        if (m_isActive)
         {
-            return;
+            m_isActive = false;
+            SetEvent(m_hStopEvent);
+
+            if (m_listenerThread && m_listenerThread->joinable())
+            {
+                m_listenerThread->join();
+                m_listenerThread.reset();
+            }
+
+            log.Info("Gamepad input listener stopped");
         }
 
-        m_isActive = false;
+        UnregisterArrival();
 
-        if (m_listenerThread && m_listenerThread->joinable())
+        if (m_hStopEvent)
         {
-            m_listenerThread->join();
-            m_listenerThread.reset();
+            CloseHandle(m_hStopEvent);
+            m_hStopEvent = NULL;
         }
+        if (m_hArrivalEvent)
+        {
+            CloseHandle(m_hArrivalEvent);
+            m_hArrivalEvent = NULL;
+        }
+    }
+
+    void GamepadInputListener::RegisterArrival()
+    {
+        for (const GUID &classGuid : ArrivalInterfaces)
+        {
+            CM_NOTIFY_FILTER filter{};
+            filter.cbSize = sizeof(filter);
+            filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+            filter.u.DeviceInterface.ClassGuid = classGuid;
 
-        log.Info("Gamepad input listener stopped");
+            HCMNOTIFICATION hNotify = NULL;
+            CONFIGRET result = CM_Register_Notification(&filter, this, OnDeviceArrival, &hNotify);
+            if (result == CR_SUCCESS)
+            {
+                m_arrivalNotifications.push_back(hNotify);
+            }
+            else
+            {
+                // Empty slots are still probed, only with the backoff
+                log.Warn("Can't listen for device arrival (%lu)", result);
+            }
+        }
+    }
+
+    void GamepadInputListener::UnregisterArrival()
+    {
+        // Waits for running callbacks, the event is not signalled after this
+        for (HCMNOTIFICATION hNotify : m_arrivalNotifications)
+        {
+            CM_Unregister_Notification(hNotify);
+        }
+        m_arrivalNotifications.clear();
+    }
+
+    DWORD CALLBACK GamepadInputListener::OnDeviceArrival(HCMNOTIFICATION hNotify, PVOID context, CM_NOTIFY_ACTION action,
+                                                        PCM_NOTIFY_EVENT_DATA eventData, DWORD eventDataSize)
+    {
+        if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL)
+        {
+            SetEvent(((GamepadInputListener *)context)->m_hArrivalEvent);
+        }
+        return ERROR_SUCCESS;
     }
 
     void GamepadInputListener::ListenerThreadFunc()
     {
-        XINPUT_STATE state{};
-        DWORD dwResult;
+        GamepadPolling polling(MAX_CONTROLLERS);
+        GamepadButtons buttons(Bindings, MAX_CONTROLLERS, LoadOptions());
+        DWORD lastPacket[MAX_CONTROLLERS]{};
+        std::vector<GamepadButtons::KeyEvent> events;
+
+        HANDLE waitHandles[] = { m_hStopEvent, m_hArrivalEvent };
+        DWORD wait = 0;
 
         while (m_isActive)
         {
-            // Poll all 4 possible controllers
+            DWORD signalled = WaitForMultipleObjects(_countof(waitHandles), waitHandles, FALSE, wait);
+            if (signalled == WAIT_OBJECT_0 || !m_isActive)
+            {
+                break;
+            }
+
+            uint64_t now = NowMs();
+            if (signalled == WAIT_OBJECT_0 + 1)
+            {
+                log.Debug("Device arrived, probing empty controller slots");
+                polling.DeviceArrived(now);
+            }
+
             for (int controllerIndex = 0; controllerIndex < MAX_CONTROLLERS; ++controllerIndex)
             {
-                dwResult = XInputGetState(controllerIndex, &state);
+                if (!polling.IsDue(controllerIndex, now))
+                {
+                    continue;
+                }
+
+                XINPUT_STATE state{};
+                DWORD dwResult = XInputGetState(controllerIndex, &state);
 
                 if (dwResult == ERROR_SUCCESS)
                 {
-                    ProcessGamepadInput(controllerIndex, state);
+                    bool changed = !polling.IsConnected(controllerIndex) || state.dwPacketNumber != lastPacket[controllerIndex];
+                    lastPacket[controllerIndex] = state.dwPacketNumber;
+
+                    GamepadButtons::Sample sample;
+                    sample.buttons = state.Gamepad.wButtons;
+                    sample.thumbX = state.Gamepad.sThumbLX;
+                    sample.thumbY = state.Gamepad.sThumbLY;
+
+                    buttons.Update(controllerIndex, sample, now, events);
+                    polling.Connected(controllerIndex, now, changed, buttons.IsHeld(controllerIndex));
                 }
-                else if (dwResult == ERROR_DEVICE_NOT_CONNECTED)
+                else
                 {
-                    // Controller disconnected - reset state for this controller
-                    m_prevButtonState[controllerIndex] = 0;
+                    // Controller disconnected - release what it held
+                    buttons.Release(controllerIndex, events);
+                    polling.Disconnected(controllerIndex, now);
                 }
             }
 
-            // Poll at ~60 Hz
-            Sleep(16);
-        }
-    }
-
-    void GamepadInputListener::ProcessGamepadInput(int controllerIndex, const XINPUT_STATE& state)
-    {
-        WORD currentButtonState = state.Gamepad.wButtons;
-
-        // Handle D-pad buttons
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_DPAD_UP, VK_UP, state);
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_DPAD_DOWN, VK_DOWN, state);
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_DPAD_LEFT, VK_LEFT, state);
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_DPAD_RIGHT, VK_RIGHT, state);
-
-        // Handle action buttons
-        // A button -> Space
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_A, VK_SPACE, state);
-
-        // B button -> Escape
-        HandleButtonStateChange(controllerIndex, XINPUT_GAMEPAD_B, VK_ESCAPE, state);
+            if (!events.empty())
+            {
+                SendKeyInput(events);
+                events.clear();
+            }
 
-        m_prevButtonState[controllerIndex] = currentButtonState;
+            uint64_t next = min(polling.NextPoll(), buttons.NextRepeat());
+            wait = next <= now ? 0 : (DWORD)min(next - now, (uint64_t)INFINITE - 1);
+        }
     }
 
-    void GamepadInputListener::HandleButtonStateChange(int controllerIndex, WORD buttonMask, WORD vKey, const XINPUT_STATE& state)
+    void GamepadInputListener::SendKeyInput(const std::vector<GamepadButtons::KeyEvent> &events)
     {
-        WORD currentButtonState = state.Gamepad.wButtons;
-        bool isCurrentlyPressed = (currentButtonState & buttonMask) != 0;
-        bool wasPreviouslyPressed = (m_prevButtonState[controllerIndex] & buttonMask) != 0;
-
-        // Button pressed (transition from not pressed to pressed)
-        if (isCurrentlyPressed && !wasPreviouslyPressed)
+        // Keys of one sample go in one call, nothing is interleaved between them
+        std::vector<INPUT> inputs(events.size());
+        for (size_t i = 0; i < events.size(); ++i)
         {
-            SendKeyInput(vKey, true);
+            inputs[i].type = INPUT_KEYBOARD;
+            inputs[i].ki.wVk = events[i].key;
+            inputs[i].ki.dwFlags = events[i].down ? 0 : KEYEVENTF_KEYUP;
+            inputs[i].ki.time = 0;
         }
-        // Button released (transition from pressed to not pressed)
-        else if (!isCurrentlyPressed && wasPreviouslyPressed)
-        {
-            SendKeyInput(vKey, false);
-        }
-    }
 
-    void GamepadInputListener::SendKeyInput(WORD vKey, bool isDown)
-    {
-        // Create a keyboard input event and send it
-        INPUT input{};
-        input.type = INPUT_KEYBOARD;
-        input.ki.wVk = vKey;
-        input.ki.dwFlags = isDown ? 0 : KEYEVENTF_KEYUP;
-        input.ki.time = 0;
-
-        SendInput(1, &input, sizeof(INPUT));
+        SendInput((UINT)inputs.size(), inputs.data(), sizeof(INPUT));
     }
 }
@@ -24,11 +24,15 @@
 #pragma once
 #include <windows.h>
 #include <xinput.h>
+#include <cfgmgr32.h>
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <vector>
+#include "AppSettings/GamepadButtons.hpp"
 
 #pragma comment(lib, "xinput.lib")
+#pragma comment(lib, "cfgmgr32.lib")
 
 namespace AnyFSE::App::AppSettings::Input
 {
@@ -52,21 +56,24 @@ namespace AnyFSE::App::AppSettings::Input
         std::atomic<bool> m_isActive{false};
         std::unique_ptr<std::thread> m_listenerThread;
 
-        // XInput state tracking - support up to 4 controllers
+        // XInput supports up to 4 controllers
         static constexpr int MAX_CONTROLLERS = 4;
-        WORD m_prevButtonState[MAX_CONTROLLERS]{};
+
+        // Wake the listener to stop, or to probe the empty slots
+        HANDLE m_hStopEvent = NULL;
+        HANDLE m_hArrivalEvent = NULL;
+        std::vector<HCMNOTIFICATION> m_arrivalNotifications;
 
         // Thread function
         void ListenerThreadFunc();
 
-        // Input processing
-        void ProcessGamepadInput(int controllerIndex, const XINPUT_STATE& state);
+        void RegisterArrival();
+        void UnregisterArrival();
+        static DWORD CALLBACK OnDeviceArrival(HCMNOTIFICATION hNotify, PVOID context, CM_NOTIFY_ACTION action,
+                                              PCM_NOTIFY_EVENT_DATA eventData, DWORD eventDataSize);
 
         // Helper to send key input to the dialog window
-        void SendKeyInput(WORD vKey, bool isDown);
-
-        // Button mapping helpers
-        void HandleButtonStateChange(int controllerIndex, WORD buttonMask, WORD vKey, const XINPUT_STATE& state);
+        void SendKeyInput(const std::vector<GamepadButtons::KeyEvent> &events);
     };
 }
 
@@ -0,0 +1,73 @@
+#include <algorithm>
+
+#include "AppSettings/GamepadPolling.hpp"
+
+namespace AnyFSE::App::AppSettings::Input
+{
+    GamepadPolling::GamepadPolling(size_t slots)
+        : GamepadPolling(slots, Timing())
+    {
+    }
+
+    GamepadPolling::GamepadPolling(size_t slots, const Timing &timing)
+        : m_slots(slots)
+        , m_timing(timing)
+    {
+    }
+
+    bool GamepadPolling::IsDue(size_t slot, uint64_t nowMs) const
+    {
+        return nowMs >= m_slots[slot].nextPoll;
+    }
+
+    void GamepadPolling::Connected(size_t slot, uint64_t nowMs, bool changed, bool held)
+    {
+        Slot &state = m_slots[slot];
+        if (changed || held || !state.connected)
+        {
+            state.lastActivity = nowMs;
+        }
+        state.connected = true;
+        state.backoff = 0;
+
+        uint32_t interval = held ? m_timing.heldMs
+                          : nowMs - state.lastActivity < m_timing.idleAfterMs ? m_timing.activeMs
+                          : m_timing.idleMs;
+        state.nextPoll = nowMs + interval;
+    }
+
+    void GamepadPolling::Disconnected(size_t slot, uint64_t nowMs)
+    {
+        Slot &state = m_slots[slot];
+        state.connected = false;
+        state.backoff = state.backoff ? std::min(state.backoff * 2, m_timing.probeMaxMs) : m_timing.probeMinMs;
+        state.nextPoll = nowMs + state.backoff;
+    }
+
+    void GamepadPolling::DeviceArrived(uint64_t nowMs)
+    {
+        for (Slot &state : m_slots)
+        {
+            if (!state.connected)
+            {
+                state.backoff = 0;
+                state.nextPoll = nowMs;
+            }
+        }
+    }
+
+    bool GamepadPolling::IsConnected(size_t slot) const
+    {
+        return m_slots[slot].connected;
+    }
+
+    uint64_t GamepadPolling::NextPoll() const
+    {
+        uint64_t next = UINT64_MAX;
+        for (const Slot &state : m_slots)
+        {
+            next = std::min(next, state.nextPoll);
+        }
+        return next;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnyFSE::App::AppSettings::Input
+{
+    // When each controller slot is read next. Held buttons are read often for the key repeat, a quiet controller
+    // rarely, and an empty slot with a growing backoff until a device arrives.
+    class GamepadPolling
+    {
+    public:
+        struct Timing
+        {
+            uint32_t heldMs = 8;
+            uint32_t activeMs = 16;
+            uint32_t idleMs = 100;
+            uint32_t idleAfterMs = 2000;
+            uint32_t probeMinMs = 500;
+            uint32_t probeMaxMs = 8000;
+        };
+
+        explicit GamepadPolling(size_t slots);
+        GamepadPolling(size_t slots, const Timing &timing);
+
+        bool IsDue(size_t slot, uint64_t nowMs) const;
+
+        // Read results, changed is for a new packet since the last read
+        void Connected(size_t slot, uint64_t nowMs, bool changed, bool held);
+        void Disconnected(size_t slot, uint64_t nowMs);
+
+        // Every empty slot is probed at once and its backoff starts over
+        void DeviceArrived(uint64_t nowMs);
+
+        bool IsConnected(size_t slot) const;
+
+        uint64_t NextPoll() const;
+
+    private:
+        struct Slot
+        {
+            bool connected = false;
+            uint64_t nextPoll = 0;
+            uint64_t lastActivity = 0;
+            uint32_t backoff = 0;
+        };
+
+        std::vector<Slot> m_slots;
+        Timing m_timing;
+    };
+}
@@ -0,0 +1,352 @@
+#include <windows.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "AppSettings/LauncherDetection.hpp"
+#include "Tools/Packages.hpp"
+#include "Tools/Paths.hpp"
+#include "Tools/Process.hpp"
+#include "Tools/UninstallRegistry.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace AnyFSE::Configuration
+{
+    static Logger log = LogManager::GetLogger("LauncherDetection");
+
+    using Tools::ProbeScheduler;
+
+    namespace
+    {
+        struct Probe
+        {
+            const char *name;
+            void (*find)(std::list<std::wstring> &found);
+            bool usesUninstallIndex;
+        };
+
+        // In the order of Config::FindInstalledLaunchers, native launchers come last
+        const Probe Probes[] =
+        {
+            { "Playnite",           Config::FindPlaynite,           true  },
+            { "Steam",              Config::FindSteam,              true  },
+            { "BigBox",             Config::FindBigBox,             false },
+            { "One Game Launcher",  Config::FindOneGameLauncher,    false },
+            { "RetroBat",           Config::FindRetroBat,           false },
+            { "Kodi",               Config::FindKodi,               true  },
+            { "Razer Cortex",       Config::FindCortex,             true  },
+            { "Armoury Crate",      Config::FindArmouryCrate,       false },
+        };
+
+        // Cheap enough to run on every detection: a package moves to a new versioned folder on update, an
+        // executable gets a new write time. Protocols have nothing to check.
+        std::wstring GetToken(const std::wstring &path)
+        {
+            if (path.find(L"://") != std::wstring::npos)
+            {
+                return L"";
+            }
+            if (path.find(L'!') != std::wstring::npos)
+            {
+                return Tools::Packages::GetAppxInstallLocation(path);
+            }
+
+            std::error_code ec;
+            std::filesystem::file_time_type time = std::filesystem::last_write_time(path, ec);
+            return ec ? L"" : std::to_wstring(time.time_since_epoch().count());
+        }
+
+        std::filesystem::path GetCachePath()
+        {
+            return std::filesystem::path(Tools::Paths::GetConfigPath()) / L"LauncherCache.json";
+        }
+    }
+
+    LauncherDetection::LauncherDetection()
+    {
+        QueryPerformanceFrequency(&m_frequency);
+    }
+
+    LauncherDetection::~LauncherDetection()
+    {
+        Cancel();
+        if (m_hWnd)
+        {
+            DestroyWindow(m_hWnd);
+            m_hWnd = NULL;
+            UnregisterClass(ClassName, Process::GetModuleInstance());
+        }
+    }
+
+    LRESULT CALLBACK LauncherDetection::DetectionWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    {
+        if (uMsg == WM_PROBE_DONE)
+        {
+            LauncherDetection *This = reinterpret_cast<LauncherDetection *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+            if (This)
+            {
+                This->OnProbeDone((UINT)wParam, (size_t)lParam);
+            }
+            return 0;
+        }
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    bool LauncherDetection::CreateDetectionWindow()
+    {
+        if (m_hWnd)
+        {
+            return true;
+        }
+
+        // The WndProc lives in the settings library, so does the class
+        HINSTANCE hInstance = Process::GetModuleInstance();
+
+        WNDCLASSEX wc = { sizeof(WNDCLASSEX) };
+        wc.lpfnWndProc = DetectionWndProc;
+        wc.hInstance = hInstance;
+        wc.lpszClassName = ClassName;
+        RegisterClassEx(&wc);
+
+        m_hWnd = CreateWindowEx(0, ClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, hInstance, NULL);
+        if (!m_hWnd)
+        {
+            log.Error(log.APIError(), "Can't create launcher detection window");
+            return false;
+        }
+        SetWindowLongPtr(m_hWnd, GWLP_USERDATA, (LONG_PTR)this);
+        return true;
+    }
+
+    bool LauncherDetection::Start(UpdateFunc update)
+    {
+        Cancel();
+        if (!CreateDetectionWindow())
+        {
+            return false;
+        }
+
+        m_update = std::move(update);
+        m_reported = 0;
+        m_tokens.clear();
+        m_shared = std::make_shared<Shared>();
+        m_scheduler.reset(new ProbeScheduler(MaxWorkers));
+        m_scheduler->SetThreadHooks(
+            [] { CoInitializeEx(NULL, COINIT_MULTITHREADED); },
+            [] { CoUninitialize(); });
+
+        std::shared_ptr<Shared> shared = m_shared;
+
+        // Four of the probes read the Uninstall keys, they wait for one scan instead of queueing on its lock
+        std::vector<size_t> launcherProbes;
+        size_t index = m_scheduler->Add("Uninstall index",
+            [] { Tools::UninstallRegistry::Instance().Refresh(); },
+            {}, ProbeTimeoutMs);
+
+        for (const Probe &probe : Probes)
+        {
+            size_t slot = m_scheduler->Count();
+            launcherProbes.push_back(slot);
+            m_scheduler->Add(probe.name,
+                [shared, slot, find = probe.find]
+                {
+                    std::list<std::wstring> found;
+                    find(found);
+
+                    std::lock_guard<std::mutex> lock(shared->lock);
+                    shared->results[slot].found = std::move(found);
+                },
+                probe.usesUninstallIndex ? std::vector<size_t>{ index } : std::vector<size_t>{},
+                ProbeTimeoutMs);
+        }
+
+        // LauncherConfigs belongs to the UI thread, the probe gets a copy of what it needs
+        m_nativeProbe = m_scheduler->Count();
+        m_scheduler->Add("Native launchers",
+            [shared, slot = m_nativeProbe, known = Config::GetKnownAppUserModelIDs()]
+            {
+                std::list<std::wstring> found;
+                std::list<LauncherConfig> natives;
+                Config::FindNativeLaunchers(found, known, natives);
+
+                std::lock_guard<std::mutex> lock(shared->lock);
+                shared->results[slot].found = std::move(found);
+                shared->natives = std::move(natives);
+            },
+            {}, ProbeTimeoutMs);
+        launcherProbes.push_back(m_nativeProbe);
+
+        // Last, over whatever the other probes found
+        m_scheduler->Add("Validation tokens",
+            [shared]
+            {
+                std::list<std::wstring> found;
+                {
+                    std::lock_guard<std::mutex> lock(shared->lock);
+                    for (const Result &result : shared->results)
+                    {
+                        if (!result.name.empty() && result.status == ProbeScheduler::Status::Done)
+                        {
+                            found.insert(found.end(), result.found.begin(), result.found.end());
+                        }
+                    }
+                }
+
+                std::map<std::wstring, std::wstring> tokens;
+                for (const std::wstring &path : found)
+                {
+                    tokens[path] = GetToken(path);
+                }
+
+                std::lock_guard<std::mutex> lock(shared->lock);
+                shared->tokens = std::move(tokens);
+            },
+            launcherProbes, ProbeTimeoutMs);
+
+        m_shared->results.resize(m_scheduler->Count());
+
+        HWND hWnd = m_hWnd;
+        UINT generation = ++m_generation;
+
+        QueryPerformanceCounter(&m_start);
+        m_scheduler->Start([shared, hWnd, generation](const ProbeScheduler::Report &report)
+        {
+            {
+                std::lock_guard<std::mutex> lock(shared->lock);
+                Result &result = shared->results[report.probe];
+                result.name = report.name;
+                result.status = report.status;
+                result.elapsedMs = report.elapsedMs;
+            }
+            PostMessage(hWnd, WM_PROBE_DONE, (WPARAM)generation, (LPARAM)report.probe);
+        });
+        return true;
+    }
+
+    void LauncherDetection::Cancel()
+    {
+        m_generation++;
+        m_scheduler.reset();
+        m_shared.reset();
+        m_update = nullptr;
+    }
+
+    void LauncherDetection::OnProbeDone(UINT generation, size_t probe)
+    {
+        if (generation != m_generation || !m_shared)
+        {
+            return;
+        }
+
+        m_reported++;
+
+        std::list<std::wstring> installed;
+        std::list<LauncherConfig> natives;
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(m_shared->lock);
+            const Result &result = m_shared->results[probe];
+
+            switch (result.status)
+            {
+                case ProbeScheduler::Status::Done:
+                    log.Debug("Probe %s found %zu in %.1f ms", result.name.c_str(), result.found.size(), result.elapsedMs);
+                    if (probe == m_nativeProbe)
+                    {
+                        natives = m_shared->natives;
+                    }
+                    break;
+                case ProbeScheduler::Status::Failed:
+                    log.Error("Probe %s failed after %.1f ms", result.name.c_str(), result.elapsedMs);
+                    break;
+                case ProbeScheduler::Status::TimedOut:
+                    log.Error("Probe %s timed out after %.1f ms", result.name.c_str(), result.elapsedMs);
+                    break;
+            }
+
+            // A timed out probe may still write its slot, only finished ones count
+            for (const Result &finished : m_shared->results)
+            {
+                if (!finished.name.empty() && finished.status == ProbeScheduler::Status::Done)
+                {
+                    installed.insert(installed.end(), finished.found.begin(), finished.found.end());
+                }
+            }
+            done = m_reported == m_shared->results.size();
+            if (done)
+            {
+                m_tokens = m_shared->tokens;
+            }
+        }
+
+        Config::AddNativeLaunchers(natives);
+
+        // The callback may start the next detection
+        UpdateFunc update = m_update;
+        if (done)
+        {
+            LARGE_INTEGER end;
+            QueryPerformanceCounter(&end);
+            log.Debug("Detected %zu launchers in %.1f ms", installed.size(),
+                (double)(end.QuadPart - m_start.QuadPart) * 1000.0 / (double)m_frequency.QuadPart);
+
+            m_scheduler.reset();
+        }
+
+        if (update)
+        {
+            update(installed, done);
+        }
+    }
+
+    std::wstring LauncherDetection::GetValidationToken(const std::wstring &path) const
+    {
+        auto it = m_tokens.find(path);
+        return it != m_tokens.end() ? it->second : L"";
+    }
+
+    bool LauncherDetection::LoadCache(std::vector<CachedLauncher> &launchers)
+    {
+        launchers.clear();
+
+        std::ifstream file(GetCachePath(), std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::stringstream text;
+        text << file.rdbuf();
+        if (!LauncherCache::Parse(text.str(), launchers))
+        {
+            log.Warn("Launcher cache is damaged or outdated, detecting again");
+            return false;
+        }
+        return true;
+    }
+
+    bool LauncherDetection::SaveCache(const std::vector<CachedLauncher> &launchers)
+    {
+        std::filesystem::path path = GetCachePath();
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                log.Error("Can't write launcher cache");
+                return false;
+            }
+            file << LauncherCache::Serialize(launchers);
+            if (!file.good())
+            {
+                log.Error("Can't write launcher cache");
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        return !ec;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <windows.h>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Configuration/Config.hpp"
+#include "Configuration/LauncherCache.hpp"
+#include "Tools/ProbeScheduler.hpp"
+
+namespace AnyFSE::Configuration
+{
+    // The launcher probes of Config on a worker pool. Every probe result is handed to the UI thread as soon as
+    // it is done, the list passed on keeps the order of the serial detection. A probe stuck in WinRT or on a
+    // slow disk is given up on after ProbeTimeoutMs and counts as finding nothing.
+    class LauncherDetection
+    {
+    public:
+        // UI thread, installed launchers found so far, all of them once done is set
+        typedef std::function<void(const std::list<std::wstring> &installed, bool done)> UpdateFunc;
+
+        LauncherDetection();
+        ~LauncherDetection();
+
+        // Drops a detection in progress
+        bool Start(UpdateFunc update);
+        void Cancel();
+        bool IsRunning() const { return m_scheduler != nullptr; }
+
+        // Once done: what identifies the installed version of a found launcher, empty if nothing does
+        std::wstring GetValidationToken(const std::wstring &path) const;
+
+        // LauncherCache.json next to AnyFSE.json
+        static bool LoadCache(std::vector<CachedLauncher> &launchers);
+        static bool SaveCache(const std::vector<CachedLauncher> &launchers);
+
+    private:
+        struct Result
+        {
+            std::string name;
+            std::list<std::wstring> found;
+            Tools::ProbeScheduler::Status status = Tools::ProbeScheduler::Status::Done;
+            double elapsedMs = 0;
+        };
+
+        // Shared with the workers, they may outlive the detection
+        struct Shared
+        {
+            std::mutex lock;
+            std::vector<Result> results;
+            std::list<LauncherConfig> natives;
+            std::map<std::wstring, std::wstring> tokens;
+        };
+
+        static const UINT WM_PROBE_DONE = WM_APP + 1;
+        static const size_t MaxWorkers = 4;
+        static const int ProbeTimeoutMs = 3000;
+        static constexpr const wchar_t *ClassName = L"AnyFSE.LauncherDetection";
+
+        static LRESULT CALLBACK DetectionWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+        HWND m_hWnd = NULL;
+        UINT m_generation = 0;
+        std::unique_ptr<Tools::ProbeScheduler> m_scheduler;
+        std::shared_ptr<Shared> m_shared;
+        size_t m_nativeProbe = 0;
+        std::map<std::wstring, std::wstring> m_tokens;
+        size_t m_reported = 0;
+        UpdateFunc m_update;
+
+        LARGE_INTEGER m_frequency{};
+        LARGE_INTEGER m_start{};
+
+        bool CreateDetectionWindow();
+        void OnProbeDone(UINT generation, size_t probe);
+    };
+}
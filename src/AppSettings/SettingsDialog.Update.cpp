@@ -54,8 +54,8 @@ namespace AnyFSE::App::AppSettings::Settings
             .SetMenu(
                 std::vector<Popup::PopupItem>
                 {
-                    Popup::PopupItem(L"\xE2B4", Translate(L"settingsUpdateViewRelease"), delegate(OnShowVersion)),
-                    Popup::PopupItem(L"\xEDAB", Translate(L"settingsUpdateDownloadAndUpdate"), delegate(OnUpdate))
+                    Popup::PopupItem(L"\xE2B4", Translate(KeyId::settingsUpdateViewRelease), delegate(OnShowVersion)),
+                    Popup::PopupItem(L"\xEDAB", Translate(KeyId::settingsUpdateDownloadAndUpdate), delegate(OnUpdate))
                 }, 400, TPM_LEFTALIGN
             );
 
@@ -76,9 +76,9 @@ namespace AnyFSE::App::AppSettings::Settings
 
         bool hasVersion = !version.empty();
         std::wstring cVersion = TranslateF(
-            hasVersion ? L"settingsCurrentVersionFmt" : L"settingsVersionFmt",
+            hasVersion ? KeyId::settingsCurrentVersionFmt : KeyId::settingsVersionFmt,
             Unicode::to_wstring(VER_VERSION_STR).c_str());
-        std::wstring aVersion = hasVersion ? TranslateF(L"settingsAvailableVersionFmt", version.c_str()) : L"";
+        std::wstring aVersion = hasVersion ? TranslateF(KeyId::settingsAvailableVersionFmt, version.c_str()) : L"";
 
         bool delayed = (LONGLONG)GetTickCount64() > uiInfo.lCommandAge + 1000;
         UpdaterState command = delayed ? uiInfo.uiState : uiInfo.uiCommand;
@@ -91,13 +91,13 @@ namespace AnyFSE::App::AppSettings::Settings
                 || uiInfo.uiState == UpdaterState::CheckingUpdate)
         {
             icon = L"\xE895";
-            cVersion = TranslateF(L"settingsCurrentVersionFmt", Unicode::to_wstring(VER_VERSION_STR).c_str());
-            aVersion =   (uiInfo.uiState == UpdaterState::CheckingUpdate)   ? Translate(L"settingsCheckingNewVersion")
-                       : (command == UpdaterState::NetworkFailed)           ? Translate(L"settingsNetworkFailed")
-                       : (uiInfo.uiState == UpdaterState::NetworkFailed)    ? Translate(L"settingsNetworkFailed")
+            cVersion = TranslateF(KeyId::settingsCurrentVersionFmt, Unicode::to_wstring(VER_VERSION_STR).c_str());
+            aVersion =   (uiInfo.uiState == UpdaterState::CheckingUpdate)   ? Translate(KeyId::settingsCheckingNewVersion)
+                       : (command == UpdaterState::NetworkFailed)           ? Translate(KeyId::settingsNetworkFailed)
+                       : (uiInfo.uiState == UpdaterState::NetworkFailed)    ? Translate(KeyId::settingsNetworkFailed)
                        : (uiInfo.uiState == UpdaterState::Done
-                          && !uiInfo.newVersion.empty())                    ? TranslateF(L"settingsNewVersionAvailableFmt", uiInfo.newVersion.c_str())
-                                                                            : Translate(L"settingsNoNewVersionAvailable");
+                          && !uiInfo.newVersion.empty())                    ? TranslateF(KeyId::settingsNewVersionAvailableFmt, uiInfo.newVersion.c_str())
+                                                                            : Translate(KeyId::settingsNoNewVersionAvailable);
         }
         else if (command == UpdaterState::NetworkFailed && !enableAnimation)
         {
@@ -106,10 +106,14 @@ namespace AnyFSE::App::AppSettings::Settings
         else if (uiInfo.uiState == UpdaterState::Downloading || command == UpdaterState::Downloading || command == UpdaterState::ReadyForUpdate)
         {
             icon = L"\xF16A";
-            aVersion = (uiInfo.uiState == UpdaterState::NetworkFailed)  ? Translate(L"settingsFailedToDownload") : L"";
+            aVersion = (uiInfo.uiState == UpdaterState::NetworkFailed)  ? Translate(KeyId::settingsFailedToDownload) : L"";
             cVersion = (uiInfo.uiState == UpdaterState::Downloading)
-                ? TranslateF(L"settingsDownloadingVersionFmt", uiInfo.newVersion.c_str())
-                : TranslateF(L"settingsUpdatingToVersionFmt", uiInfo.newVersion.c_str());
+                ? TranslateF(KeyId::settingsDownloadingVersionFmt, uiInfo.newVersion.c_str())
+                : TranslateF(KeyId::settingsUpdatingToVersionFmt, uiInfo.newVersion.c_str());
+            if (uiInfo.uiState == UpdaterState::Downloading && uiInfo.lDownloadTotal > 0)
+            {
+                cVersion += L" " + std::to_wstring(uiInfo.lDownloaded * 100 / uiInfo.lDownloadTotal) + L"%";
+            }
             enableAnimation = true;
             enableCheck = false;
             enableStatus = false;
@@ -25,6 +25,7 @@
 #include <windows.h>
 #include <Windows.h>
 #include <algorithm>
+#include <unordered_set>
 #include "Logging/LogManager.hpp"
 #include "SettingsDialog.hpp"
 #include "Configuration/Config.hpp"
@@ -40,6 +41,8 @@
 #include "Tools/Process.hpp"
 #include "Tools/Localization.hpp"
 #include "Tools/Paths.hpp"
+#include "Tools/Icon.hpp"
+#include "Tools/IconLoader.hpp"
 #include "Ally/Ally.hpp"
 #include "App/JumpList.hpp"
 
@@ -54,6 +57,7 @@ namespace AnyFSE::App::AppSettings::Settings
 
     INT_PTR SettingsDialog::Show(HINSTANCE hInstance)
     {
+        QueryPerformanceCounter(&m_openStart);
 
         WNDCLASSEX wc = {0};
         wc.cbSize = sizeof(WNDCLASSEX);
@@ -184,10 +188,11 @@ namespace AnyFSE::App::AppSettings::Settings
             {   // To enable immersive dark mode (for a dark title bar)
 
                 m_theme.AttachDlg(hwnd);
-                SetWindowText(hwnd, Translate(L"settingsMainWindowTitle").c_str());
+                SetWindowText(hwnd, Translate(KeyId::settingsMainWindowTitle).c_str());
                 OnInitDialog(hwnd);
                 RestoreWindowPlacement();
                 Process::BringWindowToForeground(m_hDialog);
+                PostMessage(hwnd, WM_DIALOG_INTERACTIVE, 0, 0);
             }
             return TRUE;
 
@@ -198,6 +203,7 @@ namespace AnyFSE::App::AppSettings::Settings
                 m_gamepadListener.reset();
             }
             StoreWindowPlacement();
+            Icon::FlushCache();
             return FALSE;
 
         case WM_KEYDOWN:
@@ -303,6 +309,10 @@ namespace AnyFSE::App::AppSettings::Settings
             OnUpdateNotification();
             return TRUE;
 
+        case WM_DIALOG_INTERACTIVE:
+            OnDialogInteractive();
+            return TRUE;
+
         case WM_SIZE:
             UpdateLayout();
             if (wParam == SIZE_RESTORED || wParam == SIZE_MAXIMIZED)
@@ -364,7 +374,7 @@ namespace AnyFSE::App::AppSettings::Settings
                 r.left += m_theme.DpiScale(Layout::MarginLeft);
                 r.top += m_theme.DpiScale(Layout::CaptionHeight);
 
-                std::wstring text1 = Translate(L"settingsAppTitle");
+                std::wstring text1 = Translate(KeyId::settingsAppTitle);
 
                 SetBkMode(paint.MemDC(), TRANSPARENT);
                 HGDIOBJ oldFont = SelectFont(paint.MemDC(), m_theme.GetFont_Title());
@@ -527,6 +537,25 @@ namespace AnyFSE::App::AppSettings::Settings
         return page.back();
     }
 
+    static bool IsSelfVisible(HWND hwnd)
+    {
+        return hwnd && (GetWindowLong(hwnd, GWL_STYLE) & WS_VISIBLE);
+    }
+
+    static void CollectVisibleLines(std::list<SettingsLine> *pPageList, std::vector<HWND> &lines)
+    {
+        if (pPageList)
+        {
+            for (auto &line : *pPageList)
+            {
+                if (IsSelfVisible(line.GetHWnd()))
+                {
+                    lines.push_back(line.GetHWnd());
+                }
+            }
+        }
+    }
+
     void SettingsDialog::SwitchActivePage(const std::wstring& pageName, std::list<SettingsLine> * pPageList, bool back)
     {
         m_pageName = pageName;
@@ -544,43 +573,25 @@ namespace AnyFSE::App::AppSettings::Settings
         int steps = 10;
         int delta = width / steps;
 
-        for (auto& line: *pPageList)
-        {
-            Window::MoveWindow(line.GetHWnd(), width * invert, 0, FALSE);
-            if (!line.IsNested())
-            {
-                ShowWindow(line.GetHWnd(), SW_SHOW);
-                line.UpdateLayout();
-            }
-        }
+        // Only the realized rows of both pages slide, offscreen ones stay hidden
+        std::vector<HWND> slidingLines;
+        CollectVisibleLines(m_pActivePageList, slidingLines);
+
+        m_pActivePageList = pPageList;
+        LayoutPageRows(width * invert);
+        CollectVisibleLines(m_pActivePageList, slidingLines);
 
         RedrawWindow(m_hDialog, NULL, NULL, RDW_INVALIDATE | RDW_UPDATENOW);
 
         for (int i = 0; i < steps; i++)
         {
-            if (m_pActivePageList)
+            for (HWND hLine : slidingLines)
             {
-                for (auto &line : *m_pActivePageList)
-                {
-                    Window::MoveWindow(line.GetHWnd(), -delta * invert, 0, TRUE);
-                }
-            }
-            for (auto &line : *pPageList)
-            {
-                Window::MoveWindow(line.GetHWnd(), -delta * invert, 0, TRUE);
+                Window::MoveWindow(hLine, -delta * invert, 0, TRUE);
             }
             RedrawWindow(m_hScrollView, NULL, NULL, RDW_INVALIDATE | RDW_UPDATENOW);
             Sleep(5);
         }
-        if (m_pActivePageList)
-        {
-            for (auto& line : *m_pActivePageList)
-            {
-                ShowWindow(line.GetHWnd(), SW_HIDE);
-                Window::MoveWindow(line.GetHWnd(), width * invert, 0, FALSE);
-            }
-        }
-        m_pActivePageList = pPageList;
         UpdateLayout();
         RedrawWindow(m_hDialog, NULL, NULL, RDW_INVALIDATE | RDW_UPDATENOW | RDW_ALLCHILDREN);
 
@@ -598,6 +609,13 @@ namespace AnyFSE::App::AppSettings::Settings
         RECT rc;
         Window::GetChildRect(line->GetHWnd(), &rc);
         OffsetRect(&rc, 0, m_scrollView.GetScrollPos());
+
+        // Offscreen rows were not placed, their top comes from the row layout
+        auto row = std::find(m_pageRows.begin(), m_pageRows.end(), line);
+        if (row != m_pageRows.end() && !IsSelfVisible(line->GetHWnd()))
+        {
+            rc.top = m_scrollView.GetRowTop((size_t)(row - m_pageRows.begin()));
+        }
         rc.bottom = rc.top + line->GetTotalHeight();
 
         m_scrollView.EnsureVisible(rc);
@@ -607,43 +625,95 @@ namespace AnyFSE::App::AppSettings::Settings
     {
         m_theme.ReflowChilds(m_hDialog);
 
-        for (auto &page: m_pages)
+        LayoutPageRows(0);
+
+        // Lines of other pages and rows outside of the view stay hidden until realized
+        std::unordered_set<SettingsLine *> realized;
+        FluentDesign::VirtualRows::Range range = m_scrollView.GetRealizedRows();
+        for (size_t row = range.first; row < range.last; ++row)
         {
-            if (&(page->GetSettingsLines()) != m_pActivePageList)
+            realized.insert(m_pageRows[row]);
+        }
+
+        auto hideLines = [&realized](std::list<SettingsLine> &lines)
+        {
+            for (auto &line : lines)
             {
-                for (auto& line: page->GetSettingsLines())
+                SettingsLine *row = line.IsNested() ? line.GetGroupHeader() : &line;
+                if (!realized.count(row) && IsSelfVisible(line.GetHWnd()))
                 {
                     ShowWindow(line.GetHWnd(), SW_HIDE);
                 }
             }
+        };
+
+        hideLines(m_settingPageList);
+        for (auto &page: m_pages)
+        {
+            hideLines(page->GetSettingsLines());
         }
 
+        RedrawWindow(m_hDialog, NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+    }
+
+    void SettingsDialog::LayoutPageRows(int offset)
+    {
         RECT rect;
         GetDialogCenteredRect(m_theme, m_hDialog, &rect);
-        int width = rect.right - rect.left
+        m_pageRowsWidth = rect.right - rect.left
             - m_theme.DpiScale(Layout::MarginLeft)
             - m_theme.DpiScale(Layout::MarginRight);
 
-        int left = rect.left + m_theme.DpiScale(Layout::MarginLeft);
+        m_pageRowsLeft = rect.left + m_theme.DpiScale(Layout::MarginLeft) + offset;
 
-        ULONG top = -m_scrollView.GetScrollPos();
+        m_pageRows.clear();
         if (m_pActivePageList)
         {
-            for(auto& line : *m_pActivePageList)
+            for (auto& line : *m_pActivePageList)
             {
                 if (!line.IsNested())
                 {
-                    ShowWindow(line.GetHWnd(), SW_SHOW);
-                    ::MoveWindow(line.GetHWnd(), left, top, width, m_theme.DpiScale(line.GetDesignHeight()), FALSE);
-                    line.UpdateLayout();
-                    top += line.GetTotalHeight();
+                    m_pageRows.push_back(&line);
                 }
             }
         }
 
-        m_scrollView.SetContentHeight(top + m_scrollView.GetScrollPos());
+        m_scrollView.SetVirtualRows(m_pageRows.size(),
+            [this](size_t row)
+            {
+                return m_pageRows[row]->MeasureTotalHeight(m_pageRowsWidth);
+            },
+            [this](size_t row, int top)
+            {
+                SettingsLine *line = m_pageRows[row];
+                ShowWindow(line->GetHWnd(), SW_SHOW);
+                ::MoveWindow(line->GetHWnd(), m_pageRowsLeft, top, m_pageRowsWidth, m_theme.DpiScale(line->GetDesignHeight()), FALSE);
+                line->UpdateLayout();
+                return line->GetTotalHeight();
+            },
+            [this](size_t row)
+            {
+                SettingsLine *line = m_pageRows[row];
+                ShowWindow(line->GetHWnd(), SW_HIDE);
+                for (SettingsLine *item : line->GetGroupItems())
+                {
+                    ShowWindow(item->GetHWnd(), SW_HIDE);
+                }
+            });
+    }
 
-        RedrawWindow(m_hDialog, NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+    void SettingsDialog::OnDialogInteractive()
+    {
+        // Paints still queued belong to opening the dialog
+        RedrawWindow(m_hDialog, NULL, NULL, RDW_UPDATENOW | RDW_ALLCHILDREN);
+
+        LARGE_INTEGER now, frequency;
+        QueryPerformanceCounter(&now);
+        QueryPerformanceFrequency(&frequency);
+
+        log.Info("Dialog interactive in %.1f ms, %zu icons still loading",
+            (double)(now.QuadPart - m_openStart.QuadPart) * 1000.0 / (double)frequency.QuadPart,
+            Tools::IconLoader::Instance().GetPendingCount());
     }
 
     HWND SettingsDialog::GetMainWindow()
@@ -657,7 +727,7 @@ namespace AnyFSE::App::AppSettings::Settings
             .SetAnchor(Align::TopLeft(), GetDialogClientRect)
             .Create(m_hDialog, Layout::BackButtonMargin * 2 + Layout::BackButtonSize, Layout::BackButtonMargin, 200, Layout::BackButtonSize - 4);
         m_captionStatic.Format().SetLineAlignment(Gdiplus::StringAlignment::StringAlignmentCenter);
-        m_captionStatic.SetText(Translate(L"settingsCaption"));
+        m_captionStatic.SetText(Translate(KeyId::settingsCaption));
 
         m_captionBackButton
             .SetAnchor(Align::TopLeft(), GetDialogClientRect)
@@ -830,7 +900,7 @@ namespace AnyFSE::App::AppSettings::Settings
 
     void SettingsDialog::RefreshLocalizedCaption()
     {
-        SetWindowText(m_hDialog, Translate(L"settingsMainWindowTitle").c_str());
+        SetWindowText(m_hDialog, Translate(KeyId::settingsMainWindowTitle).c_str());
     }
 
     void SettingsDialog::AddLanguageButton()
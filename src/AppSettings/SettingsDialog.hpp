@@ -69,6 +69,7 @@ namespace AnyFSE::App::AppSettings::Settings
 
         // SettingsDialog_Update
         static const UINT WM_UPDATE_NOTIFICATION = WM_USER + 2;
+        static const UINT WM_DIALOG_INTERACTIVE = WM_USER + 3;
         inline static const wchar_t* DialogClassName = AppConstants::SettingsDialogClass;
 
         HWND GetHwnd() { return m_hDialog; }
@@ -90,6 +91,7 @@ namespace AnyFSE::App::AppSettings::Settings
 
         void SwitchActivePage(const std::wstring& pageName, std::list<SettingsLine> *pPageList, bool back = false);
         void UpdateLayout();
+        void LayoutPageRows(int offset);
         void UpdateLine(SettingsLine *line);
 
     public:
@@ -159,6 +161,10 @@ namespace AnyFSE::App::AppSettings::Settings
         HINSTANCE m_hInstance = nullptr;
         HWND m_hDialog = nullptr;
 
+        // Open to interactive timing, logged once the first frame is painted
+        LARGE_INTEGER m_openStart{};
+        void OnDialogInteractive();
+
 
         std::wstring m_pageName = L"";
         RECT m_breadCrumbRect = { 0 };
@@ -182,6 +188,11 @@ namespace AnyFSE::App::AppSettings::Settings
         std::list<SettingsLine> m_settingPageList;
         std::list<SettingsLine> *m_pActivePageList = nullptr;
 
+        // Top level lines of the active page, realized by the scroll view while in view
+        std::vector<SettingsLine *> m_pageRows;
+        int m_pageRowsLeft = 0;
+        int m_pageRowsWidth = 0;
+
 
         void UpdateDpiLayout();
         HWND GetMainWindow();
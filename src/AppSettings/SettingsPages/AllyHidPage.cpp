@@ -19,8 +19,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         m_theme.OnThemeChanged += delegate(ReloadIcons);
 
         SettingsLine & rogAllySupport = m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsAllyFeatures"),
-            Translate(L"settingsAllyFeaturesDescription"),
+            Translate(KeyId::settingsAllyFeatures),
+            Translate(KeyId::settingsAllyFeaturesDescription),
             Layout::LineHeight, Layout::LinePadding, 0
         );
         rogAllySupport.SetState(FluentDesign::SettingsLine::Next);
@@ -29,8 +29,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
         ULONG pageTop = 0;
         m_pAllyHidLine = &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsAllyEnableAlternativeButtons"),
-            Translate(L"settingsAllyEnableAlternativeButtonsDescription"),
+            Translate(KeyId::settingsAllyEnableAlternativeButtons),
+            Translate(KeyId::settingsAllyEnableAlternativeButtonsDescription),
             m_enableAllyHidToggle,
             Layout::LineHeight, 0, 0);
         m_pAllyHidLine->SetIcon(L"@B9ECED6F.ASUSCommandCenter_qmba6cd70vzyy");
@@ -39,10 +39,10 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
         m_pACPressLine = &m_pAllyHidLine->AddGroupItem(
             &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                Translate(L"settingsAllyPressArmouryCrate"),
+                Translate(KeyId::settingsAllyPressArmouryCrate),
                 !Ally::IsXBoxRogAlly()
-                    ? Translate(L"settingsAllyShortPressRightAction")
-                    : Translate(L"settingsAllyShortPressLeftAction"),
+                    ? Translate(KeyId::settingsAllyShortPressRightAction)
+                    : Translate(KeyId::settingsAllyShortPressLeftAction),
                 m_acPressCombo,
                 Layout::LineHeight, 0, 0, 240));
 
@@ -50,15 +50,15 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         {
             m_pACHoldLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyHoldArmouryCrate"),
-                    Translate(L"settingsAllyLongPressRightAction"),
+                    Translate(KeyId::settingsAllyHoldArmouryCrate),
+                    Translate(KeyId::settingsAllyLongPressRightAction),
                     m_acHoldCombo,
                     Layout::LineHeight, 0, 0, 240));
 
             m_pCCPressLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyPressCommandCenter"),
-                    Translate(L"settingsAllyShortPressLeftAction"),
+                    Translate(KeyId::settingsAllyPressCommandCenter),
+                    Translate(KeyId::settingsAllyShortPressLeftAction),
                     m_ccPressCombo,
                     Layout::LineHeight, 0, 0, 240));
         }
@@ -66,25 +66,25 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         {
             m_pLibraryPressLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyPressLibrary"),
-                    Translate(L"settingsAllyShortPressRightAction"),
+                    Translate(KeyId::settingsAllyPressLibrary),
+                    Translate(KeyId::settingsAllyShortPressRightAction),
                     m_libraryPressCombo,
                     Layout::LineHeight, 0, 0, 240));
         }
 
         m_pAllyHidLine->AddGroupItem(
             &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                Translate(L"settingsAllySecondaryButtonsActions"),
+                Translate(KeyId::settingsAllySecondaryButtonsActions),
                 L"",
                 Layout::LinePadding * 4, 0, 0));
 
 
         m_pModeACPressLine = &m_pAllyHidLine->AddGroupItem(
             &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                Translate(L"settingsAllyModePressArmouryCrate"),
+                Translate(KeyId::settingsAllyModePressArmouryCrate),
                 !Ally::IsXBoxRogAlly()
-                    ? Translate(L"settingsAllyShortPressRightActionMode")
-                    : Translate(L"settingsAllyShortPressLeftActionMode"),
+                    ? Translate(KeyId::settingsAllyShortPressRightActionMode)
+                    : Translate(KeyId::settingsAllyShortPressLeftActionMode),
                 m_modeACPressCombo,
                 Layout::LineHeight, 0, 0, 240));
 
@@ -92,15 +92,15 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         {
             m_pModeACHoldLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyModeHoldArmouryCrate"),
-                    Translate(L"settingsAllyLongPressRightActionMode"),
+                    Translate(KeyId::settingsAllyModeHoldArmouryCrate),
+                    Translate(KeyId::settingsAllyLongPressRightActionMode),
                     m_modeACHoldCombo,
                     Layout::LineHeight, 0, 0, 240));
 
             m_pModeCCPressLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyModePressCommandCenter"),
-                    Translate(L"settingsAllyShortPressLeftActionMode"),
+                    Translate(KeyId::settingsAllyModePressCommandCenter),
+                    Translate(KeyId::settingsAllyShortPressLeftActionMode),
                     m_modeCCPressCombo,
                     Layout::LineHeight, 0, 0, 240));
         }
@@ -108,8 +108,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         {
             m_pModeLibraryPressLine = &m_pAllyHidLine->AddGroupItem(
                 &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-                    Translate(L"settingsAllyModePressLibrary"),
-                    Translate(L"settingsAllyShortPressRightActionMode"),
+                    Translate(KeyId::settingsAllyModePressLibrary),
+                    Translate(KeyId::settingsAllyShortPressRightActionMode),
                     m_modeLibraryPressCombo,
                     Layout::LineHeight, Layout::LinePadding, 0, 240));
         }
@@ -198,7 +198,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
     void AllyHidPage::OpenAllyHidPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsAllyPageTitle"), &m_pageLinesList);
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsAllyPageTitle), &m_pageLinesList);
     }
 
     void AllyHidPage::EnableAllyHidChanged()
@@ -15,8 +15,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     {
         FluentDesign::SettingsLine &confirmationsLine = m_dialog.AddSettingsLine(settingPageList,
             top,
-            Translate(L"settingsConfirmationsSetup"),
-            Translate(L"settingsConfirmationsSetupDescription"),
+            Translate(KeyId::settingsConfirmationsSetup),
+            Translate(KeyId::settingsConfirmationsSetupDescription),
             Layout::LineHeight, Layout::LinePadding, 0,
             Layout::LauncherComboWidth);
 
@@ -30,27 +30,27 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     {
         ULONG pageTop = 0;
         m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsConfirmationsEnterMode"),
-            Translate(L"settingsConfirmationsEnterModeDescription"),
+            Translate(KeyId::settingsConfirmationsEnterMode),
+            Translate(KeyId::settingsConfirmationsEnterModeDescription),
             m_confirmEnterCombo,
             Layout::LineHeight, Layout::LinePadding, 0, 330)
             .SetIcon(L'\xE93A');
 
         m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsConfirmationsExitMode"),
+            Translate(KeyId::settingsConfirmationsExitMode),
             L"",
             m_confirmExitCombo,
             Layout::LineHeight, Layout::LinePadding, 0, 330)
             .SetIcon(L'\xEE47');
 
         std::vector<std::wstring> enterOptions{
-            Translate(L"settingsConfirmationsAsk"),
-            Translate(L"settingsConfirmationsRestartToOptimize"),
-            Translate(L"settingsConfirmationsStartNowNoOptimizations")
+            Translate(KeyId::settingsConfirmationsAsk),
+            Translate(KeyId::settingsConfirmationsRestartToOptimize),
+            Translate(KeyId::settingsConfirmationsStartNowNoOptimizations)
         };
         std::vector<std::wstring> exitOptions{
-            Translate(L"settingsConfirmationsAsk"),
-            Translate(L"settingsConfirmationsExitWithoutConfirmation")
+            Translate(KeyId::settingsConfirmationsAsk),
+            Translate(KeyId::settingsConfirmationsExitWithoutConfirmation)
         };
 
         for (auto option: enterOptions)
@@ -70,10 +70,10 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     void ConfirmationsPage::LoadControls()
     {
         std::wstring key = L"HKEY_CURRENT_USER\\Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration\\SystemDialogResults";
-        m_confirmEnterCombo.SelectItem(
-            Registry::ReadDWORD(key, L"EnterGamingPostureConfirmation_Config",
-                Registry::ReadDWORD(key, L"EnterGamingPostureConfirmation", 0)));
-        m_confirmExitCombo.SelectItem(Registry::ReadDWORD(key, L"ExitGamingPostureConfirmation", 0));
+        std::vector<RegistryValue> values = Registry::ReadValues(key,
+            { L"EnterGamingPostureConfirmation_Config", L"EnterGamingPostureConfirmation", L"ExitGamingPostureConfirmation" });
+        m_confirmEnterCombo.SelectItem((int)values[0].AsDWORD(values[1].AsDWORD(0)));
+        m_confirmExitCombo.SelectItem((int)values[2].AsDWORD(0));
     }
 
     void ConfirmationsPage::SaveControls()
@@ -86,6 +86,6 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
     void ConfirmationsPage::OpenConfirmationsSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsConfirmationsPageTitle"), &m_pageLinesList);
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsConfirmationsPageTitle), &m_pageLinesList);
     }
 };
@@ -18,8 +18,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     void LauncherPage::AddPage(std::list<SettingsLine>& settingPageList, ULONG &top)
     {
         FluentDesign::SettingsLine &launcher = m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsChooseHomeApp"),
-            Translate(L"settingsChooseHomeAppDescription"),
+            Translate(KeyId::settingsChooseHomeApp),
+            Translate(KeyId::settingsChooseHomeAppDescription),
             m_launcherCombo,
             Layout::LineHeight, Layout::LauncherBrowsePadding, 0,
             Layout::LauncherComboWidth );
@@ -36,15 +36,15 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         m_pBrowseLine->SetFrame(Gdiplus::FrameFlags::SIDE_NO_TOP | Gdiplus::FrameFlags::CORNER_BOTTOM);
 
         m_pFseOnStartupLine = &m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsEnterFseOnStartup"),
+            Translate(KeyId::settingsEnterFseOnStartup),
             L"",
             m_fseOnStartupToggle,
             Layout::LineHeight, Layout::LinePadding, 0);
         m_pFseOnStartupLine->SetIcon(L'\xE93A');
 
         m_pExitOnHomeExitLine = &m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsLeaveFseOnHomeExit"),
-            Translate(L"settingsLeaveFseOnHomeExitDescription"),
+            Translate(KeyId::settingsLeaveFseOnHomeExit),
+            Translate(KeyId::settingsLeaveFseOnHomeExitDescription),
             m_fseExitOnHomeExitToggle,
             Layout::LineHeight, Layout::LinePadding, 0);
         m_pExitOnHomeExitLine->SetIcon(L'\xEE47');
@@ -52,8 +52,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         m_dialog.AddPage((new ConfirmationsPage(m_theme, m_dialog))->AddLine(settingPageList, top));
 
         m_pCustomSettingsLine = &m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsUseCustomSettings"),
-            Translate(L"settingsUseCustomSettingsDescription"),
+            Translate(KeyId::settingsUseCustomSettings),
+            Translate(KeyId::settingsUseCustomSettingsDescription),
             m_customSettingsToggle,
             Layout::LineHeight, Layout::LinePadding, 0);
 
@@ -64,8 +64,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         AddCustomPage();
 
         m_pSplashSettingsLine = &m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsSplashScreenSettings"),
-            Translate(L"settingsSplashScreenSettingsDescription"),
+            Translate(KeyId::settingsSplashScreenSettings),
+            Translate(KeyId::settingsSplashScreenSettingsDescription),
             Layout::LineHeight, Layout::LinePadding, 0);
 
         m_pSplashSettingsLine->SetState(SettingsLine::Next);
@@ -73,8 +73,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         m_pSplashSettingsLine->OnChanged += delegate(OpenSplashSettingsPage);
 
         m_pStartupSettingsLine = &m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsStartup"),
-            Translate(L"settingsStartupDescription"),
+            Translate(KeyId::settingsStartup),
+            Translate(KeyId::settingsStartupDescription),
             Layout::LineHeight, Layout::LinePadding, 0);
 
         m_pStartupSettingsLine->SetState(FluentDesign::SettingsLine::Next);
@@ -89,7 +89,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
         m_customSettingsToggle.OnChanged += delegate(OnCustomChanged);
 
-        m_browseButton.SetText(Translate(L"browseBtn"));
+        m_browseButton.SetText(Translate(KeyId::browseBtn));
         m_browseButton.OnChanged += delegate(OnBrowseLauncher);
     }
 
@@ -100,16 +100,16 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         ULONG pageTop = 0;
 
         SettingsLine & parametersSettingsLine = m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsAdditionalArguments"),
-            Translate(L"settingsAdditionalArgumentsDescription"),
+            Translate(KeyId::settingsAdditionalArguments),
+            Translate(KeyId::settingsAdditionalArgumentsDescription),
             m_additionalArgumentsEdit,
             Layout::LineHeight, Layout::LinePadding, 0);
 
         parametersSettingsLine.SetIcon(L'\xE62F');
 
         SettingsLine & primarySettingsLine = m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsHomeApplicationDetection"),
-            Translate(L"settingsHomeApplicationDetectionDescription"),
+            Translate(KeyId::settingsHomeApplicationDetection),
+            Translate(KeyId::settingsHomeApplicationDetectionDescription),
             Layout::LineHeightSmall, 0, 0);
 
 
@@ -118,26 +118,26 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         primarySettingsLine.SetIcon(L'\xF8A5');
 
         primarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsProcessName"),
-            Translate(L"settingsProcessNameDescription"),
+            Translate(KeyId::settingsProcessName),
+            Translate(KeyId::settingsProcessNameDescription),
             m_processNameEdit,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         primarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsWindowClassName"),
-            Translate(L"settingsWindowClassNameDescription"),
+            Translate(KeyId::settingsWindowClassName),
+            Translate(KeyId::settingsWindowClassNameDescription),
             m_classEdit,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         primarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsFieldWindowTitle"),
-            Translate(L"settingsWindowTitleDescription"),
+            Translate(KeyId::settingsFieldWindowTitle),
+            Translate(KeyId::settingsWindowTitleDescription),
             m_titleEdit,
             Layout::LineHeightSmall, Layout::LinePadding, Layout::LineSmallMargin));
 
         SettingsLine & secondarySettingsLine = m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsAlternativeModeDetection"),
-            Translate(L"settingsAlternativeModeDetectionDescription"),
+            Translate(KeyId::settingsAlternativeModeDetection),
+            Translate(KeyId::settingsAlternativeModeDetectionDescription),
             Layout::LineHeightSmall, 0, 0);
 
         secondarySettingsLine.SetState(SettingsLine::State::Closed);
@@ -145,20 +145,20 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         secondarySettingsLine.SetIcon(L'\xE737');
 
         secondarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSecondaryProcessName"),
-            Translate(L"settingsSecondaryProcessNameDescription"),
+            Translate(KeyId::settingsSecondaryProcessName),
+            Translate(KeyId::settingsSecondaryProcessNameDescription),
             m_processNameAltEdit,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         secondarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSecondaryWindowClassName"),
-            Translate(L"settingsSecondaryWindowClassNameDescription"),
+            Translate(KeyId::settingsSecondaryWindowClassName),
+            Translate(KeyId::settingsSecondaryWindowClassNameDescription),
             m_classAltEdit,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         secondarySettingsLine.AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSecondaryWindowTitle"),
-            Translate(L"settingsSecondaryWindowTitleDescription"),
+            Translate(KeyId::settingsSecondaryWindowTitle),
+            Translate(KeyId::settingsSecondaryWindowTitleDescription),
             m_titleAltEdit,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
@@ -170,7 +170,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
             Layout::StartupAddWidth, Layout::StartupAddHeight
         ).SetState(FluentDesign::SettingsLine::Caption);
 
-        m_customResetButton.SetText(Translate(L"resetBtn"));
+        m_customResetButton.SetText(Translate(KeyId::resetBtn));
         m_customResetButton.OnChanged = delegate(OnCustomReset);
 
         m_additionalArgumentsEdit.OnChanged += delegate(UpdateCustomResetEnabled);
@@ -185,9 +185,22 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     void LauncherPage::LoadControls()
     {
         m_currentLauncherPath = Config::GetNativePath(Config::Launcher.StartCommand);
-        Config::FindLaunchers(m_launchersList);
-        Config::FindNotInstalledLaunchers(m_notInstalledLaunchersList);
+
+        // The combo starts with the launchers of the last session, or with the current one and fills up as the
+        // probes finish. Either way the detection runs and only what it changed is redrawn.
+        m_launchersList = { L"" };
+        m_notInstalledLaunchersList.clear();
+        m_installedLaunchers.clear();
+        m_launchersDetected = false;
+        if (Configuration::LauncherDetection::LoadCache(m_cachedLaunchers))
+        {
+            ShowCachedLaunchers();
+        }
         UpdateCombo();
+        m_detection.Start([This = this](const std::list<std::wstring> &installed, bool done)
+        {
+            This->OnLaunchersDetected(installed, done);
+        });
         Config::LoadLauncherSettings(m_currentLauncherPath, m_config);
 
         bool customSettings = Config::CustomSettings;
@@ -310,17 +323,17 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
     void LauncherPage::OpenCustomSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsCustomSettings"), &m_pageLinesList);
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsCustomSettings), &m_pageLinesList);
     }
 
     void LauncherPage::OpenSplashSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsSplashSettings"), &m_pSplashPage->GetSettingsLines());
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsSplashSettings), &m_pSplashPage->GetSettingsLines());
     }
 
     void LauncherPage::OpenStartupSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsStartup"), &m_pStartupPage->GetSettingsLines());
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsStartup), &m_pStartupPage->GetSettingsLines());
     }
 
     void LauncherPage::UpdateControls()
@@ -383,23 +396,107 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
         m_pBrowseLine->SetDescription(
             m_defaultConfig.Type == LauncherType::Native
-                ? Translate(L"settingsNativeLauncherSelected")
+                ? Translate(KeyId::settingsNativeLauncherSelected)
                 : L""
         );
     }
 
     void LauncherPage::OnLauncherDropDown()
     {
-        std::list<std::wstring> notInstalled;
-        Config::FindNotInstalledLaunchers(notInstalled);
+        // Something may have been installed meanwhile, the combo only changes if the result does
+        if (!m_detection.IsRunning())
+        {
+            m_detection.Start([This = this](const std::list<std::wstring> &installed, bool done)
+            {
+                This->OnLaunchersDetected(installed, done);
+            });
+        }
+    }
 
-        if (notInstalled.size() != m_notInstalledLaunchersList.size())
+    void LauncherPage::ShowCachedLaunchers()
+    {
+        // Packages found by the last detection, GetLauncherDefaults knows them by their AUMID
+        std::list<LauncherConfig> natives;
+        for (const Configuration::CachedLauncher &cached : m_cachedLaunchers)
         {
-            m_launchersList.clear();
-            m_notInstalledLaunchersList.clear();
-            Config::FindLaunchers(m_launchersList);
-            Config::FindNotInstalledLaunchers(m_notInstalledLaunchersList);
-            UpdateCombo();
+            m_installedLaunchers.push_back(cached.path);
+            if (!cached.appUserModelId.empty() && cached.path == cached.appUserModelId)
+            {
+                LauncherConfig native;
+                native.Type = LauncherType::Native;
+                native.Name = cached.name;
+                native.StartCommand = cached.path;
+                native.AppUserModelID = cached.appUserModelId;
+                natives.push_back(native);
+            }
+        }
+        Config::AddNativeLaunchers(natives);
+
+        m_launchersList.insert(m_launchersList.end(), m_installedLaunchers.begin(), m_installedLaunchers.end());
+        Config::FindNotInstalledLaunchers(m_installedLaunchers, m_notInstalledLaunchersList);
+        m_launchersDetected = true;
+    }
+
+    std::set<std::wstring> LauncherPage::UpdateLauncherCache(const std::list<std::wstring> &installed)
+    {
+        std::vector<Configuration::CachedLauncher> detected;
+        for (const std::wstring &path : installed)
+        {
+            LauncherConfig info;
+            Config::GetLauncherDefaults(path, info);
+            detected.push_back({ path, info.AppUserModelID, info.Name, info.IconFile, m_detection.GetValidationToken(path) });
+        }
+
+        std::set<std::wstring> changed;
+        Configuration::LauncherCacheDiff diff = Configuration::LauncherCache::Compare(m_cachedLaunchers, detected);
+        if (diff.Empty())
+        {
+            return changed;
+        }
+
+        for (size_t index : diff.changed)
+        {
+            changed.insert(detected[index].path);
+        }
+        log.Info("Launcher cache updated: %zu added, %zu changed, %zu removed",
+            diff.added.size(), diff.changed.size(), diff.removed.size());
+
+        m_cachedLaunchers = std::move(detected);
+        Configuration::LauncherDetection::SaveCache(m_cachedLaunchers);
+        return changed;
+    }
+
+    void LauncherPage::OnLaunchersDetected(const std::list<std::wstring> &installed, bool done)
+    {
+        // A complete list, cached or detected before, is only replaced by another complete one
+        if (m_launchersDetected && !done)
+        {
+            return;
+        }
+
+        std::list<std::wstring> launchers = { L"" };
+        launchers.insert(launchers.end(), installed.begin(), installed.end());
+
+        std::list<std::wstring> notInstalled = m_notInstalledLaunchersList;
+        bool changed = launchers != m_launchersList;
+        std::set<std::wstring> refreshIcons;
+        if (done)
+        {
+            refreshIcons = UpdateLauncherCache(installed);
+            m_installedLaunchers = installed;
+            notInstalled.clear();
+            Config::FindNotInstalledLaunchers(installed, notInstalled);
+
+            // Portable marks are only known at the end of the first detection
+            changed = changed || notInstalled != m_notInstalledLaunchersList || !m_launchersDetected || !refreshIcons.empty();
+            m_launchersDetected = true;
+        }
+
+        if (changed)
+        {
+            m_launchersList = launchers;
+            m_notInstalledLaunchersList = notInstalled;
+            UpdateCombo(refreshIcons);
         }
     }
 
@@ -421,38 +518,46 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         UpdateCustomSettings();
     }
 
-    void LauncherPage::UpdateCombo()
+    void LauncherPage::UpdateCombo(const std::set<std::wstring> &refreshIcons)
     {
-        m_launcherCombo.Reset();
-
-        for ( auto& launcher: m_launchersList)
+        // Rows that stay keep their icons, only new rows and the launchers in refreshIcons load them again
+        std::vector<ComboBox::Item> items;
+        std::set<std::wstring> refresh;
+        auto addLauncher = [&](const std::wstring &launcher, size_t pos)
         {
             LauncherConfig info;
             Config::GetLauncherDefaults(launcher, info);
-            Config::UpdatePortableLauncher(info);
-            m_launcherCombo.AddItem(info.Name, info.IconFile, info.StartCommand);
+            if (!m_detection.IsRunning())
+            {
+                Config::UpdatePortableLauncher(info, m_installedLaunchers);
+            }
+            if (refreshIcons.count(launcher))
+            {
+                refresh.insert(info.StartCommand);
+            }
+            items.insert(items.begin() + pos, { info.Name, info.IconFile, info.StartCommand });
+        };
+
+        for ( auto& launcher: m_launchersList)
+        {
+            addLauncher(launcher, items.size());
         }
         size_t index = List::index_of(m_launchersList, m_currentLauncherPath);
 
         if (index == List::npos)
         {
-            LauncherConfig info;
-            Config::GetLauncherDefaults(m_currentLauncherPath, info);
-            Config::UpdatePortableLauncher(info);
-            m_launcherCombo.AddItem(info.Name, info.IconFile, info.StartCommand, 1);
+            addLauncher(m_currentLauncherPath, 1);
             index = 1;
         }
 
-        if (m_notInstalledLaunchersList.size())
+        for (auto& launcher: m_notInstalledLaunchersList)
         {
-            for (auto& launcher: m_notInstalledLaunchersList)
-            {
-                LauncherConfig info;
-                Config::GetLauncherDefaults(launcher, info);
-                m_launcherCombo.AddItem(info.Name, L"\xE118", info.StartCommand);
-            }
+            LauncherConfig info;
+            Config::GetLauncherDefaults(launcher, info);
+            items.push_back({ info.Name, L"\xE118", info.StartCommand });
         }
 
+        m_launcherCombo.SetItems(items, refresh);
         m_launcherCombo.SelectItem((int)index);
     }
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <list>
+#include <set>
+#include <vector>
 #include "Configuration/Config.hpp"
+#include "AppSettings/LauncherDetection.hpp"
 #include "FluentDesign/Theme.hpp"
 #include "FluentDesign/ComboBox.hpp"
 #include "FluentDesign/TextBox.hpp"
@@ -60,6 +63,10 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         std::wstring m_currentLauncherPath;
         std::list<std::wstring> m_launchersList;
         std::list<std::wstring> m_notInstalledLaunchersList;
+        std::list<std::wstring> m_installedLaunchers;
+        Configuration::LauncherDetection m_detection;
+        bool m_launchersDetected = false;
+        std::vector<Configuration::CachedLauncher> m_cachedLaunchers;
 
 
         ComboBox m_launcherCombo;
@@ -100,8 +107,11 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         void OpenStartupSettingsPage();
         void UpdateControls();
         void OnLauncherDropDown();
+        void OnLaunchersDetected(const std::list<std::wstring> &installed, bool done);
         void OnLauncherChanged();
-        void UpdateCombo();
+        void UpdateCombo(const std::set<std::wstring> &refreshIcons = {});
+        void ShowCachedLaunchers();
+        std::set<std::wstring> UpdateLauncherCache(const std::list<std::wstring> &installed);
         void UpdateCustomSettings();
     };
 };
\ No newline at end of file
@@ -13,59 +13,59 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     {
         ULONG pageTop = 0;
         m_pSplashTextLine = &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashShowLoadingText"),
+            Translate(KeyId::settingsSplashShowLoadingText),
             L"",
             m_showTextToggle,
             Layout::LineHeight, 0, 0);
 
         m_pSplashTextLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashUseCustomText"),
+            Translate(KeyId::settingsSplashUseCustomText),
             L"",
             m_customTextEdit,
             Layout::LineHeightSmall, Layout::LinePadding, Layout::LineSmallMargin));
 
         m_pSplashLogoLine = &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashShowHomeLogo"),
+            Translate(KeyId::settingsSplashShowHomeLogo),
             L"",
             m_showLogoToggle,
             Layout::LineHeight, 0, 0);
 
         m_pSplashLogoLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashAnimateLogo"),
+            Translate(KeyId::settingsSplashAnimateLogo),
             L"",
             m_showAnimationToggle,
             Layout::LineHeightSmall, Layout::LinePadding, Layout::LineSmallMargin));
 
 
         m_pSplashVideoLine = &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashShowVideo"),
-            Translate(L"settingsSplashShowVideoDescription"),
+            Translate(KeyId::settingsSplashShowVideo),
+            Translate(KeyId::settingsSplashShowVideoDescription),
             m_showVideoToggle,
             Layout::LineHeight, 0, 0);
 
         m_pSplashVideoLine->OnLink = delegate(OnGotoSplashFolder);
 
         m_pSplashVideoLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashPlayVideoAtLeastOnce"),
-            Translate(L"settingsSplashPlayVideoAtLeastOnceDescription"),
+            Translate(KeyId::settingsSplashPlayVideoAtLeastOnce),
+            Translate(KeyId::settingsSplashPlayVideoAtLeastOnceDescription),
             m_videoTillEndToggle,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         m_pSplashVideoLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashLoopVideo"),
+            Translate(KeyId::settingsSplashLoopVideo),
             L"",
             m_videoLoopToggle,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         m_pSplashVideoLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashMuteVideo"),
+            Translate(KeyId::settingsSplashMuteVideo),
             L"",
             m_videoMuteToggle,
             Layout::LineHeightSmall, 0, Layout::LineSmallMargin));
 
         m_pSplashVideoLine->AddGroupItem(&m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsSplashPauseCompleted"),
-            Translate(L"settingsSplashPauseCompletedDescription"),
+            Translate(KeyId::settingsSplashPauseCompleted),
+            Translate(KeyId::settingsSplashPauseCompletedDescription),
             m_videoPauseToggle,
             Layout::LineHeightSmall, Layout::LinePadding, Layout::LineSmallMargin));
 
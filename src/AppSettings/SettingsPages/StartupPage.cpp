@@ -12,8 +12,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     {
         ULONG pageTop = 0;
         SettingsLine &startupAppLinkLine = m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsNativeStartupSettings"),
-            Translate(L"settingsNativeStartupSettingsDescription"),
+            Translate(KeyId::settingsNativeStartupSettings),
+            Translate(KeyId::settingsNativeStartupSettingsDescription),
             Layout::LineHeight, Layout::LinePadding, 0);
 
         startupAppLinkLine.SetState(FluentDesign::SettingsLine::Link);
@@ -21,8 +21,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         startupAppLinkLine.OnChanged += delegate(OpenMSSettingsStartupApps);
 
         m_pStartupPageAppsHeader = &m_dialog.AddSettingsLine(m_pageLinesList, pageTop,
-            Translate(L"settingsAdditionalStartupApplications"),
-            Translate(L"settingsAdditionalStartupApplicationsDescription"),
+            Translate(KeyId::settingsAdditionalStartupApplications),
+            Translate(KeyId::settingsAdditionalStartupApplicationsDescription),
             Layout::LineHeight, 0, 0
         );
 
@@ -36,7 +36,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
             Layout::StartupAddWidth, Layout::StartupAddHeight
         );
 
-        m_startupAddButton.SetText(Translate(L"addBtn"));
+        m_startupAddButton.SetText(Translate(KeyId::addBtn));
         m_startupAddButton.OnChanged = delegate(OnStartupAdd);
         line.SetState(FluentDesign::SettingsLine::Caption);
     }
@@ -91,8 +91,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         line.SetMenu(
             std::vector<FluentDesign::Popup::PopupItem>
             {
-                FluentDesign::Popup::PopupItem(L"\xE13E", Translate(L"modifyBtn"),[This = this, pLine = &line](){This->OnStartupModify(pLine);}),
-                FluentDesign::Popup::PopupItem(L"\xE107", Translate(L"deleteBtn"),[This = this, pLine = &line](){This->OnStartupDelete(pLine);})
+                FluentDesign::Popup::PopupItem(L"\xE13E", Translate(KeyId::modifyBtn),[This = this, pLine = &line](){This->OnStartupModify(pLine);}),
+                FluentDesign::Popup::PopupItem(L"\xE107", Translate(KeyId::deleteBtn),[This = this, pLine = &line](){This->OnStartupDelete(pLine);})
             }
         );
         startToggle.SetCheck(enabled);
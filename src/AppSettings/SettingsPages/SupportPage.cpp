@@ -11,13 +11,13 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     void SupportPage::AddPage(std::list<SettingsLine>& settingPageList, ULONG &top)
     {
         m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsRelatedSupport"),
+            Translate(KeyId::settingsRelatedSupport),
             L"",
             Layout::LineHeightSmall, 0, 0
         ).SetState(FluentDesign::SettingsLine::Caption);
 
         SettingsLine &support = m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsSupportAndCommunity"),
+            Translate(KeyId::settingsSupportAndCommunity),
             L"",
             Layout::LineHeight, 0, 0);
 
@@ -32,19 +32,19 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         support.AddGroupItem(&links);
 
         // links.SetMaxColumns(1);
-        links.AddLinkButton(Translate(L"settingsDiscordCommunity"), L"https://discord.gg/hnVwuTzDmk");
-        links.AddLinkButton(Translate(L"settingsNavigateLogsFolder"), Tools::Paths::GetLogsPath() + L"\\");
+        links.AddLinkButton(Translate(KeyId::settingsDiscordCommunity), L"https://discord.gg/hnVwuTzDmk");
+        links.AddLinkButton(Translate(KeyId::settingsNavigateLogsFolder), Tools::Paths::GetLogsPath() + L"\\");
 
-        links.AddLinkButton(Translate(L"settingsSourceCodeGithub"), L"https://github.com/ashpynov/AnyFSE/");
-        links.AddLinkButton(Translate(L"settingsNavigateConfigFolder"), Tools::Paths::GetConfigPath() + L"\\");
+        links.AddLinkButton(Translate(KeyId::settingsSourceCodeGithub), L"https://github.com/ashpynov/AnyFSE/");
+        links.AddLinkButton(Translate(KeyId::settingsNavigateConfigFolder), Tools::Paths::GetConfigPath() + L"\\");
 
-        links.AddLinkButton(Translate(L"settingsSourceCodeCodeberg"), L"https://codeberg.org/ashpynov/AnyFSE/");
-        links.AddLinkButton(Translate(L"settingsNavigateSplashFolder"), Tools::Paths::GetSplashDefaultPath() + L"\\");
+        links.AddLinkButton(Translate(KeyId::settingsSourceCodeCodeberg), L"https://codeberg.org/ashpynov/AnyFSE/");
+        links.AddLinkButton(Translate(KeyId::settingsNavigateSplashFolder), Tools::Paths::GetSplashDefaultPath() + L"\\");
 
-        links.AddLinkButton(Translate(L"settingsReportIssueGithub"), L"https://github.com/ashpynov/AnyFSE/issues");
+        links.AddLinkButton(Translate(KeyId::settingsReportIssueGithub), L"https://github.com/ashpynov/AnyFSE/issues");
         links.AddLinkButton(L"", L"");
 
-        links.AddLinkButton(Translate(L"settingsReportIssueCodeberg"), L"https://codeberg.org/ashpynov/AnyFSE/issues");
+        links.AddLinkButton(Translate(KeyId::settingsReportIssueCodeberg), L"https://codeberg.org/ashpynov/AnyFSE/issues");
         links.AddLinkButton(L"", L"");
 
         support.SetState(FluentDesign::SettingsLine::Opened);
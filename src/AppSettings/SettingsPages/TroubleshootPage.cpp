@@ -15,13 +15,13 @@ namespace AnyFSE::App::AppSettings::Settings::Page
     {
         switch (level)
         {
-        case LogLevels::Disabled: return Translate(L"settingsLogLevelDisabled");
-        case LogLevels::Critical: return Translate(L"settingsLogLevelCritical");
-        case LogLevels::Error: return Translate(L"settingsLogLevelError");
-        case LogLevels::Warn: return Translate(L"settingsLogLevelWarn");
-        case LogLevels::Info: return Translate(L"settingsLogLevelInfo");
-        case LogLevels::Debug: return Translate(L"settingsLogLevelDebug");
-        case LogLevels::Trace: return Translate(L"settingsLogLevelTrace");
+        case LogLevels::Disabled: return Translate(KeyId::settingsLogLevelDisabled);
+        case LogLevels::Critical: return Translate(KeyId::settingsLogLevelCritical);
+        case LogLevels::Error: return Translate(KeyId::settingsLogLevelError);
+        case LogLevels::Warn: return Translate(KeyId::settingsLogLevelWarn);
+        case LogLevels::Info: return Translate(KeyId::settingsLogLevelInfo);
+        case LogLevels::Debug: return Translate(KeyId::settingsLogLevelDebug);
+        case LogLevels::Trace: return Translate(KeyId::settingsLogLevelTrace);
         default: break;
         }
         return Unicode::to_wstring(LogManager::LogLevelToString(level));
@@ -33,8 +33,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
         FluentDesign::SettingsLine &logLevel = m_dialog.AddSettingsLine(settingPageList,
             top,
-            Translate(L"settingsTroubleshootSetLogs"),
-            Translate(L"settingsTroubleshootSetLogsDescription"),
+            Translate(KeyId::settingsTroubleshootSetLogs),
+            Translate(KeyId::settingsTroubleshootSetLogsDescription),
             m_troubleLogLevelCombo,
             Layout::LineHeight, Layout::LinePadding, 0,
             Layout::LauncherComboWidth);
@@ -64,7 +64,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
     void TroubleshootPage::OpenTroubleshootSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsTroubleshootPageTitle"), &m_pageLinesList);
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsTroubleshootPageTitle), &m_pageLinesList);
     }
 
     void TroubleshootPage::OnGotoLogsFolder()
@@ -14,8 +14,8 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         GetClientRect(m_dialog.GetHwnd(), &rect);
 
         SettingsLine & dialogLine = m_dialog.AddSettingsLine(settingPageList, top,
-            Translate(L"settingsUpdateSettings"),
-            Translate(L"settingsUpdateSettingsDescription"),
+            Translate(KeyId::settingsUpdateSettings),
+            Translate(KeyId::settingsUpdateSettingsDescription),
             Layout::LineHeight, Layout::LinePadding, 0);
 
         dialogLine.SetState(FluentDesign::SettingsLine::Next);
@@ -25,13 +25,13 @@ namespace AnyFSE::App::AppSettings::Settings::Page
         ULONG topPage = 0;
 
         m_dialog.AddSettingsLine(m_pageLinesList, topPage,
-            Translate(L"settingsCheckPeriod"),
-            Translate(L"settingsCheckPeriodDescription"),
+            Translate(KeyId::settingsCheckPeriod),
+            Translate(KeyId::settingsCheckPeriodDescription),
             m_checkIntervalCombo,
             Layout::LineHeight, Layout::LinePadding, 0);
 
-        m_checkIntervalCombo.AddItem(Translate(L"settingsCheckPeriodManual"), L"", {(wchar_t)-2, 0});
-        m_checkIntervalCombo.AddItem(Translate(L"settingsCheckPeriodOnSettingsOpen"), L"", {(wchar_t)-1, 0});
+        m_checkIntervalCombo.AddItem(Translate(KeyId::settingsCheckPeriodManual), L"", {(wchar_t)-2, 0});
+        m_checkIntervalCombo.AddItem(Translate(KeyId::settingsCheckPeriodOnSettingsOpen), L"", {(wchar_t)-1, 0});
         // m_checkIntervalCombo.AddItem(L"On windows boot", L"", {(wchar_t)0, 0});
 
         // m_checkIntervalCombo.AddItem(L"Hourly", L"", {(wchar_t)1, 0});
@@ -41,14 +41,14 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
 
         m_dialog.AddSettingsLine(m_pageLinesList, topPage,
-            Translate(L"settingsIncludePrerelease"),
-            Translate(L"settingsIncludePrereleaseDescription"),
+            Translate(KeyId::settingsIncludePrerelease),
+            Translate(KeyId::settingsIncludePrereleaseDescription),
             m_preReleaseToggle,
             Layout::LineHeight, Layout::LinePadding, 0);
 
         m_dialog.AddSettingsLine(m_pageLinesList, topPage,
-            Translate(L"settingsShowNotifications"),
-            Translate(L"settingsShowNotificationsDescription"),
+            Translate(KeyId::settingsShowNotifications),
+            Translate(KeyId::settingsShowNotificationsDescription),
             m_notificationsToggle,
             Layout::LineHeight, Layout::LinePadding, 0);
 
@@ -76,7 +76,7 @@ namespace AnyFSE::App::AppSettings::Settings::Page
 
     void UpdatePage::OpenUpdateSettingsPage()
     {
-        m_dialog.SwitchActivePage(Translate(L"settingsUpdateSettings"), &m_pageLinesList);
+        m_dialog.SwitchActivePage(Translate(KeyId::settingsUpdateSettings), &m_pageLinesList);
     }
 
     void UpdatePage::UpdateSettingsChangedCheck()
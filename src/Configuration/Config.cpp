@@ -81,6 +81,12 @@ namespace AnyFSE::Configuration
     std::wstring    Config::AllyHidModeCCPress = L"";
     std::wstring    Config::AllyHidModeLibraryPress = L"";
 
+    DWORD           Config::GamepadRepeatDelay = 400;
+    DWORD           Config::GamepadRepeatInterval = 80;
+    DWORD           Config::GamepadRepeatMinInterval = 30;
+    int             Config::GamepadStickDeadzone = 7849;
+    int             Config::GamepadStickThreshold = 16000;
+
     bool Config::IsConfigured()
     {
         return fs::exists(GetConfigFileA());
@@ -157,6 +163,13 @@ namespace AnyFSE::Configuration
         AllyHidModeCCPress      = config.value(jp("/AllyHid/ModeCCPress"),  std::wstring(L""));
         AllyHidModeLibraryPress = config.value(jp("/AllyHid/ModeLibraryPress"), std::wstring(L""));
 
+        // Not on a settings page, kept in the file when it is saved
+        GamepadRepeatDelay      = config.value(jp("/Gamepad/RepeatDelay"),       (DWORD)400);
+        GamepadRepeatInterval   = config.value(jp("/Gamepad/RepeatInterval"),    (DWORD)80);
+        GamepadRepeatMinInterval = config.value(jp("/Gamepad/RepeatMinInterval"), (DWORD)30);
+        GamepadStickDeadzone    = config.value(jp("/Gamepad/StickDeadzone"),     7849);
+        GamepadStickThreshold   = config.value(jp("/Gamepad/StickThreshold"),    16000);
+
         std::wstring launcher   = config.value(jp("/Launcher/Path"),         std::wstring());
 
 
@@ -27,6 +27,7 @@
 #include <windows.h>
 #include <list>
 #include <map>
+#include <set>
 #include "Logging/Logger.hpp"
 #include "Tools/nlohmann/json_fwd.hpp"
 
@@ -99,12 +100,17 @@ namespace AnyFSE::Configuration
             static bool IsAnyFSEConfigured();
             static bool FindInstalledLaunchers(std::list<std::wstring> &found);
             static bool FindNotInstalledLaunchers(std::list<std::wstring> &found);
+            static bool FindNotInstalledLaunchers(const std::list<std::wstring> &installed, std::list<std::wstring> &found);
             static std::wstring GetNativePath(const std::wstring &launcher);
             static void FindPlaynite(std::list<std::wstring>& found);
             static void FindSteam(std::list<std::wstring>& found);
             static void FindBigBox(std::list<std::wstring>& found);
             static void FindOneGameLauncher(std::list<std::wstring>& found);
             static void FindNativeLaunchers(std::list<std::wstring> &found);
+            // Doesn't touch LauncherConfigs, safe off the UI thread. Launchers not in known come back in natives
+            static void FindNativeLaunchers(std::list<std::wstring> &found, const std::set<std::wstring> &known, std::list<LauncherConfig> &natives);
+            static void AddNativeLaunchers(const std::list<LauncherConfig> &natives);
+            static std::set<std::wstring> GetKnownAppUserModelIDs();
             static void FindArmouryCrate(std::list<std::wstring> &found);
             static void FindRetroBat(std::list<std::wstring>& found);
             static void FindKodi(std::list<std::wstring> &found);
@@ -118,6 +124,7 @@ namespace AnyFSE::Configuration
         public:
             // Unsafe
             static void UpdatePortableLauncher(LauncherConfig &out);
+            static void UpdatePortableLauncher(LauncherConfig &out, const std::list<std::wstring> &installed);
             static bool FindLaunchers(std::list<std::wstring> &found);
 
             static std::string GetConfigFileA(bool readOnly = true);
@@ -189,6 +196,12 @@ namespace AnyFSE::Configuration
             static std::wstring AllyHidModeACHold;
             static std::wstring AllyHidModeCCPress;
             static std::wstring AllyHidModeLibraryPress;
+
+            static DWORD        GamepadRepeatDelay;
+            static DWORD        GamepadRepeatInterval;
+            static DWORD        GamepadRepeatMinInterval;
+            static int          GamepadStickDeadzone;
+            static int          GamepadStickThreshold;
     };
 }
 
@@ -0,0 +1,198 @@
+#include <cstdint>
+#include <unordered_map>
+
+#include "Configuration/LauncherCache.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+namespace AnyFSE::Configuration::LauncherCache
+{
+    using json = nlohmann::json;
+
+    namespace
+    {
+        // Unicode::to_string is Win32, the cache stays portable. wchar_t is UTF-16 on Windows, UTF-32 elsewhere.
+        std::string ToUtf8(const std::wstring &text)
+        {
+            std::string out;
+            out.reserve(text.size());
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                uint32_t code = (uint32_t)text[i];
+                if (code >= 0xD800 && code < 0xDC00 && i + 1 < text.size()
+                    && (uint32_t)text[i + 1] >= 0xDC00 && (uint32_t)text[i + 1] < 0xE000)
+                {
+                    code = 0x10000 + ((code - 0xD800) << 10) + ((uint32_t)text[++i] - 0xDC00);
+                }
+
+                if (code < 0x80)
+                {
+                    out += (char)code;
+                }
+                else if (code < 0x800)
+                {
+                    out += (char)(0xC0 | (code >> 6));
+                    out += (char)(0x80 | (code & 0x3F));
+                }
+                else if (code < 0x10000)
+                {
+                    out += (char)(0xE0 | (code >> 12));
+                    out += (char)(0x80 | ((code >> 6) & 0x3F));
+                    out += (char)(0x80 | (code & 0x3F));
+                }
+                else
+                {
+                    out += (char)(0xF0 | (code >> 18));
+                    out += (char)(0x80 | ((code >> 12) & 0x3F));
+                    out += (char)(0x80 | ((code >> 6) & 0x3F));
+                    out += (char)(0x80 | (code & 0x3F));
+                }
+            }
+            return out;
+        }
+
+        std::wstring FromUtf8(const std::string &text)
+        {
+            std::wstring out;
+            out.reserve(text.size());
+            for (size_t i = 0; i < text.size();)
+            {
+                uint8_t lead = (uint8_t)text[i];
+                size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+                if (!length || i + length > text.size())
+                {
+                    // The parser has validated the text, this is not reached for a cache we wrote
+                    out += L'\xFFFD';
+                    i++;
+                    continue;
+                }
+
+                uint32_t code = length == 1 ? lead : lead & (0x7F >> length);
+                for (size_t k = 1; k < length; ++k)
+                {
+                    code = (code << 6) | ((uint8_t)text[i + k] & 0x3F);
+                }
+                i += length;
+
+                if (sizeof(wchar_t) == 2 && code >= 0x10000)
+                {
+                    code -= 0x10000;
+                    out += (wchar_t)(0xD800 + (code >> 10));
+                    out += (wchar_t)(0xDC00 + (code & 0x3FF));
+                }
+                else
+                {
+                    out += (wchar_t)code;
+                }
+            }
+            return out;
+        }
+
+        std::wstring ReadString(const json &entry, const char *key)
+        {
+            auto it = entry.find(key);
+            return it != entry.end() && it->is_string() ? FromUtf8(it->get<std::string>()) : L"";
+        }
+    }
+
+    bool Parse(const std::string &text, std::vector<CachedLauncher> &launchers)
+    {
+        launchers.clear();
+
+        json cache = json::parse(text, nullptr, false);
+        if (cache.is_discarded() || !cache.is_object()
+            || cache.value("Version", 0) != Version
+            || !cache.contains("Launchers") || !cache["Launchers"].is_array())
+        {
+            return false;
+        }
+
+        for (const json &entry : cache["Launchers"])
+        {
+            if (!entry.is_object())
+            {
+                launchers.clear();
+                return false;
+            }
+
+            CachedLauncher launcher;
+            launcher.path = ReadString(entry, "Path");
+            launcher.appUserModelId = ReadString(entry, "AppUserModelID");
+            launcher.name = ReadString(entry, "Name");
+            launcher.iconKey = ReadString(entry, "Icon");
+            launcher.token = ReadString(entry, "Token");
+            launchers.push_back(std::move(launcher));
+        }
+        return true;
+    }
+
+    std::string Serialize(const std::vector<CachedLauncher> &launchers)
+    {
+        json entries = json::array();
+        for (const CachedLauncher &launcher : launchers)
+        {
+            entries.push_back(json
+            {
+                { "Path", ToUtf8(launcher.path) },
+                { "AppUserModelID", ToUtf8(launcher.appUserModelId) },
+                { "Name", ToUtf8(launcher.name) },
+                { "Icon", ToUtf8(launcher.iconKey) },
+                { "Token", ToUtf8(launcher.token) },
+            });
+        }
+
+        json cache
+        {
+            { "Version", Version },
+            { "Launchers", entries },
+        };
+        return cache.dump(4);
+    }
+
+    LauncherCacheDiff Compare(const std::vector<CachedLauncher> &cached, const std::vector<CachedLauncher> &detected)
+    {
+        LauncherCacheDiff diff;
+
+        std::unordered_map<std::wstring, size_t> cachedIndex;
+        for (size_t i = 0; i < cached.size(); ++i)
+        {
+            cachedIndex.emplace(cached[i].path, i);
+        }
+
+        std::vector<bool> seen(cached.size(), false);
+        size_t lastCached = 0;
+        bool first = true;
+
+        for (size_t i = 0; i < detected.size(); ++i)
+        {
+            auto it = cachedIndex.find(detected[i].path);
+            if (it == cachedIndex.end() || seen[it->second])
+            {
+                diff.added.push_back(i);
+                continue;
+            }
+
+            seen[it->second] = true;
+            if (cached[it->second] != detected[i])
+            {
+                diff.changed.push_back(i);
+            }
+
+            // Kept entries have to come in the cached order
+            if (!first && it->second < lastCached)
+            {
+                diff.reordered = true;
+            }
+            lastCached = it->second;
+            first = false;
+        }
+
+        for (size_t i = 0; i < cached.size(); ++i)
+        {
+            if (!seen[i])
+            {
+                diff.removed.push_back(i);
+            }
+        }
+        return diff;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Launchers found by the last detection, kept next to AnyFSE.json so Settings can show them before the
+// probes have run. Each entry carries a validation token that changes with the launcher itself: the
+// executable's write time, or the versioned install folder of a package.
+namespace AnyFSE::Configuration
+{
+    struct CachedLauncher
+    {
+        std::wstring path;              // As detected: an executable, a protocol or an AUMID
+        std::wstring appUserModelId;
+        std::wstring name;
+        std::wstring iconKey;
+        std::wstring token;
+
+        bool operator==(const CachedLauncher &other) const
+        {
+            return path == other.path && appUserModelId == other.appUserModelId && name == other.name
+                && iconKey == other.iconKey && token == other.token;
+        }
+        bool operator!=(const CachedLauncher &other) const { return !(*this == other); }
+    };
+
+    struct LauncherCacheDiff
+    {
+        std::vector<size_t> added;      // Into the detected list
+        std::vector<size_t> changed;    // Into the detected list, same path with anything else different
+        std::vector<size_t> removed;    // Into the cached list
+        bool reordered = false;
+
+        bool Empty() const { return added.empty() && changed.empty() && removed.empty() && !reordered; }
+    };
+
+    namespace LauncherCache
+    {
+        const int Version = 1;
+
+        // False for a damaged file or another version, the launchers are left empty then
+        bool Parse(const std::string &text, std::vector<CachedLauncher> &launchers);
+        std::string Serialize(const std::vector<CachedLauncher> &launchers);
+
+        LauncherCacheDiff Compare(const std::vector<CachedLauncher> &cached, const std::vector<CachedLauncher> &detected);
+    }
+}
@@ -0,0 +1,128 @@
+#include "FluentDesign/AnchorLayout.hpp"
+
+namespace FluentDesign::AnchorLayout
+{
+    namespace
+    {
+        // Align::Side
+        const uint8_t SideNone = 0;
+        const uint8_t SideNear = 1;
+        const uint8_t SideFar = 2;
+        const uint8_t SideCenter = 3;
+
+        uint8_t LeftSide(uint8_t anchor)   { return (anchor >> 6) & SideCenter; }
+        uint8_t TopSide(uint8_t anchor)    { return (anchor >> 4) & SideCenter; }
+        uint8_t RightSide(uint8_t anchor)  { return (anchor >> 2) & SideCenter; }
+        uint8_t BottomSide(uint8_t anchor) { return anchor & SideCenter; }
+
+        // Align::HSide and Align::VSide
+        float Edge(uint8_t side, float origin, float length, float size)
+        {
+            switch (side)
+            {
+                case SideNear:
+                    return origin;
+                case SideFar:
+                    return origin + length;
+                case SideCenter:
+                    return origin + length / 2;
+            }
+            return size;
+        }
+    }
+
+    Box Unscale(const Rect &rect, uint32_t dpi)
+    {
+        return Box
+        {
+            (float)rect.left * 96 / dpi,
+            (float)rect.top * 96 / dpi,
+            (float)(rect.right - rect.left) * 96 / dpi,
+            (float)(rect.bottom - rect.top) * 96 / dpi
+        };
+    }
+
+    Rect Scale(const Box &box, uint32_t dpi)
+    {
+        return Rect
+        {
+            (int32_t)(box.x * dpi / 96),
+            (int32_t)(box.y * dpi / 96),
+            (int32_t)((box.x + box.width) * dpi / 96),
+            (int32_t)((box.y + box.height) * dpi / 96)
+        };
+    }
+
+    Box Place(uint8_t anchor, const Margins &margins, const Box &parent)
+    {
+        float l = margins.left   + Edge(LeftSide(anchor), parent.x, parent.width, 0);
+        float t = margins.top    + Edge(TopSide(anchor), parent.y, parent.height, 0);
+        float r = margins.right  + Edge(RightSide(anchor), parent.x, parent.width, l);
+        float b = margins.bottom + Edge(BottomSide(anchor), parent.y, parent.height, t);
+
+        return Box{ l, t, r - l, b - t };
+    }
+
+    void Tree::Clear()
+    {
+        m_frames.clear();
+        m_frameBoxes.clear();
+        m_nodes.clear();
+        m_clientBoxes.clear();
+    }
+
+    int32_t Tree::AddFrame(const Rect &rect)
+    {
+        m_frames.push_back(rect);
+        return (int32_t)m_frames.size() - 1;
+    }
+
+    int32_t Tree::Add(const Node &node)
+    {
+        // Parents come first, a single pass in order sees every parent placed
+        if (node.parent >= (int32_t)m_nodes.size()
+            || (node.parent < 0 && (node.frame < 0 || node.frame >= (int32_t)m_frames.size())))
+        {
+            return -1;
+        }
+
+        m_nodes.push_back(node);
+        return (int32_t)m_nodes.size() - 1;
+    }
+
+    void Tree::Measure(uint32_t dpi)
+    {
+        m_frameBoxes.resize(m_frames.size());
+        for (size_t i = 0; i < m_frames.size(); ++i)
+        {
+            m_frameBoxes[i] = Unscale(m_frames[i], dpi);
+        }
+    }
+
+    size_t Tree::Arrange(uint32_t dpi)
+    {
+        m_clientBoxes.resize(m_nodes.size());
+
+        size_t changed = 0;
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            Node &node = m_nodes[i];
+            if (node.anchor == SideNone)
+            {
+                node.arranged = node.current;
+            }
+            else
+            {
+                const Box &parent = node.parent < 0 ? m_frameBoxes[node.frame] : m_clientBoxes[node.parent];
+                node.arranged = Scale(Place(node.anchor, node.margins, parent), dpi);
+            }
+
+            node.changed = node.arranged != node.current;
+            changed += node.changed ? 1 : 0;
+
+            Rect client{ 0, 0, node.arranged.right - node.arranged.left, node.arranged.bottom - node.arranged.top };
+            m_clientBoxes[i] = Unscale(client, dpi);
+        }
+        return changed;
+    }
+}
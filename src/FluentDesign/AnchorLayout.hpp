@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The anchor rules of Align.hpp on plain data, nothing here touches a window.
+//
+// Frames are the rects top level nodes anchor to, in device pixels. A node anchors either to a frame or to a
+// node added before it, then it is placed in the client coordinates of that node. Measure converts every frame
+// to design units once, Arrange places all nodes in the order they were added, scales them back to pixels and
+// marks the nodes whose rect differs from the one they have now.
+namespace FluentDesign::AnchorLayout
+{
+    // Device pixels
+    struct Rect
+    {
+        int32_t left = 0;
+        int32_t top = 0;
+        int32_t right = 0;
+        int32_t bottom = 0;
+
+        bool operator==(const Rect &other) const
+        {
+            return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+        }
+        bool operator!=(const Rect &other) const { return !(*this == other); }
+    };
+
+    // Design units, origin and size like Gdiplus::RectF so rounding matches Theme::DpiScale
+    struct Box
+    {
+        float x = 0;
+        float y = 0;
+        float width = 0;
+        float height = 0;
+    };
+
+    // Align::Margins, left and top are offsets, right and bottom are offsets or the size when the side is free
+    struct Margins
+    {
+        float left = 0;
+        float top = 0;
+        float right = 0;
+        float bottom = 0;
+    };
+
+    struct Node
+    {
+        uint8_t anchor = 0;         // Align::Anchor, a node without one keeps its rect
+        Margins margins;
+        int32_t parent = -1;        // Node index, or -1 when anchored to a frame
+        int32_t frame = 0;
+        Rect current;               // Rect the node has now
+
+        Rect arranged;
+        bool changed = false;
+    };
+
+    Box Unscale(const Rect &rect, uint32_t dpi);
+    Rect Scale(const Box &box, uint32_t dpi);
+
+    // Same as ReflowControl for a single control
+    Box Place(uint8_t anchor, const Margins &margins, const Box &parent);
+
+    class Tree
+    {
+    public:
+        // Capacity is kept, a tree rebuilt on every resize doesn't allocate
+        void Clear();
+
+        int32_t AddFrame(const Rect &rect);
+        int32_t Add(const Node &node);
+
+        void Measure(uint32_t dpi);
+
+        // Returns the number of changed nodes
+        size_t Arrange(uint32_t dpi);
+
+        size_t Count() const { return m_nodes.size(); }
+        const Node &operator[](size_t index) const { return m_nodes[index]; }
+
+    private:
+        std::vector<Rect> m_frames;
+        std::vector<Box> m_frameBoxes;
+        std::vector<Node> m_nodes;
+        std::vector<Box> m_clientBoxes;
+    };
+}
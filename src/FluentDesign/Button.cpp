@@ -25,11 +25,15 @@
 #include <windows.h>
 #include <string>
 #include <functional>
+#include <algorithm>
+#include <cmath>
 #include <Uxtheme.h>
 #include "Tools/Unicode.hpp"
 #include "Button.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Tools/AnimationClock.hpp"
+#include "Palette.hpp"
 
 #pragma comment(lib, "Gdiplus.lib")
 
@@ -51,11 +55,8 @@ namespace FluentDesign
         , m_textPressedColor(Theme::Colors::Text)
         , m_backgroundPressedColor(Theme::Colors::ButtonPressed)
         , m_iconAngle(0)
-        , m_startAngle(0)
-        , m_endAngle(0)
-        , m_stepAngle(0)
-        , m_animationLoop(false)
-        , m_animationTimer(0)
+        , m_animationId(0)
+        , m_iconRect{0}
     {
     }
 
@@ -112,6 +113,7 @@ namespace FluentDesign
             return *this;
 
         m_text = text;
+        m_extentsValid = false;
         InvalidateRect(m_hWnd, NULL, FALSE);
         return *this;
     }
@@ -128,6 +130,7 @@ namespace FluentDesign
 
         m_icon = glyph;
         m_isSmallIcon = bSmall;
+        m_extentsValid = false;
 
         InvalidateRect(m_hWnd, NULL, FALSE);
         return *this;
@@ -181,7 +184,7 @@ namespace FluentDesign
     void Button::SetAngle(int angle)
     {
         m_iconAngle = angle;
-        InvalidateRect(m_hWnd, NULL, FALSE);
+        InvalidateRect(m_hWnd, IsRectEmpty(&m_iconRect) ? NULL : &m_iconRect, FALSE);
     }
 
     Button& Button::SetLinkStyle()
@@ -276,30 +279,13 @@ namespace FluentDesign
         HDC hdc = GetWindowDC(m_hWnd);
         Graphics graphics(hdc);
 
-        StringFormat format;
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
         long align = GetWindowLong(m_hWnd, GWL_STYLE) & BS_CENTER;
-        format.SetAlignment(align == BS_LEFT ? StringAlignmentNear : align == BS_RIGHT ? StringAlignmentFar : StringAlignmentCenter);
-        format.SetLineAlignment(StringAlignmentCenter);
-        format.SetTrimming(StringTrimmingNone);
-        format.SetFormatFlags(StringFormatFlagsNoWrap);
-
-        Font textFont(hdc, m_theme.GetFont_Text());
-        Font iconFont(hdc, m_isSmallIcon ? m_theme.GetFont_Glyph() : m_theme.GetFont_GlyphNormal());
-
-        RectF bounds;
-        bounds.Width = 100000;
-        bounds.Height = 100000;
+        const StringFormat *format = palette->Format(align == BS_LEFT ? StringAlignmentNear : align == BS_RIGHT ? StringAlignmentFar : StringAlignmentCenter, true);
 
         RectF textRect{};
         RectF iconRect{};
-        if (!m_text.empty())
-        {
-            graphics.MeasureString(m_text.c_str(), -1, &textFont, bounds, &format, &textRect);
-        }
-        if (!m_icon.empty())
-        {
-            graphics.MeasureString(m_icon.c_str(), -1, &iconFont, bounds, &format, &iconRect);
-        }
+        MeasureContent(graphics, palette, format, textRect, iconRect);
 
         float spacing = (!m_text.empty() && !m_icon.empty()) ? m_theme.DpiScaleF(6.0f) : 0.0f;
         float width = textRect.Width + iconRect.Width + spacing;
@@ -311,6 +297,7 @@ namespace FluentDesign
 
     Button::~Button()
     {
+        AnyFSE::Tools::AnimationClock::Instance().Remove(m_animationId);
         if (m_hWnd)
         {
             m_popup.Hide();
@@ -321,56 +308,56 @@ namespace FluentDesign
 
     void Button::Animate(int startAngle, int stopAngle, int duration, bool bInfinite)
     {
-        bool active = m_animationTimer;
+        using namespace AnyFSE::Tools;
+        AnimationClock &clock = AnimationClock::Instance();
+        double now = clock.Now();
 
-        m_startAngle = startAngle;
-        m_endAngle = stopAngle;
-        m_stepAngle = (stopAngle - startAngle) * 10 / duration;
-        if (!m_stepAngle)
+        m_angleTween = Tween(startAngle, stopAngle, duration);
+        if (bInfinite)
         {
-            m_stepAngle = m_endAngle > m_startAngle ? 1 : -1;
+            m_angleTween.SetRepeat(Tween::Repeat::Loop);
         }
-        m_animationLoop = bInfinite;
-        if (!active)
+
+        if (clock.IsAnimating(m_animationId) && stopAngle != startAngle)
         {
-            m_animationTimer = SetTimer(m_hWnd, 1, 10, NULL);
-            SetAngle(m_startAngle);
+            // Already spinning, carry on from the current angle instead of jumping back
+            double progress = (double)(m_iconAngle - startAngle) / (stopAngle - startAngle);
+            m_angleTween.Start(now - std::clamp(progress, 0.0, 1.0) * duration);
+            return;
         }
+
+        m_angleTween.Start(now);
+        m_animationId = clock.Add(m_hWnd, [this](double frameTime) { return OnAnimationFrame(frameTime); });
+        SetAngle(startAngle);
     }
 
     void Button::CompleteAnimation()
     {
-        m_animationLoop = false;
+        m_angleTween.StopRepeating(AnyFSE::Tools::AnimationClock::Instance().Now());
     }
 
     void Button::CancelAnimation(int endAngle)
     {
-        KillTimer(m_hWnd, m_animationTimer);
-        m_animationTimer = 0;
+        AnyFSE::Tools::AnimationClock::Instance().Remove(m_animationId);
+        m_animationId = 0;
         SetAngle(endAngle);
     }
 
-    LRESULT Button::OnTimer(UINT timerId)
+    bool Button::OnAnimationFrame(double now)
     {
-        if (timerId != 1)
-            return 0;
+        if (m_angleTween.IsFinished(now))
+        {
+            m_animationId = 0;
+            SetAngle((int)m_angleTween.To());
+            return false;
+        }
 
-        int nextAngle = m_iconAngle + m_stepAngle;
-        if ( (m_endAngle > m_startAngle && nextAngle >= m_endAngle)
-            || (m_endAngle < m_startAngle && nextAngle <= m_endAngle))
+        int angle = (int)std::lround(m_angleTween.Value(now));
+        if (angle != m_iconAngle)
         {
-            if (!m_animationLoop)
-            {
-                CancelAnimation(m_endAngle);
-                return 0;
-            }
-            else
-            {
-                nextAngle = m_startAngle;
-            }
+            SetAngle(angle);
         }
-        SetAngle(nextAngle);
-        return 0;
+        return true;
     }
 
     LRESULT Button::ButtonSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData)
@@ -387,8 +374,6 @@ namespace FluentDesign
                     return TRUE;
                 }
                 break;
-            case WM_TIMER:
-                return This->OnTimer((UINT)wParam);
             case WM_MOUSEMOVE:
             case WM_MOUSELEAVE:
             case WM_LBUTTONDOWN:
@@ -488,18 +473,18 @@ namespace FluentDesign
         RectF br = gdiRect;
         br.Inflate(-m_theme.DpiScaleF(1), -m_theme.DpiScaleF(1));
 
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+
         // Determine colors based on state
-        Color borderColor(m_theme.GetColor(
+        Theme::Colors borderColor =
                 pressed ? Theme::Colors::ButtonBorderPressed
             : m_buttonMouseOver ? Theme::Colors::ButtonBorderHover
-                                : Theme::Colors::ButtonBorder
-        ));
+                                : Theme::Colors::ButtonBorder;
 
-        Color backColor(m_theme.GetColor(
+        Theme::Colors backColor =
                 pressed ? m_backgroundPressedColor
             : m_buttonMouseOver ? m_backgroundHoverColor
-                                : m_backgroundNormalColor
-        ));
+                                : m_backgroundNormalColor;
 
         if (m_bFlat)
         {
@@ -514,58 +499,42 @@ namespace FluentDesign
         if (!m_bFlat || pressed || m_buttonMouseOver)
         {
             // Draw outer rounded rectangle (track)
-            Pen borderPen(borderColor, (REAL)m_theme.DpiScale(1));
-            SolidBrush backBrush(backColor);
+            const Pen *borderPen = palette->Pen(borderColor, Palette::PenWidth::ThinWhole);
+            const SolidBrush *backBrush = palette->Brush(backColor);
 
             // For rounded rectangles in GDI+, we need to use GraphicsPath
             if (m_bSquare && !(m_bFlat && focused && m_buttonMouseOver && m_theme.IsKeyboardFocused()))
             {
-                graphics.FillRectangle(&backBrush, br);
+                graphics.FillRectangle(backBrush, br);
                 if (!m_bFlat)
                 {
-                    graphics.DrawRectangle(&borderPen, br);
+                    graphics.DrawRectangle(borderPen, br);
                 }
             }
             else
             {
-                Gdiplus::RoundRect(graphics, br, m_theme.DpiScaleF(m_cornerRadius), &backBrush, borderPen);
+                Gdiplus::RoundRect(graphics, br, m_theme.DpiScaleF(m_cornerRadius), backBrush, *borderPen);
             }
         }
 
-        Font textFont(hdc, m_theme.GetFont_Text());
-        Font iconFont(hdc, m_isSmallIcon ? m_theme.GetFont_Glyph() : m_theme.GetFont_GlyphNormal());
+        const Font *textFont = palette->Font(Palette::Fonts::Text);
+        const Font *iconFont = palette->Font(m_isSmallIcon ? Palette::Fonts::Glyph : Palette::Fonts::GlyphNormal);
 
-        Color textColor(m_theme.GetColor(
+        const SolidBrush *textBrush = palette->Brush(
             ! enabled           ? Theme::Colors::TextDisabled
             : pressed           ? m_textPressedColor
             : m_buttonMouseOver ? m_textHoverColor
                                 : m_textNormalColor
-        ));
+        );
 
-        SolidBrush textBrush(textColor);
         br = gdiRect;
         br.Inflate(-m_theme.DpiScaleF(1), -m_theme.DpiScaleF(1));
-        StringFormat format;
         long align = GetWindowLong(m_hWnd, GWL_STYLE) & BS_CENTER;
-        format.SetAlignment(align == BS_LEFT ? StringAlignmentNear : align == BS_RIGHT ? StringAlignmentFar : StringAlignmentCenter);
-        format.SetLineAlignment(StringAlignmentCenter);
-        format.SetTrimming(StringTrimmingNone);
-        format.SetFormatFlags(StringFormatFlagsNoWrap);
-
-        RectF measureBounds;
-        measureBounds.Width = 100000;
-        measureBounds.Height = 100000;
+        const StringFormat *format = palette->Format(align == BS_LEFT ? StringAlignmentNear : align == BS_RIGHT ? StringAlignmentFar : StringAlignmentCenter, true);
 
         RectF textRect{};
         RectF iconRect{};
-        if (!m_text.empty())
-        {
-            graphics.MeasureString(m_text.c_str(), -1, &textFont, measureBounds, &format, &textRect);
-        }
-        if (!m_icon.empty())
-        {
-            graphics.MeasureString(m_icon.c_str(), -1, &iconFont, measureBounds, &format, &iconRect);
-        }
+        MeasureContent(graphics, palette, format, textRect, iconRect);
 
         const float spacing = (!m_text.empty() && !m_icon.empty()) ? m_theme.DpiScaleF(6.0f) : 0.0f;
         const float contentWidth = iconRect.Width + spacing + textRect.Width;
@@ -585,16 +554,27 @@ namespace FluentDesign
             iconDraw.X = x;
             iconDraw.Width = iconRect.Width;
 
+            const float cx = iconDraw.X + iconDraw.Width / 2.0f;
+            const float cy = iconDraw.Y + iconDraw.Height / 2.0f;
+
+            // Any rotation of the glyph stays within the circle around its measured box
+            const float radius = std::sqrt(iconRect.Width * iconRect.Width + iconRect.Height * iconRect.Height) / 2.0f;
+            m_iconRect =
+            {
+                (LONG)std::floor(cx - radius) - 1,
+                (LONG)std::floor(cy - radius) - 1,
+                (LONG)std::ceil(cx + radius) + 1,
+                (LONG)std::ceil(cy + radius) + 1
+            };
+
             if (m_iconAngle)
             {
-                const float cx = iconDraw.X + iconDraw.Width / 2.0f;
-                const float cy = iconDraw.Y + iconDraw.Height / 2.0f;
                 graphics.TranslateTransform(cx, cy);
                 graphics.RotateTransform((REAL)m_iconAngle);
                 iconDraw.X -= cx;
                 iconDraw.Y -= cy;
             }
-            graphics.DrawString(m_icon.c_str(), -1, &iconFont, iconDraw, &format, &textBrush);
+            graphics.DrawString(m_icon.c_str(), -1, iconFont, iconDraw, format, textBrush);
             graphics.ResetTransform();
             x += iconRect.Width + spacing;
         }
@@ -604,12 +584,46 @@ namespace FluentDesign
             RectF textDraw = br;
             textDraw.X = x;
             textDraw.Width = textRect.Width;
-            graphics.DrawString(m_text.c_str(), -1, &textFont, textDraw, &format, &textBrush);
+            graphics.DrawString(m_text.c_str(), -1, textFont, textDraw, format, textBrush);
         }
         graphics.ResetTransform();
 
         return;
     }
+    void Button::MeasureContent(Graphics &graphics, const std::shared_ptr<const Palette> &palette,
+        const StringFormat *format, RectF &textRect, RectF &iconRect)
+    {
+        // The weak pointer tells a rebuilt palette apart even if it got the old address
+        bool samePalette = !m_extentsPalette.expired()
+            && !m_extentsPalette.owner_before(palette) && !palette.owner_before(m_extentsPalette);
+
+        if (!m_extentsValid || !samePalette)
+        {
+            const Font *textFont = palette->Font(Palette::Fonts::Text);
+            const Font *iconFont = palette->Font(m_isSmallIcon ? Palette::Fonts::Glyph : Palette::Fonts::GlyphNormal);
+
+            RectF bounds;
+            bounds.Width = 100000;
+            bounds.Height = 100000;
+
+            m_textExtent = RectF{};
+            m_iconExtent = RectF{};
+            if (!m_text.empty())
+            {
+                graphics.MeasureString(m_text.c_str(), -1, textFont, bounds, format, &m_textExtent);
+            }
+            if (!m_icon.empty())
+            {
+                graphics.MeasureString(m_icon.c_str(), -1, iconFont, bounds, format, &m_iconExtent);
+            }
+            m_extentsPalette = palette;
+            m_extentsValid = true;
+        }
+
+        textRect = m_textExtent;
+        iconRect = m_iconExtent;
+    }
+
     void Button::UpdateLayout()
     {
         SetWindowPos(m_hWnd, 0, 0, 0,
@@ -29,6 +29,7 @@
 #include <string>
 #include <functional>
 #include "Tools/Event.hpp"
+#include "Tools/Tween.hpp"
 #include "Theme.hpp"
 #include "Popup.hpp"
 #include "FluentControl.hpp"
@@ -43,11 +44,9 @@ namespace FluentDesign
         int m_designHeight = 0;
 
         int m_iconAngle;
-        int m_startAngle;
-        int m_endAngle;
-        int m_stepAngle;
-        UINT_PTR m_animationTimer;
-        bool m_animationLoop;
+        AnyFSE::Tools::Tween m_angleTween;
+        UINT m_animationId;
+        RECT m_iconRect;        // bounds of the rotated icon, all a spinning frame repaints
 
         bool m_buttonMouseOver;
         bool m_bFlat;
@@ -70,7 +69,16 @@ namespace FluentDesign
         std::wstring m_icon;
         std::wstring m_text;
 
-        LRESULT OnTimer(UINT timerId);
+        // Measured text and icon boxes, kept until either of them or the palette fonts change
+        std::weak_ptr<const Palette> m_extentsPalette;
+        Gdiplus::RectF m_textExtent;
+        Gdiplus::RectF m_iconExtent;
+        bool m_extentsValid = false;
+
+        void MeasureContent(Gdiplus::Graphics &graphics, const std::shared_ptr<const Palette> &palette,
+            const Gdiplus::StringFormat *format, Gdiplus::RectF &textRect, Gdiplus::RectF &iconRect);
+
+        bool OnAnimationFrame(double now);
 
         static LRESULT CALLBACK ButtonSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
                                                    UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
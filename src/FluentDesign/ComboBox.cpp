@@ -25,11 +25,14 @@
 #include <windows.h>
 #include <string>
 #include <functional>
+#include <algorithm>
 #include <Uxtheme.h>
 #include "ComboBox.hpp"
-#include "Tools/Icon.hpp"
+#include "Tools/IconLoader.hpp"
+#include "Tools/AnimationClock.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 
 namespace FluentDesign
 {
@@ -82,6 +85,8 @@ namespace FluentDesign
 
     ComboBox::~ComboBox()
     {
+        CancelIconRequests();
+        AnyFSE::Tools::AnimationClock::Instance().Remove(m_iconAnimationId);
         ImageList_RemoveAll(m_hImageList);
         ImageList_Destroy(m_hImageList);
         m_popup.Hide();
@@ -97,24 +102,159 @@ namespace FluentDesign
         ComboItem &cb = *(m_comboItems.insert(pos != -1 ? m_comboItems.begin() + pos : m_comboItems.end(), ComboItem{name, icon, value, -1}));
 
         cb.iconIndex = -1;
-        if (icon[0] < 0xE001)
+        if (IsFileIcon(cb.icon))
         {
-            HICON hIcon = Icon::LoadIcon(cb.icon, 32);
-            cb.iconIndex = hIcon ? ImageList_AddIcon(m_hImageList, hIcon) : -1;
+            RequestIcon(cb);
         }
 
         InvalidateRect(m_hWnd, NULL, FALSE);
         return pos == -1 ? (int)m_comboItems.size() : pos;
     }
 
+    void ComboBox::RequestIcon(ComboItem &item)
+    {
+        AnyFSE::Tools::IconLoader &loader = AnyFSE::Tools::IconLoader::Instance();
+        loader.Cancel(item.iconRequest);
+
+        item.iconRequest = loader.Request(item.icon, 32, [this](UINT request, HICON hIcon) { OnIconLoaded(request, hIcon); });
+    }
+
+    void ComboBox::CancelIconRequests()
+    {
+        for (auto &item : m_comboItems)
+        {
+            AnyFSE::Tools::IconLoader::Instance().Cancel(item.iconRequest);
+            item.iconRequest = 0;
+        }
+    }
+
+    void ComboBox::OnIconLoaded(UINT request, HICON hIcon)
+    {
+        using namespace AnyFSE::Tools;
+
+        auto item = std::find_if(m_comboItems.begin(), m_comboItems.end(),
+            [request](const ComboItem &item) { return item.iconRequest == request; });
+        if (item == m_comboItems.end())
+        {
+            if (hIcon)
+            {
+                DestroyIcon(hIcon);
+            }
+            return;
+        }
+
+        item->iconRequest = 0;
+        if (!hIcon)
+        {
+            return;
+        }
+
+        // The image list keeps its own copy, a refreshed icon replaces the old one in place
+        int index = item->iconIndex;
+        if (index == -1 && !m_freeImages.empty())
+        {
+            index = m_freeImages.back();
+            m_freeImages.pop_back();
+        }
+        item->iconIndex = index != -1 ? ImageList_ReplaceIcon(m_hImageList, index, hIcon)
+                                      : ImageList_AddIcon(m_hImageList, hIcon);
+        DestroyIcon(hIcon);
+
+        AnimationClock &clock = AnimationClock::Instance();
+        item->iconFade = Tween(0, 255, Layout_IconFadeMs, Easing::OutCubic);
+        item->iconFade.Start(clock.Now());
+        if (!clock.IsAnimating(m_iconAnimationId))
+        {
+            m_iconAnimationId = clock.Add(m_hWnd, [this](double now) { return OnIconFadeFrame(now); });
+        }
+        InvalidateItems();
+    }
+
+    bool ComboBox::OnIconFadeFrame(double now)
+    {
+        InvalidateItems();
+
+        bool fading = std::any_of(m_comboItems.begin(), m_comboItems.end(),
+            [now](const ComboItem &item) { return item.iconFade.IsStarted() && !item.iconFade.IsFinished(now); });
+        if (!fading)
+        {
+            m_iconAnimationId = 0;
+        }
+        return fading;
+    }
+
+    void ComboBox::InvalidateItems()
+    {
+        InvalidateRect(m_hWnd, NULL, FALSE);
+        if (HWND hPopup = m_popup.GetHwnd())
+        {
+            InvalidateRect(hPopup, NULL, FALSE);
+        }
+    }
+
     int ComboBox::Reset()
     {
+        CancelIconRequests();
         m_comboItems.clear();
+        m_freeImages.clear();
         ImageList_RemoveAll(m_hImageList);
         InvalidateRect(m_hWnd, NULL, FALSE);
         return 0;
     }
 
+    void ComboBox::SetItems(const std::vector<Item> &items, const std::set<std::wstring> &refresh)
+    {
+        std::vector<ComboItem> previous = std::move(m_comboItems);
+        std::vector<bool> kept(previous.size(), false);
+
+        m_comboItems.clear();
+        m_comboItems.reserve(items.size());
+        for (const Item &item : items)
+        {
+            auto old = std::find_if(previous.begin(), previous.end(), [&](const ComboItem &row)
+            {
+                return !kept[&row - previous.data()] && row.value == item.value && row.icon == item.icon;
+            });
+
+            if (old != previous.end())
+            {
+                kept[old - previous.begin()] = true;
+                m_comboItems.push_back(std::move(*old));
+                m_comboItems.back().name = item.name;
+                if (IsFileIcon(item.icon) && refresh.count(item.value))
+                {
+                    RequestIcon(m_comboItems.back());
+                }
+            }
+            else
+            {
+                m_comboItems.push_back(ComboItem{ item.name, item.icon, item.value, -1 });
+                if (IsFileIcon(item.icon))
+                {
+                    RequestIcon(m_comboItems.back());
+                }
+            }
+        }
+
+        for (size_t i = 0; i < previous.size(); ++i)
+        {
+            if (!kept[i])
+            {
+                AnyFSE::Tools::IconLoader::Instance().Cancel(previous[i].iconRequest);
+                if (previous[i].iconIndex != -1)
+                {
+                    m_freeImages.push_back(previous[i].iconIndex);
+                }
+            }
+        }
+
+        if (m_selectedIndex >= (int)m_comboItems.size())
+        {
+            m_selectedIndex = (int)m_comboItems.size() - 1;
+        }
+        InvalidateItems();
+    }
+
     void ComboBox::SelectItem(int index)
     {
         if (index >=0 && index < m_comboItems.size())
@@ -285,19 +425,18 @@ namespace FluentDesign
             graphics.SetSmoothingMode(SmoothingModeAntiAlias);
 
             // Draw button background
-            Color color = m_theme.GetColor(
+            Theme::Colors color =
                   !enabled          ? Theme::Colors::ComboDisabled                       // TODO Disabled Color
                 : m_buttonPressed     ? Theme::Colors::ComboPressed
                 : m_buttonMouseOver   ? Theme::Colors::ComboHover
-                : Theme::Colors::Combo
-            );
+                : Theme::Colors::Combo;
 
             RectF clientRect = ToRectF(rect);
             clientRect.Height -= 1;
             clientRect.Width -= 1;
-            Pen pen(m_theme.GetColor(Theme::Colors::ComboBorder), m_theme.DpiScaleF(1));
-            SolidBrush brush(color);
-            Gdiplus::RoundRect(graphics, clientRect, (REAL)m_theme.GetSize_FocusCornerSize(), &brush, pen);
+            std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+            Gdiplus::RoundRect(graphics, clientRect, (REAL)m_theme.GetSize_FocusCornerSize(),
+                palette->Brush(color), *palette->Pen(Theme::Colors::ComboBorder));
             return;
     }
     void ComboBox::DrawComboItem(HWND hWnd, HDC hdc, RECT rect, int itemId)
@@ -322,7 +461,26 @@ namespace FluentDesign
         if (item.iconIndex != -1)
         {
             int imageY = rect.top + (rect.bottom - rect.top - m_theme.DpiScale(Layout_ImageSize)) / 2;
-            ImageList_Draw(m_hImageList, item.iconIndex, hdc, rect.left, imageY, ILD_NORMAL);
+
+            double now = AnyFSE::Tools::AnimationClock::Instance().Now();
+            if (item.iconFade.IsStarted() && !item.iconFade.IsFinished(now))
+            {
+                IMAGELISTDRAWPARAMS params = { sizeof(IMAGELISTDRAWPARAMS) };
+                params.himl = m_hImageList;
+                params.i = item.iconIndex;
+                params.hdcDst = hdc;
+                params.x = rect.left;
+                params.y = imageY;
+                params.rgbBk = CLR_NONE;
+                params.fStyle = ILD_NORMAL;
+                params.fState = ILS_ALPHA;
+                params.Frame = (DWORD)item.iconFade.Value(now);
+                ImageList_DrawIndirect(&params);
+            }
+            else
+            {
+                ImageList_Draw(m_hImageList, item.iconIndex, hdc, rect.left, imageY, ILD_NORMAL);
+            }
             rect.left += m_theme.DpiScale(Layout_ImageSize + Layout_IconMargin);
         }
         else
@@ -334,7 +492,9 @@ namespace FluentDesign
 
                 (HFONT)SelectObject(hdc, m_theme.GetFont_GlyphNormal());
 
-                ::DrawText(hdc, item.icon.c_str(), -1, &glyphRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+                // Placeholder while the icon loads, or for good if it could not be loaded
+                std::wstring glyph = IsFileIcon(item.icon) ? std::wstring(1, Glyph_IconLoading) : item.icon;
+                ::DrawText(hdc, glyph.c_str(), -1, &glyphRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
                 (HFONT) SelectObject(hdc, m_theme.GetFont_Text());
                 rect.left += m_theme.DpiScale(Layout_ImageSize + Layout_IconMargin);
             }
@@ -417,6 +577,7 @@ namespace FluentDesign
 
         ImageList_RemoveAll(m_hImageList);
         ImageList_Destroy(m_hImageList);
+        m_freeImages.clear();
 
         m_hImageList = ImageList_Create(
             m_theme.DpiScale(Layout_ImageSize), m_theme.DpiScale(Layout_ImageSize),
@@ -424,10 +585,10 @@ namespace FluentDesign
 
         for(auto& item: m_comboItems)
         {
-            if (item.iconIndex != -1 && !item.icon.empty())
+            item.iconIndex = -1;
+            if (IsFileIcon(item.icon))
             {
-                HICON hIcon = Icon::LoadIcon(item.icon, 32);
-                item.iconIndex = hIcon ? ImageList_AddIcon(m_hImageList, hIcon) : -1;
+                RequestIcon(item);
             }
         }
     }
@@ -28,7 +28,10 @@
 #include <commctrl.h>
 #include <string>
 #include <functional>
+#include <set>
+#include <vector>
 #include "Tools/Event.hpp"
+#include "Tools/Tween.hpp"
 #include "Theme.hpp"
 #include "FluentControl.hpp"
 #include "Popup.hpp"
@@ -43,6 +46,8 @@ namespace FluentDesign
             std::wstring icon;
             std::wstring value;
             int iconIndex;
+            UINT iconRequest = 0;
+            AnyFSE::Tools::Tween iconFade;
         };
 
     private:
@@ -52,8 +57,12 @@ namespace FluentDesign
         static const int Layout_IconMargin = 8;
         static const int Layout_ChevronMargin = 16;
         static const int Layout_CornerRadius = 8;
+        static const int Layout_IconFadeMs = 200;
+        static const wchar_t Glyph_IconLoading = L'\xECAA';
 
         HIMAGELIST m_hImageList = NULL;
+        std::vector<int> m_freeImages;      // Slots of dropped items, reused before the list grows
+        UINT m_iconAnimationId = 0;
 
         std::vector<ComboItem> m_comboItems;
         Popup m_popup;
@@ -74,9 +83,24 @@ namespace FluentDesign
         void DrawComboChevron(HWND hWnd, HDC hdc, RECT rect);
         void HandleListClick(int index);
 
+        // File and package icons load in the background, glyphs draw right away
+        static bool IsFileIcon(const std::wstring &icon) { return !icon.empty() && icon[0] < 0xE001; }
+        void RequestIcon(ComboItem &item);
+        void CancelIconRequests();
+        void OnIconLoaded(UINT request, HICON hIcon);
+        bool OnIconFadeFrame(double now);
+        void InvalidateItems();
+
         void UpdateLayout();
 
     public:
+        struct Item
+        {
+            std::wstring name;
+            std::wstring icon;
+            std::wstring value;
+        };
+
         ComboBox(Theme& theme);
         ComboBox(
             Theme& theme,
@@ -90,6 +114,9 @@ namespace FluentDesign
 
         int AddItem(const std::wstring &name, const std::wstring &icon, const std::wstring &value, int pos = -1);
         int Reset();
+
+        // Replaces the items keeping the loaded icons of rows that stay, icons of values in refresh load again
+        void SetItems(const std::vector<Item> &items, const std::set<std::wstring> &refresh = {});
         void SelectItem(int index);
         void SelectItem(const std::wstring &value);
         std::wstring GetCurentValue();
@@ -1,6 +1,7 @@
 #include "Dialog.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/Window.hpp"
+#include "Palette.hpp"
 
 namespace FluentDesign
 {
@@ -53,15 +54,14 @@ namespace FluentDesign
         RectF panelRect = rect;
         panelRect.Height = rect.Height - m_theme.DpiScaleF(GetFooterDesignHeight()) + 1;
 
-        SolidBrush panelBrush(m_theme.GetColor(GetDialogColor()));
-        graphics.FillRectangle(&panelBrush, panelRect);
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+        graphics.FillRectangle(palette->Brush(GetDialogColor()), panelRect);
 
         RectF footerRect = rect;
         footerRect.Y = panelRect.GetBottom() - 1;
         footerRect.Height = m_theme.DpiScaleF(GetFooterDesignHeight());
 
-        SolidBrush footerBrush(m_theme.GetColor(GetFooterColor()));
-        graphics.FillRectangle(&footerBrush, footerRect);
+        graphics.FillRectangle(palette->Brush(GetFooterColor()), footerRect);
 
         for (auto &a : m_designedPositions)
         {
@@ -143,17 +143,14 @@ namespace FluentDesign
 
         RECT parentRECT;
         m_getParentRect(m_theme, GetParent(m_hWnd), &parentRECT);
-        Gdiplus::RectF parentRect = m_theme.DpiUnscaleF(parentRECT);
-
-        float l, t, r, b = 0.f;
 
-        l = m_designMargins.Left    + Align::HSide(Align::LeftSide(m_anchor), parentRect, 0 );
-        t = m_designMargins.Top     + Align::VSide(Align::TopSide(m_anchor), parentRect, 0 );
-        r = m_designMargins.Right   + Align::HSide(Align::RightSide(m_anchor), parentRect, l );
-        b = m_designMargins.Bottom  + Align::VSide(Align::BottomSide(m_anchor), parentRect, t );
+        ULONG dpi = m_theme.GetDpi();
+        AnchorLayout::Box parentBox = AnchorLayout::Unscale(
+            AnchorLayout::Rect{ parentRECT.left, parentRECT.top, parentRECT.right, parentRECT.bottom }, dpi);
+        AnchorLayout::Margins margins{ m_designMargins.Left, m_designMargins.Top, m_designMargins.Right, m_designMargins.Bottom };
 
-        Gdiplus::RectF controlRect(l, t, r - l, b - t);
-        RECT controlRECT = m_theme.DpiScale(controlRect);
+        AnchorLayout::Rect rect = AnchorLayout::Scale(AnchorLayout::Place(m_anchor, margins, parentBox), dpi);
+        RECT controlRECT{ rect.left, rect.top, rect.right, rect.bottom };
         if (!hdwp)
         {
             Window::MoveWindow(m_hWnd, &controlRECT, FALSE);
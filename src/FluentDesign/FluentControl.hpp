@@ -47,6 +47,9 @@ namespace FluentDesign
 
         public:
             HWND GetHwnd() const { return m_hWnd; }
+            Align::Anchor GetAnchor() const { return m_anchor; }
+            GetParentRectFunc GetParentRectFunction() const { return m_getParentRect; }
+            const Align::Margins &GetDesignMargins() const { return m_designMargins; }
             Event OnClick;
 
             void SetAnchor(Align::Anchor anchor, GetParentRectFunc getParentRect = GetParentRect);
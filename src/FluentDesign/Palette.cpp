@@ -0,0 +1,134 @@
+#include "Palette.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace FluentDesign
+{
+    static Logger log = LogManager::GetLogger("Palette");
+
+    std::atomic<unsigned long long> Palette::m_created{0};
+    std::atomic<unsigned long long> Palette::m_borrowed{0};
+    std::atomic<ULONGLONG> Palette::m_reportTick{0};
+
+    static const ULONGLONG ReportInterval = 10000;
+
+    Palette::Palette(Theme &theme)
+    {
+        using namespace Gdiplus;
+
+        const REAL widths[PenCount] =
+        {
+            0.0f,
+            0.5f,
+            1.0f,
+            theme.DpiScaleF(1),
+            (REAL)theme.DpiScale(1),
+            (REAL)theme.GetSize_FocusWidth()
+        };
+
+        for (int color = 0; color < ColorCount; ++color)
+        {
+            Color argb(theme.GetColor((Theme::Colors)color));
+            m_brushes[color] = std::make_unique<SolidBrush>(argb);
+            for (int width = 0; width < PenCount; ++width)
+            {
+                m_pens[color][width] = std::make_unique<Gdiplus::Pen>(argb, widths[width]);
+            }
+        }
+
+        const HFONT fonts[FontCount] =
+        {
+            theme.GetFont_Text(),
+            theme.GetFont_TextBold(),
+            theme.GetFont_TextSecondary(),
+            theme.GetFont_TextLarge(),
+            theme.GetFont_Glyph(),
+            theme.GetFont_GlyphNormal(),
+            theme.GetFont_Title(),
+            theme.GetFont_Icon()
+        };
+
+        HDC hdc = GetDC(NULL);
+        for (int font = 0; font < FontCount; ++font)
+        {
+            m_fonts[font] = std::make_unique<Gdiplus::Font>(hdc, fonts[font]);
+        }
+        ReleaseDC(NULL, hdc);
+
+        const StringAlignment alignments[3] = { StringAlignmentNear, StringAlignmentCenter, StringAlignmentFar };
+        for (int format = 0; format < FormatCount; ++format)
+        {
+            m_formats[format] = std::make_unique<StringFormat>();
+            m_formats[format]->SetAlignment(alignments[format % 3]);
+            m_formats[format]->SetLineAlignment(StringAlignmentCenter);
+            if (format >= 3)
+            {
+                m_formats[format]->SetTrimming(StringTrimmingNone);
+                m_formats[format]->SetFormatFlags(StringFormatFlagsNoWrap);
+            }
+        }
+
+        m_created += ColorCount * (1 + PenCount) + FontCount + FormatCount;
+    }
+
+    int Palette::ColorIndex(Theme::Colors color)
+    {
+        return (color > Theme::Colors::Transparent && color < Theme::Colors::Max)
+            ? (int)color
+            : (int)Theme::Colors::Transparent;
+    }
+
+    const Gdiplus::SolidBrush *Palette::Brush(Theme::Colors color) const
+    {
+        CountBorrow();
+        return m_brushes[ColorIndex(color)].get();
+    }
+
+    const Gdiplus::Pen *Palette::Pen(Theme::Colors color, PenWidth width) const
+    {
+        CountBorrow();
+        return m_pens[ColorIndex(color)][(int)width].get();
+    }
+
+    const Gdiplus::Font *Palette::Font(Fonts font) const
+    {
+        CountBorrow();
+        return m_fonts[(int)font].get();
+    }
+
+    const Gdiplus::StringFormat *Palette::Format(Gdiplus::StringAlignment align, bool noWrap) const
+    {
+        CountBorrow();
+        return m_formats[(int)align + (noWrap ? 3 : 0)].get();
+    }
+
+    Palette::Counters Palette::GetCounters()
+    {
+        return Counters { m_created.load(), m_borrowed.load() };
+    }
+
+    void Palette::CountBorrow()
+    {
+        // Every borrow is a GDI+ object the painter used to construct and destroy itself
+        unsigned long long borrowed = ++m_borrowed;
+
+        ULONGLONG now = GetTickCount64();
+        ULONGLONG last = m_reportTick.load();
+        if (last == 0)
+        {
+            m_reportTick.compare_exchange_strong(last, now);
+        }
+        else if (now - last >= ReportInterval && m_reportTick.compare_exchange_strong(last, now))
+        {
+            static unsigned long long lastBorrowed = 0;
+            static unsigned long long lastCreated = 0;
+            unsigned long long created = m_created.load();
+            double seconds = (now - last) / 1000.0;
+
+            log.Debug("GDI+ objects per second: %.1f created (palette), %.1f borrowed (were created per paint)",
+                (created - lastCreated) / seconds, (borrowed - lastBorrowed) / seconds);
+
+            lastCreated = created;
+            lastBorrowed = borrowed;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <windows.h>
+#include "Tools/GdiPlus.hpp"
+#include "Theme.hpp"
+
+namespace FluentDesign
+{
+    // GDI+ brushes, pens, fonts and string formats for the current theme colors and DPI.
+    // Built by Theme on first use and replaced as a whole on accent, theme or DPI change,
+    // painters borrow the objects instead of constructing their own on every paint.
+    class Palette
+    {
+    public:
+        enum class Fonts
+        {
+            Text,
+            TextBold,
+            TextSecondary,
+            TextLarge,
+            Glyph,
+            GlyphNormal,
+            Title,
+            Icon,
+
+            Max
+        };
+
+        enum class PenWidth
+        {
+            Device,     // 0, always one device pixel
+            Half,       // 0.5 px
+            One,        // 1 px, not scaled
+            Thin,       // 1 px scaled to DPI
+            ThinWhole,  // 1 px scaled to DPI, rounded to whole pixels
+            Focus,      // focus frame width
+
+            Max
+        };
+
+        struct Counters
+        {
+            unsigned long long created;
+            unsigned long long borrowed;
+        };
+
+        Palette(Theme &theme);
+
+        const Gdiplus::SolidBrush *Brush(Theme::Colors color) const;
+        const Gdiplus::Pen *Pen(Theme::Colors color, PenWidth width = PenWidth::Thin) const;
+        const Gdiplus::Font *Font(Fonts font) const;
+
+        // Vertically centered format with the given horizontal alignment
+        const Gdiplus::StringFormat *Format(Gdiplus::StringAlignment align, bool noWrap = false) const;
+
+        static Counters GetCounters();
+
+    private:
+        static const int ColorCount = Theme::Colors::Max;
+        static const int PenCount = (int)PenWidth::Max;
+        static const int FontCount = (int)Fonts::Max;
+        static const int FormatCount = 6;
+
+        std::unique_ptr<Gdiplus::SolidBrush> m_brushes[ColorCount];
+        std::unique_ptr<Gdiplus::Pen> m_pens[ColorCount][PenCount];
+        std::unique_ptr<Gdiplus::Font> m_fonts[FontCount];
+        std::unique_ptr<Gdiplus::StringFormat> m_formats[FormatCount];
+
+        static std::atomic<unsigned long long> m_created;
+        static std::atomic<unsigned long long> m_borrowed;
+        static std::atomic<ULONGLONG> m_reportTick;
+
+        static int ColorIndex(Theme::Colors color);
+        static void CountBorrow();
+    };
+}
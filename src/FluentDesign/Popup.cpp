@@ -30,6 +30,7 @@
 #include "Popup.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 #include "Popup.hpp"
 
 namespace FluentDesign
@@ -132,12 +133,13 @@ namespace FluentDesign
         HBRUSH hNilBrush = CreateSolidBrush(RGB(0,0,0));
         FillRect(hdc, &rect, hNilBrush);
 
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+
         RectF rectF = ToRectF(rect);
         rectF.Inflate(-m_theme.DpiScaleF(1), -m_theme.DpiScaleF(1));
-        Pen borderPen(m_theme.GetColor(Theme::Colors::ComboPopupBorder), m_theme.DpiScaleF(1));
-        SolidBrush bgBrush(m_theme.GetColor(Theme::Colors::ComboPopup));
 
-        RoundRect(Graphics(hdc), rectF, (float)m_theme.GetSize_Corner(), &bgBrush, borderPen);
+        RoundRect(Graphics(hdc), rectF, (float)m_theme.GetSize_Corner(),
+            palette->Brush(Theme::Colors::ComboPopup), *palette->Pen(Theme::Colors::ComboPopupBorder));
 
         if (m_nPopupContentHeight > m_nPopupViewHeight)
         {
@@ -151,11 +153,10 @@ namespace FluentDesign
             rect.bottom = rect.top + thumbHeight;
 
             RectF rectF = ToRectF(rect);
-            DWORD color = m_theme.GetColor(false ? Theme::Colors::ScrollThumb : Theme::Colors::ScrollThumbStroke);
-            SolidBrush thumbBrush(color);
-            Pen thumbPen(color, 0.5);
+            Theme::Colors color = false ? Theme::Colors::ScrollThumb : Theme::Colors::ScrollThumbStroke;
 
-            RoundRect(Graphics(hdc), rectF, rectF.Width, &thumbBrush, thumbPen);
+            RoundRect(Graphics(hdc), rectF, rectF.Width,
+                palette->Brush(color), *palette->Pen(color, Palette::PenWidth::Half));
 
         }
     }
@@ -170,25 +171,25 @@ namespace FluentDesign
         RectF backgroundRect = ToRectF(itemRect);
         backgroundRect.Inflate(m_theme.DpiScaleF(-Layout_LeftMargin/4), m_theme.DpiScaleF(-2));
 
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+
         if ( itemId == m_hoveredIndex || itemId == m_selectedIndex)
         {
-            Color color = m_theme.GetColor(
+            Theme::Colors color =
                 itemId == m_hoveredIndex
                     ? Theme::Colors::ComboPopupHover
-                    : Theme::Colors::ComboPopupSelected);
-            SolidBrush hoverBrush(color);
-            Pen borserPen(color, 1);
-            Gdiplus::RoundRect(graphics, backgroundRect, (float)m_theme.GetSize_Corner(), &hoverBrush, borserPen);
+                    : Theme::Colors::ComboPopupSelected;
+            Gdiplus::RoundRect(graphics, backgroundRect, (float)m_theme.GetSize_Corner(),
+                palette->Brush(color), *palette->Pen(color, Palette::PenWidth::One));
         }
         if (itemId == m_selectedIndex)
         {
-            SolidBrush gripBrush(m_theme.GetColor(Theme::Colors::ComboPopupSelectedMark));
             RectF gripRect = backgroundRect;
             gripRect.X += 2;
             gripRect.Width = m_theme.DpiScaleF(3);
             gripRect.Y += (gripRect.Height - m_theme.DpiScale(16)) / 2;
             gripRect.Height = m_theme.DpiScaleF(16);
-            graphics.FillRectangle(&gripBrush, gripRect);
+            graphics.FillRectangle(palette->Brush(Theme::Colors::ComboPopupSelectedMark), gripRect);
         }
     }
     void Popup::DrawPopupItem(HWND hWnd, HDC hdc, RECT itemRect, int itemId)
@@ -216,26 +217,23 @@ namespace FluentDesign
             return;
         }
 
-        SolidBrush textBrush(Color(m_theme.GetColor(Theme::Colors::Text)));
-        StringFormat format;
-        format.SetAlignment(StringAlignmentCenter);
-        format.SetLineAlignment(StringAlignmentCenter);
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+        const SolidBrush *textBrush = palette->Brush(Theme::Colors::Text);
 
         if (!pItem->icon.empty())
         {
             RectF iconRect = rectF;
             iconRect.Width = m_theme.DpiScaleF(Layout_ImageSize);
             iconRect.Y += m_theme.DpiScaleF(2);
-            Font font(hdc, m_theme.GetFont_GlyphNormal());
 
-            graphics.DrawString(pItem->icon.c_str(), -1, &font, iconRect, &format, &textBrush);
+            graphics.DrawString(pItem->icon.c_str(), -1, palette->Font(Palette::Fonts::GlyphNormal), iconRect,
+                palette->Format(StringAlignmentCenter), textBrush);
             rectF.X += m_theme.DpiScaleF(Layout_ImageSize + Layout_IconMargin);
             rectF.Width -= m_theme.DpiScaleF(Layout_ImageSize + Layout_IconMargin);
         }
-        format.SetAlignment(StringAlignmentNear);
 
-        Font font(hdc, m_theme.GetFont_Text());
-        graphics.DrawString(pItem->name.c_str(), -1, &font, rectF, &format, &textBrush);
+        graphics.DrawString(pItem->name.c_str(), -1, palette->Font(Palette::Fonts::Text), rectF,
+            palette->Format(StringAlignmentNear), textBrush);
     }
 
     void Popup::OnPaint(HWND hWnd)
@@ -25,6 +25,7 @@
 #include "ScrollView.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 #include "Tools/Window.hpp"
 
 namespace FluentDesign
@@ -181,24 +182,22 @@ namespace FluentDesign
         graphics.SetSmoothingMode(SmoothingModeAntiAlias);
 
         RectF rect = ToRectF(m_scrollBarRect);
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
 
         if (rect.Width > 0 && m_hovered)
         {
             //rect.Inflate(m_theme.DpiScaleF(-2), 0);
-            SolidBrush backBrush(m_theme.GetColor(Theme::Colors::ScrollTrack));
-            Pen thumbPen(m_theme.GetColor(Theme::Colors::ScrollTrack), 0.5);
-            RoundRect(graphics, rect, rect.Width, &backBrush, thumbPen);
+            RoundRect(graphics, rect, rect.Width,
+                palette->Brush(Theme::Colors::ScrollTrack), *palette->Pen(Theme::Colors::ScrollTrack, Palette::PenWidth::Half));
         }
 
         rect = ToRectF(m_thumbRect);
 
         if (rect.Width > 0)
         {
-            DWORD color = m_theme.GetColor(m_hovered ? Theme::Colors::ScrollThumb : Theme::Colors::ScrollThumbStroke);
-            SolidBrush thumbBrush(color);
-            Pen thumbPen(color, 0.5);
-
-            RoundRect(graphics, rect, rect.Width, &thumbBrush, thumbPen);
+            Theme::Colors color = m_hovered ? Theme::Colors::ScrollThumb : Theme::Colors::ScrollThumbStroke;
+            RoundRect(graphics, rect, rect.Width,
+                palette->Brush(color), *palette->Pen(color, Palette::PenWidth::Half));
         }
         return 0;
     }
@@ -207,6 +206,102 @@ namespace FluentDesign
     {
     }
 
+    static bool IsSelfVisible(HWND hWnd)
+    {
+        return (GetWindowLong(hWnd, GWL_STYLE) & WS_VISIBLE) != 0;
+    }
+
+    void ScrollView::OffsetVisibleChilds(int delta)
+    {
+        HDWP hdwp = BeginDeferWindowPos((int)(m_realizedRows.last - m_realizedRows.first) + 1);
+
+        for (HWND hChild = GetWindow(m_hWnd, GW_CHILD); hChild && hdwp; hChild = GetWindow(hChild, GW_HWNDNEXT))
+        {
+            if (IsSelfVisible(hChild))
+            {
+                RECT rc;
+                Window::GetChildRect(hChild, &rc);
+                hdwp = DeferWindowPos(hdwp, hChild, NULL, rc.left, rc.top + delta, 0, 0,
+                    SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOREDRAW);
+            }
+        }
+        if (hdwp)
+        {
+            EndDeferWindowPos(hdwp);
+        }
+    }
+
+    void ScrollView::SetVirtualRows(size_t count, MeasureRowFunc measure, RealizeRowFunc realize, ReleaseRowFunc release)
+    {
+        // Rows realized from a previous set are up to the caller, their indices mean nothing here
+        m_virtual = true;
+        m_measureRow = measure;
+        m_realizeRow = realize;
+        m_releaseRow = release;
+        m_realizedRows = VirtualRows::Range();
+
+        m_rows.Reset(count);
+        for (size_t row = 0; row < count; ++row)
+        {
+            m_rows.SetHeight(row, m_measureRow(row));
+        }
+
+        int scrollPos = m_scrollPos;
+        SetContentHeight(m_rows.ContentHeight());
+        if (m_scrollPos == scrollPos)
+        {
+            RealizeRows(true);
+        }
+    }
+
+    void ScrollView::RealizeRows(bool relayout)
+    {
+        if (!m_virtual || m_realizing)
+        {
+            return;
+        }
+        m_realizing = true;
+
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            // A view of overscan on both sides keeps focus navigation to the neighbour rows working
+            VirtualRows::Range range = m_rows.VisibleRange(m_scrollPos, m_viewHeight, m_viewHeight);
+
+            for (size_t row = m_realizedRows.first; row < m_realizedRows.last; ++row)
+            {
+                if (!range.Contains(row))
+                {
+                    m_releaseRow(row);
+                }
+            }
+
+            bool resized = false;
+            for (size_t row = range.first; row < range.last; ++row)
+            {
+                if (relayout || !m_realizedRows.Contains(row))
+                {
+                    resized |= m_rows.SetHeight(row, m_realizeRow(row, m_rows.Top(row) - m_scrollPos));
+                }
+            }
+            m_realizedRows = range;
+
+            if (!resized)
+            {
+                break;
+            }
+            // Measured height was off, the rows below have to follow
+            relayout = true;
+        }
+
+        m_realizing = false;
+
+        int contentHeight = m_rows.ContentHeight();
+        if (max(contentHeight, m_viewHeight) != m_contentHeight)
+        {
+            SetContentHeight(contentHeight);
+        }
+    }
+
     void ScrollView::CalculateRects()
     {
         RECT rcWindow;
@@ -320,8 +415,18 @@ namespace FluentDesign
             int delta = m_scrollPos - newPos;
             m_scrollPos = newPos;
 
-            // Scroll the window content
-            ScrollWindowEx(m_hWnd, 0, delta, NULL, NULL, NULL, NULL, SW_INVALIDATE | SW_SCROLLCHILDREN );
+            if (m_virtual)
+            {
+                // Hidden rows are not moved at all, the ones coming into view are placed on realize
+                ScrollWindowEx(m_hWnd, 0, delta, NULL, NULL, NULL, NULL, SW_INVALIDATE);
+                OffsetVisibleChilds(delta);
+                RealizeRows(false);
+            }
+            else
+            {
+                // Scroll the window content
+                ScrollWindowEx(m_hWnd, 0, delta, NULL, NULL, NULL, NULL, SW_INVALIDATE | SW_SCROLLCHILDREN );
+            }
             UpdateScrollBar();
             RedrawWindow(m_hWnd, NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
         }
@@ -381,12 +486,17 @@ namespace FluentDesign
         HWND hChild = GetWindow(m_hWnd, GW_CHILD);
         while (hChild)
         {
-            RECT rc;
-            GetClientRect(hChild, &rc);
-            SendMessage(hChild, WM_SIZE, 0, MAKELONG(rc.right - rc.left, rc.bottom - rc.top));
+            // Hidden rows of a virtual list get their layout when realized
+            if (!m_virtual || IsSelfVisible(hChild))
+            {
+                RECT rc;
+                GetClientRect(hChild, &rc);
+                SendMessage(hChild, WM_SIZE, 0, MAKELONG(rc.right - rc.left, rc.bottom - rc.top));
+            }
             hChild = GetWindow(hChild, GW_HWNDNEXT);
         }
         m_viewHeight = newHeight;
+        RealizeRows(false);
         UpdateScrollBar();
     }
 
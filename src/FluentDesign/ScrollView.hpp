@@ -31,11 +31,20 @@
 #include "Tools/Event.hpp"
 #include "Theme.hpp"
 #include "FluentControl.hpp"
+#include "VirtualRows.hpp"
 
 namespace FluentDesign
 {
     class ScrollView : public FluentControl
     {
+    public:
+        // Virtual list callbacks: height of a row without realizing it, show and place a row
+        // returning its actual height, hide a row that has left the view
+        typedef std::function<int(size_t row)> MeasureRowFunc;
+        typedef std::function<int(size_t row, int top)> RealizeRowFunc;
+        typedef std::function<void(size_t row)> ReleaseRowFunc;
+
+    private:
         static LRESULT CALLBACK ScrollViewSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
                                                        UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 
@@ -54,7 +63,17 @@ namespace FluentDesign
         int  m_panStartScrollPos = 0;
         POINT m_panStartPoint{};
 
+        bool m_virtual = false;
+        bool m_realizing = false;
+        VirtualRows m_rows;
+        VirtualRows::Range m_realizedRows;
+        MeasureRowFunc m_measureRow;
+        RealizeRowFunc m_realizeRow;
+        ReleaseRowFunc m_releaseRow;
+
         void SetOffset(int newOffset);
+        void OffsetVisibleChilds(int delta);
+        void RealizeRows(bool relayout);
 
         void CalculateRects();
         LRESULT OnPaint(HWND hWnd);
@@ -79,6 +98,12 @@ namespace FluentDesign
         void ScrollBy(int delta);
         int GetScrollPos() const;
 
+        // Only rows intersecting the view are realized, the rest are kept as heights
+        void SetVirtualRows(size_t count, MeasureRowFunc measure, RealizeRowFunc realize, ReleaseRowFunc release);
+        bool IsVirtual() const { return m_virtual; }
+        int GetRowTop(size_t row) { return m_rows.Top(row); }
+        VirtualRows::Range GetRealizedRows() const { return m_realizedRows; }
+
         ~ScrollView();
 
         void OnResize(int newWidth, int newHeight);
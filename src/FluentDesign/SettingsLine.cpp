@@ -26,10 +26,13 @@
 #include "Logging/LogManager.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 #include "Tools/List.hpp"
 #include "Tools/Window.hpp"
 #include "App/AppConstants.hpp"
 #include "Tools/Icon.hpp"
+#include "Tools/IconLoader.hpp"
+#include "Tools/AnimationClock.hpp"
 #include <filesystem>
 #include <commctrl.h>
 #include <uxtheme.h>
@@ -88,6 +91,8 @@ namespace FluentDesign
 
     SettingsLine::~SettingsLine()
     {
+        CancelIconRequest();
+        AnyFSE::Tools::AnimationClock::Instance().Remove(m_iconAnimationId);
         if (m_hIcon)
         {
             DestroyIcon(m_hIcon);
@@ -205,6 +210,18 @@ namespace FluentDesign
             OnEnable(wParam != 0);
             return 0;
 
+        case WM_SHOWWINDOW:
+            // Rows scrolled out of view drop their pending icon and ask again once realized
+            if (!wParam)
+            {
+                CancelIconRequest();
+            }
+            else if (!m_hIcon && !m_iconPath.empty())
+            {
+                RequestIcon();
+            }
+            break;
+
         case WM_ERASEBKGND:
             {
                 if(lParam)
@@ -270,17 +287,25 @@ namespace FluentDesign
         graphics.SetSmoothingMode(SmoothingModeAntiAlias);
         graphics.SetPixelOffsetMode(PixelOffsetModeNone);
 
-        SolidBrush backBrush(m_theme.GetColor(m_hovered? Theme::Colors::PanelHover : Theme::Colors::Panel));
+        Theme::Colors backColor = m_hovered? Theme::Colors::PanelHover : Theme::Colors::Panel;
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+        const SolidBrush *backBrush = palette->Brush(backColor);
         if (frame)
         {
             br.Offset(-0.5, -0.5);
-            Pen borderPen(m_theme.GetColor(Theme::Colors::PanelBorder),m_theme.DpiScaleF(1));
-            Gdiplus::RoundRect(graphics, br, (REAL)m_theme.GetSize_Corner(), &backBrush, borderPen, m_frameFlags);
+
+            // Every line has the same frame, blit it from the pre-rendered skin
+            if (!Gdiplus::DrawRoundRectSkin(hdc, br, (REAL)m_theme.GetSize_Corner(),
+                    m_theme.GetColor(backColor), m_theme.GetColor(Theme::Colors::PanelBorder), m_theme.DpiScaleF(1), m_frameFlags))
+            {
+                const Pen *borderPen = palette->Pen(Theme::Colors::PanelBorder);
+                Gdiplus::RoundRect(graphics, br, (REAL)m_theme.GetSize_Corner(), backBrush, *borderPen, m_frameFlags);
+            }
         }
         else
         {
             br.Inflate(1, 1);
-            graphics.FillRectangle(&backBrush, br);
+            graphics.FillRectangle(backBrush, br);
         }
     }
 
@@ -289,7 +314,7 @@ namespace FluentDesign
         RECT rect = clientRect;
         rect.left += (m_state != State::Caption) ? m_theme.DpiScale(m_leftMargin) : 0;
 
-        if (m_icon || m_hIcon)
+        if (HasIcon())
         {
             rect.left += m_theme.GetSize_Icon() + m_theme.DpiScale(m_leftMargin);
         }
@@ -301,9 +326,19 @@ namespace FluentDesign
             rightPos -= m_theme.DpiScale(CHEVRON_SIZE + CHEVRON_SPACE);
         }
 
-        for (auto it = m_childControlsList.rbegin(); it != m_childControlsList.rend(); ++it)
-        {
-            HWND hChildControl = *it;
+        rightPos -= GetChildControlsWidth();
+
+        rect.right = max(rect.left, rightPos);
+        return rect;
+    }
+
+    // Measured every time: a child resizing itself (a combo or button getting new text) does not
+    // tell the line, so a cached width would go stale.
+    int SettingsLine::GetChildControlsWidth() const
+    {
+        int width = 0;
+        for (HWND hChildControl : m_childControlsList)
+        {
             if (!IsSelfVisible(hChildControl))
             {
                 continue;
@@ -311,11 +346,20 @@ namespace FluentDesign
 
             RECT childRect;
             GetWindowRect(hChildControl, &childRect);
-            rightPos -= (childRect.right - childRect.left) + m_theme.DpiScale(4);
+            width += (childRect.right - childRect.left) + m_theme.DpiScale(4);
         }
 
-        rect.right = max(rect.left, rightPos);
-        return rect;
+        return width;
+    }
+
+    static void DrawTextLayout(HDC hdc, const std::wstring &text, const AnyFSE::Tools::TextLayout &layout, const RECT &rect)
+    {
+        int top = rect.top;
+        for (const AnyFSE::Tools::TextLine &line : layout.lines)
+        {
+            ExtTextOutW(hdc, rect.left, top, 0, nullptr, text.c_str() + line.start, (UINT)line.length, nullptr);
+            top += layout.lineHeight;
+        }
     }
 
     int SettingsLine::GetTextBlockHeight(int maximumWidth) const
@@ -326,14 +370,14 @@ namespace FluentDesign
         }
 
         HFONT nameFont = (m_state != State::Caption) ? m_theme.GetFont_Text() : m_theme.GetFont_TextBold();
-        int height = max(m_theme.GetSize_Text(), Gdiplus::MeasureTextHeight(m_name, nameFont, maximumWidth));
+        int height = max(m_theme.GetSize_Text(), m_theme.GetTextLayout(m_name, nameFont, maximumWidth)->height);
 
         if (!m_description.empty())
         {
             height += m_theme.DpiScale(m_linePadding);
             height += max(
                 m_theme.GetSize_TextSecondary(),
-                Gdiplus::MeasureTextHeight(m_description, m_theme.GetFont_TextSecondary(), maximumWidth)
+                m_theme.GetTextLayout(m_description, m_theme.GetFont_TextSecondary(), maximumWidth)->height
             );
         }
 
@@ -390,7 +434,8 @@ namespace FluentDesign
             return;
         }
 
-        SelectObject(hdc, (m_state != State::Caption) ? m_theme.GetFont_Text() : m_theme.GetFont_TextBold());
+        HFONT nameFont = (m_state != State::Caption) ? m_theme.GetFont_Text() : m_theme.GetFont_TextBold();
+        SelectObject(hdc, nameFont);
         SetTextColor(hdc, textColor);
 
         int height = GetTextBlockHeight(textWidth);
@@ -400,16 +445,11 @@ namespace FluentDesign
             ? (rect.bottom - rect.top - height) / 2
             : (rect.bottom - height - m_theme.DpiScale(m_linePadding));
 
-        nameRect.bottom = nameRect.top + max(
-            m_theme.GetSize_Text(),
-            Gdiplus::MeasureTextHeight(
-                m_name,
-                (m_state != State::Caption) ? m_theme.GetFont_Text() : m_theme.GetFont_TextBold(),
-                textWidth
-            )
-        );
+        // Layouts were cached by GetTextBlockHeight, painting only draws the lines
+        std::shared_ptr<const AnyFSE::Tools::TextLayout> nameLayout = m_theme.GetTextLayout(m_name, nameFont, textWidth);
+        nameRect.bottom = nameRect.top + max(m_theme.GetSize_Text(), nameLayout->height);
 
-        ::DrawText(hdc, m_name.c_str(), -1, &nameRect, DT_LEFT | DT_WORDBREAK | DT_NOPREFIX | DT_NOCLIP);
+        DrawTextLayout(hdc, m_name, *nameLayout, nameRect);
 
         if ( !m_description.empty())
         {
@@ -420,14 +460,14 @@ namespace FluentDesign
             SelectObject(hdc, m_theme.GetFont_TextSecondary());
             SetTextColor(hdc, descColor);
 
+            std::shared_ptr<const AnyFSE::Tools::TextLayout> descLayout =
+                m_theme.GetTextLayout(m_description, m_theme.GetFont_TextSecondary(), textWidth);
+
             RECT descRect = rect;
             descRect.top = nameRect.bottom + m_theme.DpiScale(m_linePadding);
-            descRect.bottom = descRect.top + max(
-                m_theme.GetSize_TextSecondary(),
-                Gdiplus::MeasureTextHeight(m_description, m_theme.GetFont_TextSecondary(), textWidth)
-            );
+            descRect.bottom = descRect.top + max(m_theme.GetSize_TextSecondary(), descLayout->height);
 
-            ::DrawText(hdc, m_description.c_str(), -1, &descRect, DT_LEFT | DT_WORDBREAK | DT_NOPREFIX | DT_NOCLIP);
+            DrawTextLayout(hdc, m_description, *descLayout, descRect);
 
             m_secondaryTextRect = descRect;
         }
@@ -437,19 +477,26 @@ namespace FluentDesign
         }
     }
 
-    void SettingsLine::DrawIcon(HDC hdc)
+    RECT SettingsLine::GetIconRect() const
     {
-        if (!m_icon && !m_hIcon)
-        {
-            return;
-        }
-
         RECT rect;
         GetClientRect(m_hWnd, &rect);
 
         rect.left += (m_state != State::Caption) ? m_theme.DpiScale(m_leftMargin) : 0;
         rect.top = (rect.bottom - rect.top - m_theme.GetSize_Icon()) / 2;
         rect.bottom = rect.top + m_theme.GetSize_Icon();
+        rect.right = rect.left + m_theme.GetSize_Icon();
+        return rect;
+    }
+
+    void SettingsLine::DrawIcon(HDC hdc)
+    {
+        if (!HasIcon())
+        {
+            return;
+        }
+
+        RECT rect = GetIconRect();
 
 
         if (m_hIcon)
@@ -462,15 +509,23 @@ namespace FluentDesign
 
             if (pImage)
             {
+                float opacity = m_iconAnimationId
+                    ? (float)m_iconFade.Value(AnyFSE::Tools::AnimationClock::Instance().Now())
+                    : 1.0f;
+                if (!m_enabled)
+                {
+                    opacity *= 0.5f;
+                }
+
                 Gdiplus::ImageAttributes imageAttributes;
                 Gdiplus::ColorMatrix colorMatrix = {
                     1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
                     0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
                     0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-                    0.0f, 0.0f, 0.0f, 0.5f, 0.0f,
+                    0.0f, 0.0f, 0.0f, opacity, 0.0f,
                     0.0f, 0.0f, 0.0f, 0.0f, 1.0f
                 };
-                if (!m_enabled)
+                if (opacity < 1.0f)
                 {
                     imageAttributes.SetColorMatrix(&colorMatrix, Gdiplus::ColorMatrixFlagsDefault, Gdiplus::ColorAdjustTypeBitmap);
                 }
@@ -491,7 +546,8 @@ namespace FluentDesign
             SetTextColor(hdc, m_theme.GetColorRef(m_enabled ? FluentDesign::Theme::Text : FluentDesign::Theme::TextDisabled));
 
 
-            ::DrawText(hdc, &m_icon, 1, &rect, DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP);
+            wchar_t glyph = m_icon ? m_icon : ICON_PLACEHOLDER;
+            ::DrawText(hdc, &glyph, 1, &rect, DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP);
         }
 
     }
@@ -716,15 +772,70 @@ namespace FluentDesign
 
     void SettingsLine::SetIcon(const std::wstring &path)
     {
+        CancelIconRequest();
         if (m_hIcon)
         {
             DestroyIcon(m_hIcon);
             m_hIcon = NULL;
         }
-        m_hIcon = Icon::LoadIcon(path);
+        m_iconPath = path;
+
+        // Hidden rows load once they are shown
+        if (!m_iconPath.empty() && IsSelfVisible(m_hWnd))
+        {
+            RequestIcon();
+        }
         UpdateLayout();
     }
 
+    void SettingsLine::RequestIcon()
+    {
+        if (m_iconRequest)
+        {
+            return;
+        }
+        m_iconRequest = AnyFSE::Tools::IconLoader::Instance().Request(m_iconPath, 256,
+            [this](UINT, HICON hIcon) { OnIconLoaded(hIcon); });
+    }
+
+    void SettingsLine::CancelIconRequest()
+    {
+        AnyFSE::Tools::IconLoader::Instance().Cancel(m_iconRequest);
+        m_iconRequest = 0;
+    }
+
+    void SettingsLine::OnIconLoaded(HICON hIcon)
+    {
+        using namespace AnyFSE::Tools;
+
+        m_iconRequest = 0;
+        if (!hIcon)
+        {
+            return;
+        }
+        m_hIcon = hIcon;
+
+        AnimationClock &clock = AnimationClock::Instance();
+        clock.Remove(m_iconAnimationId);
+
+        m_iconFade = Tween(0, 1, ICON_FADE_MS, Easing::OutCubic);
+        m_iconFade.Start(clock.Now());
+        m_iconAnimationId = clock.Add(m_hWnd, [this](double now)
+        {
+            RECT iconRect = GetIconRect();
+            InvalidateRect(m_hWnd, &iconRect, FALSE);
+            if (m_iconFade.IsFinished(now))
+            {
+                m_iconAnimationId = 0;
+                return false;
+            }
+            return true;
+        });
+
+        RECT iconRect = GetIconRect();
+        InvalidateRect(m_hWnd, &iconRect, FALSE);
+    }
+
     void SettingsLine::SetMenu(const std::vector<Popup::PopupItem> &items)
     {
         SetState(State::Menu);
@@ -950,6 +1061,16 @@ namespace FluentDesign
         return height;
     }
 
+    int SettingsLine::MeasureTotalHeight(int width)
+    {
+        m_width = width;
+        for (auto& gr : m_groupItemsList)
+        {
+            gr->m_width = width;
+        }
+        return GetTotalHeight();
+    }
+
     void SettingsLine::SetTop(int top)
     {
         m_top = top;
@@ -31,6 +31,7 @@
 #include "FluentControl.hpp"
 #include "Tools/Event.hpp"
 #include "Tools/Process.hpp"
+#include "Tools/Tween.hpp"
 #include "Button.hpp"
 #include "Popup.hpp"
 
@@ -68,6 +69,12 @@ namespace FluentDesign
 
         HICON m_hIcon;
 
+        // Path icons load in the background, a placeholder glyph holds their place meanwhile
+        std::wstring m_iconPath;
+        UINT m_iconRequest = 0;
+        UINT m_iconAnimationId = 0;
+        AnyFSE::Tools::Tween m_iconFade;
+
         int m_left = 0, m_top = 0;
         int m_width = 0, m_height = 0;
 
@@ -96,10 +103,21 @@ namespace FluentDesign
         const int LINK_VPADDING = 8;
         const int CHEVRON_SIZE = 24;
         const int CHEVRON_SPACE = 9;
+        const int ICON_FADE_MS = 200;
+        const wchar_t ICON_PLACEHOLDER = L'\xECAA';
 
         Button m_chevronButton;
 
     private:
+        // Room taken by the visible child controls
+        int GetChildControlsWidth() const;
+
+        bool HasIcon() const { return m_icon || m_hIcon || !m_iconPath.empty(); }
+        RECT GetIconRect() const;
+        void RequestIcon();
+        void CancelIconRequest();
+        void OnIconLoaded(HICON hIcon);
+
         virtual LPARAM OnCommand(HWND hwnd, int msg, WPARAM wParam, LPARAM lParam) { return 0; };
         virtual LPARAM OnDrawItem(HWND hwnd, LPDRAWITEMSTRUCT dis) { return 0; };
 
@@ -153,6 +171,8 @@ namespace FluentDesign
         int GetDesignPadding() const;
 
         int GetTotalHeight() const;
+        // Total height at the given width, without touching the windows
+        int MeasureTotalHeight(int width);
         void SetTop(int top);
         void SetLeftMargin(int margin);
 
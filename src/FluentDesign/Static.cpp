@@ -30,6 +30,7 @@
 #include "Static.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 #include "Tools/Icon.hpp"
 
 #pragma comment(lib, "Gdiplus.lib")
@@ -189,10 +190,9 @@ namespace FluentDesign
         }
         else
         {
-            // Create the font and brush
-            Font font(hdc, m_large ? m_theme.GetFont_TextLarge() : m_theme.GetFont_Text() );
-            SolidBrush textBrush(Color(m_theme.GetColor(m_colorId)));
-            graphics.DrawString(m_text.c_str(), -1, &font, rectF, &m_format, &textBrush);
+            std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+            const Font *font = palette->Font(m_large ? Palette::Fonts::TextLarge : Palette::Fonts::Text);
+            graphics.DrawString(m_text.c_str(), -1, font, rectF, &m_format, palette->Brush(m_colorId));
         }
         return;
     }
@@ -26,6 +26,7 @@
 #include "TextBox.hpp"
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 
 #pragma comment(lib, "gdiplus.lib")
 #pragma comment(lib, "comctl32.lib")
@@ -328,17 +329,17 @@ namespace FluentDesign
         Gdiplus::Graphics graphics(memDC);
         graphics.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
 
-        Color accent(m_hasFocus ? m_theme.GetColor(Theme::Colors::EditAccentFocus)
-                                : m_theme.GetColor(Theme::Colors::EditAccent)
-        );
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
 
+        Theme::Colors accent = m_hasFocus ? Theme::Colors::EditAccentFocus
+                                          : Theme::Colors::EditAccent;
 
-        Color back(m_hasFocus ? m_theme.GetColor(Theme::Colors::EditFocus)
-                : m_mouseOver ? m_theme.GetColor(Theme::Colors::EditHover)
-                              : m_theme.GetColor(Theme::Colors::Edit)
-        );
 
-        Color border(m_theme.GetColor(m_hasFocus ? Theme::Colors::EditBorderFocus : Theme::Colors::EditBorder));
+        Theme::Colors back = m_hasFocus ? Theme::Colors::EditFocus
+                           : m_mouseOver ? Theme::Colors::EditHover
+                                         : Theme::Colors::Edit;
+
+        Theme::Colors border = m_hasFocus ? Theme::Colors::EditBorderFocus : Theme::Colors::EditBorder;
 
         RectF accentRect((REAL)rect.left, (REAL)rect.top,
                 ( REAL)(rect.right - rect.left),
@@ -352,13 +353,12 @@ namespace FluentDesign
         clientRect.Height -= m_theme.DpiScaleF(m_hasFocus ? 1 : 0);
         accentRect.Inflate(-m_theme.DpiScaleF(m_borderWidth), 0);
 
-        Pen accentPen(accent, 0*m_theme.DpiScaleF(m_borderWidth));
-        SolidBrush accentBrush(accent);
-        RoundRect(graphics, accentRect, m_theme.DpiScaleF(m_cornerRadius), &accentBrush, accentPen);
+        RoundRect(graphics, accentRect, m_theme.DpiScaleF(m_cornerRadius),
+            palette->Brush(accent), *palette->Pen(accent, Palette::PenWidth::Device));
 
-        Pen borderPen(border, m_theme.DpiScaleF(m_borderWidth));
-        SolidBrush controlBrush(back);
-        RoundRect(graphics, clientRect, m_theme.DpiScaleF(m_cornerRadius), &controlBrush, borderPen);
+        // m_borderWidth is one design pixel
+        RoundRect(graphics, clientRect, m_theme.DpiScaleF(m_cornerRadius),
+            palette->Brush(back), *palette->Pen(border, Palette::PenWidth::Thin));
 
     }
 
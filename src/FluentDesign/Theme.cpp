@@ -23,8 +23,10 @@
 
 
 #include "Theme.hpp"
+#include "Palette.hpp"
 #include "Tools/GdiPlus.hpp"
 #include "Tools/Window.hpp"
+#include "Tools/DoubleBufferedPaint.hpp"
 #include "Logging/LogManager.hpp"
 
 #include <dwmapi.h>
@@ -225,6 +227,7 @@ namespace FluentDesign
                 if (lParam != NULL && wcscmp(L"ImmersiveColorSet", (LPCWSTR)lParam) == 0)
                 {
                     This->LoadColors();
+                    BackBufferPool::Instance().Release();
                     This->OnThemeChanged.Notify();
                     RedrawWindow(hWnd, NULL, NULL, RDW_ALLCHILDREN | RDW_INVALIDATE | RDW_UPDATENOW);
                 }
@@ -233,6 +236,7 @@ namespace FluentDesign
             case WM_DWMCOLORIZATIONCOLORCHANGED:
             {
                 This->LoadColors();
+                BackBufferPool::Instance().Release();
                 This->OnThemeChanged.Notify();
                 RedrawWindow(hWnd, NULL, NULL, RDW_ALLCHILDREN | RDW_INVALIDATE | RDW_UPDATENOW);
                 break;
@@ -242,6 +246,7 @@ namespace FluentDesign
                 ULONG oldDPI = This->m_dpi;
                 This->m_dpi = HIWORD(wParam);
                 This->CreateFonts();
+                BackBufferPool::Instance().Release();
                 RECT* const prcNewWindow = (RECT*)lParam;
                 SetWindowPos(hWnd,
                     NULL,
@@ -354,10 +359,11 @@ namespace FluentDesign
         RectF focusRect = ToRectF(clientRect);
         focusRect.Inflate(offset, offset);
 
-        Pen borderPen(GetColor(FluentDesign::Theme::Colors::FocusFrame), (REAL)GetSize_FocusWidth());
+        std::shared_ptr<const Palette> palette = GetPalette();
+        const Pen *borderPen = palette->Pen(Colors::FocusFrame, Palette::PenWidth::Focus);
 
         // For rounded rectangles in GDI+, we need to use GraphicsPath
-        Gdiplus::RoundRect(graphics, focusRect, (REAL)GetSize_FocusCornerSize() + offset, nullptr, borderPen);
+        Gdiplus::RoundRect(graphics, focusRect, (REAL)GetSize_FocusCornerSize() + offset, nullptr, *borderPen);
 
     }
 
@@ -433,6 +439,9 @@ namespace FluentDesign
 
     void Theme::FreeFonts()
     {
+        ResetPalette();
+        m_textLayouts.Clear();
+
         if (m_hPrimaryFont)
             DeleteObject(m_hPrimaryFont);
 
@@ -467,6 +476,51 @@ namespace FluentDesign
         m_hIconFont = NULL;
     }
 
+    std::shared_ptr<const Palette> Theme::GetPalette()
+    {
+        std::shared_ptr<const Palette> palette = std::atomic_load(&m_palette);
+        if (!palette)
+        {
+            palette = std::make_shared<const Palette>(*this);
+            std::atomic_store(&m_palette, palette);
+        }
+        return palette;
+    }
+
+    std::shared_ptr<const AnyFSE::Tools::TextLayout> Theme::GetTextLayout(const std::wstring &text, HFONT hFont, int maxWidth)
+    {
+        using namespace AnyFSE::Tools;
+
+        TextLayoutKey key{ text, (uintptr_t)hFont, maxWidth, (unsigned)m_dpi };
+        return m_textLayouts.Get(key, [](const TextLayoutKey &key)
+        {
+            std::vector<int> extents(key.text.size());
+
+            HDC hdc = GetDC(nullptr);
+            HGDIOBJ oldFont = SelectObject(hdc, (HFONT)key.font);
+
+            // One call measures every prefix of the text, the line breaker works from those
+            SIZE size{};
+            TEXTMETRIC tm{};
+            if (!key.text.empty())
+            {
+                GetTextExtentExPointW(hdc, key.text.c_str(), (int)key.text.size(), 0, nullptr, extents.data(), &size);
+            }
+            GetTextMetrics(hdc, &tm);
+
+            SelectObject(hdc, oldFont);
+            ReleaseDC(nullptr, hdc);
+
+            return BreakLines(key.text, extents, key.maxWidth, tm.tmHeight);
+        });
+    }
+
+    void Theme::ResetPalette()
+    {
+        // Painters still holding the old palette keep it alive until they finish
+        std::atomic_store(&m_palette, std::shared_ptr<const Palette>());
+    }
+
     const int Theme::DpiUnscale(int scaledSize)
     {
         return MulDiv(scaledSize, 96, m_dpi);
@@ -25,12 +25,18 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <vector>
 #include <windows.h>
 #include "Tools/Event.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Tools/TextLayout.hpp"
+#include "FluentDesign/AnchorLayout.hpp"
 
 namespace FluentDesign
 {
+    class Palette;
+
     class Theme
     {
     public:
@@ -130,6 +136,15 @@ namespace FluentDesign
 
         HBRUSH m_hDialogBack = nullptr;
 
+        std::shared_ptr<const Palette> m_palette;
+
+        // Keyed by font handle, cleared together with the fonts
+        AnyFSE::Tools::TextLayoutCache m_textLayouts;
+
+        // Reused by every reflow, windows are in the order of the layout nodes
+        AnchorLayout::Tree m_layout;
+        std::vector<HWND> m_layoutWindows;
+
         COLORREF m_colors[Colors::Max + 1];
 
         static const int m_primarySize = 14;
@@ -157,6 +172,7 @@ namespace FluentDesign
         void LoadColors();
         void CreateFonts();
         void FreeFonts();
+        void ResetPalette();
 
         static LRESULT CALLBACK DialogSubclassProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
         static LRESULT ControlParentSublassProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
@@ -193,6 +209,8 @@ namespace FluentDesign
 
         const bool IsDark() { return m_isDark; }
 
+        const ULONG GetDpi() const { return m_dpi; }
+
         const int DpiUnscale(int scaledSize);
         const float DpiUnscaleF(int scaledSize);
         const float DpiUnscaleF(float scaledSize);
@@ -224,6 +242,12 @@ namespace FluentDesign
         const HFONT GetFont_Title() { return m_hTitleFont; }
         const HFONT GetFont_Icon() { return m_hIconFont; }
 
+        // GDI+ objects for painting, hold the pointer for the duration of the paint
+        std::shared_ptr<const Palette> GetPalette();
+
+        // Word wrapped layout of the text in one of the theme fonts, measured once per font and DPI
+        std::shared_ptr<const AnyFSE::Tools::TextLayout> GetTextLayout(const std::wstring &text, HFONT hFont, int maxWidth);
+
         // colors
         const DWORD ReverseRGB(DWORD rgb) { return RGB(rgb >> 16, rgb >> 8, rgb); }
         const DWORD GetColor(Colors code) { return code ? ReverseRGB(m_colors[code]) | 0xFF000000 : 0; }
@@ -38,7 +38,8 @@ namespace FluentDesign
     bool Theme::IsDarkThemeEnabled()
     {
         std::wstring root = L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize";
-        DWORD appLight = Registry::ReadDWORD(root, L"AppsUseLightTheme", Registry::ReadDWORD(root, L"SystemUsesLightTheme", 1));
+        std::vector<RegistryValue> values = Registry::ReadValues(root, { L"AppsUseLightTheme", L"SystemUsesLightTheme" });
+        DWORD appLight = values[0].AsDWORD(values[1].AsDWORD(1));
         return (appLight == 0);
     }
 
@@ -282,5 +283,6 @@ namespace FluentDesign
         if(m_hDialogBack) DeleteObject(m_hDialogBack);
         m_hDialogBack = CreateSolidBrush(GetColorRef(FluentDesign::Theme::Colors::Dialog));
 
+        ResetPalette();
     }
 }
\ No newline at end of file
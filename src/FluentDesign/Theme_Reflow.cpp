@@ -22,24 +22,90 @@
 //
 
 
+#include <algorithm>
 #include "Theme.hpp"
+#include "Tools/Window.hpp"
 #include "FluentDesign/FluentControl.hpp"
 
 namespace FluentDesign
 {
+    namespace
+    {
+        AnchorLayout::Rect ToLayoutRect(const RECT &rect)
+        {
+            return AnchorLayout::Rect{ rect.left, rect.top, rect.right, rect.bottom };
+        }
+    }
+
     const void Theme::ReflowChilds(HWND parent)
     {
+        m_layout.Clear();
+        m_layoutWindows.clear();
+
+        // Controls sharing a parent rect function share one frame, it is asked for once
+        std::vector<FluentControl::GetParentRectFunc> frames;
+
         HWND hChild = GetWindow(parent, GW_CHILD);
-        HDWP hdwp = BeginDeferWindowPos(3);
         while (hChild)
         {
             FluentControl *pControl = dynamic_cast<FluentControl*>((FluentControl*)GetWindowLongPtr(hChild, GWLP_USERDATA));
-            if (pControl)
+            if (pControl && pControl->GetAnchor() != Align::None)
             {
-                hdwp = pControl->ReflowControl(hdwp);
+                FluentControl::GetParentRectFunc getParentRect = pControl->GetParentRectFunction();
+                auto frame = std::find(frames.begin(), frames.end(), getParentRect);
+                if (frame == frames.end())
+                {
+                    RECT parentRect;
+                    getParentRect(*this, parent, &parentRect);
+                    m_layout.AddFrame(ToLayoutRect(parentRect));
+                    frame = frames.insert(frames.end(), getParentRect);
+                }
+
+                const Align::Margins &margins = pControl->GetDesignMargins();
+                RECT controlRect;
+                Window::GetChildRect(hChild, &controlRect);
+
+                AnchorLayout::Node node;
+                node.anchor = pControl->GetAnchor();
+                node.margins = AnchorLayout::Margins{ margins.Left, margins.Top, margins.Right, margins.Bottom };
+                node.frame = (int32_t)(frame - frames.begin());
+                node.current = ToLayoutRect(controlRect);
+
+                m_layout.Add(node);
+                m_layoutWindows.push_back(hChild);
             }
             hChild = GetWindow(hChild, GW_HWNDNEXT);
         }
+
+        m_layout.Measure(m_dpi);
+        size_t changed = m_layout.Arrange(m_dpi);
+        if (!changed)
+        {
+            return;
+        }
+
+        // Sized for the moves it gets, the batch never has to grow
+        HDWP hdwp = BeginDeferWindowPos((int)changed);
+        for (size_t i = 0; i < m_layout.Count(); ++i)
+        {
+            const AnchorLayout::Node &node = m_layout[i];
+            if (!node.changed)
+            {
+                continue;
+            }
+
+            RECT rect{ node.arranged.left, node.arranged.top, node.arranged.right, node.arranged.bottom };
+            if (hdwp)
+            {
+                hdwp = DeferWindowPos(hdwp, m_layoutWindows[i], nullptr,
+                                      rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top,
+                                      SWP_NOZORDER);
+            }
+            else
+            {
+                Window::MoveWindow(m_layoutWindows[i], &rect, FALSE);
+            }
+        }
         if (hdwp)
         {
             EndDeferWindowPos(hdwp);
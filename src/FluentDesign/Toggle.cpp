@@ -31,6 +31,7 @@
 #include "Tools/DoubleBufferedPaint.hpp"
 #include "Tools/Localization.hpp"
 #include "Tools/GdiPlus.hpp"
+#include "Palette.hpp"
 #pragma comment(lib, "Gdiplus.lib")
 
 using namespace Gdiplus;
@@ -241,34 +242,32 @@ namespace FluentDesign
 
         br.Inflate(-m_theme.DpiScaleF(1), -m_theme.DpiScaleF(1));
 
+        std::shared_ptr<const Palette> palette = m_theme.GetPalette();
+
         // Determine colors based on state
-        Color borderColor(m_theme.GetColor(
+        Theme::Colors borderColor =
             m_isChecked ? ( enabled ? Theme::Colors::ToggleBorderOn : Theme::Colors::ToggleBorderOnDisabled)
-                        : ( enabled ? Theme::Colors::ToggleBorderOff : Theme::Colors::ToggleBorderOffDisabled)
-        ));
+                        : ( enabled ? Theme::Colors::ToggleBorderOff : Theme::Colors::ToggleBorderOffDisabled);
 
-        Color backColor(m_theme.GetColor(
+        Theme::Colors backColor =
               (m_isChecked && !enabled)         ? Theme::Colors::ToggleTrackOnDisabled
             : (m_isChecked && m_buttonPressed)    ? Theme::Colors::ToggleTrackOnPressed
             : (m_isChecked)                     ? Theme::Colors::ToggleTrackOn
             : (!m_isChecked && !enabled)        ? Theme::Colors::ToggleTrackOffDisabled
             : (!m_isChecked && m_buttonMouseOver) ? Theme::Colors::ToggleTrackOffHover
-                                              : Theme::Colors::ToggleTrackOff
-        ));
+                                              : Theme::Colors::ToggleTrackOff;
 
-        Color thumbColor(m_theme.GetColor(
+        Theme::Colors thumbColor =
             m_isChecked ? (enabled ? Theme::Colors::ToggleThumbOn : Theme::Colors::ToggleThumbOnDisabled)
-                      : (enabled ? Theme::Colors::ToggleThumbOff : Theme::Colors::ToggleThumbOffDisabled)
-        ));
+                      : (enabled ? Theme::Colors::ToggleThumbOff : Theme::Colors::ToggleThumbOffDisabled);
 
-        Color thumbCircleColor = (m_buttonPressed || m_buttonMouseOver) ? thumbColor : backColor;
+        Theme::Colors thumbCircleColor = (m_buttonPressed || m_buttonMouseOver) ? thumbColor : backColor;
 
         // Draw outer rounded rectangle (track)
-        Pen borderPen(borderColor, (REAL)m_theme.DpiScale(1));
-        SolidBrush backBrush(backColor);
+        const Pen *borderPen = palette->Pen(borderColor, Palette::PenWidth::ThinWhole);
 
         // For rounded rectangles in GDI+, we need to use GraphicsPath
-        Gdiplus::RoundRect(graphics, br, m_theme.DpiScaleF(Layout_ItemHeight), &backBrush, borderPen);
+        Gdiplus::RoundRect(graphics, br, m_theme.DpiScaleF(Layout_ItemHeight), palette->Brush(backColor), *borderPen);
 
         // Calculate thumb rectangle
         RectF tr = br;
@@ -288,26 +287,19 @@ namespace FluentDesign
         }
 
         // Draw thumb (inner circle)
-        Pen thumbPen(thumbCircleColor, m_theme.DpiScaleF(1));
-        SolidBrush thumbBrush(thumbColor);
-
-        graphics.FillEllipse(&thumbBrush, tr);
-        graphics.DrawEllipse(&thumbPen, tr);
+        graphics.FillEllipse(palette->Brush(thumbColor), tr);
+        graphics.DrawEllipse(palette->Pen(thumbCircleColor), tr);
 
         // Define the rectangle (X, Y, Width, Height)
         RectF textRect = gdiRect;
         textRect.Width = m_theme.DpiScaleF(Layout_TextWidth - 4);
 
-        // Create the font and brush
-        Font font(hdc, m_theme.GetFont_Text());
-        SolidBrush textBrush(Color(m_theme.GetColor(enabled ? Theme::Colors::Text : Theme::Colors::TextDisabled)));
-
-        std::wstring text = Translate(m_isChecked ? L"toggleOn" : L"toggleOff").c_str();
-        StringFormat format;
-        format.SetAlignment(StringAlignmentFar);       // Left
-        format.SetLineAlignment(StringAlignmentCenter); // Vertical center
+        std::wstring text = Translate(m_isChecked ? KeyId::toggleOn : KeyId::toggleOff).c_str();
 
-        graphics.DrawString(text.c_str(), -1, &font, textRect, &format, &textBrush);
+        graphics.DrawString(text.c_str(), -1,
+            palette->Font(Palette::Fonts::Text), textRect,
+            palette->Format(StringAlignmentFar),
+            palette->Brush(enabled ? Theme::Colors::Text : Theme::Colors::TextDisabled));
 
         return;
     }
@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "VirtualRows.hpp"
+
+namespace FluentDesign
+{
+    void VirtualRows::Reset(size_t count)
+    {
+        m_heights.assign(count, 0);
+        m_offsets.assign(count + 1, 0);
+        m_validOffsets = 1;
+    }
+
+    bool VirtualRows::SetHeight(size_t row, int height)
+    {
+        if (m_heights[row] == height)
+        {
+            return false;
+        }
+
+        m_heights[row] = height;
+        m_validOffsets = std::min(m_validOffsets, row + 1);
+        return true;
+    }
+
+    void VirtualRows::UpdateOffsets(size_t upTo)
+    {
+        for (; m_validOffsets <= upTo; ++m_validOffsets)
+        {
+            m_offsets[m_validOffsets] = m_offsets[m_validOffsets - 1] + m_heights[m_validOffsets - 1];
+        }
+    }
+
+    int VirtualRows::Top(size_t row)
+    {
+        UpdateOffsets(row);
+        return m_offsets[row];
+    }
+
+    int VirtualRows::ContentHeight()
+    {
+        return Top(m_heights.size());
+    }
+
+    size_t VirtualRows::RowAt(int position)
+    {
+        UpdateOffsets(m_heights.size());
+
+        // Last row starting at or above the position, zero height rows are skipped
+        auto it = std::upper_bound(m_offsets.begin(), m_offsets.end() - 1, position);
+        if (it == m_offsets.begin())
+        {
+            return 0;
+        }
+
+        size_t row = (size_t)(it - m_offsets.begin()) - 1;
+        return position < m_offsets.back() ? row : m_heights.size();
+    }
+
+    VirtualRows::Range VirtualRows::VisibleRange(int scrollPos, int viewHeight, int overscan)
+    {
+        Range range;
+        int top = std::max(0, scrollPos - overscan);
+        int bottom = scrollPos + viewHeight + overscan;
+
+        range.first = RowAt(top);
+        if (range.first >= m_heights.size() || bottom <= top)
+        {
+            range.first = range.last = m_heights.size();
+            return range;
+        }
+
+        // First row starting at or below the bottom edge
+        auto it = std::lower_bound(m_offsets.begin() + range.first, m_offsets.end() - 1, bottom);
+        range.last = (size_t)(it - m_offsets.begin());
+        return range;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace FluentDesign
+{
+    // Heights and offsets of a virtualized list. Offsets are rebuilt lazily from the first changed row,
+    // lookups by scroll position are binary searches over them.
+    class VirtualRows
+    {
+    public:
+        // Half-open [first, last) range of rows
+        struct Range
+        {
+            size_t first = 0;
+            size_t last = 0;
+
+            bool Empty() const { return first >= last; }
+            bool Contains(size_t row) const { return row >= first && row < last; }
+        };
+
+        void Reset(size_t count);
+        size_t Count() const { return m_heights.size(); }
+
+        int Height(size_t row) const { return m_heights[row]; }
+
+        // Returns true if the height has changed
+        bool SetHeight(size_t row, int height);
+
+        int Top(size_t row);
+        int ContentHeight();
+
+        // Row under the content position, Count() if the position is past the last row
+        size_t RowAt(int position);
+
+        // Rows intersecting the view extended by overscan on both sides
+        Range VisibleRange(int scrollPos, int viewHeight, int overscan = 0);
+
+    private:
+        std::vector<int> m_heights;
+        std::vector<int> m_offsets;     // top of each row, the extra last item is the content height
+        size_t m_validOffsets = 1;      // offsets before this index are up to date
+
+        void UpdateOffsets(size_t upTo);
+    };
+}
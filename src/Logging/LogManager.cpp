@@ -48,6 +48,8 @@ namespace AnyFSE::Logging
     std::string LogManager::ApplicationName;
     bool LogManager::LogToConsole;
     std::wstring LogManager::FilePath;
+    bool LogManager::Buffering = false;
+    std::vector<std::pair<LogLevels, std::string>> LogManager::Buffered;
 
     void LogManager::DeleteLog()
     {
@@ -81,6 +83,31 @@ namespace AnyFSE::Logging
             LogWriter.open(FilePath, ios::app | ios::out);
 
         }
+
+        if (Buffering)
+        {
+            lock_guard<mutex> lock(WriteLock);
+            for (const auto &entry : Buffered)
+            {
+                if (entry.first > Level)
+                {
+                    continue;
+                }
+                if (LogWriter.is_open())
+                {
+                    LogWriter << entry.second << endl;
+                }
+                OutputDebugStringA(entry.second.c_str());
+            }
+            Buffered.clear();
+            Buffering = false;
+        }
+    }
+
+    void LogManager::BufferUntilInitialized()
+    {
+        lock_guard<mutex> lock(WriteLock);
+        Buffering = true;
     }
 
     LogManager::~LogManager()
@@ -133,7 +160,7 @@ namespace AnyFSE::Logging
     // Main logging method
     void LogManager::WriteMessage(LogLevels level, const string &loggerName, const char *format, va_list args)
     {
-        if (level > Level)// || !(LogToConsole || LogWriter.is_open()))
+        if (level > Level && !Buffering)// || !(LogToConsole || LogWriter.is_open()))
         {
             return;
         }
@@ -162,6 +189,17 @@ namespace AnyFSE::Logging
 
         string message = FormatString(format, args);
 
+        // The level is not known yet, the messages are filtered once it is
+        if (Buffering)
+        {
+            lock_guard<mutex> lock(WriteLock);
+            if (Buffering)
+            {
+                Buffered.emplace_back(level, prefix + " " + message);
+                return;
+            }
+        }
+
         // Write to file
         if (LogWriter.is_open())
         {
@@ -27,6 +27,8 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <utility>
+#include <vector>
 #include "Logger.hpp"
 
 namespace AnyFSE::Logging
@@ -42,6 +44,8 @@ namespace AnyFSE::Logging
         static std::string ApplicationName;
         static bool LogToConsole;
         static std::wstring FilePath;
+        static bool Buffering;
+        static std::vector<std::pair<LogLevels, std::string>> Buffered;
 
         LogManager() {};
         ~LogManager();
@@ -53,6 +57,8 @@ namespace AnyFSE::Logging
     public:
         static void DeleteLog();
         static void Initialize(const std::string &appName, LogLevels level = LogLevels::Trace, const std::wstring &filePath = L"");
+        // Messages logged before the configuration is read are kept and written by Initialize
+        static void BufferUntilInitialized();
         static Logger GetLogger(const std::string &loggerName = "");
         static const char * LogLevelToString(LogLevels level);
     };
@@ -0,0 +1,200 @@
+#include <windows.h>
+#include <dwmapi.h>
+#include <algorithm>
+
+#include "Tools/AnimationClock.hpp"
+#include "Tools/Process.hpp"
+#include "Logging/LogManager.hpp"
+
+#pragma comment(lib, "dwmapi.lib")
+
+namespace AnyFSE::Tools
+{
+    static Logger log = LogManager::GetLogger("AnimationClock");
+
+    AnimationClock &AnimationClock::Instance()
+    {
+        static AnimationClock clock;
+        return clock;
+    }
+
+    AnimationClock::AnimationClock()
+    {
+        QueryPerformanceFrequency(&m_frequency);
+        QueryPerformanceCounter(&m_origin);
+    }
+
+    AnimationClock::~AnimationClock()
+    {
+        // Nothing is left to stop in the library, the exe may still be animating at exit
+        Shutdown();
+    }
+
+    void AnimationClock::Shutdown()
+    {
+        m_running = false;
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+        m_animations.clear();
+        m_tickPending = false;
+
+        if (m_hWnd)
+        {
+            DestroyWindow(m_hWnd);
+            m_hWnd = NULL;
+            UnregisterClass(ClassName, Process::GetModuleInstance());
+        }
+    }
+
+    double AnimationClock::Now() const
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return (double)(counter.QuadPart - m_origin.QuadPart) * 1000.0 / (double)m_frequency.QuadPart;
+    }
+
+    LRESULT CALLBACK AnimationClock::ClockWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    {
+        if (uMsg == WM_CLOCK_TICK)
+        {
+            AnimationClock *This = reinterpret_cast<AnimationClock *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+            if (This)
+            {
+                This->OnTick();
+            }
+            return 0;
+        }
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    bool AnimationClock::CreateClockWindow()
+    {
+        if (m_hWnd)
+        {
+            return true;
+        }
+
+        // The exe and the settings library each have a clock, the class belongs to the module of its WndProc
+        HINSTANCE hInstance = Process::GetModuleInstance();
+
+        WNDCLASSEX wc = { sizeof(WNDCLASSEX) };
+        wc.lpfnWndProc = ClockWndProc;
+        wc.hInstance = hInstance;
+        wc.lpszClassName = ClassName;
+        RegisterClassEx(&wc);
+
+        m_hWnd = CreateWindowEx(0, ClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, hInstance, NULL);
+        if (!m_hWnd)
+        {
+            log.Error(log.APIError(), "Can't create animation clock window");
+            return false;
+        }
+        SetWindowLongPtr(m_hWnd, GWLP_USERDATA, (LONG_PTR)this);
+        return true;
+    }
+
+    UINT AnimationClock::Add(HWND hOwner, FrameFunc frame)
+    {
+        if (!frame || !CreateClockWindow())
+        {
+            return 0;
+        }
+
+        UINT id = m_nextId++;
+        m_animations.push_back(Animation{ id, hOwner, std::move(frame) });
+        StartWorker();
+        return id;
+    }
+
+    void AnimationClock::Remove(UINT id)
+    {
+        // Entries are dropped after the tick, the frame being called may remove itself
+        for (auto &animation : m_animations)
+        {
+            if (animation.id == id)
+            {
+                animation.frame = nullptr;
+            }
+        }
+    }
+
+    bool AnimationClock::IsAnimating(UINT id) const
+    {
+        return id && std::any_of(m_animations.begin(), m_animations.end(),
+            [id](const Animation &animation) { return animation.id == id && animation.frame; });
+    }
+
+    void AnimationClock::StartWorker()
+    {
+        if (m_running)
+        {
+            return;
+        }
+
+        // The previous worker has seen m_running drop and leaves within a frame
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+
+        m_running = true;
+        m_worker = std::thread(&AnimationClock::WorkerProc, this);
+    }
+
+    void AnimationClock::WorkerProc()
+    {
+        while (m_running)
+        {
+            // Blocks until the next composition pass, keeps a fixed pace if DWM can't tell
+            if (FAILED(DwmFlush()))
+            {
+                Sleep(FallbackFrameMs);
+            }
+
+            if (m_running && !m_tickPending.exchange(true))
+            {
+                if (!PostMessage(m_hWnd, WM_CLOCK_TICK, 0, 0))
+                {
+                    m_tickPending = false;
+                }
+            }
+        }
+    }
+
+    void AnimationClock::OnTick()
+    {
+        m_tickPending = false;
+        double now = Now();
+
+        // Frames may add animations, they are picked up on the next tick
+        size_t count = m_animations.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!m_animations[i].frame)
+            {
+                continue;
+            }
+            if (m_animations[i].hOwner && !IsWindow(m_animations[i].hOwner))
+            {
+                m_animations[i].frame = nullptr;
+                continue;
+            }
+
+            FrameFunc frame = m_animations[i].frame;
+            if (!frame(now))
+            {
+                m_animations[i].frame = nullptr;
+            }
+        }
+
+        m_animations.erase(std::remove_if(m_animations.begin(), m_animations.end(),
+            [](const Animation &animation) { return !animation.frame; }), m_animations.end());
+
+        if (m_animations.empty())
+        {
+            m_running = false;
+        }
+    }
+}
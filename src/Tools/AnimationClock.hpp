@@ -0,0 +1,68 @@
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // One frame clock per module, driven from the UI thread that adds the animations. A worker waits for the
+    // next DWM present and posts one tick, so every animation advances on the same vsync aligned frame and
+    // ticks never queue up behind a slow one. The worker exits once the last animation is done, an idle UI
+    // wakes nobody. A library stops its clock with Shutdown before it is unloaded, joining the worker from
+    // a static destructor there would wait on the loader lock.
+    class AnimationClock
+    {
+    public:
+        // Called on the UI thread once a frame with the clock time in ms, returns false when done
+        typedef std::function<bool(double now)> FrameFunc;
+
+        static AnimationClock &Instance();
+
+        // The animation is also dropped when its owner window is gone
+        UINT Add(HWND hOwner, FrameFunc frame);
+        void Remove(UINT id);
+        bool IsAnimating(UINT id) const;
+
+        double Now() const;
+
+        // Drops every animation, joins the worker and destroys the window. Adding again starts over.
+        void Shutdown();
+
+        ~AnimationClock();
+
+    private:
+        struct Animation
+        {
+            UINT id;
+            HWND hOwner;
+            FrameFunc frame;
+        };
+
+        static const UINT WM_CLOCK_TICK = WM_APP + 1;
+        static const DWORD FallbackFrameMs = 16;
+        static constexpr const wchar_t *ClassName = L"AnyFSE.AnimationClock";
+
+        static LRESULT CALLBACK ClockWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+        HWND m_hWnd = NULL;
+        LARGE_INTEGER m_frequency{};
+        LARGE_INTEGER m_origin{};
+
+        std::vector<Animation> m_animations;
+        UINT m_nextId = 1;
+
+        std::thread m_worker;
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_tickPending{false};
+
+        AnimationClock();
+
+        bool CreateClockWindow();
+        void StartWorker();
+        void WorkerProc();
+        void OnTick();
+    };
+}
@@ -0,0 +1,202 @@
+#include <algorithm>
+
+#include "Tools/DoubleBufferedPaint.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace FluentDesign
+{
+    static Logger log = LogManager::GetLogger("DoubleBuferedPaint");
+
+    BackBufferPool &BackBufferPool::Instance()
+    {
+        static BackBufferPool pool;
+        return pool;
+    }
+
+    int BackBufferPool::SizeClass(int width, int height)
+    {
+        auto bucket = [](int value)
+        {
+            int bits = 5; // 32 px is the smallest class
+            while ((1 << bits) < value && bits < 15)
+            {
+                bits++;
+            }
+            return bits;
+        };
+        return (bucket(width) << 8) | bucket(height);
+    }
+
+    bool BackBufferPool::Create(Buffer &buffer, HDC hdc, int width, int height)
+    {
+        HDC hdcMem = CreateCompatibleDC(hdc);
+        if (!hdcMem)
+        {
+            log.Error(log.APIError(), "Can't create back buffer DC");
+            return false;
+        }
+
+        HBITMAP hBitmap = CreateCompatibleBitmap(hdc, width, height);
+        if (!hBitmap)
+        {
+            log.Error(log.APIError(), "Can't create %dx%d back buffer", width, height);
+            DeleteDC(hdcMem);
+            return false;
+        }
+
+        buffer.hdc = hdcMem;
+        buffer.hBitmap = hBitmap;
+        buffer.hOldBitmap = (HBITMAP)SelectObject(hdcMem, hBitmap);
+        buffer.width = width;
+        buffer.height = height;
+
+        m_counters.buffersCreated++;
+        m_counters.pooledBytes += (size_t)width * height * 4;
+        return true;
+    }
+
+    void BackBufferPool::Delete(Buffer &buffer)
+    {
+        if (buffer.hdc)
+        {
+            SelectObject(buffer.hdc, buffer.hOldBitmap);
+            DeleteObject(buffer.hBitmap);
+            DeleteDC(buffer.hdc);
+
+            m_counters.buffersDeleted++;
+            m_counters.pooledBytes -= (size_t)buffer.width * buffer.height * 4;
+        }
+        buffer.hdc = NULL;
+        buffer.hBitmap = NULL;
+        buffer.hOldBitmap = NULL;
+    }
+
+    BackBufferPool::Buffer *BackBufferPool::Acquire(HDC hdc, int width, int height)
+    {
+        width = std::max(width, 1);
+        height = std::max(height, 1);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const int sizeClass = SizeClass(width, height);
+        Buffer *buffer = nullptr;
+        for (auto &candidate : m_buffers)
+        {
+            if (!candidate->inUse && candidate->sizeClass == sizeClass)
+            {
+                buffer = candidate.get();
+                break;
+            }
+        }
+
+        if (buffer && (buffer->width < width || buffer->height < height))
+        {
+            // Grow to cover both the old and the new size, so the class settles on one bitmap
+            int newWidth = std::max(buffer->width, width);
+            int newHeight = std::max(buffer->height, height);
+            Delete(*buffer);
+            if (!Create(*buffer, hdc, newWidth, newHeight))
+            {
+                m_buffers.erase(std::find_if(m_buffers.begin(), m_buffers.end(),
+                    [buffer](const std::unique_ptr<Buffer> &item) { return item.get() == buffer; }));
+                return nullptr;
+            }
+        }
+        else if (buffer)
+        {
+            m_counters.buffersReused++;
+        }
+        else
+        {
+            auto created = std::make_unique<Buffer>();
+            if (!Create(*created, hdc, width, height))
+            {
+                return nullptr;
+            }
+            created->sizeClass = sizeClass;
+            buffer = created.get();
+            m_buffers.push_back(std::move(created));
+        }
+
+        buffer->inUse = true;
+        buffer->generation = m_generation;
+
+        // Whatever the previous painter selected or clipped is dropped on Return
+        buffer->savedDC = SaveDC(buffer->hdc);
+        return buffer;
+    }
+
+    void BackBufferPool::Return(Buffer *buffer)
+    {
+        if (!buffer)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        RestoreDC(buffer->hdc, buffer->savedDC);
+        buffer->inUse = false;
+
+        size_t idle = 0;
+        for (auto &item : m_buffers)
+        {
+            if (!item->inUse && item->sizeClass == buffer->sizeClass)
+            {
+                idle++;
+            }
+        }
+
+        // Released while painting, or more idle buffers than nested paints ever need
+        if (buffer->generation != m_generation || idle > MaxIdlePerClass)
+        {
+            Delete(*buffer);
+            m_buffers.erase(std::find_if(m_buffers.begin(), m_buffers.end(),
+                [buffer](const std::unique_ptr<Buffer> &item) { return item.get() == buffer; }));
+        }
+    }
+
+    void BackBufferPool::Release()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_generation++;
+        for (auto it = m_buffers.begin(); it != m_buffers.end();)
+        {
+            if ((*it)->inUse)
+            {
+                ++it;
+                continue;
+            }
+            Delete(**it);
+            it = m_buffers.erase(it);
+        }
+
+        log.Debug("Back buffers released, paints: %llu (%llu partial), pixels copied: %llu of %llu, "
+            "buffers created: %llu, reused: %llu, pooled: %zu bytes",
+            m_counters.paints, m_counters.partialPaints, m_counters.paintedPixels, m_counters.clientPixels,
+            m_counters.buffersCreated, m_counters.buffersReused, m_counters.pooledBytes);
+    }
+
+    void BackBufferPool::CountPaint(const RECT &client, const RECT &paint)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        unsigned long long clientPixels = (unsigned long long)(client.right - client.left) * (client.bottom - client.top);
+        unsigned long long paintedPixels = (unsigned long long)(paint.right - paint.left) * (paint.bottom - paint.top);
+
+        m_counters.paints++;
+        m_counters.clientPixels += clientPixels;
+        m_counters.paintedPixels += paintedPixels;
+        if (paintedPixels < clientPixels)
+        {
+            m_counters.partialPaints++;
+        }
+    }
+
+    PaintCounters BackBufferPool::GetCounters() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_counters;
+    }
+}
@@ -22,18 +22,79 @@
 //
 
 
+#pragma once
+
 #include <windows.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace FluentDesign
 {
+    struct PaintCounters
+    {
+        unsigned long long paints = 0;
+        unsigned long long partialPaints = 0;   // paints where rcPaint was smaller than the client area
+        unsigned long long clientPixels = 0;    // pixels a full client repaint would have copied
+        unsigned long long paintedPixels = 0;   // pixels actually copied to the screen
+        unsigned long long buffersCreated = 0;
+        unsigned long long buffersReused = 0;
+        unsigned long long buffersDeleted = 0;
+        size_t pooledBytes = 0;
+    };
+
+    // Back buffers shared by every DoubleBuferedPaint. Buffers are grouped by size
+    // class (power of two of width and height), kept between paints and only
+    // recreated when a paint in the same class needs a bigger one.
+    class BackBufferPool
+    {
+    public:
+        struct Buffer
+        {
+            HDC hdc = NULL;
+            HBITMAP hBitmap = NULL;
+            HBITMAP hOldBitmap = NULL;
+            int width = 0;
+            int height = 0;
+            int sizeClass = 0;
+            int savedDC = 0;
+            unsigned generation = 0;
+            bool inUse = false;
+        };
+
+        static BackBufferPool &Instance();
+
+        // Returns a memory DC at least width x height, compatible with hdc
+        Buffer *Acquire(HDC hdc, int width, int height);
+        void Return(Buffer *buffer);
+
+        // Frees the idle buffers, the busy ones are freed when returned.
+        // Called on DPI and theme changes.
+        void Release();
+
+        void CountPaint(const RECT &client, const RECT &paint);
+        PaintCounters GetCounters() const;
+
+    private:
+        static const size_t MaxIdlePerClass = 2;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<Buffer>> m_buffers;
+        unsigned m_generation = 0;
+        PaintCounters m_counters;
+
+        static int SizeClass(int width, int height);
+        bool Create(Buffer &buffer, HDC hdc, int width, int height);
+        void Delete(Buffer &buffer);
+    };
+
     class DoubleBuferedPaint
     {
         PAINTSTRUCT m_ps;
         RECT m_rect;
         HDC m_hdc;
         HDC m_hdcMem;
-        HBITMAP m_hbmMem;
-        HBITMAP m_hOldBitmap;
+        BackBufferPool::Buffer *m_buffer;
         int m_width;
         int m_height;
         HWND m_hWnd;
@@ -48,9 +109,11 @@ namespace FluentDesign
             m_height = m_rect.bottom - m_rect.top;
 
             // === DOUBLE BUFFERING START ===
-            m_hdcMem = CreateCompatibleDC(m_hdc);
-            m_hbmMem = CreateCompatibleBitmap(m_hdc, m_width, m_height);
-            m_hOldBitmap = (HBITMAP)SelectObject(m_hdcMem, m_hbmMem);
+            m_buffer = BackBufferPool::Instance().Acquire(m_hdc, m_width, m_height);
+            m_hdcMem = m_buffer ? m_buffer->hdc : NULL;
+
+            // Only the invalidated part is copied back, so nothing else has to be drawn
+            IntersectClipRect(m_hdcMem, m_ps.rcPaint.left, m_ps.rcPaint.top, m_ps.rcPaint.right, m_ps.rcPaint.bottom);
 
             HWND parent = GetParent(m_hWnd);
             if (parent)
@@ -69,16 +132,25 @@ namespace FluentDesign
             return m_rect;
         }
 
+        RECT PaintRect()
+        {
+            return m_ps.rcPaint;
+        }
+
         ~DoubleBuferedPaint()
         {
             // === DOUBLE BUFFERING - COPY TO SCREEN ===
-            BitBlt(m_hdc, 0, 0, m_width, m_height, m_hdcMem, 0, 0, SRCCOPY);
+            const RECT &paint = m_ps.rcPaint;
+            if (m_buffer)
+            {
+                BitBlt(m_hdc, paint.left, paint.top, paint.right - paint.left, paint.bottom - paint.top,
+                    m_hdcMem, paint.left, paint.top, SRCCOPY);
+            }
+            BackBufferPool::Instance().CountPaint(m_rect, paint);
 
-            // === CLEANUP DOUBLE BUFFERING ===
-            SelectObject(m_hdcMem, m_hOldBitmap);
+            // === RETURN BUFFER TO THE POOL ===
             SelectClipRgn(m_hdc, NULL);
-            DeleteObject(m_hbmMem);
-            DeleteDC(m_hdcMem);
+            BackBufferPool::Instance().Return(m_buffer);
 
             EndPaint(m_hWnd, &m_ps);
         }
@@ -0,0 +1,319 @@
+#include <windows.h>
+#include <cmath>
+#include <mutex>
+
+#include "Tools/GdiPlus.hpp"
+#include "Tools/LruCache.hpp"
+#include "Tools/NineSlice.hpp"
+
+#pragma comment(lib, "msimg32.lib")
+
+namespace Gdiplus
+{
+    namespace
+    {
+        // Positions and sizes are matched to 1/64 px
+        const REAL KeyScale = 64.0f;
+        const size_t GeometryCacheSize = 256;
+        const size_t SkinCacheSize = 32;
+
+        int Quantize(REAL value)
+        {
+            return (int)std::lround(value * KeyScale);
+        }
+
+        REAL Fraction(REAL value)
+        {
+            return value - std::floor(value);
+        }
+
+        // Skin corners have to hold the arc, the stroke and the anti-aliased fringe
+        int SkinInset(REAL cornerRadius, REAL strokeWidth)
+        {
+            return (int)std::ceil(cornerRadius / 2) + (int)std::ceil(strokeWidth) + 2;
+        }
+
+        size_t Combine(size_t seed, size_t value)
+        {
+            return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+
+        struct GeometryKey
+        {
+            int x;
+            int y;
+            int width;
+            int height;
+            int radius;
+            UINT flags;
+
+            bool operator==(const GeometryKey &other) const
+            {
+                return x == other.x && y == other.y && width == other.width && height == other.height
+                    && radius == other.radius && flags == other.flags;
+            }
+        };
+
+        struct GeometryKeyHash
+        {
+            size_t operator()(const GeometryKey &key) const
+            {
+                size_t seed = std::hash<int>()(key.width);
+                seed = Combine(seed, std::hash<int>()(key.height));
+                seed = Combine(seed, std::hash<int>()(key.x));
+                seed = Combine(seed, std::hash<int>()(key.y));
+                seed = Combine(seed, std::hash<int>()(key.radius));
+                return Combine(seed, std::hash<UINT>()(key.flags));
+            }
+        };
+
+        struct SkinKey
+        {
+            int left;
+            int top;
+            int right;
+            int bottom;
+            int radius;
+            int strokeWidth;
+            ARGB fill;
+            ARGB stroke;
+            UINT flags;
+
+            bool operator==(const SkinKey &other) const
+            {
+                return left == other.left && top == other.top && right == other.right && bottom == other.bottom
+                    && radius == other.radius && strokeWidth == other.strokeWidth
+                    && fill == other.fill && stroke == other.stroke && flags == other.flags;
+            }
+        };
+
+        struct SkinKeyHash
+        {
+            size_t operator()(const SkinKey &key) const
+            {
+                size_t seed = std::hash<int>()(key.radius);
+                seed = Combine(seed, std::hash<int>()(key.left));
+                seed = Combine(seed, std::hash<int>()(key.top));
+                seed = Combine(seed, std::hash<int>()(key.right));
+                seed = Combine(seed, std::hash<int>()(key.bottom));
+                seed = Combine(seed, std::hash<int>()(key.strokeWidth));
+                seed = Combine(seed, std::hash<ARGB>()(key.fill));
+                seed = Combine(seed, std::hash<ARGB>()(key.stroke));
+                return Combine(seed, std::hash<UINT>()(key.flags));
+            }
+        };
+
+        // Pre-rendered premultiplied 32bpp skin selected into its own memory DC
+        struct Skin
+        {
+            HDC hdc = NULL;
+            HBITMAP hBitmap = NULL;
+            HGDIOBJ hOldBitmap = NULL;
+            int inset = 0;
+
+            ~Skin()
+            {
+                if (hdc)
+                {
+                    SelectObject(hdc, hOldBitmap);
+                    DeleteDC(hdc);
+                }
+                if (hBitmap)
+                {
+                    DeleteObject(hBitmap);
+                }
+            }
+        };
+
+        using GeometryCache = AnyFSE::Tools::LruCache<GeometryKey, std::shared_ptr<const RoundRectGeometry>, GeometryKeyHash>;
+        using SkinCache = AnyFSE::Tools::LruCache<SkinKey, std::shared_ptr<Skin>, SkinKeyHash>;
+
+        std::mutex &CacheMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        GeometryCache &Geometries()
+        {
+            static GeometryCache cache(GeometryCacheSize);
+            return cache;
+        }
+
+        SkinCache &Skins()
+        {
+            static SkinCache cache(SkinCacheSize);
+            return cache;
+        }
+
+        void StorePath(GraphicsPath &path, RoundRectPath &target)
+        {
+            path.Flatten();
+
+            INT count = path.GetPointCount();
+            target.points.resize(count);
+            target.types.resize(count);
+            if (count > 0)
+            {
+                path.GetPathPoints(target.points.data(), count);
+                path.GetPathTypes(target.types.data(), count);
+            }
+        }
+
+        std::shared_ptr<Skin> RenderSkin(const RectF &rect, REAL cornerRadius, ARGB fill, ARGB stroke, REAL strokeWidth, UINT flags)
+        {
+            auto skin = std::make_shared<Skin>();
+
+            skin->inset = SkinInset(cornerRadius, strokeWidth);
+            int size = AnyFSE::Tools::NineSlice::SkinSize(skin->inset);
+
+            BITMAPINFO bmi = {};
+            bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bmi.bmiHeader.biWidth = size;
+            bmi.bmiHeader.biHeight = -size;
+            bmi.bmiHeader.biPlanes = 1;
+            bmi.bmiHeader.biBitCount = 32;
+            bmi.bmiHeader.biCompression = BI_RGB;
+
+            void *bits = nullptr;
+            skin->hBitmap = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+            if (!skin->hBitmap)
+            {
+                return nullptr;
+            }
+            ZeroMemory(bits, (size_t)size * size * 4);
+
+            {
+                Bitmap bitmap(size, size, size * 4, PixelFormat32bppPARGB, (BYTE *)bits);
+                Graphics graphics(&bitmap);
+                graphics.SetSmoothingMode(SmoothingModeAntiAlias);
+                graphics.SetPixelOffsetMode(PixelOffsetModeNone);
+
+                // Same fractional offsets as the target, the right and bottom edges land on the last pixel
+                RectF skinRect = rect;
+                skinRect.X = Fraction(rect.X);
+                skinRect.Y = Fraction(rect.Y);
+                skinRect.Width = size - (std::ceil(rect.GetRight()) - rect.GetRight()) - skinRect.X;
+                skinRect.Height = size - (std::ceil(rect.GetBottom()) - rect.GetBottom()) - skinRect.Y;
+
+                SolidBrush brush(fill);
+                Pen pen(stroke, strokeWidth);
+                RoundRect(graphics, skinRect, cornerRadius, &brush, pen, flags);
+            }
+            GdiFlush();
+
+            skin->hdc = CreateCompatibleDC(NULL);
+            if (!skin->hdc)
+            {
+                return nullptr;
+            }
+            skin->hOldBitmap = SelectObject(skin->hdc, skin->hBitmap);
+            return skin;
+        }
+    }
+
+    std::shared_ptr<const RoundRectGeometry> GetRoundRectGeometry(const RectF& rect, REAL cornerRadius, UINT flags)
+    {
+        GeometryKey key
+        {
+            Quantize(Fraction(rect.X)),
+            Quantize(Fraction(rect.Y)),
+            Quantize(rect.Width),
+            Quantize(rect.Height),
+            Quantize(cornerRadius),
+            flags
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex());
+            if (std::shared_ptr<const RoundRectGeometry> *cached = Geometries().Find(key))
+            {
+                return *cached;
+            }
+        }
+
+        RectF origin(Fraction(rect.X), Fraction(rect.Y), rect.Width, rect.Height);
+
+        GraphicsPath fill;
+        GraphicsPath strokes[5];
+        auto geometry = std::make_shared<RoundRectGeometry>();
+        geometry->strokeCount = BuildRoundRectPaths(origin, cornerRadius, flags, fill, strokes);
+
+        StorePath(fill, geometry->fill);
+        for (int i = 1; i <= geometry->strokeCount; ++i)
+        {
+            StorePath(strokes[i], geometry->strokes[i]);
+        }
+
+        std::lock_guard<std::mutex> lock(CacheMutex());
+        return Geometries().Insert(key, geometry);
+    }
+
+    bool DrawRoundRectSkin(HDC hdc, const RectF& rect, REAL cornerRadius, ARGB fill, ARGB stroke, REAL strokeWidth, UINT flags)
+    {
+        using namespace AnyFSE::Tools;
+
+        NineSlice::Rect target
+        {
+            (int)std::floor(rect.X),
+            (int)std::floor(rect.Y),
+            (int)std::ceil(rect.GetRight()) - (int)std::floor(rect.X),
+            (int)std::ceil(rect.GetBottom()) - (int)std::floor(rect.Y)
+        };
+
+        // The skin reproduces the rect only if neither side clamps the corner diameter
+        int inset = SkinInset(cornerRadius, strokeWidth);
+        if (rect.Width < cornerRadius + 2 || rect.Height < cornerRadius + 2
+            || target.width < inset * 2 || target.height < inset * 2)
+        {
+            return false;
+        }
+
+        SkinKey key
+        {
+            Quantize(Fraction(rect.X)),
+            Quantize(Fraction(rect.Y)),
+            Quantize(Fraction(rect.GetRight())),
+            Quantize(Fraction(rect.GetBottom())),
+            Quantize(cornerRadius),
+            Quantize(strokeWidth),
+            fill,
+            stroke,
+            flags
+        };
+
+        std::vector<NineSlice::Piece> pieces;
+        if (!NineSlice::Build(inset, target, pieces))
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(CacheMutex());
+
+        std::shared_ptr<Skin> skin;
+        if (std::shared_ptr<Skin> *cached = Skins().Find(key))
+        {
+            skin = *cached;
+        }
+        else
+        {
+            // Rendering goes through RoundRect and the geometry cache, which takes the lock itself
+            lock.unlock();
+            skin = RenderSkin(rect, cornerRadius, fill, stroke, strokeWidth, flags);
+            if (!skin)
+            {
+                return false;
+            }
+            lock.lock();
+            Skins().Insert(key, skin);
+        }
+
+        BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+        for (const NineSlice::Piece &piece : pieces)
+        {
+            AlphaBlend(hdc, piece.target.x, piece.target.y, piece.target.width, piece.target.height,
+                skin->hdc, piece.source.x, piece.source.y, piece.source.width, piece.source.height, blend);
+        }
+        return true;
+    }
+}
@@ -26,7 +26,10 @@
 
 #define byte ::byte
 #include <gdiplus.h>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Gdiplus
 {
@@ -84,29 +87,21 @@ namespace Gdiplus
         }
     }
 
-    static void RoundRect(Graphics& graphics, const RectF& origRect, REAL cornerRadius, const Brush *brush, const Pen &pen,
-        UINT flags = SIDE_ALL | CORNER_ALL
-    )
+    // Builds the fill path and the side strokes of a rounded rectangle, strokes[1..n] are used
+    static int BuildRoundRectPaths(const RectF& origRect, REAL cornerRadius, UINT flags, GraphicsPath &fill, GraphicsPath (&strokes)[5])
     {
         RectF rect = origRect;
         REAL dia = min(min(rect.Height, rect.Width), cornerRadius);
-        REAL radius = dia / 2;
 
-        if (brush)
-        {
-            GraphicsPath path;
-            AddCorner(path, CORNER_NE, flags & CORNER_NE, rect, dia);
-            AddCorner(path, CORNER_SE, flags & CORNER_SE, rect, dia);
-            AddCorner(path, CORNER_SW, flags & CORNER_SW, rect, dia);
-            AddCorner(path, CORNER_NW, flags & CORNER_NW, rect, dia);
-            path.CloseFigure();
-            graphics.FillPath(brush, &path);
-        }
+        AddCorner(fill, CORNER_NE, flags & CORNER_NE, rect, dia);
+        AddCorner(fill, CORNER_SE, flags & CORNER_SE, rect, dia);
+        AddCorner(fill, CORNER_SW, flags & CORNER_SW, rect, dia);
+        AddCorner(fill, CORNER_NW, flags & CORNER_NW, rect, dia);
+        fill.CloseFigure();
 
         RectF strokeRect = origRect;
         strokeRect.Inflate(-.5, -.5);
         dia = min(min(strokeRect.Height, strokeRect.Width), cornerRadius);
-        GraphicsPath strokes[5];
         int n = 0;
         if (flags & SIDE_TOP)
         {
@@ -137,11 +132,57 @@ namespace Gdiplus
             }
             AddCorner(strokes[n], CORNER_NW | (flags & SIDE_TOP), flags & CORNER_NW, strokeRect, dia);
         }
+        return n;
+    }
+
+    struct RoundRectPath
+    {
+        std::vector<PointF> points;
+        std::vector<BYTE> types;
+    };
+
+    // Kept as point data rather than GraphicsPath objects, so it outlives GdiplusShutdown
+    struct RoundRectGeometry
+    {
+        RoundRectPath fill;
+        RoundRectPath strokes[5];
+        int strokeCount = 0;
+    };
+
+    // Flattened paths of a rounded rectangle placed at the fractional part of rect's position,
+    // shared by all rectangles that differ only by whole pixels. Implemented in GdiPlus.cpp.
+    std::shared_ptr<const RoundRectGeometry> GetRoundRectGeometry(const RectF& rect, REAL cornerRadius, UINT flags);
+
+    // Blits the rounded rectangle as nine slices of a cached pre-rendered skin (anti-aliased,
+    // PixelOffsetModeNone). Returns false when rect is too small for the skin, the caller draws it then.
+    bool DrawRoundRectSkin(HDC hdc, const RectF& rect, REAL cornerRadius, ARGB fill, ARGB stroke, REAL strokeWidth,
+        UINT flags = SIDE_ALL | CORNER_ALL);
+
+    static void RoundRect(Graphics& graphics, const RectF& origRect, REAL cornerRadius, const Brush *brush, const Pen &pen,
+        UINT flags = SIDE_ALL | CORNER_ALL
+    )
+    {
+        std::shared_ptr<const RoundRectGeometry> geometry = GetRoundRectGeometry(origRect, cornerRadius, flags);
+
+        // Geometry sits at the fractional offset, move it by the whole pixels
+        GraphicsState state = graphics.Save();
+        graphics.TranslateTransform((REAL)floor(origRect.X), (REAL)floor(origRect.Y));
+
+        if (brush)
+        {
+            const RoundRectPath &fill = geometry->fill;
+            GraphicsPath path(fill.points.data(), fill.types.data(), (INT)fill.points.size());
+            graphics.FillPath(brush, &path);
+        }
 
-        for (int i = 0; i <= n; i++)
+        for (int i = 1; i <= geometry->strokeCount; i++)
         {
-            graphics.DrawPath(&pen, &strokes[i]);
+            const RoundRectPath &stroke = geometry->strokes[i];
+            GraphicsPath path(stroke.points.data(), stroke.types.data(), (INT)stroke.points.size());
+            graphics.DrawPath(&pen, &path);
         }
+
+        graphics.Restore(state);
     }
 
     static RectF ToRectF(const RECT &rect)
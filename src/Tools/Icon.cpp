@@ -31,7 +31,10 @@
 #include <shlobj_core.h>
 #include "Logging/LogManager.hpp"
 #include "Icon.hpp"
+#include "IconCache.hpp"
+#include "App/AppConstants.hpp"
 #include "Packages.hpp"
+#include "Unicode.hpp"
 
 namespace AnyFSE::Tools::Icon
 {
@@ -100,7 +103,8 @@ namespace AnyFSE::Tools::Icon
 
         return hIcon;
     }
-    HICON LoadIcon(const std::wstring &icon, int iconSize)
+
+    static HICON DecodeIcon(const std::wstring &icon, int iconSize)
     {
         if (icon.empty())
         {
@@ -165,44 +169,243 @@ namespace AnyFSE::Tools::Icon
         return hIcon;
     }
 
-    Gdiplus::Bitmap * LoadBitmapFromIcon(const std::wstring &icon, int iconSize)
+    struct CacheKey
     {
-        HICON hIcon = Icon::LoadIcon(icon, iconSize);
-        if (!hIcon)
+        std::string key;
+        uint32_t size = 0;
+        uint64_t stamp = 0;
+    };
+
+    // Packaged logos are stamped with the install location, a package update moves to a new versioned folder
+    static bool MakeCacheKey(const std::wstring &icon, int iconSize, CacheKey &cacheKey)
+    {
+        if (icon.empty())
         {
-            return nullptr;
+            return false;
+        }
+
+        cacheKey.key = Unicode::to_string(icon);
+        cacheKey.size = (uint32_t)iconSize;
+        cacheKey.stamp = 0;
+
+        std::error_code ec;
+        if (icon[0] == L'@')
+        {
+            // "@AUMID", "@family/Assets/file.png", or "@/Assets/file.png" of this package
+            std::wstring package = icon.substr(1, icon.find(L'/', 1) - 1);
+            std::wstring location = Packages::GetAppxInstallLocation(package.empty() ? AppConstants::PackageFamilyName : package);
+            if (location.empty())
+            {
+                return false;
+            }
+
+            auto installTime = std::filesystem::last_write_time(std::filesystem::path(location), ec);
+            cacheKey.stamp = IconAtlas::HashKey(Unicode::to_string(location))
+                ^ (ec ? 0 : (uint64_t)installTime.time_since_epoch().count());
+            return true;
+        }
+
+        auto writeTime = std::filesystem::last_write_time(std::filesystem::path(icon.substr(0, icon.find(L','))), ec);
+        if (ec)
+        {
+            return false;
+        }
+        cacheKey.stamp = (uint64_t)writeTime.time_since_epoch().count();
+        return true;
+    }
+
+    // Premultiplied BGRA of the icon, the mask stands in for alpha in icons without one
+    static bool ExtractPixels(HICON hIcon, uint32_t &width, uint32_t &height, std::vector<uint8_t> &pixels)
+    {
+        ICONINFO ii{};
+        if (!GetIconInfo(hIcon, &ii))
+        {
+            return false;
+        }
+
+        bool success = false;
+        BITMAP bm{};
+        if (ii.hbmColor && GetObject(ii.hbmColor, sizeof(bm), &bm) && bm.bmWidth > 0 && bm.bmHeight > 0)
+        {
+            width = (uint32_t)bm.bmWidth;
+            height = (uint32_t)bm.bmHeight;
+            pixels.assign((size_t)width * height * 4, 0);
+
+            BITMAPINFO bmi{};
+            bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bmi.bmiHeader.biWidth = bm.bmWidth;
+            bmi.bmiHeader.biHeight = -bm.bmHeight;
+            bmi.bmiHeader.biPlanes = 1;
+            bmi.bmiHeader.biBitCount = 32;
+            bmi.bmiHeader.biCompression = BI_RGB;
+
+            HDC hdc = GetDC(NULL);
+            success = GetDIBits(hdc, ii.hbmColor, 0, height, pixels.data(), &bmi, DIB_RGB_COLORS) == (int)height;
+
+            bool hasAlpha = false;
+            for (size_t i = 3; success && i < pixels.size() && !hasAlpha; i += 4)
+            {
+                hasAlpha = pixels[i] != 0;
+            }
+
+            if (success && !hasAlpha)
+            {
+                std::vector<uint8_t> mask(pixels.size());
+                success = ii.hbmMask && GetDIBits(hdc, ii.hbmMask, 0, height, mask.data(), &bmi, DIB_RGB_COLORS) == (int)height;
+                for (size_t i = 3; success && i < pixels.size(); i += 4)
+                {
+                    pixels[i] = mask[i - 3] ? 0 : 255;
+                }
+            }
+            ReleaseDC(NULL, hdc);
+
+            for (size_t i = 0; success && i < pixels.size(); i += 4)
+            {
+                uint8_t alpha = pixels[i + 3];
+                pixels[i + 0] = (uint8_t)(pixels[i + 0] * alpha / 255);
+                pixels[i + 1] = (uint8_t)(pixels[i + 1] * alpha / 255);
+                pixels[i + 2] = (uint8_t)(pixels[i + 2] * alpha / 255);
+            }
         }
 
-        //get the icon info
-        ICONINFO ii;
-        GetIconInfo(hIcon, &ii);
+        if (ii.hbmColor) DeleteObject(ii.hbmColor);
+        if (ii.hbmMask) DeleteObject(ii.hbmMask);
+        return success;
+    }
 
+    static HICON CreateIconFromImage(const IconAtlas::Image &image)
+    {
+        BITMAPV5HEADER bi{};
+        bi.bV5Size = sizeof(bi);
+        bi.bV5Width = (LONG)image.width;
+        bi.bV5Height = -(LONG)image.height;
+        bi.bV5Planes = 1;
+        bi.bV5BitCount = 32;
+        bi.bV5Compression = BI_BITFIELDS;
+        bi.bV5RedMask = 0x00FF0000;
+        bi.bV5GreenMask = 0x0000FF00;
+        bi.bV5BlueMask = 0x000000FF;
+        bi.bV5AlphaMask = 0xFF000000;
+
+        void *bits = nullptr;
+        HDC hdc = GetDC(NULL);
+        HBITMAP hbmColor = CreateDIBSection(hdc, (BITMAPINFO *)&bi, DIB_RGB_COLORS, &bits, NULL, 0);
+        ReleaseDC(NULL, hdc);
+        if (!hbmColor)
+        {
+            return NULL;
+        }
+
+        // Icons carry straight alpha
+        uint8_t *out = (uint8_t *)bits;
+        size_t count = (size_t)image.width * image.height * 4;
+        for (size_t i = 0; i < count; i += 4)
+        {
+            uint8_t alpha = image.pixels[i + 3];
+            for (size_t c = 0; c < 3; ++c)
+            {
+                out[i + c] = alpha ? (uint8_t)min(255, image.pixels[i + c] * 255 / alpha) : 0;
+            }
+            out[i + 3] = alpha;
+        }
+
+        HBITMAP hbmMask = CreateBitmap(image.width, image.height, 1, 1, NULL);
+
+        ICONINFO ii{};
+        ii.fIcon = TRUE;
+        ii.hbmColor = hbmColor;
+        ii.hbmMask = hbmMask;
+        HICON hIcon = CreateIconIndirect(&ii);
+
+        DeleteObject(hbmColor);
+        if (hbmMask) DeleteObject(hbmMask);
+        return hIcon;
+    }
+
+    static Gdiplus::Bitmap *CreateBitmapFromImage(const IconAtlas::Image &image)
+    {
         using namespace Gdiplus;
 
-        //create a bitmap from the ICONINFO so we can access the bitmapData
-        Bitmap bmpIcon(ii.hbmColor, NULL);
-        Rect rectBounds(0, 0, bmpIcon.GetWidth(), bmpIcon.GetHeight() );
+        Bitmap *bitmap = new Bitmap(image.width, image.height, PixelFormat32bppPARGB);
+        Rect rect(0, 0, image.width, image.height);
 
-        //get the BitmapData
-        BitmapData bmData;
-        bmpIcon.LockBits(&rectBounds, ImageLockModeRead, bmpIcon.GetPixelFormat(), &bmData);
+        BitmapData data;
+        if (bitmap->GetLastStatus() != Ok
+            || bitmap->LockBits(&rect, ImageLockModeWrite, PixelFormat32bppPARGB, &data) != Ok)
+        {
+            delete bitmap;
+            return nullptr;
+        }
 
-        Bitmap * tmp = new Bitmap(bmData.Width, bmData.Height, bmData.Stride, PixelFormat32bppARGB, (BYTE*)bmData.Scan0);
+        size_t rowBytes = (size_t)image.width * 4;
+        for (UINT y = 0; y < image.height; ++y)
+        {
+            memcpy((uint8_t *)data.Scan0 + (size_t)y * data.Stride, image.pixels + y * rowBytes, rowBytes);
+        }
+        bitmap->UnlockBits(&data);
+        return bitmap;
+    }
 
-        Bitmap * result = new Bitmap(bmpIcon.GetWidth(), bmpIcon.GetHeight(), PixelFormat32bppARGB);
-        Graphics graphics(result);
-        graphics.DrawImage(tmp, 0, 0, bmpIcon.GetWidth(), bmpIcon.GetHeight());
+    HICON LoadIcon(const std::wstring &icon, int iconSize)
+    {
+        CacheKey cacheKey;
+        bool cacheable = MakeCacheKey(icon, iconSize, cacheKey);
 
-        delete tmp;
+        HICON hIcon = NULL;
+        if (cacheable && IconCache::Instance().Find(cacheKey.key, cacheKey.size, cacheKey.stamp,
+            [&](const IconAtlas::Image &image) { hIcon = CreateIconFromImage(image); }) && hIcon)
+        {
+            return hIcon;
+        }
 
-        bmpIcon.UnlockBits(&bmData);
+        hIcon = DecodeIcon(icon, iconSize);
 
-        DestroyIcon(hIcon);
-        DeleteObject(ii.hbmColor);
-        DeleteObject(ii.hbmMask);
+        uint32_t width, height;
+        std::vector<uint8_t> pixels;
+        if (hIcon && cacheable && ExtractPixels(hIcon, width, height, pixels))
+        {
+            IconCache::Instance().Store(cacheKey.key, cacheKey.size, cacheKey.stamp, width, height, pixels.data());
+        }
+        return hIcon;
+    }
+
+    Gdiplus::Bitmap * LoadBitmapFromIcon(const std::wstring &icon, int iconSize)
+    {
+        CacheKey cacheKey;
+        bool cacheable = MakeCacheKey(icon, iconSize, cacheKey);
 
+        Gdiplus::Bitmap *result = nullptr;
+        if (cacheable && IconCache::Instance().Find(cacheKey.key, cacheKey.size, cacheKey.stamp,
+            [&](const IconAtlas::Image &image) { result = CreateBitmapFromImage(image); }) && result)
+        {
+            return result;
+        }
+
+        HICON hIcon = DecodeIcon(icon, iconSize);
+        if (!hIcon)
+        {
+            return nullptr;
+        }
+
+        uint32_t width, height;
+        std::vector<uint8_t> pixels;
+        if (ExtractPixels(hIcon, width, height, pixels))
+        {
+            if (cacheable)
+            {
+                IconCache::Instance().Store(cacheKey.key, cacheKey.size, cacheKey.stamp, width, height, pixels.data());
+            }
+            result = CreateBitmapFromImage(IconAtlas::Image{ width, height, pixels.data() });
+        }
+
+        DestroyIcon(hIcon);
         return result;
     }
+
+    void FlushCache()
+    {
+        IconCache::Instance().Flush();
+    }
 }
 
 namespace Icon = AnyFSE::Tools::Icon;
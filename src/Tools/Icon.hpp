@@ -31,4 +31,7 @@ namespace AnyFSE::Tools::Icon
 {
     HICON LoadIcon(const std::wstring& icon, int size = 256);
     Gdiplus::Bitmap * LoadBitmapFromIcon(const std::wstring &icon, int iconSize = 256);
+
+    // Saves icons decoded since the last flush, the next run loads them without decoding
+    void FlushCache();
 }
@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Tools/IconAtlas.hpp"
+
+namespace AnyFSE::Tools::IconAtlas
+{
+    namespace
+    {
+        const char Magic[4] = { 'A', 'F', 'I', 'A' };
+        const uint32_t Version = 1;
+
+        const size_t HeaderSize = 32;
+        const size_t EntrySize = 40;
+        const size_t PixelAlignment = 16;
+
+        uint32_t Read32(const uint8_t *data)
+        {
+            return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+        }
+
+        uint64_t Read64(const uint8_t *data)
+        {
+            return (uint64_t)Read32(data) | ((uint64_t)Read32(data + 4) << 32);
+        }
+
+        void Write32(std::vector<uint8_t> &out, size_t offset, uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out[offset + i] = (uint8_t)(value >> (i * 8));
+            }
+        }
+
+        void Write64(std::vector<uint8_t> &out, size_t offset, uint64_t value)
+        {
+            Write32(out, offset, (uint32_t)value);
+            Write32(out, offset + 4, (uint32_t)(value >> 32));
+        }
+
+        size_t Align(size_t value)
+        {
+            return (value + PixelAlignment - 1) / PixelAlignment * PixelAlignment;
+        }
+
+        size_t PixelBytes(uint32_t width, uint32_t height)
+        {
+            return (size_t)width * height * 4;
+        }
+    }
+
+    uint64_t HashKey(const std::string &key)
+    {
+        // FNV-1a, stable across builds and platforms
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : key)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool Reader::Open(const uint8_t *data, size_t size)
+    {
+        Close();
+
+        if (!data || size < HeaderSize || memcmp(data, Magic, sizeof(Magic)) != 0 || Read32(data + 4) != Version)
+        {
+            return false;
+        }
+
+        size_t count = Read32(data + 8);
+        size_t keysOffset = Read32(data + 12);
+        size_t pixelsOffset = Read32(data + 16);
+        size_t fileSize = Read32(data + 20);
+
+        if (fileSize != size
+            || HeaderSize + count * EntrySize > keysOffset
+            || keysOffset > pixelsOffset
+            || pixelsOffset > size)
+        {
+            return false;
+        }
+
+        m_data = data;
+        m_size = size;
+        m_count = count;
+        m_keysOffset = keysOffset;
+        m_pixelsOffset = pixelsOffset;
+        return true;
+    }
+
+    void Reader::Close()
+    {
+        m_data = nullptr;
+        m_size = 0;
+        m_count = 0;
+        m_keysOffset = 0;
+        m_pixelsOffset = 0;
+    }
+
+    Reader::Entry Reader::ReadEntry(size_t index) const
+    {
+        const uint8_t *p = m_data + HeaderSize + index * EntrySize;
+
+        Entry entry;
+        entry.hash = Read64(p);
+        entry.stamp = Read64(p + 8);
+        entry.keyOffset = Read32(p + 16);
+        entry.keyLength = Read32(p + 20);
+        entry.size = Read32(p + 24);
+        entry.width = Read32(p + 28);
+        entry.height = Read32(p + 32);
+        entry.pixelOffset = Read32(p + 36);
+        return entry;
+    }
+
+    bool Reader::Resolve(const Entry &entry, std::string *key, Image *image) const
+    {
+        if (entry.keyOffset > m_pixelsOffset - m_keysOffset
+            || entry.keyLength > m_pixelsOffset - m_keysOffset - entry.keyOffset)
+        {
+            return false;
+        }
+        size_t keyStart = m_keysOffset + entry.keyOffset;
+
+        size_t pixelBytes = PixelBytes(entry.width, entry.height);
+        if (entry.pixelOffset > m_size - m_pixelsOffset
+            || pixelBytes > m_size - m_pixelsOffset - entry.pixelOffset
+            || entry.pixelOffset % PixelAlignment != 0)
+        {
+            return false;
+        }
+
+        if (key)
+        {
+            key->assign((const char *)m_data + keyStart, entry.keyLength);
+        }
+        if (image)
+        {
+            image->width = entry.width;
+            image->height = entry.height;
+            image->pixels = m_data + m_pixelsOffset + entry.pixelOffset;
+        }
+        return true;
+    }
+
+    bool Reader::Find(const std::string &key, uint32_t size, uint64_t stamp, Image &image) const
+    {
+        if (!m_data)
+        {
+            return false;
+        }
+
+        uint64_t hash = HashKey(key);
+
+        // First entry not ordered before (hash, size)
+        size_t low = 0;
+        size_t high = m_count;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            Entry entry = ReadEntry(middle);
+            if (entry.hash < hash || (entry.hash == hash && entry.size < size))
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        std::string entryKey;
+        for (size_t index = low; index < m_count; ++index)
+        {
+            Entry entry = ReadEntry(index);
+            if (entry.hash != hash || entry.size != size)
+            {
+                break;
+            }
+            if (Resolve(entry, &entryKey, nullptr) && entryKey == key)
+            {
+                return entry.stamp == stamp && Resolve(entry, nullptr, &image);
+            }
+        }
+        return false;
+    }
+
+    void Reader::ForEach(const EntryFunc &func) const
+    {
+        std::string key;
+        Image image;
+        for (size_t index = 0; index < m_count; ++index)
+        {
+            Entry entry = ReadEntry(index);
+            if (Resolve(entry, &key, &image))
+            {
+                func(key, entry.size, entry.stamp, image);
+            }
+        }
+    }
+
+    Writer::Item *Writer::FindItem(const std::string &key, uint32_t size)
+    {
+        auto it = std::find_if(m_items.begin(), m_items.end(),
+            [&](const Item &item) { return item.size == size && item.key == key; });
+        return it != m_items.end() ? &*it : nullptr;
+    }
+
+    void Writer::Add(const std::string &key, uint32_t size, uint64_t stamp,
+        uint32_t width, uint32_t height, const uint8_t *pixels)
+    {
+        Item *item = FindItem(key, size);
+        if (!item)
+        {
+            m_items.emplace_back();
+            item = &m_items.back();
+            item->key = key;
+            item->size = size;
+        }
+
+        item->stamp = stamp;
+        item->width = width;
+        item->height = height;
+        item->pixels.assign(pixels, pixels + PixelBytes(width, height));
+    }
+
+    void Writer::Merge(const Reader &reader)
+    {
+        reader.ForEach([this](const std::string &key, uint32_t size, uint64_t stamp, const Image &image)
+        {
+            if (!FindItem(key, size))
+            {
+                Add(key, size, stamp, image.width, image.height, image.pixels);
+            }
+        });
+    }
+
+    bool Writer::Find(const std::string &key, uint32_t size, uint64_t stamp, Image &image) const
+    {
+        for (const Item &item : m_items)
+        {
+            if (item.size == size && item.key == key)
+            {
+                if (item.stamp != stamp)
+                {
+                    return false;
+                }
+                image.width = item.width;
+                image.height = item.height;
+                image.pixels = item.pixels.data();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<uint8_t> Writer::Serialize() const
+    {
+        std::vector<const Item *> items;
+        items.reserve(m_items.size());
+        for (const Item &item : m_items)
+        {
+            items.push_back(&item);
+        }
+
+        std::vector<uint64_t> hashes(m_items.size());
+        for (size_t i = 0; i < m_items.size(); ++i)
+        {
+            hashes[i] = HashKey(m_items[i].key);
+        }
+        auto hashOf = [&](const Item *item) { return hashes[item - m_items.data()]; };
+
+        std::sort(items.begin(), items.end(), [&](const Item *a, const Item *b)
+        {
+            uint64_t hashA = hashOf(a);
+            uint64_t hashB = hashOf(b);
+            return hashA != hashB ? hashA < hashB : a->size < b->size;
+        });
+
+        size_t keysSize = 0;
+        size_t pixelsSize = 0;
+        for (const Item *item : items)
+        {
+            keysSize += item->key.size();
+            pixelsSize = Align(pixelsSize) + item->pixels.size();
+        }
+
+        size_t keysOffset = HeaderSize + items.size() * EntrySize;
+        size_t pixelsOffset = Align(keysOffset + keysSize);
+        size_t fileSize = pixelsOffset + pixelsSize;
+
+        std::vector<uint8_t> out(fileSize, 0);
+        memcpy(out.data(), Magic, sizeof(Magic));
+        Write32(out, 4, Version);
+        Write32(out, 8, (uint32_t)items.size());
+        Write32(out, 12, (uint32_t)keysOffset);
+        Write32(out, 16, (uint32_t)pixelsOffset);
+        Write32(out, 20, (uint32_t)fileSize);
+
+        size_t keyOffset = 0;
+        size_t pixelOffset = 0;
+        for (size_t index = 0; index < items.size(); ++index)
+        {
+            const Item *item = items[index];
+            pixelOffset = Align(pixelOffset);
+
+            size_t entry = HeaderSize + index * EntrySize;
+            Write64(out, entry, hashOf(item));
+            Write64(out, entry + 8, item->stamp);
+            Write32(out, entry + 16, (uint32_t)keyOffset);
+            Write32(out, entry + 20, (uint32_t)item->key.size());
+            Write32(out, entry + 24, item->size);
+            Write32(out, entry + 28, item->width);
+            Write32(out, entry + 32, item->height);
+            Write32(out, entry + 36, (uint32_t)pixelOffset);
+
+            memcpy(out.data() + keysOffset + keyOffset, item->key.data(), item->key.size());
+            if (!item->pixels.empty())
+            {
+                memcpy(out.data() + pixelsOffset + pixelOffset, item->pixels.data(), item->pixels.size());
+            }
+
+            keyOffset += item->key.size();
+            pixelOffset += item->pixels.size();
+        }
+        return out;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Flat file of decoded icons, read in place from a memory mapping.
+//
+//   Header   magic "AFIA", version, entry count, offsets of the key and pixel blobs, file size
+//   Entries  sorted by key hash and size: hash, source stamp, key, size, width, height, pixels
+//   Keys     UTF-8 source paths or @AUMIDs, not terminated
+//   Pixels   premultiplied BGRA, top-down rows of width * 4 bytes, each image 16 byte aligned
+//
+// All numbers are little-endian. Offsets and lengths are checked on every lookup, so a truncated
+// or damaged file reads as a miss rather than out of bounds.
+namespace AnyFSE::Tools::IconAtlas
+{
+    struct Image
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        const uint8_t *pixels = nullptr;
+    };
+
+    typedef std::function<void(const std::string &key, uint32_t size, uint64_t stamp, const Image &image)> EntryFunc;
+
+    uint64_t HashKey(const std::string &key);
+
+    class Reader
+    {
+    public:
+        // The data has to outlive the reader, nothing is copied
+        bool Open(const uint8_t *data, size_t size);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        size_t Count() const { return m_count; }
+
+        // Stamp has to match the one stored, a changed source is a miss
+        bool Find(const std::string &key, uint32_t size, uint64_t stamp, Image &image) const;
+        void ForEach(const EntryFunc &func) const;
+
+    private:
+        struct Entry
+        {
+            uint64_t hash;
+            uint64_t stamp;
+            uint32_t keyOffset;
+            uint32_t keyLength;
+            uint32_t size;
+            uint32_t width;
+            uint32_t height;
+            uint32_t pixelOffset;
+        };
+
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_count = 0;
+        size_t m_keysOffset = 0;
+        size_t m_pixelsOffset = 0;
+
+        Entry ReadEntry(size_t index) const;
+        bool Resolve(const Entry &entry, std::string *key, Image *image) const;
+    };
+
+    class Writer
+    {
+    public:
+        // Replaces an entry with the same key and size
+        void Add(const std::string &key, uint32_t size, uint64_t stamp,
+            uint32_t width, uint32_t height, const uint8_t *pixels);
+
+        // Takes the entries of an existing file that were not added here
+        void Merge(const Reader &reader);
+
+        size_t Count() const { return m_items.size(); }
+        bool Empty() const { return m_items.empty(); }
+        void Clear() { m_items.clear(); }
+
+        // Entries not saved yet, the image stays valid until the writer changes
+        bool Find(const std::string &key, uint32_t size, uint64_t stamp, Image &image) const;
+
+        std::vector<uint8_t> Serialize() const;
+
+    private:
+        struct Item
+        {
+            std::string key;
+            uint32_t size;
+            uint64_t stamp;
+            uint32_t width;
+            uint32_t height;
+            std::vector<uint8_t> pixels;
+        };
+
+        std::vector<Item> m_items;
+
+        Item *FindItem(const std::string &key, uint32_t size);
+    };
+}
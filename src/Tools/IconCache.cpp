@@ -0,0 +1,223 @@
+#include <windows.h>
+#include <algorithm>
+#include <filesystem>
+
+#include "Tools/IconCache.hpp"
+#include "Tools/Paths.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace AnyFSE::Tools
+{
+    static Logger log = LogManager::GetLogger("IconCache");
+
+    namespace
+    {
+        // Fixed width hex, names sort like their generations
+        std::wstring FileName(uint64_t generation)
+        {
+            wchar_t name[64];
+            swprintf_s(name, L"IconCache-%016llx.bin", (unsigned long long)generation);
+            return name;
+        }
+    }
+
+    IconCache &IconCache::Instance()
+    {
+        static IconCache cache;
+        return cache;
+    }
+
+    IconCache::IconCache()
+        : m_folder(Paths::GetCachePath())
+    {
+        OpenFile();
+    }
+
+    IconCache::~IconCache()
+    {
+        CloseFile();
+    }
+
+    std::wstring IconCache::FindNewest(uint64_t &generation) const
+    {
+        generation = 0;
+        std::wstring newest;
+
+        WIN32_FIND_DATAW data;
+        HANDLE hFind = FindFirstFileW((m_folder + L"\\IconCache-*.bin").c_str(), &data);
+        if (hFind == INVALID_HANDLE_VALUE)
+        {
+            return newest;
+        }
+        do
+        {
+            unsigned long long value = 0;
+            if (swscanf_s(data.cFileName, L"IconCache-%llx", &value) == 1
+                && value > generation && FileName(value) == data.cFileName)
+            {
+                generation = value;
+                newest = m_folder + L"\\" + data.cFileName;
+            }
+        } while (FindNextFileW(hFind, &data));
+        FindClose(hFind);
+        return newest;
+    }
+
+    void IconCache::RemoveOlder(const std::wstring &current) const
+    {
+        // Files still mapped elsewhere refuse to go, a later flush takes them. IconCache.bin is the
+        // unversioned file of earlier builds.
+        WIN32_FIND_DATAW data;
+        HANDLE hFind = FindFirstFileW((m_folder + L"\\IconCache*.bin").c_str(), &data);
+        if (hFind == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        do
+        {
+            std::wstring path = m_folder + L"\\" + data.cFileName;
+            if (_wcsicmp(path.c_str(), current.c_str()) != 0)
+            {
+                DeleteFileW(path.c_str());
+            }
+        } while (FindNextFileW(hFind, &data));
+        FindClose(hFind);
+    }
+
+    void IconCache::OpenFile()
+    {
+        uint64_t generation = 0;
+        m_path = FindNewest(generation);
+        if (m_path.empty())
+        {
+            return;
+        }
+
+        m_hFile = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(m_hFile, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseFile();
+            return;
+        }
+
+        m_hMapping = CreateFileMappingW(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        m_view = m_hMapping ? (const uint8_t *)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!m_view)
+        {
+            log.Warn(log.APIError(), "Can't map icon cache %ls", m_path.c_str());
+            CloseFile();
+            return;
+        }
+
+        if (!m_reader.Open(m_view, (size_t)fileSize.QuadPart))
+        {
+            log.Warn("Icon cache %ls is damaged or outdated, it will be rebuilt", m_path.c_str());
+            CloseFile();
+            return;
+        }
+
+        log.Debug("Icon cache opened, %zu icons", m_reader.Count());
+    }
+
+    void IconCache::CloseFile()
+    {
+        m_reader.Close();
+        if (m_view)
+        {
+            UnmapViewOfFile(m_view);
+            m_view = nullptr;
+        }
+        if (m_hMapping)
+        {
+            CloseHandle(m_hMapping);
+            m_hMapping = NULL;
+        }
+        if (m_hFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_hFile);
+            m_hFile = INVALID_HANDLE_VALUE;
+        }
+    }
+
+    bool IconCache::Find(const std::string &key, uint32_t size, uint64_t stamp, const ImageFunc &use)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        IconAtlas::Image image;
+        if (m_pending.Find(key, size, stamp, image) || m_reader.Find(key, size, stamp, image))
+        {
+            use(image);
+            return true;
+        }
+        return false;
+    }
+
+    void IconCache::Store(const std::string &key, uint32_t size, uint64_t stamp,
+        uint32_t width, uint32_t height, const uint8_t *pixels)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.Add(key, size, stamp, width, height, pixels);
+    }
+
+    void IconCache::Flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.Empty())
+        {
+            return;
+        }
+
+        // Another module may have flushed since this one opened its file
+        uint64_t generation = 0;
+        if (FindNewest(generation) != m_path)
+        {
+            CloseFile();
+            OpenFile();
+        }
+
+        m_pending.Merge(m_reader);
+        std::vector<uint8_t> data = m_pending.Serialize();
+
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+        uint64_t next = std::max(((uint64_t)now.dwHighDateTime << 32) | now.dwLowDateTime, generation + 1);
+        std::wstring path = m_folder + L"\\" + FileName(next);
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_folder, ec);
+
+        std::wstring tempPath = path + L".tmp";
+        HANDLE hFile = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            log.Error(log.APIError(), "Can't create icon cache %ls", tempPath.c_str());
+            return;
+        }
+
+        DWORD written = 0;
+        BOOL success = WriteFile(hFile, data.data(), (DWORD)data.size(), &written, NULL) && written == data.size();
+        CloseHandle(hFile);
+
+        // A new name, no mapping of an older file stands in the way
+        if (!success || !MoveFileExW(tempPath.c_str(), path.c_str(), 0))
+        {
+            log.Error(log.APIError(), "Can't write icon cache %ls", path.c_str());
+            DeleteFileW(tempPath.c_str());
+            return;
+        }
+
+        log.Debug("Icon cache saved, %zu icons, %zu bytes", m_pending.Count(), data.size());
+        m_pending.Clear();
+
+        CloseFile();
+        RemoveOlder(path);
+        OpenFile();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <windows.h>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "Tools/IconAtlas.hpp"
+
+namespace AnyFSE::Tools
+{
+    // Decoded icons kept on disk as an IconAtlas file. The file is mapped read-only, a hit copies the
+    // pixels straight from the mapping. Misses are kept in memory and written together by Flush, so
+    // nothing touches the disk while a dialog is being built.
+    //
+    // A mapped file can't be replaced, and the exe, the settings library and other processes may each
+    // have one open. Every flush writes IconCache-<generation>.bin under a new name instead, readers open
+    // the newest one and older ones are removed once nobody maps them.
+    class IconCache
+    {
+    public:
+        typedef std::function<void(const IconAtlas::Image &image)> ImageFunc;
+
+        static IconCache &Instance();
+
+        // Calls use with the cached pixels, under the cache lock, the image is only valid inside
+        bool Find(const std::string &key, uint32_t size, uint64_t stamp, const ImageFunc &use);
+        void Store(const std::string &key, uint32_t size, uint64_t stamp,
+            uint32_t width, uint32_t height, const uint8_t *pixels);
+
+        // Rewrites the file with the new entries merged in
+        void Flush();
+
+        ~IconCache();
+
+    private:
+        std::mutex m_mutex;
+        std::wstring m_folder;
+        std::wstring m_path;
+
+        HANDLE m_hFile = INVALID_HANDLE_VALUE;
+        HANDLE m_hMapping = NULL;
+        const uint8_t *m_view = nullptr;
+
+        IconAtlas::Reader m_reader;
+        IconAtlas::Writer m_pending;
+
+        IconCache();
+
+        std::wstring FindNewest(uint64_t &generation) const;
+        void RemoveOlder(const std::wstring &current) const;
+        void OpenFile();
+        void CloseFile();
+    };
+}
@@ -0,0 +1,224 @@
+#include <windows.h>
+#include <algorithm>
+
+#include "Tools/IconLoader.hpp"
+#include "Tools/Icon.hpp"
+#include "Tools/Process.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace AnyFSE::Tools
+{
+    static Logger log = LogManager::GetLogger("IconLoader");
+
+    IconLoader &IconLoader::Instance()
+    {
+        static IconLoader loader;
+        return loader;
+    }
+
+    IconLoader::IconLoader()
+    {
+        QueryPerformanceFrequency(&m_frequency);
+    }
+
+    IconLoader::~IconLoader()
+    {
+        // Nothing is left to stop in the library, see Shutdown
+        Shutdown();
+    }
+
+    void IconLoader::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+            m_queue.clear();
+        }
+        m_wakeup.notify_all();
+
+        for (std::thread &worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+        m_requests.clear();
+        m_stopping = false;
+
+        if (m_hWnd)
+        {
+            // Results posted after the last callback still own an icon
+            MSG msg;
+            while (PeekMessage(&msg, m_hWnd, WM_ICON_LOADED, WM_ICON_LOADED, PM_REMOVE))
+            {
+                if (msg.lParam)
+                {
+                    DestroyIcon((HICON)msg.lParam);
+                }
+            }
+            DestroyWindow(m_hWnd);
+            m_hWnd = NULL;
+            UnregisterClass(ClassName, Process::GetModuleInstance());
+        }
+    }
+
+    LRESULT CALLBACK IconLoader::LoaderWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    {
+        if (uMsg == WM_ICON_LOADED)
+        {
+            IconLoader *This = reinterpret_cast<IconLoader *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+            if (This)
+            {
+                This->OnLoaded((UINT)wParam, (HICON)lParam);
+            }
+            else if (lParam)
+            {
+                DestroyIcon((HICON)lParam);
+            }
+            return 0;
+        }
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    bool IconLoader::CreateLoaderWindow()
+    {
+        if (m_hWnd)
+        {
+            return true;
+        }
+
+        // Registered by the module of the WndProc, the settings library unregisters it before unloading
+        HINSTANCE hInstance = Process::GetModuleInstance();
+
+        WNDCLASSEX wc = { sizeof(WNDCLASSEX) };
+        wc.lpfnWndProc = LoaderWndProc;
+        wc.hInstance = hInstance;
+        wc.lpszClassName = ClassName;
+        RegisterClassEx(&wc);
+
+        m_hWnd = CreateWindowEx(0, ClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, hInstance, NULL);
+        if (!m_hWnd)
+        {
+            log.Error(log.APIError(), "Can't create icon loader window");
+            return false;
+        }
+        SetWindowLongPtr(m_hWnd, GWLP_USERDATA, (LONG_PTR)this);
+        return true;
+    }
+
+    void IconLoader::StartWorkers()
+    {
+        if (!m_workers.empty())
+        {
+            return;
+        }
+
+        size_t count = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MaxWorkers);
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_workers.emplace_back(&IconLoader::WorkerProc, this);
+        }
+    }
+
+    UINT IconLoader::Request(const std::wstring &icon, int size, LoadedFunc loaded)
+    {
+        if (!loaded || !CreateLoaderWindow())
+        {
+            return 0;
+        }
+
+        if (m_requests.empty())
+        {
+            QueryPerformanceCounter(&m_batchStart);
+            m_batchCount = 0;
+        }
+
+        UINT id = m_nextId++;
+        m_requests[id] = std::move(loaded);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(Job{ id, icon, size });
+        }
+        StartWorkers();
+        m_wakeup.notify_one();
+        return id;
+    }
+
+    void IconLoader::Cancel(UINT id)
+    {
+        if (!id || !m_requests.erase(id))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+            [id](const Job &job) { return job.id == id; }), m_queue.end());
+    }
+
+    bool IconLoader::IsPending(UINT id) const
+    {
+        return id && m_requests.count(id);
+    }
+
+    void IconLoader::WorkerProc()
+    {
+        // Packages initializes WinRT as multithreaded, the worker has to agree
+        HRESULT hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
+
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeup.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                if (m_stopping)
+                {
+                    break;
+                }
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            HICON hIcon = Icon::LoadIcon(job.icon, job.size);
+            if (!PostMessage(m_hWnd, WM_ICON_LOADED, (WPARAM)job.id, (LPARAM)hIcon) && hIcon)
+            {
+                DestroyIcon(hIcon);
+            }
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            CoUninitialize();
+        }
+    }
+
+    void IconLoader::OnLoaded(UINT id, HICON hIcon)
+    {
+        auto it = m_requests.find(id);
+        if (it == m_requests.end())
+        {
+            if (hIcon)
+            {
+                DestroyIcon(hIcon);
+            }
+            return;
+        }
+
+        LoadedFunc loaded = std::move(it->second);
+        m_requests.erase(it);
+        m_batchCount++;
+
+        loaded(id, hIcon);
+
+        if (m_requests.empty())
+        {
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            log.Debug("Loaded %zu icons in %.1f ms", m_batchCount,
+                (double)(now.QuadPart - m_batchStart.QuadPart) * 1000.0 / (double)m_frequency.QuadPart);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <windows.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // Resolves icons on a small pool of workers, packaged logos go through PackageManager and must not
+    // block the UI thread. Results come back as posted messages, so callbacks run on the thread that
+    // made the request. A cancelled request never calls back, a job already running drops its icon.
+    // A library stops the workers with Shutdown before it is unloaded, joining them from a static
+    // destructor there would wait on the loader lock.
+    class IconLoader
+    {
+    public:
+        // The icon belongs to the callee, NULL when it could not be loaded
+        typedef std::function<void(UINT id, HICON hIcon)> LoadedFunc;
+
+        static IconLoader &Instance();
+
+        UINT Request(const std::wstring &icon, int size, LoadedFunc loaded);
+        void Cancel(UINT id);
+        bool IsPending(UINT id) const;
+        size_t GetPendingCount() const { return m_requests.size(); }
+
+        // Drops every request, joins the workers and destroys the window. Requesting again starts over.
+        void Shutdown();
+
+        ~IconLoader();
+
+    private:
+        struct Job
+        {
+            UINT id;
+            std::wstring icon;
+            int size;
+        };
+
+        static const UINT WM_ICON_LOADED = WM_APP + 1;
+        static const size_t MaxWorkers = 4;
+        static constexpr const wchar_t *ClassName = L"AnyFSE.IconLoader";
+
+        static LRESULT CALLBACK LoaderWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+        HWND m_hWnd = NULL;
+
+        // Worker side
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::deque<Job> m_queue;
+        std::vector<std::thread> m_workers;
+        bool m_stopping = false;
+
+        // UI thread side
+        std::unordered_map<UINT, LoadedFunc> m_requests;
+        UINT m_nextId = 1;
+        LARGE_INTEGER m_frequency{};
+        LARGE_INTEGER m_batchStart{};
+        size_t m_batchCount = 0;
+
+        IconLoader();
+
+        bool CreateLoaderWindow();
+        void StartWorkers();
+        void WorkerProc();
+        void OnLoaded(UINT id, HICON hIcon);
+    };
+}
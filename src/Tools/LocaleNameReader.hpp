@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Tools/nlohmann/json.hpp"
+
+namespace AnyFSE::Tools
+{
+    // SAX handler which stops the parser right after the top level "language" value,
+    // so getting a display name scans only the head of a locale file.
+    class LocaleNameReader : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        std::string language;
+
+        // False when the content has no top level "language" string
+        static bool Read(std::string_view content, std::string &language)
+        {
+            LocaleNameReader reader;
+            try
+            {
+                nlohmann::json::sax_parse(content.begin(), content.end(), &reader);
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+            if (reader.language.empty())
+            {
+                return false;
+            }
+            language = std::move(reader.language);
+            return true;
+        }
+
+        bool null() override { return Value(); }
+        bool boolean(bool) override { return Value(); }
+        bool number_integer(number_integer_t) override { return Value(); }
+        bool number_unsigned(number_unsigned_t) override { return Value(); }
+        bool number_float(number_float_t, const string_t &) override { return Value(); }
+        bool binary(binary_t &) override { return Value(); }
+
+        bool string(string_t &value) override
+        {
+            if (m_isLanguageKey)
+            {
+                language = value;
+                return false;
+            }
+            return Value();
+        }
+
+        bool key(string_t &value) override
+        {
+            m_isLanguageKey = m_depth == 1 && value == "language";
+            return true;
+        }
+
+        bool start_object(std::size_t) override { m_isLanguageKey = false; ++m_depth; return true; }
+        bool end_object() override { --m_depth; return true; }
+        bool start_array(std::size_t) override { m_isLanguageKey = false; ++m_depth; return true; }
+        bool end_array() override { --m_depth; return true; }
+
+        bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+        {
+            return false;
+        }
+
+    private:
+        int m_depth = 0;
+        bool m_isLanguageKey = false;
+
+        bool Value()
+        {
+            m_isLanguageKey = false;
+            return true;
+        }
+    };
+}
@@ -3,16 +3,19 @@
 #include <windows.h>
 
 #include <cstdarg>
+#include <cstring>
 #include <cwctype>
 #include <algorithm>
 #include <fstream>
 #include <map>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <vector>
 #include <set>
 
+#include "Tools/LocaleNameReader.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/Paths.hpp"
 #include "Tools/nlohmann/adl_serializer_wstring.hpp"
@@ -25,7 +28,9 @@ namespace AnyFSE::Tools::Localization
 
     namespace
     {
-        std::map<std::wstring, std::wstring> g_dictionary;
+        using Dictionary = std::vector<std::wstring>;
+
+        Dictionary g_dictionary(KeyCount);
         std::mutex g_lock;
         std::wstring g_forcedLocale;
         std::wstring g_currentLocale = L"en_US";
@@ -63,15 +68,56 @@ namespace AnyFSE::Tools::Localization
                 code = code.substr(1, code.size() - 2);
             }
             std::transform(code.begin(), code.end(), code.begin(), towupper);
-            (*locales)[code] = std::string(static_cast<const char *>(ptr), static_cast<size_t>(size));
+            (*locales)[code] = std::string_view(static_cast<const char *>(ptr), static_cast<size_t>(size));
             return TRUE;
         }
 
-        ResourceLocales LoadResourceLocalesFromModule(HMODULE hModule)
+        bool ReadLanguageName(std::string_view content, std::wstring &language)
+        {
+            std::string name;
+            if (!LocaleNameReader::Read(content, name))
+            {
+                return false;
+            }
+            language = Unicode::to_wstring(name);
+            return true;
+        }
+
+        struct ResourceLocaleIndex
+        {
+            ResourceLocales content;
+            std::vector<LocaleInfo> locales;    // sorted by display name
+        };
+
+        ResourceLocaleIndex BuildResourceLocaleIndex(HMODULE hModule)
+        {
+            ResourceLocaleIndex index;
+            EnumResourceNamesW(hModule, L"LOCALIZATION", EnumLocalizationResNameProc, reinterpret_cast<LONG_PTR>(&index.content));
+
+            for (const auto &[code, content] : index.content)
+            {
+                LocaleInfo info;
+                info.code = code;
+                if (!ReadLanguageName(content, info.language))
+                {
+                    info.language = code;
+                }
+                index.locales.push_back(info);
+            }
+
+            std::sort(index.locales.begin(), index.locales.end(), [](const LocaleInfo &a, const LocaleInfo &b)
+            {
+                return _wcsicmp(a.language.c_str(), b.language.c_str()) < 0;
+            });
+
+            return index;
+        }
+
+        // Embedded resources never change at runtime, so the index is built once on first use.
+        const ResourceLocaleIndex &GetResourceLocaleIndex()
         {
-            ResourceLocales locales;
-            EnumResourceNamesW(hModule, L"LOCALIZATION", EnumLocalizationResNameProc, reinterpret_cast<LONG_PTR>(&locales));
-            return locales;
+            static const ResourceLocaleIndex index = BuildResourceLocaleIndex(GetModuleHandleW(NULL));
+            return index;
         }
 
         std::wstring GetUserDefaultLocaleCode()
@@ -134,7 +180,20 @@ namespace AnyFSE::Tools::Localization
             return true;
         }
 
-        bool LoadLanguageJsonToMap(const nlohmann::json &parsed, std::map<std::wstring, std::wstring> &out)
+        const KeyIndexEntry *FindKey(const std::string &name)
+        {
+            const KeyIndexEntry *end = KeyIndex + KeyCount;
+            const KeyIndexEntry *it = std::lower_bound(KeyIndex, end, name.c_str(),
+                [](const KeyIndexEntry &entry, const char *value)
+                {
+                    return strcmp(entry.name, value) < 0;
+                });
+
+            return it != end && strcmp(it->name, name.c_str()) == 0 ? it : nullptr;
+        }
+
+        // Merges the known keys of a locale json into the dictionary, unknown keys are ignored.
+        bool LoadLanguageJsonToDictionary(const nlohmann::json &parsed, Dictionary &out)
         {
             if (!parsed.is_object())
             {
@@ -148,13 +207,19 @@ namespace AnyFSE::Tools::Localization
                     continue;
                 }
 
-                out[Unicode::to_wstring(key)] = Unicode::to_wstring(value.get<std::string>());
+                const KeyIndexEntry *entry = FindKey(key);
+                if (!entry)
+                {
+                    continue;
+                }
+
+                out[static_cast<size_t>(entry->id)] = Unicode::to_wstring(value.get<std::string>());
             }
 
             return true;
         }
 
-        bool LoadLanguageFileToMap(const std::wstring &filePath, std::map<std::wstring, std::wstring> &out)
+        bool LoadLanguageFileToDictionary(const std::wstring &filePath, Dictionary &out)
         {
             std::string content;
             if (!ReadFileUtf8(filePath, content))
@@ -165,7 +230,7 @@ namespace AnyFSE::Tools::Localization
             try
             {
                 const auto parsed = nlohmann::json::parse(content);
-                if (!LoadLanguageJsonToMap(parsed, out))
+                if (!LoadLanguageJsonToDictionary(parsed, out))
                 {
                     return false;
                 }
@@ -178,12 +243,12 @@ namespace AnyFSE::Tools::Localization
             return true;
         }
 
-        bool LoadLanguageContentToMap(const std::string &content, std::map<std::wstring, std::wstring> &out)
+        bool LoadLanguageContentToDictionary(std::string_view content, Dictionary &out)
         {
             try
             {
-                const auto parsed = nlohmann::json::parse(content);
-                if (!LoadLanguageJsonToMap(parsed, out))
+                const auto parsed = nlohmann::json::parse(content.begin(), content.end());
+                if (!LoadLanguageJsonToDictionary(parsed, out))
                 {
                     return false;
                 }
@@ -198,16 +263,7 @@ namespace AnyFSE::Tools::Localization
 
         bool LoadLanguageFile(const std::wstring &filePath)
         {
-            std::map<std::wstring, std::wstring> parsed;
-            if (!LoadLanguageFileToMap(filePath, parsed))
-            {
-                return false;
-            }
-            for (const auto &[key, value] : parsed)
-            {
-                g_dictionary[key] = value;
-            }
-            return true;
+            return LoadLanguageFileToDictionary(filePath, g_dictionary);
         }
 
         bool MergeLocaleFromMap(
@@ -223,17 +279,7 @@ namespace AnyFSE::Tools::Localization
                 return false;
             }
 
-            std::map<std::wstring, std::wstring> parsed;
-            if (!LoadLanguageContentToMap(it->second, parsed))
-            {
-                return false;
-            }
-
-            for (const auto &[k, v] : parsed)
-            {
-                g_dictionary[k] = v;
-            }
-            return true;
+            return LoadLanguageContentToDictionary(it->second, g_dictionary);
         }
 
         bool InitializeFromResourceLocales(const ResourceLocales &resourceLocales, const std::wstring &code)
@@ -246,7 +292,7 @@ namespace AnyFSE::Tools::Localization
             }
 
             std::lock_guard<std::mutex> guard(g_lock);
-            g_dictionary.clear();
+            g_dictionary.assign(KeyCount, std::wstring());
             g_currentLocale = L"en_US";
 
             MergeLocaleFromMap(resourceLocales, L"en_US");
@@ -264,51 +310,6 @@ namespace AnyFSE::Tools::Localization
             return true;
         }
 
-        std::vector<LocaleInfo> EnumerateResourceLocales(const ResourceLocales &resourceLocales)
-        {
-            if (resourceLocales.empty())
-            {
-                return EnumerateLocales();
-            }
-
-            std::vector<LocaleInfo> result;
-            std::set<std::wstring> seen;
-
-            for (const auto &[code, content] : resourceLocales)
-            {
-                std::wstring upperCode = code;
-                std::transform(upperCode.begin(), upperCode.end(), upperCode.begin(), towupper);
-
-                if (seen.find(upperCode) != seen.end())
-                {
-                    continue;
-                }
-
-                LocaleInfo info;
-                info.code = upperCode;
-                info.language = upperCode;
-                std::map<std::wstring, std::wstring> parsed;
-                if (LoadLanguageContentToMap(content, parsed))
-                {
-                    const auto it = parsed.find(L"language");
-                    if (it != parsed.end() && !it->second.empty())
-                    {
-                        info.language = it->second;
-                    }
-                }
-
-                seen.insert(info.code);
-                result.push_back(info);
-            }
-
-            std::sort(result.begin(), result.end(), [](const LocaleInfo &a, const LocaleInfo &b)
-            {
-                return _wcsicmp(a.language.c_str(), b.language.c_str()) < 0;
-            });
-
-            return result;
-        }
-
     }
 
     bool Initialize(const std::wstring &code)
@@ -318,7 +319,7 @@ namespace AnyFSE::Tools::Localization
         SetPreferredLocale(!code.empty() ? code : GetPreferedLocale());
 
         std::lock_guard<std::mutex> guard(g_lock);
-        g_dictionary.clear();
+        g_dictionary.assign(KeyCount, std::wstring());
         g_currentLocale = L"en_US";
 
         const fs::path programDataPath = fs::path(Paths::GetDataPath()) / L"Localization";
@@ -353,9 +354,9 @@ namespace AnyFSE::Tools::Localization
         return InitializeFromResourceLocales(LoadResourceLocales(), code);
     }
 
-    ResourceLocales LoadResourceLocales()
+    const ResourceLocales &LoadResourceLocales()
     {
-        return LoadResourceLocalesFromModule(GetModuleHandleW(NULL));
+        return GetResourceLocaleIndex().content;
     }
 
     std::vector<LocaleInfo> EnumerateLocales()
@@ -386,15 +387,10 @@ namespace AnyFSE::Tools::Localization
                     continue;
                 }
 
-                info.language = info.code;
-                std::map<std::wstring, std::wstring> parsed;
-                if (LoadLanguageFileToMap(entry.path().wstring(), parsed))
+                std::string content;
+                if (!ReadFileUtf8(entry.path().wstring(), content) || !ReadLanguageName(content, info.language))
                 {
-                    const auto it = parsed.find(L"language");
-                    if (it != parsed.end() && !it->second.empty())
-                    {
-                        info.language = it->second;
-                    }
+                    info.language = info.code;
                 }
 
                 seen.insert(info.code);
@@ -416,7 +412,12 @@ namespace AnyFSE::Tools::Localization
 
     std::vector<LocaleInfo> EnumerateResourceLocales()
     {
-        return EnumerateResourceLocales(LoadResourceLocales());
+        const ResourceLocaleIndex &index = GetResourceLocaleIndex();
+        if (index.locales.empty())
+        {
+            return EnumerateLocales();
+        }
+        return index.locales;
     }
 
     std::wstring GetCurrentLocale()
@@ -425,20 +426,27 @@ namespace AnyFSE::Tools::Localization
         return g_currentLocale;
     }
 
-    std::wstring Translate(const std::wstring &key)
+    std::wstring Translate(KeyId key)
     {
-        std::lock_guard<std::mutex> guard(g_lock);
-        const auto it = g_dictionary.find(key);
-        if (it == g_dictionary.end())
+        const size_t index = static_cast<size_t>(key);
+        if (index >= KeyCount)
+        {
+            return std::wstring();
+        }
+
         {
-            return key;
+            std::lock_guard<std::mutex> guard(g_lock);
+            if (!g_dictionary[index].empty())
+            {
+                return g_dictionary[index];
+            }
         }
-        return it->second;
+        return Unicode::to_wstring(KeyNames[index]);
     }
 
-    std::wstring VTranslateF(const wchar_t *key, va_list args)
+    std::wstring VTranslateF(KeyId key, va_list args)
     {
-        std::wstring format = Translate(key ? std::wstring(key) : std::wstring());
+        std::wstring format = Translate(key);
 
         va_list argsCopy;
         va_copy(argsCopy, args);
@@ -455,7 +463,7 @@ namespace AnyFSE::Tools::Localization
         return formatted;
     }
 
-    std::wstring TranslateF(const wchar_t *key, ...)
+    std::wstring TranslateF(KeyId key, ...)
     {
         va_list args;
         va_start(args, key);
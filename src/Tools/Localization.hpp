@@ -2,12 +2,17 @@
 
 #include <cstdarg>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 
+#include "Tools/LocalizationKeys.hpp"
+
 namespace AnyFSE::Tools::Localization
 {
-    using ResourceLocales = std::map<std::wstring, std::string>;
+    // Locale json embedded as LOCALIZATION resources, keyed by upper case locale code.
+    // The views point into the loaded module image and stay valid for the process lifetime.
+    using ResourceLocales = std::map<std::wstring, std::string_view>;
 
     struct LocaleInfo
     {
@@ -15,16 +20,17 @@ namespace AnyFSE::Tools::Localization
         std::wstring language;
     };
 
-    ResourceLocales LoadResourceLocales();
+    const ResourceLocales &LoadResourceLocales();
     bool Initialize(const std::wstring &code = L"");
     bool InitializeFromLocales(const std::wstring &code = L"");
     std::wstring GetCurrentLocale();
     std::vector<LocaleInfo> EnumerateLocales();
     std::vector<LocaleInfo> EnumerateResourceLocales();
-    std::wstring Translate(const std::wstring &key);
-    std::wstring TranslateF(const wchar_t *key, ...);
-    std::wstring VTranslateF(const wchar_t *key, va_list args);
+    std::wstring Translate(KeyId key);
+    std::wstring TranslateF(KeyId key, ...);
+    std::wstring VTranslateF(KeyId key, va_list args);
 }
 
+using AnyFSE::Tools::Localization::KeyId;
 using AnyFSE::Tools::Localization::Translate;
 using AnyFSE::Tools::Localization::TranslateF;
@@ -0,0 +1,583 @@
+// Generated by tools/GenerateLocalizationKeys.py from localization/en_US.json.
+// Do not edit manually: add keys to en_US.json and rebuild.
+#pragma once
+
+#include <cstddef>
+
+namespace AnyFSE::Tools::Localization
+{
+    enum class KeyId : int
+    {
+        language,
+        updaterWelcomeCaption,
+        updaterWelcomeDescription,
+        cancelBtn,
+        updateBtn,
+        installerWelcomeCaption,
+        installerWelcomeDescription,
+        nextBtn,
+        licenseCaption,
+        licenseDescription,
+        acceptBtn,
+        uninstallerWindowTitle,
+        uninstallerWelcomeCaption,
+        uninstallerWelcomeDescription,
+        uninstallBtn,
+        updaterProgressCaption,
+        installerProgressCaption,
+        progressPreparation,
+        doneBtn,
+        updaterDoneDescription,
+        installerDoneDescription,
+        uninstallerDoneDescription,
+        configureBtn,
+        closeBtn,
+        uninstallerInsufficientPermissionsCaption,
+        uninstallerInsufficientPermissionsDescription,
+        uninstallationErrorCaption,
+        jumpListEnterFse,
+        jumpListSettings,
+        progressUnpackFiles,
+        progressDownloadFiles,
+        progressRemoveOldVersion,
+        progressEnableDeveloperMode,
+        progressInstallPublisherCertificate,
+        progressRestoreAsusOptimizationService,
+        progressStopAcseInjectorService,
+        progressInstallPackage,
+        progressStartAcseInjectorService,
+        progressCleanupFiles,
+        progressDisableDeveloperMode,
+        progressRemovingCertificate,
+        installationErrorCaption,
+        updaterWindowTitle,
+        installerWindowTitle,
+        notSupportedCaption,
+        notSupportedDescription,
+        insufficientPermissionsCaption,
+        insufficientPermissionsDescription,
+        settingsMainWindowTitle,
+        settingsAppTitle,
+        settingsCaption,
+        settingsUpdateViewRelease,
+        settingsUpdateDownloadAndUpdate,
+        settingsCurrentVersionFmt,
+        settingsVersionFmt,
+        settingsAvailableVersionFmt,
+        settingsCheckingNewVersion,
+        settingsNetworkFailed,
+        settingsNewVersionAvailableFmt,
+        settingsNoNewVersionAvailable,
+        settingsFailedToDownload,
+        settingsDownloadingVersionFmt,
+        settingsUpdatingToVersionFmt,
+        settingsAddApplicationCaption,
+        settingsEditApplicationCaption,
+        settingsSelectAppToExecute,
+        browseBtn,
+        settingsAdditionalStartupArguments,
+        okBtn,
+        settingsChooseHomeApp,
+        settingsChooseHomeAppDescription,
+        settingsEnterFseOnStartup,
+        settingsLeaveFseOnHomeExit,
+        settingsLeaveFseOnHomeExitDescription,
+        settingsUseCustomSettings,
+        settingsUseCustomSettingsDescription,
+        settingsSplashScreenSettings,
+        settingsSplashScreenSettingsDescription,
+        settingsStartup,
+        settingsStartupDescription,
+        settingsAdditionalArguments,
+        settingsAdditionalArgumentsDescription,
+        settingsHomeApplicationDetection,
+        settingsHomeApplicationDetectionDescription,
+        settingsProcessName,
+        settingsProcessNameDescription,
+        settingsWindowClassName,
+        settingsWindowClassNameDescription,
+        settingsFieldWindowTitle,
+        settingsWindowTitleDescription,
+        settingsAlternativeModeDetection,
+        settingsAlternativeModeDetectionDescription,
+        settingsSecondaryProcessName,
+        settingsSecondaryProcessNameDescription,
+        settingsSecondaryWindowClassName,
+        settingsSecondaryWindowClassNameDescription,
+        settingsSecondaryWindowTitle,
+        settingsSecondaryWindowTitleDescription,
+        resetBtn,
+        settingsCustomSettings,
+        settingsSplashSettings,
+        settingsNativeLauncherSelected,
+        settingsNativeStartupSettings,
+        settingsNativeStartupSettingsDescription,
+        settingsAdditionalStartupApplications,
+        settingsAdditionalStartupApplicationsDescription,
+        addBtn,
+        modifyBtn,
+        deleteBtn,
+        settingsRelatedSupport,
+        settingsSupportAndCommunity,
+        settingsDiscordCommunity,
+        settingsNavigateLogsFolder,
+        settingsSourceCodeGithub,
+        settingsNavigateConfigFolder,
+        settingsSourceCodeCodeberg,
+        settingsNavigateSplashFolder,
+        settingsReportIssueGithub,
+        settingsReportIssueCodeberg,
+        settingsUpdateSettings,
+        settingsUpdateSettingsDescription,
+        settingsCheckPeriod,
+        settingsCheckPeriodDescription,
+        settingsCheckPeriodManual,
+        settingsCheckPeriodOnSettingsOpen,
+        settingsIncludePrerelease,
+        settingsIncludePrereleaseDescription,
+        settingsShowNotifications,
+        settingsShowNotificationsDescription,
+        settingsLanguageButton,
+        settingsSplashShowLoadingText,
+        settingsSplashUseCustomText,
+        settingsSplashShowHomeLogo,
+        settingsSplashAnimateLogo,
+        settingsSplashShowVideo,
+        settingsSplashShowVideoDescription,
+        settingsSplashPlayVideoAtLeastOnce,
+        settingsSplashPlayVideoAtLeastOnceDescription,
+        settingsSplashLoopVideo,
+        settingsSplashMuteVideo,
+        settingsSplashPauseCompleted,
+        settingsSplashPauseCompletedDescription,
+        settingsAllyFeatures,
+        settingsAllyFeaturesDescription,
+        settingsAllyEnableAlternativeButtons,
+        settingsAllyEnableAlternativeButtonsDescription,
+        settingsAllyPressArmouryCrate,
+        settingsAllyShortPressRightAction,
+        settingsAllyShortPressLeftAction,
+        settingsAllyHoldArmouryCrate,
+        settingsAllyLongPressRightAction,
+        settingsAllyPressCommandCenter,
+        settingsAllyPressLibrary,
+        settingsAllySecondaryButtonsActions,
+        settingsAllyModePressArmouryCrate,
+        settingsAllyShortPressRightActionMode,
+        settingsAllyShortPressLeftActionMode,
+        settingsAllyModeHoldArmouryCrate,
+        settingsAllyLongPressRightActionMode,
+        settingsAllyModePressCommandCenter,
+        settingsAllyModePressLibrary,
+        settingsAllyPageTitle,
+        settingsConfirmationsSetup,
+        settingsConfirmationsSetupDescription,
+        settingsConfirmationsEnterMode,
+        settingsConfirmationsEnterModeDescription,
+        settingsConfirmationsExitMode,
+        settingsConfirmationsAsk,
+        settingsConfirmationsRestartToOptimize,
+        settingsConfirmationsStartNowNoOptimizations,
+        settingsConfirmationsExitWithoutConfirmation,
+        settingsConfirmationsPageTitle,
+        settingsTroubleshootSetLogs,
+        settingsTroubleshootSetLogsDescription,
+        settingsTroubleshootPageTitle,
+        settingsLogLevelDisabled,
+        settingsLogLevelCritical,
+        settingsLogLevelError,
+        settingsLogLevelWarn,
+        settingsLogLevelInfo,
+        settingsLogLevelDebug,
+        settingsLogLevelTrace,
+        toggleOn,
+        toggleOff,
+        Count
+    };
+
+    constexpr size_t KeyCount = static_cast<size_t>(KeyId::Count);
+
+    // Key names indexed by KeyId.
+    constexpr const char *KeyNames[KeyCount] =
+    {
+        "language",
+        "updaterWelcomeCaption",
+        "updaterWelcomeDescription",
+        "cancelBtn",
+        "updateBtn",
+        "installerWelcomeCaption",
+        "installerWelcomeDescription",
+        "nextBtn",
+        "licenseCaption",
+        "licenseDescription",
+        "acceptBtn",
+        "uninstallerWindowTitle",
+        "uninstallerWelcomeCaption",
+        "uninstallerWelcomeDescription",
+        "uninstallBtn",
+        "updaterProgressCaption",
+        "installerProgressCaption",
+        "progressPreparation",
+        "doneBtn",
+        "updaterDoneDescription",
+        "installerDoneDescription",
+        "uninstallerDoneDescription",
+        "configureBtn",
+        "closeBtn",
+        "uninstallerInsufficientPermissionsCaption",
+        "uninstallerInsufficientPermissionsDescription",
+        "uninstallationErrorCaption",
+        "jumpListEnterFse",
+        "jumpListSettings",
+        "progressUnpackFiles",
+        "progressDownloadFiles",
+        "progressRemoveOldVersion",
+        "progressEnableDeveloperMode",
+        "progressInstallPublisherCertificate",
+        "progressRestoreAsusOptimizationService",
+        "progressStopAcseInjectorService",
+        "progressInstallPackage",
+        "progressStartAcseInjectorService",
+        "progressCleanupFiles",
+        "progressDisableDeveloperMode",
+        "progressRemovingCertificate",
+        "installationErrorCaption",
+        "updaterWindowTitle",
+        "installerWindowTitle",
+        "notSupportedCaption",
+        "notSupportedDescription",
+        "insufficientPermissionsCaption",
+        "insufficientPermissionsDescription",
+        "settingsMainWindowTitle",
+        "settingsAppTitle",
+        "settingsCaption",
+        "settingsUpdateViewRelease",
+        "settingsUpdateDownloadAndUpdate",
+        "settingsCurrentVersionFmt",
+        "settingsVersionFmt",
+        "settingsAvailableVersionFmt",
+        "settingsCheckingNewVersion",
+        "settingsNetworkFailed",
+        "settingsNewVersionAvailableFmt",
+        "settingsNoNewVersionAvailable",
+        "settingsFailedToDownload",
+        "settingsDownloadingVersionFmt",
+        "settingsUpdatingToVersionFmt",
+        "settingsAddApplicationCaption",
+        "settingsEditApplicationCaption",
+        "settingsSelectAppToExecute",
+        "browseBtn",
+        "settingsAdditionalStartupArguments",
+        "okBtn",
+        "settingsChooseHomeApp",
+        "settingsChooseHomeAppDescription",
+        "settingsEnterFseOnStartup",
+        "settingsLeaveFseOnHomeExit",
+        "settingsLeaveFseOnHomeExitDescription",
+        "settingsUseCustomSettings",
+        "settingsUseCustomSettingsDescription",
+        "settingsSplashScreenSettings",
+        "settingsSplashScreenSettingsDescription",
+        "settingsStartup",
+        "settingsStartupDescription",
+        "settingsAdditionalArguments",
+        "settingsAdditionalArgumentsDescription",
+        "settingsHomeApplicationDetection",
+        "settingsHomeApplicationDetectionDescription",
+        "settingsProcessName",
+        "settingsProcessNameDescription",
+        "settingsWindowClassName",
+        "settingsWindowClassNameDescription",
+        "settingsFieldWindowTitle",
+        "settingsWindowTitleDescription",
+        "settingsAlternativeModeDetection",
+        "settingsAlternativeModeDetectionDescription",
+        "settingsSecondaryProcessName",
+        "settingsSecondaryProcessNameDescription",
+        "settingsSecondaryWindowClassName",
+        "settingsSecondaryWindowClassNameDescription",
+        "settingsSecondaryWindowTitle",
+        "settingsSecondaryWindowTitleDescription",
+        "resetBtn",
+        "settingsCustomSettings",
+        "settingsSplashSettings",
+        "settingsNativeLauncherSelected",
+        "settingsNativeStartupSettings",
+        "settingsNativeStartupSettingsDescription",
+        "settingsAdditionalStartupApplications",
+        "settingsAdditionalStartupApplicationsDescription",
+        "addBtn",
+        "modifyBtn",
+        "deleteBtn",
+        "settingsRelatedSupport",
+        "settingsSupportAndCommunity",
+        "settingsDiscordCommunity",
+        "settingsNavigateLogsFolder",
+        "settingsSourceCodeGithub",
+        "settingsNavigateConfigFolder",
+        "settingsSourceCodeCodeberg",
+        "settingsNavigateSplashFolder",
+        "settingsReportIssueGithub",
+        "settingsReportIssueCodeberg",
+        "settingsUpdateSettings",
+        "settingsUpdateSettingsDescription",
+        "settingsCheckPeriod",
+        "settingsCheckPeriodDescription",
+        "settingsCheckPeriodManual",
+        "settingsCheckPeriodOnSettingsOpen",
+        "settingsIncludePrerelease",
+        "settingsIncludePrereleaseDescription",
+        "settingsShowNotifications",
+        "settingsShowNotificationsDescription",
+        "settingsLanguageButton",
+        "settingsSplashShowLoadingText",
+        "settingsSplashUseCustomText",
+        "settingsSplashShowHomeLogo",
+        "settingsSplashAnimateLogo",
+        "settingsSplashShowVideo",
+        "settingsSplashShowVideoDescription",
+        "settingsSplashPlayVideoAtLeastOnce",
+        "settingsSplashPlayVideoAtLeastOnceDescription",
+        "settingsSplashLoopVideo",
+        "settingsSplashMuteVideo",
+        "settingsSplashPauseCompleted",
+        "settingsSplashPauseCompletedDescription",
+        "settingsAllyFeatures",
+        "settingsAllyFeaturesDescription",
+        "settingsAllyEnableAlternativeButtons",
+        "settingsAllyEnableAlternativeButtonsDescription",
+        "settingsAllyPressArmouryCrate",
+        "settingsAllyShortPressRightAction",
+        "settingsAllyShortPressLeftAction",
+        "settingsAllyHoldArmouryCrate",
+        "settingsAllyLongPressRightAction",
+        "settingsAllyPressCommandCenter",
+        "settingsAllyPressLibrary",
+        "settingsAllySecondaryButtonsActions",
+        "settingsAllyModePressArmouryCrate",
+        "settingsAllyShortPressRightActionMode",
+        "settingsAllyShortPressLeftActionMode",
+        "settingsAllyModeHoldArmouryCrate",
+        "settingsAllyLongPressRightActionMode",
+        "settingsAllyModePressCommandCenter",
+        "settingsAllyModePressLibrary",
+        "settingsAllyPageTitle",
+        "settingsConfirmationsSetup",
+        "settingsConfirmationsSetupDescription",
+        "settingsConfirmationsEnterMode",
+        "settingsConfirmationsEnterModeDescription",
+        "settingsConfirmationsExitMode",
+        "settingsConfirmationsAsk",
+        "settingsConfirmationsRestartToOptimize",
+        "settingsConfirmationsStartNowNoOptimizations",
+        "settingsConfirmationsExitWithoutConfirmation",
+        "settingsConfirmationsPageTitle",
+        "settingsTroubleshootSetLogs",
+        "settingsTroubleshootSetLogsDescription",
+        "settingsTroubleshootPageTitle",
+        "settingsLogLevelDisabled",
+        "settingsLogLevelCritical",
+        "settingsLogLevelError",
+        "settingsLogLevelWarn",
+        "settingsLogLevelInfo",
+        "settingsLogLevelDebug",
+        "settingsLogLevelTrace",
+        "toggleOn",
+        "toggleOff",
+    };
+
+    struct KeyIndexEntry
+    {
+        const char *name;
+        KeyId id;
+    };
+
+    // Key names sorted by strcmp order, for binary search while loading locale files.
+    constexpr KeyIndexEntry KeyIndex[KeyCount] =
+    {
+        { "acceptBtn", KeyId::acceptBtn },
+        { "addBtn", KeyId::addBtn },
+        { "browseBtn", KeyId::browseBtn },
+        { "cancelBtn", KeyId::cancelBtn },
+        { "closeBtn", KeyId::closeBtn },
+        { "configureBtn", KeyId::configureBtn },
+        { "deleteBtn", KeyId::deleteBtn },
+        { "doneBtn", KeyId::doneBtn },
+        { "installationErrorCaption", KeyId::installationErrorCaption },
+        { "installerDoneDescription", KeyId::installerDoneDescription },
+        { "installerProgressCaption", KeyId::installerProgressCaption },
+        { "installerWelcomeCaption", KeyId::installerWelcomeCaption },
+        { "installerWelcomeDescription", KeyId::installerWelcomeDescription },
+        { "installerWindowTitle", KeyId::installerWindowTitle },
+        { "insufficientPermissionsCaption", KeyId::insufficientPermissionsCaption },
+        { "insufficientPermissionsDescription", KeyId::insufficientPermissionsDescription },
+        { "jumpListEnterFse", KeyId::jumpListEnterFse },
+        { "jumpListSettings", KeyId::jumpListSettings },
+        { "language", KeyId::language },
+        { "licenseCaption", KeyId::licenseCaption },
+        { "licenseDescription", KeyId::licenseDescription },
+        { "modifyBtn", KeyId::modifyBtn },
+        { "nextBtn", KeyId::nextBtn },
+        { "notSupportedCaption", KeyId::notSupportedCaption },
+        { "notSupportedDescription", KeyId::notSupportedDescription },
+        { "okBtn", KeyId::okBtn },
+        { "progressCleanupFiles", KeyId::progressCleanupFiles },
+        { "progressDisableDeveloperMode", KeyId::progressDisableDeveloperMode },
+        { "progressDownloadFiles", KeyId::progressDownloadFiles },
+        { "progressEnableDeveloperMode", KeyId::progressEnableDeveloperMode },
+        { "progressInstallPackage", KeyId::progressInstallPackage },
+        { "progressInstallPublisherCertificate", KeyId::progressInstallPublisherCertificate },
+        { "progressPreparation", KeyId::progressPreparation },
+        { "progressRemoveOldVersion", KeyId::progressRemoveOldVersion },
+        { "progressRemovingCertificate", KeyId::progressRemovingCertificate },
+        { "progressRestoreAsusOptimizationService", KeyId::progressRestoreAsusOptimizationService },
+        { "progressStartAcseInjectorService", KeyId::progressStartAcseInjectorService },
+        { "progressStopAcseInjectorService", KeyId::progressStopAcseInjectorService },
+        { "progressUnpackFiles", KeyId::progressUnpackFiles },
+        { "resetBtn", KeyId::resetBtn },
+        { "settingsAddApplicationCaption", KeyId::settingsAddApplicationCaption },
+        { "settingsAdditionalArguments", KeyId::settingsAdditionalArguments },
+        { "settingsAdditionalArgumentsDescription", KeyId::settingsAdditionalArgumentsDescription },
+        { "settingsAdditionalStartupApplications", KeyId::settingsAdditionalStartupApplications },
+        { "settingsAdditionalStartupApplicationsDescription", KeyId::settingsAdditionalStartupApplicationsDescription },
+        { "settingsAdditionalStartupArguments", KeyId::settingsAdditionalStartupArguments },
+        { "settingsAllyEnableAlternativeButtons", KeyId::settingsAllyEnableAlternativeButtons },
+        { "settingsAllyEnableAlternativeButtonsDescription", KeyId::settingsAllyEnableAlternativeButtonsDescription },
+        { "settingsAllyFeatures", KeyId::settingsAllyFeatures },
+        { "settingsAllyFeaturesDescription", KeyId::settingsAllyFeaturesDescription },
+        { "settingsAllyHoldArmouryCrate", KeyId::settingsAllyHoldArmouryCrate },
+        { "settingsAllyLongPressRightAction", KeyId::settingsAllyLongPressRightAction },
+        { "settingsAllyLongPressRightActionMode", KeyId::settingsAllyLongPressRightActionMode },
+        { "settingsAllyModeHoldArmouryCrate", KeyId::settingsAllyModeHoldArmouryCrate },
+        { "settingsAllyModePressArmouryCrate", KeyId::settingsAllyModePressArmouryCrate },
+        { "settingsAllyModePressCommandCenter", KeyId::settingsAllyModePressCommandCenter },
+        { "settingsAllyModePressLibrary", KeyId::settingsAllyModePressLibrary },
+        { "settingsAllyPageTitle", KeyId::settingsAllyPageTitle },
+        { "settingsAllyPressArmouryCrate", KeyId::settingsAllyPressArmouryCrate },
+        { "settingsAllyPressCommandCenter", KeyId::settingsAllyPressCommandCenter },
+        { "settingsAllyPressLibrary", KeyId::settingsAllyPressLibrary },
+        { "settingsAllySecondaryButtonsActions", KeyId::settingsAllySecondaryButtonsActions },
+        { "settingsAllyShortPressLeftAction", KeyId::settingsAllyShortPressLeftAction },
+        { "settingsAllyShortPressLeftActionMode", KeyId::settingsAllyShortPressLeftActionMode },
+        { "settingsAllyShortPressRightAction", KeyId::settingsAllyShortPressRightAction },
+        { "settingsAllyShortPressRightActionMode", KeyId::settingsAllyShortPressRightActionMode },
+        { "settingsAlternativeModeDetection", KeyId::settingsAlternativeModeDetection },
+        { "settingsAlternativeModeDetectionDescription", KeyId::settingsAlternativeModeDetectionDescription },
+        { "settingsAppTitle", KeyId::settingsAppTitle },
+        { "settingsAvailableVersionFmt", KeyId::settingsAvailableVersionFmt },
+        { "settingsCaption", KeyId::settingsCaption },
+        { "settingsCheckPeriod", KeyId::settingsCheckPeriod },
+        { "settingsCheckPeriodDescription", KeyId::settingsCheckPeriodDescription },
+        { "settingsCheckPeriodManual", KeyId::settingsCheckPeriodManual },
+        { "settingsCheckPeriodOnSettingsOpen", KeyId::settingsCheckPeriodOnSettingsOpen },
+        { "settingsCheckingNewVersion", KeyId::settingsCheckingNewVersion },
+        { "settingsChooseHomeApp", KeyId::settingsChooseHomeApp },
+        { "settingsChooseHomeAppDescription", KeyId::settingsChooseHomeAppDescription },
+        { "settingsConfirmationsAsk", KeyId::settingsConfirmationsAsk },
+        { "settingsConfirmationsEnterMode", KeyId::settingsConfirmationsEnterMode },
+        { "settingsConfirmationsEnterModeDescription", KeyId::settingsConfirmationsEnterModeDescription },
+        { "settingsConfirmationsExitMode", KeyId::settingsConfirmationsExitMode },
+        { "settingsConfirmationsExitWithoutConfirmation", KeyId::settingsConfirmationsExitWithoutConfirmation },
+        { "settingsConfirmationsPageTitle", KeyId::settingsConfirmationsPageTitle },
+        { "settingsConfirmationsRestartToOptimize", KeyId::settingsConfirmationsRestartToOptimize },
+        { "settingsConfirmationsSetup", KeyId::settingsConfirmationsSetup },
+        { "settingsConfirmationsSetupDescription", KeyId::settingsConfirmationsSetupDescription },
+        { "settingsConfirmationsStartNowNoOptimizations", KeyId::settingsConfirmationsStartNowNoOptimizations },
+        { "settingsCurrentVersionFmt", KeyId::settingsCurrentVersionFmt },
+        { "settingsCustomSettings", KeyId::settingsCustomSettings },
+        { "settingsDiscordCommunity", KeyId::settingsDiscordCommunity },
+        { "settingsDownloadingVersionFmt", KeyId::settingsDownloadingVersionFmt },
+        { "settingsEditApplicationCaption", KeyId::settingsEditApplicationCaption },
+        { "settingsEnterFseOnStartup", KeyId::settingsEnterFseOnStartup },
+        { "settingsFailedToDownload", KeyId::settingsFailedToDownload },
+        { "settingsFieldWindowTitle", KeyId::settingsFieldWindowTitle },
+        { "settingsHomeApplicationDetection", KeyId::settingsHomeApplicationDetection },
+        { "settingsHomeApplicationDetectionDescription", KeyId::settingsHomeApplicationDetectionDescription },
+        { "settingsIncludePrerelease", KeyId::settingsIncludePrerelease },
+        { "settingsIncludePrereleaseDescription", KeyId::settingsIncludePrereleaseDescription },
+        { "settingsLanguageButton", KeyId::settingsLanguageButton },
+        { "settingsLeaveFseOnHomeExit", KeyId::settingsLeaveFseOnHomeExit },
+        { "settingsLeaveFseOnHomeExitDescription", KeyId::settingsLeaveFseOnHomeExitDescription },
+        { "settingsLogLevelCritical", KeyId::settingsLogLevelCritical },
+        { "settingsLogLevelDebug", KeyId::settingsLogLevelDebug },
+        { "settingsLogLevelDisabled", KeyId::settingsLogLevelDisabled },
+        { "settingsLogLevelError", KeyId::settingsLogLevelError },
+        { "settingsLogLevelInfo", KeyId::settingsLogLevelInfo },
+        { "settingsLogLevelTrace", KeyId::settingsLogLevelTrace },
+        { "settingsLogLevelWarn", KeyId::settingsLogLevelWarn },
+        { "settingsMainWindowTitle", KeyId::settingsMainWindowTitle },
+        { "settingsNativeLauncherSelected", KeyId::settingsNativeLauncherSelected },
+        { "settingsNativeStartupSettings", KeyId::settingsNativeStartupSettings },
+        { "settingsNativeStartupSettingsDescription", KeyId::settingsNativeStartupSettingsDescription },
+        { "settingsNavigateConfigFolder", KeyId::settingsNavigateConfigFolder },
+        { "settingsNavigateLogsFolder", KeyId::settingsNavigateLogsFolder },
+        { "settingsNavigateSplashFolder", KeyId::settingsNavigateSplashFolder },
+        { "settingsNetworkFailed", KeyId::settingsNetworkFailed },
+        { "settingsNewVersionAvailableFmt", KeyId::settingsNewVersionAvailableFmt },
+        { "settingsNoNewVersionAvailable", KeyId::settingsNoNewVersionAvailable },
+        { "settingsProcessName", KeyId::settingsProcessName },
+        { "settingsProcessNameDescription", KeyId::settingsProcessNameDescription },
+        { "settingsRelatedSupport", KeyId::settingsRelatedSupport },
+        { "settingsReportIssueCodeberg", KeyId::settingsReportIssueCodeberg },
+        { "settingsReportIssueGithub", KeyId::settingsReportIssueGithub },
+        { "settingsSecondaryProcessName", KeyId::settingsSecondaryProcessName },
+        { "settingsSecondaryProcessNameDescription", KeyId::settingsSecondaryProcessNameDescription },
+        { "settingsSecondaryWindowClassName", KeyId::settingsSecondaryWindowClassName },
+        { "settingsSecondaryWindowClassNameDescription", KeyId::settingsSecondaryWindowClassNameDescription },
+        { "settingsSecondaryWindowTitle", KeyId::settingsSecondaryWindowTitle },
+        { "settingsSecondaryWindowTitleDescription", KeyId::settingsSecondaryWindowTitleDescription },
+        { "settingsSelectAppToExecute", KeyId::settingsSelectAppToExecute },
+        { "settingsShowNotifications", KeyId::settingsShowNotifications },
+        { "settingsShowNotificationsDescription", KeyId::settingsShowNotificationsDescription },
+        { "settingsSourceCodeCodeberg", KeyId::settingsSourceCodeCodeberg },
+        { "settingsSourceCodeGithub", KeyId::settingsSourceCodeGithub },
+        { "settingsSplashAnimateLogo", KeyId::settingsSplashAnimateLogo },
+        { "settingsSplashLoopVideo", KeyId::settingsSplashLoopVideo },
+        { "settingsSplashMuteVideo", KeyId::settingsSplashMuteVideo },
+        { "settingsSplashPauseCompleted", KeyId::settingsSplashPauseCompleted },
+        { "settingsSplashPauseCompletedDescription", KeyId::settingsSplashPauseCompletedDescription },
+        { "settingsSplashPlayVideoAtLeastOnce", KeyId::settingsSplashPlayVideoAtLeastOnce },
+        { "settingsSplashPlayVideoAtLeastOnceDescription", KeyId::settingsSplashPlayVideoAtLeastOnceDescription },
+        { "settingsSplashScreenSettings", KeyId::settingsSplashScreenSettings },
+        { "settingsSplashScreenSettingsDescription", KeyId::settingsSplashScreenSettingsDescription },
+        { "settingsSplashSettings", KeyId::settingsSplashSettings },
+        { "settingsSplashShowHomeLogo", KeyId::settingsSplashShowHomeLogo },
+        { "settingsSplashShowLoadingText", KeyId::settingsSplashShowLoadingText },
+        { "settingsSplashShowVideo", KeyId::settingsSplashShowVideo },
+        { "settingsSplashShowVideoDescription", KeyId::settingsSplashShowVideoDescription },
+        { "settingsSplashUseCustomText", KeyId::settingsSplashUseCustomText },
+        { "settingsStartup", KeyId::settingsStartup },
+        { "settingsStartupDescription", KeyId::settingsStartupDescription },
+        { "settingsSupportAndCommunity", KeyId::settingsSupportAndCommunity },
+        { "settingsTroubleshootPageTitle", KeyId::settingsTroubleshootPageTitle },
+        { "settingsTroubleshootSetLogs", KeyId::settingsTroubleshootSetLogs },
+        { "settingsTroubleshootSetLogsDescription", KeyId::settingsTroubleshootSetLogsDescription },
+        { "settingsUpdateDownloadAndUpdate", KeyId::settingsUpdateDownloadAndUpdate },
+        { "settingsUpdateSettings", KeyId::settingsUpdateSettings },
+        { "settingsUpdateSettingsDescription", KeyId::settingsUpdateSettingsDescription },
+        { "settingsUpdateViewRelease", KeyId::settingsUpdateViewRelease },
+        { "settingsUpdatingToVersionFmt", KeyId::settingsUpdatingToVersionFmt },
+        { "settingsUseCustomSettings", KeyId::settingsUseCustomSettings },
+        { "settingsUseCustomSettingsDescription", KeyId::settingsUseCustomSettingsDescription },
+        { "settingsVersionFmt", KeyId::settingsVersionFmt },
+        { "settingsWindowClassName", KeyId::settingsWindowClassName },
+        { "settingsWindowClassNameDescription", KeyId::settingsWindowClassNameDescription },
+        { "settingsWindowTitleDescription", KeyId::settingsWindowTitleDescription },
+        { "toggleOff", KeyId::toggleOff },
+        { "toggleOn", KeyId::toggleOn },
+        { "uninstallBtn", KeyId::uninstallBtn },
+        { "uninstallationErrorCaption", KeyId::uninstallationErrorCaption },
+        { "uninstallerDoneDescription", KeyId::uninstallerDoneDescription },
+        { "uninstallerInsufficientPermissionsCaption", KeyId::uninstallerInsufficientPermissionsCaption },
+        { "uninstallerInsufficientPermissionsDescription", KeyId::uninstallerInsufficientPermissionsDescription },
+        { "uninstallerWelcomeCaption", KeyId::uninstallerWelcomeCaption },
+        { "uninstallerWelcomeDescription", KeyId::uninstallerWelcomeDescription },
+        { "uninstallerWindowTitle", KeyId::uninstallerWindowTitle },
+        { "updateBtn", KeyId::updateBtn },
+        { "updaterDoneDescription", KeyId::updaterDoneDescription },
+        { "updaterProgressCaption", KeyId::updaterProgressCaption },
+        { "updaterWelcomeCaption", KeyId::updaterWelcomeCaption },
+        { "updaterWelcomeDescription", KeyId::updaterWelcomeDescription },
+        { "updaterWindowTitle", KeyId::updaterWindowTitle },
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace AnyFSE::Tools
+{
+    // Fixed capacity map that drops the least recently used entry when full.
+    // Not synchronized, owners guard it with their own lock.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache
+    {
+    public:
+        explicit LruCache(size_t capacity)
+            : m_capacity(capacity ? capacity : 1)
+        {}
+
+        // Returns the cached value and marks it as the most recently used, nullptr if absent.
+        Value *Find(const Key &key)
+        {
+            auto it = m_index.find(key);
+            if (it == m_index.end())
+            {
+                m_misses++;
+                return nullptr;
+            }
+            m_hits++;
+            m_items.splice(m_items.begin(), m_items, it->second);
+            return &it->second->second;
+        }
+
+        // Inserts or replaces the value, evicting the least recently used entries above capacity.
+        Value &Insert(const Key &key, Value value)
+        {
+            auto it = m_index.find(key);
+            if (it != m_index.end())
+            {
+                it->second->second = std::move(value);
+                m_items.splice(m_items.begin(), m_items, it->second);
+                return it->second->second;
+            }
+
+            m_items.emplace_front(key, std::move(value));
+            m_index[key] = m_items.begin();
+
+            while (m_items.size() > m_capacity)
+            {
+                m_index.erase(m_items.back().first);
+                m_items.pop_back();
+                m_evictions++;
+            }
+            return m_items.front().second;
+        }
+
+        void Clear()
+        {
+            m_index.clear();
+            m_items.clear();
+        }
+
+        size_t Size() const { return m_items.size(); }
+        size_t Capacity() const { return m_capacity; }
+
+        uint64_t Hits() const { return m_hits; }
+        uint64_t Misses() const { return m_misses; }
+        uint64_t Evictions() const { return m_evictions; }
+
+    private:
+        using Items = std::list<std::pair<Key, Value>>;
+
+        size_t m_capacity;
+        Items m_items;
+        std::unordered_map<Key, typename Items::iterator, Hash> m_index;
+
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+    };
+}
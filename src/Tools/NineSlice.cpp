@@ -0,0 +1,45 @@
+#include "Tools/NineSlice.hpp"
+
+namespace AnyFSE::Tools::NineSlice
+{
+    int SkinSize(int inset)
+    {
+        return inset * 2 + 1;
+    }
+
+    bool Build(int inset, const Rect &target, std::vector<Piece> &pieces)
+    {
+        pieces.clear();
+
+        if (inset < 0 || target.width < inset * 2 || target.height < inset * 2)
+        {
+            return false;
+        }
+
+        // Source and target spans of the left/top corner, the middle and the right/bottom corner
+        const int sourceStart[3] = { 0, inset, inset + 1 };
+        const int sourceSize[3] = { inset, 1, inset };
+
+        const int targetStartX[3] = { target.x, target.x + inset, target.x + target.width - inset };
+        const int targetSizeX[3] = { inset, target.width - inset * 2, inset };
+        const int targetStartY[3] = { target.y, target.y + inset, target.y + target.height - inset };
+        const int targetSizeY[3] = { inset, target.height - inset * 2, inset };
+
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                if (targetSizeX[column] <= 0 || targetSizeY[row] <= 0 || sourceSize[column] <= 0 || sourceSize[row] <= 0)
+                {
+                    continue;
+                }
+
+                Piece piece;
+                piece.source = Rect{ sourceStart[column], sourceStart[row], sourceSize[column], sourceSize[row] };
+                piece.target = Rect{ targetStartX[column], targetStartY[row], targetSizeX[column], targetSizeY[row] };
+                pieces.push_back(piece);
+            }
+        }
+        return true;
+    }
+}
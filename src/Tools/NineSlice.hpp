@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+namespace AnyFSE::Tools::NineSlice
+{
+    struct Rect
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    struct Piece
+    {
+        Rect source;
+        Rect target;
+    };
+
+    // Side of the square skin bitmap: two corners of inset pixels and one stretchable pixel between them
+    int SkinSize(int inset);
+
+    // Splits target into up to nine pieces copied from a SkinSize(inset) skin: corners 1:1,
+    // edges stretched along their side, center stretched both ways. Pieces of zero size are left out.
+    // Returns false when target is smaller than its two corners and can't be built from the skin.
+    bool Build(int inset, const Rect &target, std::vector<Piece> &pieces);
+}
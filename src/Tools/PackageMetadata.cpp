@@ -0,0 +1,182 @@
+#include "Tools/PackageMetadata.hpp"
+
+namespace AnyFSE::Tools
+{
+    namespace
+    {
+        // Apps not asked about for this many TTLs drop out of the batched process query
+        const int WatchTtls = 8;
+    }
+
+    std::wstring PackageMetadata::GetPackageFamilyName(const std::wstring &appUserModelID)
+    {
+        size_t pos = appUserModelID.find(L'!');
+        return pos == std::wstring::npos ? appUserModelID : appUserModelID.substr(0, pos);
+    }
+
+    PackageMetadata::PackageMetadata(PackageSource &source, Clock::duration processIdsTtl)
+        : m_source(source)
+        , m_processIdsTtl(processIdsTtl)
+    {
+    }
+
+    template <class Map, class Key, class Query>
+    typename Map::mapped_type PackageMetadata::Lookup(Map &map, const Key &key, Query query)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        auto it = map.find(key);
+        if (it != map.end())
+        {
+            m_stats.hits++;
+            return it->second;
+        }
+        m_stats.misses++;
+        size_t generation = m_generation;
+        lock.unlock();
+
+        typename Map::mapped_type value = query();
+
+        lock.lock();
+        if (generation == m_generation)
+        {
+            map.emplace(key, value);
+        }
+        return value;
+    }
+
+    std::wstring PackageMetadata::GetInstallLocation(const std::wstring &appUserModelID)
+    {
+        std::wstring familyName = GetPackageFamilyName(appUserModelID);
+        return Lookup(m_installLocations, familyName, [&] { return m_source.GetInstallLocation(familyName); });
+    }
+
+    std::wstring PackageMetadata::GetDisplayName(const std::wstring &appUserModelID)
+    {
+        std::wstring familyName = GetPackageFamilyName(appUserModelID);
+        return Lookup(m_displayNames, familyName, [&] { return m_source.GetDisplayName(familyName); });
+    }
+
+    std::vector<uint8_t> PackageMetadata::GetLogo(const std::wstring &path, int size)
+    {
+        return Lookup(m_logos, std::make_pair(path, size), [&] { return m_source.GetLogo(path, size); });
+    }
+
+    std::vector<std::wstring> PackageMetadata::GetGamingApps()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (m_hasGamingApps)
+        {
+            m_stats.hits++;
+            return m_gamingApps;
+        }
+        m_stats.misses++;
+        size_t generation = m_generation;
+        lock.unlock();
+
+        std::vector<std::wstring> apps = m_source.GetGamingApps();
+
+        lock.lock();
+        if (generation == m_generation)
+        {
+            m_gamingApps = apps;
+            m_hasGamingApps = true;
+        }
+        return apps;
+    }
+
+    std::vector<uint32_t> PackageMetadata::GetProcessIds(const std::wstring &appUserModelID)
+    {
+        std::map<std::wstring, std::vector<uint32_t>> processIds = GetProcessIds(std::set<std::wstring>{ appUserModelID });
+        return processIds[appUserModelID];
+    }
+
+    std::map<std::wstring, std::vector<uint32_t>> PackageMetadata::GetProcessIds(const std::set<std::wstring> &appUserModelIDs)
+    {
+        std::map<std::wstring, std::vector<uint32_t>> result;
+        std::set<std::wstring> query;
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        Clock::time_point now = Clock::now();
+
+        auto isFresh = [&](const Processes &processes)
+        {
+            return processes.queried != Clock::time_point() && now - processes.queried < m_processIdsTtl;
+        };
+
+        for (const std::wstring &appUserModelID : appUserModelIDs)
+        {
+            Processes &processes = m_processes[appUserModelID];
+            processes.asked = now;
+            if (isFresh(processes))
+            {
+                m_stats.hits++;
+                result[appUserModelID] = processes.ids;
+            }
+            else
+            {
+                m_stats.misses++;
+                query.insert(appUserModelID);
+            }
+        }
+
+        if (query.empty())
+        {
+            return result;
+        }
+
+        // Everything else polled lately rides along, the next tick of its caller finds it fresh
+        for (auto it = m_processes.begin(); it != m_processes.end();)
+        {
+            if (now - it->second.asked >= m_processIdsTtl * WatchTtls)
+            {
+                it = m_processes.erase(it);
+                continue;
+            }
+            if (!isFresh(it->second))
+            {
+                query.insert(it->first);
+            }
+            ++it;
+        }
+        m_stats.processQueries++;
+        lock.unlock();
+
+        std::map<std::wstring, std::vector<uint32_t>> found = m_source.GetProcessIds(query);
+
+        lock.lock();
+        Clock::time_point queried = Clock::now();
+        for (const std::wstring &appUserModelID : query)
+        {
+            std::vector<uint32_t> &ids = found[appUserModelID];
+            auto it = m_processes.find(appUserModelID);
+            if (it != m_processes.end())
+            {
+                it->second.ids = ids;
+                it->second.queried = queried;
+            }
+            if (appUserModelIDs.count(appUserModelID))
+            {
+                result[appUserModelID] = ids;
+            }
+        }
+        return result;
+    }
+
+    void PackageMetadata::Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_generation++;
+        m_installLocations.clear();
+        m_displayNames.clear();
+        m_logos.clear();
+        m_gamingApps.clear();
+        m_hasGamingApps = false;
+    }
+
+    PackageMetadata::Stats PackageMetadata::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_stats;
+    }
+}
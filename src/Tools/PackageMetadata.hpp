@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // What is asked of the package manager, WinRT on Windows or a synthetic catalog elsewhere. Every call is
+    // expected to be slow, PackageMetadata makes as few of them as it can.
+    class PackageSource
+    {
+    public:
+        virtual ~PackageSource() {}
+
+        // Empty when the family is not installed
+        virtual std::wstring GetInstallLocation(const std::wstring &familyName) = 0;
+        virtual std::wstring GetDisplayName(const std::wstring &familyName) = 0;
+
+        // A family logo, or a file inside the package with "family/Assets/file.png"
+        virtual std::vector<uint8_t> GetLogo(const std::wstring &path, int size) = 0;
+
+        // AUMIDs of the apps that declare themselves game launchers
+        virtual std::vector<std::wstring> GetGamingApps() = 0;
+
+        // Running processes of each of the apps in one query, apps without any may be left out
+        virtual std::map<std::wstring, std::vector<uint32_t>> GetProcessIds(const std::set<std::wstring> &appUserModelIDs) = 0;
+    };
+
+    // Package metadata by family, kept until Invalidate. Process ids change all the time, they are kept for
+    // ProcessIdsTtl and refreshed for all the apps asked about recently in one query.
+    class PackageMetadata
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Stats
+        {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t processQueries = 0;
+        };
+
+        static std::wstring GetPackageFamilyName(const std::wstring &appUserModelID);
+
+        explicit PackageMetadata(PackageSource &source, Clock::duration processIdsTtl = std::chrono::milliseconds(250));
+
+        std::wstring GetInstallLocation(const std::wstring &appUserModelID);
+        std::wstring GetDisplayName(const std::wstring &appUserModelID);
+        std::vector<uint8_t> GetLogo(const std::wstring &path, int size);
+        std::vector<std::wstring> GetGamingApps();
+
+        std::vector<uint32_t> GetProcessIds(const std::wstring &appUserModelID);
+        std::map<std::wstring, std::vector<uint32_t>> GetProcessIds(const std::set<std::wstring> &appUserModelIDs);
+
+        // A package was installed, updated or removed
+        void Invalidate();
+
+        Stats GetStats() const;
+
+    private:
+        struct Processes
+        {
+            std::vector<uint32_t> ids;
+            Clock::time_point queried;
+            Clock::time_point asked;
+        };
+
+        PackageSource &m_source;
+        Clock::duration m_processIdsTtl;
+
+        mutable std::mutex m_lock;
+        size_t m_generation = 0;
+        std::unordered_map<std::wstring, std::wstring> m_installLocations;
+        std::unordered_map<std::wstring, std::wstring> m_displayNames;
+        std::map<std::pair<std::wstring, int>, std::vector<uint8_t>> m_logos;
+        std::vector<std::wstring> m_gamingApps;
+        bool m_hasGamingApps = false;
+        std::unordered_map<std::wstring, Processes> m_processes;
+        Stats m_stats;
+
+        // Looks the key up, on a miss asks the source without the lock and keeps the answer unless an
+        // Invalidate came meanwhile
+        template <class Map, class Key, class Query>
+        typename Map::mapped_type Lookup(Map &map, const Key &key, Query query);
+    };
+}
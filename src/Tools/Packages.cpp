@@ -7,7 +7,9 @@
 
 #include "Packages.hpp"
 #include "App/AppConstants.hpp"
+#include "Tools/PackageMetadata.hpp"
 #include "Tools/Unicode.hpp"
+#include "Logging/LogManager.hpp"
 
 #include <winrt/windows.foundation.collections.h>
 #include <winrt/Windows.Management.Deployment.h>
@@ -28,154 +30,242 @@ using namespace Windows::ApplicationModel::AppExtensions;
 
 namespace AnyFSE::Tools::Packages
 {
-    std::wstring GetPackageFamilyName(const std::wstring& appUserModelID)
-    {
-        size_t pos = appUserModelID.find(L'!');
-        return pos == std::wstring::npos ? appUserModelID : appUserModelID.substr(0, pos);
-    }
+    static Logger log = LogManager::GetLogger("Packages");
 
-    std::wstring GetAppxInstallLocation(const std::wstring &appUserModelID)
+    namespace
     {
-        UINT32 count = 0;
-        UINT32 bufferLength = 0;
-
-        // Search for packages with the specific name pattern
-        std::wstring searchPattern = GetPackageFamilyName(appUserModelID);
+        class WinRTPackageSource : public PackageSource
+        {
+        public:
+            std::wstring GetInstallLocation(const std::wstring &familyName) override
+            {
+                UINT32 count = 0;
+                UINT32 bufferLength = 0;
+
+                // First call to get the count and buffer size
+                LONG result = GetPackagesByPackageFamily(
+                    familyName.c_str(),
+                    &count,
+                    nullptr,
+                    &bufferLength,
+                    nullptr);
+
+                if (result == ERROR_INSUFFICIENT_BUFFER && count > 0)
+                {
+                    std::vector<WCHAR> buffer(bufferLength);
+                    std::vector<WCHAR*> packageFullNames(count);
+
+                    // Second call to get the actual package names
+                    result = GetPackagesByPackageFamily(
+                        familyName.c_str(),
+                        &count,
+                        packageFullNames.data(),
+                        &bufferLength,
+                        buffer.data());
+
+                    if (result == ERROR_SUCCESS && count > 0)
+                    {
+                        // Get the install path for the first matching package
+                        WCHAR path[MAX_PATH];
+                        UINT32 pathLength = MAX_PATH;
+
+                        if (GetStagedPackagePathByFullName(buffer.data(), &pathLength, path) == ERROR_SUCCESS)
+                        {
+                            return std::wstring(path);
+                        }
+                    }
+                }
 
-        // First call to get the count and buffer size
-        LONG result = GetPackagesByPackageFamily(
-            searchPattern.c_str(),
-            &count,
-            nullptr,
-            &bufferLength,
-            nullptr);
+                return L"";
+            }
 
-        if (result == ERROR_INSUFFICIENT_BUFFER && count > 0)
-        {
-            std::vector<WCHAR> buffer(bufferLength);
-            std::vector<WCHAR*> packageFullNames(count);
-
-            // Second call to get the actual package names
-            result = GetPackagesByPackageFamily(
-                searchPattern.c_str(),
-                &count,
-                packageFullNames.data(),
-                &bufferLength,
-                buffer.data());
-
-            if (result == ERROR_SUCCESS && count > 0)
+            std::wstring GetDisplayName(const std::wstring &familyName) override
             {
-                // Get the install path for the first matching package
-                WCHAR path[MAX_PATH];
-                UINT32 pathLength = MAX_PATH;
+                auto packages = m_packageManager.FindPackagesForUser(L"", familyName);
 
-                if (GetStagedPackagePathByFullName(buffer.data(), &pathLength, path) == ERROR_SUCCESS)
+                for (auto const &pkg : packages)
                 {
-                    return std::wstring(path);
+                    return pkg.DisplayName().c_str();
                 }
+                return L"";
             }
-        }
 
-        return L"";
-    }
+            std::vector<uint8_t> GetLogo(const std::wstring &path, int size) override
+            {
+                std::wstring familyName;
+                std::wstring resourcePath;
+                size_t pathPos = path.find(L'/');
 
-    std::wstring GetAppDisplayName(const std::wstring &appUserModelID)
-    {
-        PackageManager pm;
-        auto packages = pm.FindPackagesForUser(L"", GetPackageFamilyName(appUserModelID));
+                familyName = pathPos ? PackageMetadata::GetPackageFamilyName(path.substr(0, pathPos)) : AppConstants::PackageFamilyName;
+                resourcePath = pathPos != std::wstring::npos ? path.substr(pathPos) : L"";
 
-        for (auto const &pkg : packages)
-        {
-            return pkg.DisplayName().c_str();
-        }
-        return L"";
-    }
-
-    std::vector<uint8_t> GetAppDisplayLogoRawBytes(const std::wstring &path, int size)
-    {
-        PackageManager pm;
+                auto packages = m_packageManager.FindPackagesForUser(L"", familyName);
 
-        std::wstring familyName;
-        std::wstring resourcePath;
-        size_t pathPos = path.find(L'/');
+                for (auto const &pkg : packages)
+                {
+                    try
+                    {
+                        Windows::Storage::Streams::IRandomAccessStreamWithContentType stream;
+                        if ( resourcePath.empty() )
+                        {
+                            auto logoRef = pkg.GetLogoAsRandomAccessStreamReference(Windows::Foundation::Size((float)size, (float)size));
+                            stream = logoRef.OpenReadAsync().get();
+                        }
+                        else
+                        {
+                            auto installFolder = pkg.InstalledLocation();
+                            std::replace(resourcePath.begin(), resourcePath.end(), L'/', L'\\');
+                            std::wstring fullPath = installFolder.Path().c_str() + resourcePath;
+                            auto file = Windows::Storage::StorageFile::GetFileFromPathAsync(fullPath).get();
+                            auto streamRef = RandomAccessStreamReference::CreateFromFile(file);
+
+                            stream = streamRef.OpenReadAsync().get();
+                        }
+
+                        auto buffer = Buffer(static_cast<uint32_t>(stream.Size()));
+                        auto readBuffer = stream.ReadAsync(buffer, (uint32_t)stream.Size(), InputStreamOptions::None).get();
+
+                        std::vector<uint8_t> bytes(readBuffer.Length());
+                        auto reader = DataReader::FromBuffer(readBuffer);
+                        reader.ReadBytes(bytes);
+
+                        return bytes;
+                    }
+                    catch (winrt::hresult_error const&)
+                    {
+                    }
+                }
+                return std::vector<uint8_t>();
+            }
 
-        familyName = pathPos ? GetPackageFamilyName(path.substr(0, pathPos)) : AppConstants::PackageFamilyName;
-        resourcePath = pathPos != std::wstring::npos ? path.substr(pathPos) : L"";
+            std::vector<std::wstring> GetGamingApps() override
+            {
+                std::vector<std::wstring> launchers;
 
-        auto packages = pm.FindPackagesForUser(L"", familyName);
+                auto catalog = AppExtensionCatalog::Open(L"windows.gamingApp");
+                auto extensions = catalog.FindAll();
 
-        for (auto const &pkg : packages)
-        {
-            try
-            {
-                Windows::Storage::Streams::IRandomAccessStreamWithContentType stream;
-                if ( resourcePath.empty() )
+                for (auto extension : extensions)
                 {
-                    auto logoRef = pkg.GetLogoAsRandomAccessStreamReference(Windows::Foundation::Size((float)size, (float)size));
-                    stream = logoRef.OpenReadAsync().get();
+                    launchers.push_back(extension.AppInfo().AppUserModelId().c_str());
                 }
-                else
-                {
-                    auto installFolder = pkg.InstalledLocation();
-                    std::replace(resourcePath.begin(), resourcePath.end(), L'/', L'\\');
-                    std::wstring fullPath = installFolder.Path().c_str() + resourcePath;
-                    auto file = Windows::Storage::StorageFile::GetFileFromPathAsync(fullPath).get();
-                    auto streamRef = RandomAccessStreamReference::CreateFromFile(file);
 
-                    stream = streamRef.OpenReadAsync().get();
-                }
+                return launchers;
+            }
 
-                auto buffer = Buffer(static_cast<uint32_t>(stream.Size()));
-                auto readBuffer = stream.ReadAsync(buffer, (uint32_t)stream.Size(), InputStreamOptions::None).get();
+            std::map<std::wstring, std::vector<uint32_t>> GetProcessIds(const std::set<std::wstring> &appUserModelIDs) override
+            {
+                std::map<std::wstring, std::vector<uint32_t>> pids;
 
-                std::vector<uint8_t> bytes(readBuffer.Length());
-                auto reader = DataReader::FromBuffer(readBuffer);
-                reader.ReadBytes(bytes);
+                // One app is asked for directly, several share the diagnostics of all running apps
+                auto infos = appUserModelIDs.size() == 1
+                    ? AppDiagnosticInfo::RequestInfoForAppAsync(*appUserModelIDs.begin()).get()
+                    : AppDiagnosticInfo::RequestInfoAsync().get();
 
-                return bytes;
+                for (const auto& info : infos)
+                {
+                    std::wstring appUserModelID = appUserModelIDs.size() == 1
+                        ? *appUserModelIDs.begin()
+                        : std::wstring(info.AppInfo().AppUserModelId().c_str());
+                    if (!appUserModelIDs.count(appUserModelID))
+                    {
+                        continue;
+                    }
+
+                    std::vector<uint32_t> &ids = pids[appUserModelID];
+                    for (const auto& group : info.GetResourceGroups())
+                    {
+                        for (const auto& process : group.GetProcessDiagnosticInfos())
+                        {
+                            ids.push_back(process.ProcessId());
+                        }
+                    }
+                }
+                return pids;
             }
-            catch (winrt::hresult_error const&)
+
+        private:
+            PackageManager m_packageManager;
+        };
+
+        // Created on first use, the catalog events drop the cached metadata whenever a package comes or goes
+        class PackageService
+        {
+        public:
+            static PackageService &Instance()
             {
+                static PackageService service;
+                return service;
             }
-        }
-        return std::vector<uint8_t>();
-    }
 
-    std::vector<DWORD> GetAppProcessIds(const std::wstring &appUserModelID)
-    {
-        std::vector<DWORD> pids;
-        auto infos = AppDiagnosticInfo::RequestInfoForAppAsync(appUserModelID).get();
+            PackageMetadata &Metadata() { return m_metadata; }
 
-        for (const auto& info : infos)
-        {
-            auto groups = info.GetResourceGroups();
-            for (const auto& group : groups)
+        private:
+            WinRTPackageSource m_source;
+            PackageMetadata m_metadata;
+            Windows::ApplicationModel::PackageCatalog m_catalog{ nullptr };
+
+            PackageService()
+                : m_metadata(m_source)
             {
-                auto processes = group.GetProcessDiagnosticInfos();
-                for (const auto& process : processes)
+                try
+                {
+                    m_catalog = Windows::ApplicationModel::PackageCatalog::OpenForCurrentUser();
+                    m_catalog.PackageInstalling([this](auto &&, PackageInstallingEventArgs const &args)
+                    {
+                        if (args.IsComplete()) m_metadata.Invalidate();
+                    });
+                    m_catalog.PackageUninstalling([this](auto &&, PackageUninstallingEventArgs const &args)
+                    {
+                        if (args.IsComplete()) m_metadata.Invalidate();
+                    });
+                    m_catalog.PackageUpdating([this](auto &&, PackageUpdatingEventArgs const &args)
+                    {
+                        if (args.IsComplete()) m_metadata.Invalidate();
+                    });
+                    m_catalog.PackageStatusChanged([this](auto &&, PackageStatusChangedEventArgs const &)
+                    {
+                        m_metadata.Invalidate();
+                    });
+                }
+                catch (winrt::hresult_error const &e)
                 {
-                    const wchar_t * c = process.ExecutableFileName().c_str();
-                    pids.push_back(process.ProcessId());
+                    log.Error("Can't watch package changes, cached metadata stays until restart: %s",
+                        Unicode::to_string(e.message().c_str()).c_str());
                 }
             }
-        }
-        return pids;
+        };
     }
 
-    std::vector<std::wstring> GetNativeLaunchers()
+    std::wstring GetPackageFamilyName(const std::wstring& appUserModelID)
     {
-        std::vector<std::wstring> launchers;
+        return PackageMetadata::GetPackageFamilyName(appUserModelID);
+    }
 
-        auto catalog = AppExtensionCatalog::Open(L"windows.gamingApp");
-        auto extensions = catalog.FindAll();
+    std::wstring GetAppxInstallLocation(const std::wstring &appUserModelID)
+    {
+        return PackageService::Instance().Metadata().GetInstallLocation(appUserModelID);
+    }
 
-        for (auto extension : extensions)
-        {
-            launchers.push_back(extension.AppInfo().AppUserModelId().c_str());
-        }
+    std::wstring GetAppDisplayName(const std::wstring &appUserModelID)
+    {
+        return PackageService::Instance().Metadata().GetDisplayName(appUserModelID);
+    }
+
+    std::vector<uint8_t> GetAppDisplayLogoRawBytes(const std::wstring &path, int size)
+    {
+        return PackageService::Instance().Metadata().GetLogo(path, size);
+    }
 
-        return launchers;
+    std::vector<DWORD> GetAppProcessIds(const std::wstring &appUserModelID)
+    {
+        std::vector<uint32_t> pids = PackageService::Instance().Metadata().GetProcessIds(appUserModelID);
+        return std::vector<DWORD>(pids.begin(), pids.end());
+    }
 
+    std::vector<std::wstring> GetNativeLaunchers()
+    {
+        return PackageService::Instance().Metadata().GetGamingApps();
     }
 
     bool IsPackageInstalled(const std::wstring &packageFamilyName)
@@ -79,6 +79,11 @@ namespace AnyFSE::Tools::Paths
         return Tools::Paths::GetAppLocalCachePath() + L"\\logs";
     }
 
+    std::wstring GetCachePath()
+    {
+        return Tools::Paths::GetAppLocalCachePath();
+    }
+
     std::wstring GetTempPath()
     {
         return Tools::Paths::GetAppTempPath();
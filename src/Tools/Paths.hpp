@@ -5,6 +5,7 @@ namespace AnyFSE::Tools::Paths
 {
     std::wstring GetConfigPath();
     std::wstring GetLogsPath();
+    std::wstring GetCachePath();
     std::wstring GetTempPath();
     std::wstring GetDumpsPath();
     std::wstring GetSplashDefaultPath();
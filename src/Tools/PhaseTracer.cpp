@@ -0,0 +1,177 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#include "Tools/PhaseTracer.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+namespace AnyFSE::Tools
+{
+    PhaseTracer::Scope::Scope(const char *name, const char *category)
+        : m_name(name)
+        , m_category(category)
+        , m_start(PhaseTracer::Instance().Now())
+    {
+    }
+
+    PhaseTracer::Scope::~Scope()
+    {
+        PhaseTracer &tracer = PhaseTracer::Instance();
+        tracer.Complete(m_name, m_category, m_start, tracer.Now());
+    }
+
+    PhaseTracer &PhaseTracer::Instance()
+    {
+        static PhaseTracer tracer;
+        return tracer;
+    }
+
+    uint32_t PhaseTracer::CurrentThreadId()
+    {
+        static std::atomic<uint32_t> nextId{ 1 };
+        thread_local uint32_t threadId = nextId++;
+        return threadId;
+    }
+
+    int64_t PhaseTracer::Now() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_origin).count();
+    }
+
+    void PhaseTracer::Instant(const char *name, const char *category)
+    {
+        Event event;
+        event.name = name;
+        event.category = category;
+        event.phase = 'i';
+        event.timestampUs = Now();
+        Add(event);
+    }
+
+    void PhaseTracer::Begin(const char *name, const char *category)
+    {
+        Event event;
+        event.name = name;
+        event.category = category;
+        event.phase = 'B';
+        event.timestampUs = Now();
+        Add(event);
+    }
+
+    void PhaseTracer::End(const char *name, const char *category)
+    {
+        Event event;
+        event.name = name;
+        event.category = category;
+        event.phase = 'E';
+        event.timestampUs = Now();
+        Add(event);
+    }
+
+    void PhaseTracer::Complete(const char *name, const char *category, int64_t startUs, int64_t endUs)
+    {
+        Event event;
+        event.name = name;
+        event.category = category;
+        event.phase = 'X';
+        event.timestampUs = startUs;
+        event.durationUs = endUs > startUs ? endUs - startUs : 0;
+        Add(event);
+    }
+
+    void PhaseTracer::Add(const Event &event)
+    {
+        Event traced = event;
+        traced.threadId = traced.threadId ? traced.threadId : CurrentThreadId();
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_ring[m_count % Capacity] = traced;
+        m_count++;
+    }
+
+    std::vector<PhaseTracer::Event> PhaseTracer::Snapshot(size_t *dropped) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        size_t kept = m_count < Capacity ? m_count : Capacity;
+        std::vector<Event> events;
+        events.reserve(kept);
+        for (size_t i = m_count - kept; i < m_count; ++i)
+        {
+            events.push_back(m_ring[i % Capacity]);
+        }
+
+        if (dropped)
+        {
+            *dropped = m_count - kept;
+        }
+        return events;
+    }
+
+    void PhaseTracer::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_count = 0;
+    }
+
+    std::string PhaseTracer::ToChromeTrace(const std::vector<Event> &events, uint32_t processId, const std::string &processName)
+    {
+        using json = nlohmann::json;
+
+        json traceEvents = json::array();
+        traceEvents.push_back(
+        {
+            { "name", "process_name" },
+            { "ph", "M" },
+            { "pid", processId },
+            { "tid", 0 },
+            { "args", { { "name", processName } } },
+        });
+
+        for (const Event &event : events)
+        {
+            json traced
+            {
+                { "name", event.name ? event.name : "" },
+                { "cat", event.category ? event.category : "" },
+                { "ph", std::string(1, event.phase) },
+                { "ts", event.timestampUs },
+                { "pid", processId },
+                { "tid", event.threadId },
+            };
+
+            if (event.phase == 'X')
+            {
+                traced["dur"] = event.durationUs;
+            }
+            else if (event.phase == 'i')
+            {
+                // Thread scoped, drawn as a tick on its own row
+                traced["s"] = "t";
+            }
+            traceEvents.push_back(std::move(traced));
+        }
+
+        json trace
+        {
+            { "traceEvents", traceEvents },
+            { "displayTimeUnit", "ms" },
+        };
+        return trace.dump();
+    }
+
+    bool PhaseTracer::Write(const std::wstring &path, uint32_t processId, const std::string &processName) const
+    {
+        std::error_code ec;
+        std::filesystem::path filePath(path);
+        std::filesystem::create_directories(filePath.parent_path(), ec);
+
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file << ToChromeTrace(Snapshot(), processId, processName);
+        return file.good();
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // Named phases with microsecond timestamps in a fixed ring, cheap enough to leave on. At exit the ring is
+    // written as Chrome trace events, chrome://tracing and Perfetto open the file as a timeline.
+    class PhaseTracer
+    {
+    public:
+        static const size_t Capacity = 1024;
+
+        struct Event
+        {
+            const char *name = "";          // String literals, the ring keeps only the pointers
+            const char *category = "";
+            char phase = 'i';               // 'B' begin, 'E' end, 'X' complete, 'i' instant
+            int64_t timestampUs = 0;
+            int64_t durationUs = 0;
+            uint32_t threadId = 0;
+        };
+
+        // Begins and ends the phase on the calling thread
+        class Scope
+        {
+        public:
+            Scope(const char *name, const char *category);
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            const char *m_name;
+            const char *m_category;
+            int64_t m_start;
+        };
+
+        static PhaseTracer &Instance();
+
+        // Small numbers in the order threads first trace
+        static uint32_t CurrentThreadId();
+
+        // Since the tracer was created
+        int64_t Now() const;
+
+        void Instant(const char *name, const char *category);
+        void Begin(const char *name, const char *category);
+        void End(const char *name, const char *category);
+        void Complete(const char *name, const char *category, int64_t startUs, int64_t endUs);
+        void Add(const Event &event);
+
+        // Oldest first, and how many were overwritten before them
+        std::vector<Event> Snapshot(size_t *dropped = nullptr) const;
+        void Clear();
+
+        static std::string ToChromeTrace(const std::vector<Event> &events, uint32_t processId, const std::string &processName);
+
+        // Writes the ring, false if the file can't be written
+        bool Write(const std::wstring &path, uint32_t processId, const std::string &processName) const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        Clock::time_point m_origin = Clock::now();
+
+        mutable std::mutex m_lock;
+        std::array<Event, Capacity> m_ring;
+        size_t m_count = 0;
+    };
+}
@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "Tools/ProbeScheduler.hpp"
+
+namespace AnyFSE::Tools
+{
+    typedef std::chrono::steady_clock Clock;
+
+    namespace
+    {
+#ifdef _WIN32
+        struct ThreadStart
+        {
+            std::function<void()> proc;
+            HMODULE hModule;
+        };
+
+        DWORD WINAPI ThreadProc(LPVOID param)
+        {
+            HMODULE hModule = NULL;
+            {
+                std::unique_ptr<ThreadStart> start(static_cast<ThreadStart *>(param));
+                hModule = start->hModule;
+                start->proc();
+            }
+            // Nothing of the module runs past this call
+            if (hModule)
+            {
+                FreeLibraryAndExitThread(hModule, 0);
+            }
+            return 0;
+        }
+
+        // The thread holds a reference to the module it runs in, a library unloaded while a probe is stuck
+        // stays mapped until the probe returns
+        void Detach(std::function<void()> proc)
+        {
+            HMODULE hModule = NULL;
+            GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCWSTR)&ThreadProc, &hModule);
+
+            ThreadStart *start = new ThreadStart{ std::move(proc), hModule };
+            HANDLE hThread = CreateThread(NULL, 0, ThreadProc, start, 0, NULL);
+            if (!hThread)
+            {
+                delete start;
+                if (hModule)
+                {
+                    FreeLibrary(hModule);
+                }
+                throw std::runtime_error("Can't start a probe worker");
+            }
+            CloseHandle(hThread);
+        }
+#else
+        void Detach(std::function<void()> proc)
+        {
+            std::thread(std::move(proc)).detach();
+        }
+#endif
+    }
+
+    struct ProbeScheduler::State
+    {
+        enum class Phase
+        {
+            Waiting,
+            Queued,
+            Running,
+            Finished
+        };
+
+        struct Probe
+        {
+            std::string name;
+            RunFunc run;
+            std::vector<size_t> dependents;
+            size_t pendingDependencies = 0;
+            double timeoutMs = 0;
+            Phase phase = Phase::Waiting;
+            Clock::time_point started;
+        };
+
+        std::mutex lock;
+        std::condition_variable wakeWorkers;
+        std::condition_variable wakeWatchdog;
+        std::condition_variable finished;
+
+        std::vector<Probe> probes;
+        std::deque<size_t> ready;
+        size_t remaining = 0;
+        bool started = false;
+        bool cancelled = false;
+
+        ReportFunc report;
+        ThreadFunc enter;
+        ThreadFunc leave;
+
+        bool IsOver() const { return cancelled || remaining == 0; }
+
+        static double Elapsed(Clock::time_point start, Clock::time_point end)
+        {
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        // Locked
+        void Finish(size_t index, Status status, double elapsedMs)
+        {
+            Probe &probe = probes[index];
+            probe.phase = Phase::Finished;
+            probe.run = nullptr;
+            remaining--;
+
+            for (size_t dependent : probe.dependents)
+            {
+                if (--probes[dependent].pendingDependencies == 0)
+                {
+                    probes[dependent].phase = Phase::Queued;
+                    ready.push_back(dependent);
+                }
+            }
+
+            if (report && !cancelled)
+            {
+                report(Report{ index, probe.name, status, elapsedMs });
+            }
+
+            wakeWorkers.notify_all();
+            wakeWatchdog.notify_all();
+            if (remaining == 0)
+            {
+                finished.notify_all();
+            }
+        }
+    };
+
+    ProbeScheduler::ProbeScheduler(size_t workers)
+        : m_state(std::make_shared<State>())
+        , m_workers(std::max<size_t>(1, workers))
+    {
+    }
+
+    ProbeScheduler::~ProbeScheduler()
+    {
+        Cancel();
+    }
+
+    size_t ProbeScheduler::Add(const std::string &name, RunFunc run, const std::vector<size_t> &dependsOn, double timeoutMs)
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+
+        size_t index = m_state->probes.size();
+        if (m_state->started || !run
+            || std::any_of(dependsOn.begin(), dependsOn.end(), [index](size_t dependency) { return dependency >= index; }))
+        {
+            return npos;
+        }
+
+        State::Probe probe;
+        probe.name = name;
+        probe.run = std::move(run);
+        probe.timeoutMs = timeoutMs;
+        for (size_t dependency : dependsOn)
+        {
+            m_state->probes[dependency].dependents.push_back(index);
+            probe.pendingDependencies++;
+        }
+
+        m_state->probes.push_back(std::move(probe));
+        m_state->remaining++;
+        return index;
+    }
+
+    void ProbeScheduler::SetThreadHooks(ThreadFunc enter, ThreadFunc leave)
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+        m_state->enter = std::move(enter);
+        m_state->leave = std::move(leave);
+    }
+
+    size_t ProbeScheduler::Count() const
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+        return m_state->probes.size();
+    }
+
+    void ProbeScheduler::Start(ReportFunc report)
+    {
+        size_t workers = 0;
+        bool watchdog = false;
+        {
+            std::lock_guard<std::mutex> lock(m_state->lock);
+            if (m_state->started)
+            {
+                return;
+            }
+            m_state->started = true;
+            m_state->report = std::move(report);
+
+            for (size_t i = 0; i < m_state->probes.size(); ++i)
+            {
+                State::Probe &probe = m_state->probes[i];
+                if (probe.pendingDependencies == 0)
+                {
+                    probe.phase = State::Phase::Queued;
+                    m_state->ready.push_back(i);
+                }
+                watchdog = watchdog || probe.timeoutMs > 0;
+            }
+            workers = std::min(m_workers, m_state->probes.size());
+        }
+
+        std::shared_ptr<State> state = m_state;
+        for (size_t i = 0; i < workers; ++i)
+        {
+            Detach([state] { WorkerProc(state); });
+        }
+        if (watchdog)
+        {
+            Detach([state] { WatchdogProc(state); });
+        }
+    }
+
+    void ProbeScheduler::Cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+        m_state->cancelled = true;
+        m_state->ready.clear();
+        m_state->wakeWorkers.notify_all();
+        m_state->wakeWatchdog.notify_all();
+        m_state->finished.notify_all();
+    }
+
+    bool ProbeScheduler::Wait(double timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(m_state->lock);
+        State &state = *m_state;
+
+        if (timeoutMs < 0)
+        {
+            state.finished.wait(lock, [&state] { return state.IsOver(); });
+        }
+        else
+        {
+            state.finished.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs),
+                [&state] { return state.IsOver(); });
+        }
+        return !state.cancelled && state.remaining == 0;
+    }
+
+    void ProbeScheduler::WorkerProc(std::shared_ptr<State> state)
+    {
+        ThreadFunc enter, leave;
+        {
+            std::lock_guard<std::mutex> lock(state->lock);
+            enter = state->enter;
+            leave = state->leave;
+        }
+        if (enter)
+        {
+            enter();
+        }
+
+        std::unique_lock<std::mutex> lock(state->lock);
+        while (true)
+        {
+            state->wakeWorkers.wait(lock, [&state] { return state->IsOver() || !state->ready.empty(); });
+            if (state->IsOver())
+            {
+                break;
+            }
+
+            size_t index = state->ready.front();
+            state->ready.pop_front();
+
+            State::Probe &probe = state->probes[index];
+            probe.phase = State::Phase::Running;
+            probe.started = Clock::now();
+            RunFunc run = probe.run;
+            state->wakeWatchdog.notify_all();
+
+            lock.unlock();
+            Status status = Status::Done;
+            try
+            {
+                run();
+            }
+            catch (...)
+            {
+                status = Status::Failed;
+            }
+            Clock::time_point end = Clock::now();
+            lock.lock();
+
+            // Given up on meanwhile, a replacement has taken over the pool
+            if (state->probes[index].phase == State::Phase::Finished)
+            {
+                break;
+            }
+            state->Finish(index, status, State::Elapsed(state->probes[index].started, end));
+        }
+        lock.unlock();
+
+        if (leave)
+        {
+            leave();
+        }
+    }
+
+    void ProbeScheduler::WatchdogProc(std::shared_ptr<State> state)
+    {
+        std::unique_lock<std::mutex> lock(state->lock);
+        while (!state->IsOver())
+        {
+            Clock::time_point now = Clock::now();
+            Clock::time_point next = Clock::time_point::max();
+            size_t replacements = 0;
+
+            for (size_t i = 0; i < state->probes.size(); ++i)
+            {
+                State::Probe &probe = state->probes[i];
+                if (probe.phase != State::Phase::Running || probe.timeoutMs <= 0)
+                {
+                    continue;
+                }
+
+                Clock::time_point deadline = probe.started
+                    + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(probe.timeoutMs));
+                if (deadline <= now)
+                {
+                    state->Finish(i, Status::TimedOut, State::Elapsed(probe.started, now));
+                    replacements++;
+                }
+                else
+                {
+                    next = std::min(next, deadline);
+                }
+            }
+
+            if (replacements)
+            {
+                lock.unlock();
+                for (size_t i = 0; i < replacements; ++i)
+                {
+                    Detach([state] { WorkerProc(state); });
+                }
+                lock.lock();
+                continue;
+            }
+
+            if (next == Clock::time_point::max())
+            {
+                state->wakeWatchdog.wait(lock);
+            }
+            else
+            {
+                state->wakeWatchdog.wait_until(lock, next);
+            }
+        }
+    }
+}
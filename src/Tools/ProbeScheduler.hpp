@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // Runs independent probes on a small worker pool. A probe starts once the probes it depends on are
+    // finished, whatever their outcome. A probe running past its timeout is reported as timed out, its
+    // dependents go on and a fresh worker takes its place; the stuck worker leaves when the call returns.
+    //
+    // Workers are detached and share the state with the scheduler, so a probe has to own what it uses
+    // rather than point into its caller. On Windows each worker keeps the module it runs in loaded until
+    // it leaves, so the settings library may be unloaded while a probe is stuck.
+    class ProbeScheduler
+    {
+    public:
+        enum class Status
+        {
+            Done,
+            Failed,
+            TimedOut
+        };
+
+        struct Report
+        {
+            size_t probe;
+            std::string name;
+            Status status;
+            double elapsedMs;
+        };
+
+        typedef std::function<void()> RunFunc;
+
+        // Called once per probe on a worker or the watchdog, with the scheduler locked: keep it short and
+        // don't call back into the scheduler
+        typedef std::function<void(const Report &report)> ReportFunc;
+
+        // Run on every worker thread around its probes, for COM apartments and the like
+        typedef std::function<void()> ThreadFunc;
+
+        static const size_t npos = (size_t)-1;
+
+        explicit ProbeScheduler(size_t workers);
+        ~ProbeScheduler();
+
+        // Dependencies have to be added before, so the graph can't have cycles. A timeout of 0 waits forever.
+        size_t Add(const std::string &name, RunFunc run, const std::vector<size_t> &dependsOn = {}, double timeoutMs = 0);
+        void SetThreadHooks(ThreadFunc enter, ThreadFunc leave);
+
+        void Start(ReportFunc report);
+
+        // Probes not started are dropped, nothing is reported once it returns
+        void Cancel();
+
+        // Until every probe is reported, false on timeout or cancel. A negative timeout waits forever.
+        bool Wait(double timeoutMs = -1);
+
+        size_t Count() const;
+
+    private:
+        struct State;
+
+        std::shared_ptr<State> m_state;
+        size_t m_workers;
+
+        static void WorkerProc(std::shared_ptr<State> state);
+        static void WatchdogProc(std::shared_ptr<State> state);
+    };
+}
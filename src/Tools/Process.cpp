@@ -36,6 +36,8 @@
 #include "Tools/Unicode.hpp"
 #include "Process.hpp"
 
+extern "C" IMAGE_DOS_HEADER __ImageBase;
+
 #pragma comment(lib, "psapi.lib")
 
 namespace AnyFSE::Tools::Process
@@ -445,4 +447,9 @@ namespace AnyFSE::Tools::Process
         CloseHandle(hProcess);
         return ERROR_SUCCESS;
     }
+
+    HINSTANCE GetModuleInstance()
+    {
+        return (HINSTANCE)&__ImageBase;
+    }
 }
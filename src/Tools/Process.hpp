@@ -42,6 +42,9 @@ namespace AnyFSE::Tools::Process
     bool BringWindowToForeground(HWND hWnd, int nShowCmd = SW_SHOWDEFAULT);
     std::wstring GetWindowProcessName(HWND hWnd);
     HRESULT Kill(DWORD processId);
+
+    // The exe or the library this code is linked into, for window classes owned by that module
+    HINSTANCE GetModuleInstance();
 }
 
 namespace Process = AnyFSE::Tools::Process;
\ No newline at end of file
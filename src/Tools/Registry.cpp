@@ -26,9 +26,127 @@
 #include <vector>
 #include <string>
 #include "Registry.hpp"
+#include "Tools/RegistryCache.hpp"
 
 namespace AnyFSE::Tools
 {
+    namespace
+    {
+        // Handles opened for reading, kept by RegistryCache
+        class WindowsRegistry : public RegistryBackend
+        {
+            struct Handle
+            {
+                HKEY hKey;
+                HANDLE hChanged;
+            };
+
+        public:
+            Key Open(const std::wstring &path) override
+            {
+                std::wstring actualPath;
+                HKEY rootKey = Registry::GetRootKey(path, actualPath);
+
+                HKEY hKey;
+                if (RegOpenKeyExW(rootKey, actualPath.c_str(), 0, KEY_READ, &hKey) != ERROR_SUCCESS)
+                {
+                    return 0;
+                }
+                return (Key)new Handle{ hKey, NULL };
+            }
+
+            void Close(Key key) override
+            {
+                Handle *handle = (Handle *)key;
+                RegCloseKey(handle->hKey);
+                if (handle->hChanged)
+                {
+                    CloseHandle(handle->hChanged);
+                }
+                delete handle;
+            }
+
+            Result Read(Key key, const std::wstring &name, RegistryValue &value) override
+            {
+                Handle *handle = (Handle *)key;
+
+                // Most values fit, longer ones are read again into the heap
+                BYTE buffer[512];
+                std::vector<BYTE> heapBuffer;
+                BYTE *data = buffer;
+                DWORD size = sizeof(buffer);
+                DWORD type = REG_NONE;
+
+                LONG result = RegQueryValueExW(handle->hKey, name.c_str(), NULL, &type, data, &size);
+                while (result == ERROR_MORE_DATA)
+                {
+                    heapBuffer.resize(size);
+                    data = heapBuffer.data();
+                    result = RegQueryValueExW(handle->hKey, name.c_str(), NULL, &type, data, &size);
+                }
+
+                if (result == ERROR_KEY_DELETED)
+                {
+                    return Result::KeyDeleted;
+                }
+                if (result != ERROR_SUCCESS)
+                {
+                    return Result::NotFound;
+                }
+
+                if (type == REG_SZ || type == REG_EXPAND_SZ || type == REG_MULTI_SZ)
+                {
+                    // Stored strings are not always terminated, a multi-string reads as its first one
+                    const wchar_t *text = (const wchar_t *)data;
+                    value.type = RegistryValue::Type::String;
+                    value.text.assign(text, wcsnlen(text, size / sizeof(wchar_t)));
+                }
+                else if (type == REG_DWORD && size == sizeof(DWORD))
+                {
+                    value.type = RegistryValue::Type::DWord;
+                    memcpy(&value.number, data, sizeof(DWORD));
+                }
+                else
+                {
+                    value.type = RegistryValue::Type::Other;
+                }
+                return Result::Found;
+            }
+
+            bool Watch(Key key) override
+            {
+                Handle *handle = (Handle *)key;
+                if (!handle->hChanged)
+                {
+                    handle->hChanged = CreateEvent(NULL, TRUE, FALSE, NULL);
+                    if (!handle->hChanged)
+                    {
+                        return false;
+                    }
+                }
+
+                // Thread agnostic, the reading thread may be a worker that exits before the key changes
+                ResetEvent(handle->hChanged);
+                return RegNotifyChangeKeyValue(handle->hKey, FALSE,
+                    REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET | REG_NOTIFY_THREAD_AGNOSTIC,
+                    handle->hChanged, TRUE) == ERROR_SUCCESS;
+            }
+
+            bool IsChanged(Key key) override
+            {
+                Handle *handle = (Handle *)key;
+                return handle->hChanged && WaitForSingleObject(handle->hChanged, 0) == WAIT_OBJECT_0;
+            }
+        };
+
+        RegistryCache &Cache()
+        {
+            static WindowsRegistry backend;
+            static RegistryCache cache(backend);
+            return cache;
+        }
+    }
+
     HKEY Registry::GetRootKey(const std::wstring &subKey, std::wstring &actualPath)
     {
         // Extract root key from subKey (e.g., "HKEY_CURRENT_USER\\Software\\MyApp" -> HKEY_CURRENT_USER)
@@ -62,46 +180,14 @@ namespace AnyFSE::Tools
     // static
     std::wstring Registry::ReadString(const std::wstring &subKey, const std::wstring &valueName, const std::wstring &defaultValue )
     {
-        HKEY hOpenedKey;
-        std::wstring result = defaultValue;
-        std::wstring actualPath;
-        HKEY rootKey = GetRootKey(subKey, actualPath);
-
-        if (RegOpenKeyEx(rootKey, actualPath.c_str(), 0, KEY_READ, &hOpenedKey) == ERROR_SUCCESS)
-        {
-            DWORD size = 0;
-            // Get required buffer size
-            if (RegQueryValueEx(hOpenedKey, valueName.c_str(), NULL, NULL, NULL, &size) == ERROR_SUCCESS)
-            {
-                wchar_t *buffer = new wchar_t[size / sizeof(wchar_t) + 1];
-                if (RegQueryValueEx(hOpenedKey, valueName.c_str(), NULL, NULL, (LPBYTE)buffer, &size) == ERROR_SUCCESS)
-                {
-                    result = buffer;
-                }
-                delete[] buffer;
-            }
-            RegCloseKey(hOpenedKey);
-        }
-        return result;
+        return Cache().Read(subKey, valueName).AsString(defaultValue);
     }
 
     // Read DWORD from registry
     //static
     DWORD Registry::ReadDWORD(const std::wstring &subKey, const std::wstring &valueName, DWORD defaultValue)
     {
-        HKEY hOpenedKey;
-        DWORD result = defaultValue;
-        DWORD size = sizeof(DWORD);
-
-        std::wstring actualPath;
-        HKEY rootKey = GetRootKey(subKey, actualPath);
-
-        if (RegOpenKeyEx(rootKey, actualPath.c_str(), 0, KEY_READ, &hOpenedKey) == ERROR_SUCCESS)
-        {
-            RegQueryValueEx(hOpenedKey, valueName.c_str(), NULL, NULL, (LPBYTE)&result, &size);
-            RegCloseKey(hOpenedKey);
-        }
-        return result;
+        return Cache().Read(subKey, valueName).AsDWORD(defaultValue);
     }
 
     // Read boolean from registry
@@ -111,6 +197,18 @@ namespace AnyFSE::Tools
         return ReadDWORD(subKey, valueName, defaultValue ? 1 : 0) != 0;
     }
 
+    //static
+    std::vector<RegistryValue> Registry::ReadValues(const std::wstring &subKey, const std::vector<std::wstring> &valueNames)
+    {
+        return Cache().Read(subKey, valueNames);
+    }
+
+    //static
+    bool Registry::CacheValues(const std::wstring &subKey)
+    {
+        return Cache().CacheValues(subKey);
+    }
+
     bool Registry::WriteString(const std::wstring &subKey, const std::wstring &valueName, const std::wstring &value)
     {
         std::wstring actualPath;
@@ -126,6 +224,7 @@ namespace AnyFSE::Tools
                                 reinterpret_cast<const BYTE *>(value.c_str()),
                                 (DWORD)((value.size() + 1) * sizeof(wchar_t)));
         RegCloseKey(hKey);
+        Cache().Invalidate(subKey);
 
         return (result == ERROR_SUCCESS);
     }
@@ -144,6 +243,7 @@ namespace AnyFSE::Tools
         result = RegSetValueExW(hKey, valueName.c_str(), 0, REG_DWORD,
                                 reinterpret_cast<const BYTE *>(&value), sizeof(DWORD));
         RegCloseKey(hKey);
+        Cache().Invalidate(subKey);
 
         return (result == ERROR_SUCCESS);
     }
@@ -166,6 +266,7 @@ namespace AnyFSE::Tools
 
         result = RegSetValueExW(hKey, valueName.c_str(), 0, REG_BINARY, data, size);
         RegCloseKey(hKey);
+        Cache().Invalidate(subKey);
 
         return (result == ERROR_SUCCESS);
     }
@@ -182,6 +283,7 @@ namespace AnyFSE::Tools
 
         result = RegDeleteValueW(hKey, valueName.c_str());
         RegCloseKey(hKey);
+        Cache().Invalidate(subKey);
 
         return (result == ERROR_SUCCESS);
     }
@@ -192,6 +294,7 @@ namespace AnyFSE::Tools
         HKEY rootKey = GetRootKey(subKey, actualPath);
 
         // Recursive delete for the key and all subkeys
+        Cache().Remove(subKey);
         return (RegDeleteTreeW(rootKey, actualPath.c_str()) == ERROR_SUCCESS);
     }
 
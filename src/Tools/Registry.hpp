@@ -24,6 +24,8 @@
 
 #include <windows.h>
 #include <string>
+#include <vector>
+#include "Tools/RegistryCache.hpp"
 
 namespace AnyFSE::Tools
 {
@@ -34,6 +36,12 @@ namespace AnyFSE::Tools
         static DWORD ReadDWORD(const std::wstring &subKey, const std::wstring &valueName, DWORD defaultValue = 0);
         static bool ReadBool(const std::wstring &subKey, const std::wstring &valueName, bool defaultValue = false);
 
+        // Several values of one key, in the order of the names
+        static std::vector<RegistryValue> ReadValues(const std::wstring &subKey, const std::vector<std::wstring> &valueNames);
+
+        // Values of the key are read once and then until the key reports a change
+        static bool CacheValues(const std::wstring &subKey);
+
         static bool WriteString(const std::wstring &subKey, const std::wstring &valueName, const std::wstring &value);
         static bool WriteDWORD(const std::wstring &subKey, const std::wstring &valueName, DWORD value);
         static bool WriteBool(const std::wstring &subKey, const std::wstring &valueName, bool value);
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cwctype>
+
+#include "Tools/RegistryCache.hpp"
+
+namespace AnyFSE::Tools
+{
+    namespace
+    {
+        struct RootName
+        {
+            const wchar_t *alias;
+            const wchar_t *name;
+        };
+
+        const RootName Roots[] =
+        {
+            { L"HKEY_CURRENT_USER",     L"HKEY_CURRENT_USER" },
+            { L"HKCU",                  L"HKEY_CURRENT_USER" },
+            { L"HKEY_LOCAL_MACHINE",    L"HKEY_LOCAL_MACHINE" },
+            { L"HKLM",                  L"HKEY_LOCAL_MACHINE" },
+            { L"HKEY_CLASSES_ROOT",     L"HKEY_CLASSES_ROOT" },
+            { L"HKCR",                  L"HKEY_CLASSES_ROOT" },
+            { L"HKEY_USERS",            L"HKEY_USERS" },
+            { L"HKEY_CURRENT_CONFIG",   L"HKEY_CURRENT_CONFIG" },
+        };
+    }
+
+    std::wstring RegistryCache::NormalizePath(const std::wstring &path)
+    {
+        size_t pos = path.find(L'\\');
+        if (pos == std::wstring::npos)
+        {
+            return L"HKEY_CURRENT_USER";
+        }
+
+        std::wstring root = path.substr(0, pos);
+        std::wstring rest = path.substr(pos);
+        const wchar_t *rootName = nullptr;
+        for (const RootName &known : Roots)
+        {
+            if (root == known.alias)
+            {
+                rootName = known.name;
+                break;
+            }
+        }
+
+        if (!rootName)
+        {
+            rootName = L"HKEY_CURRENT_USER";
+            rest = L"\\" + path;
+        }
+
+        std::transform(rest.begin(), rest.end(), rest.begin(), [](wchar_t c) { return (wchar_t)std::towlower(c); });
+        return rootName + rest;
+    }
+
+    RegistryCache::RegistryCache(RegistryBackend &backend, size_t maxKeys)
+        : m_backend(backend)
+        , m_maxKeys(std::max<size_t>(1, maxKeys))
+    {
+    }
+
+    RegistryCache::~RegistryCache()
+    {
+        Clear();
+    }
+
+    RegistryCache::OpenKey *RegistryCache::Open(const std::wstring &path)
+    {
+        auto it = m_keys.find(path);
+        if (it != m_keys.end())
+        {
+            it->second.used = ++m_useCounter;
+            return &it->second;
+        }
+
+        RegistryBackend::Key handle = m_backend.Open(path);
+        m_stats.opens++;
+        if (!handle)
+        {
+            // Not kept, the key may be created later
+            return nullptr;
+        }
+
+        if (m_keys.size() >= m_maxKeys)
+        {
+            Close(std::min_element(m_keys.begin(), m_keys.end(),
+                [](const auto &a, const auto &b) { return a.second.used < b.second.used; }));
+        }
+
+        OpenKey &key = m_keys[path];
+        key.handle = handle;
+        key.used = ++m_useCounter;
+        key.watched = m_cachedPaths.count(path) && m_backend.Watch(handle);
+        return &key;
+    }
+
+    void RegistryCache::Close(std::unordered_map<std::wstring, OpenKey>::iterator key)
+    {
+        m_backend.Close(key->second.handle);
+        m_keys.erase(key);
+    }
+
+    RegistryValue RegistryCache::ReadValue(const std::wstring &path, const std::wstring &name)
+    {
+        RegistryValue value;
+
+        // A stale handle gets one more try with a fresh one
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            OpenKey *key = Open(path);
+            if (!key)
+            {
+                return RegistryValue();
+            }
+
+            if (key->watched)
+            {
+                // Armed again before the values are read, a change meanwhile is not lost
+                if (m_backend.IsChanged(key->handle))
+                {
+                    key->values.clear();
+                    key->watched = m_backend.Watch(key->handle);
+                }
+
+                auto cached = key->values.find(name);
+                if (key->watched && cached != key->values.end())
+                {
+                    m_stats.hits++;
+                    return cached->second;
+                }
+            }
+
+            value = RegistryValue();
+            m_stats.reads++;
+            RegistryBackend::Result result = m_backend.Read(key->handle, name, value);
+            if (result == RegistryBackend::Result::KeyDeleted)
+            {
+                Close(m_keys.find(path));
+                continue;
+            }
+
+            if (key->watched)
+            {
+                key->values[name] = value;
+            }
+            return value;
+        }
+        return RegistryValue();
+    }
+
+    RegistryValue RegistryCache::Read(const std::wstring &path, const std::wstring &name)
+    {
+        std::wstring normalized = NormalizePath(path);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        return ReadValue(normalized, name);
+    }
+
+    std::vector<RegistryValue> RegistryCache::Read(const std::wstring &path, const std::vector<std::wstring> &names)
+    {
+        std::wstring normalized = NormalizePath(path);
+        std::vector<RegistryValue> values;
+        values.reserve(names.size());
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (const std::wstring &name : names)
+        {
+            values.push_back(ReadValue(normalized, name));
+        }
+        return values;
+    }
+
+    bool RegistryCache::CacheValues(const std::wstring &path)
+    {
+        std::wstring normalized = NormalizePath(path);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_cachedPaths.insert(normalized);
+
+        auto it = m_keys.find(normalized);
+        if (it == m_keys.end())
+        {
+            return true;
+        }
+        if (!it->second.watched)
+        {
+            it->second.values.clear();
+            it->second.watched = m_backend.Watch(it->second.handle);
+        }
+        return it->second.watched;
+    }
+
+    void RegistryCache::Invalidate(const std::wstring &path)
+    {
+        std::wstring normalized = NormalizePath(path);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_keys.find(normalized);
+        if (it != m_keys.end())
+        {
+            it->second.values.clear();
+        }
+    }
+
+    void RegistryCache::Remove(const std::wstring &path)
+    {
+        std::wstring normalized = NormalizePath(path);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto it = m_keys.begin(); it != m_keys.end();)
+        {
+            const std::wstring &keyPath = it->first;
+            bool below = keyPath.compare(0, normalized.size(), normalized) == 0
+                && (keyPath.size() == normalized.size() || keyPath[normalized.size()] == L'\\');
+            if (below)
+            {
+                m_backend.Close(it->second.handle);
+                it = m_keys.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void RegistryCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto &key : m_keys)
+        {
+            m_backend.Close(key.second.handle);
+        }
+        m_keys.clear();
+    }
+
+    RegistryCache::Stats RegistryCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_stats;
+    }
+}
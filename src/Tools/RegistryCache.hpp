@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    struct RegistryValue
+    {
+        enum class Type
+        {
+            None,       // The key or the value does not exist
+            String,
+            DWord,
+            Other
+        };
+
+        Type type = Type::None;
+        std::wstring text;
+        uint32_t number = 0;
+
+        std::wstring AsString(const std::wstring &defaultValue = L"") const { return type == Type::String ? text : defaultValue; }
+        uint32_t AsDWORD(uint32_t defaultValue = 0) const { return type == Type::DWord ? number : defaultValue; }
+    };
+
+    // Where the keys live, the Windows registry or an in-memory one in the tests. Paths are normalized by
+    // RegistryCache::NormalizePath before they get here.
+    class RegistryBackend
+    {
+    public:
+        typedef uintptr_t Key;
+
+        enum class Result
+        {
+            Found,
+            NotFound,
+            KeyDeleted      // The handle is stale, the key has to be opened again
+        };
+
+        virtual ~RegistryBackend() {}
+
+        // 0 if the key does not exist
+        virtual Key Open(const std::wstring &path) = 0;
+        virtual void Close(Key key) = 0;
+        virtual Result Read(Key key, const std::wstring &name, RegistryValue &value) = 0;
+
+        // Arms a one-shot notification for changes to the values of the key, false if there is none
+        virtual bool Watch(Key key) = 0;
+        virtual bool IsChanged(Key key) = 0;
+    };
+
+    // Open keys by path, so repeated reads skip parsing and opening. Keys passed to CacheValues also keep
+    // their values until the backend reports a change to the key.
+    class RegistryCache
+    {
+    public:
+        struct Stats
+        {
+            size_t opens = 0;
+            size_t reads = 0;
+            size_t hits = 0;
+        };
+
+        // Root names in full and upper case, the rest in lower case. Without a known root the path is under
+        // HKEY_CURRENT_USER, as Registry::GetRootKey has it.
+        static std::wstring NormalizePath(const std::wstring &path);
+
+        explicit RegistryCache(RegistryBackend &backend, size_t maxKeys = 64);
+        ~RegistryCache();
+
+        RegistryValue Read(const std::wstring &path, const std::wstring &name);
+        std::vector<RegistryValue> Read(const std::wstring &path, const std::vector<std::wstring> &names);
+
+        // Also for keys that do not exist yet, false if the backend can't watch the key
+        bool CacheValues(const std::wstring &path);
+
+        // After a write to the key, or a delete of it and everything below
+        void Invalidate(const std::wstring &path);
+        void Remove(const std::wstring &path);
+        void Clear();
+
+        Stats GetStats() const;
+
+    private:
+        struct OpenKey
+        {
+            RegistryBackend::Key handle = 0;
+            bool watched = false;
+            uint64_t used = 0;
+            std::unordered_map<std::wstring, RegistryValue> values;
+        };
+
+        RegistryBackend &m_backend;
+        size_t m_maxKeys;
+
+        mutable std::mutex m_lock;
+        std::unordered_map<std::wstring, OpenKey> m_keys;
+        std::set<std::wstring> m_cachedPaths;
+        uint64_t m_useCounter = 0;
+        Stats m_stats;
+
+        // Locked
+        OpenKey *Open(const std::wstring &path);
+        void Close(std::unordered_map<std::wstring, OpenKey>::iterator key);
+        RegistryValue ReadValue(const std::wstring &path, const std::wstring &name);
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AnyFSE::Tools
+{
+    // Incremental SHA-256 (FIPS 180-4), fed chunk by chunk while data streams in.
+    class Sha256
+    {
+    public:
+        Sha256();
+
+        void Reset();
+        void Update(const void *data, size_t size);
+
+        // Finishes the hash and returns it as lowercase hex. The object has to be Reset before reuse.
+        std::string HexDigest();
+
+    private:
+        uint32_t m_state[8];
+        uint8_t m_block[64];
+        size_t m_blockSize;
+        uint64_t m_totalSize;
+
+        void Transform(const uint8_t *block);
+    };
+}
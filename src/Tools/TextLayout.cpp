@@ -0,0 +1,132 @@
+#include <algorithm>
+
+#include "Tools/TextLayout.hpp"
+
+namespace AnyFSE::Tools
+{
+    namespace
+    {
+        bool IsSpace(wchar_t c)
+        {
+            return c == L' ' || c == L'\t';
+        }
+
+        bool IsLineFeed(wchar_t c)
+        {
+            return c == L'\n' || c == L'\r';
+        }
+
+        size_t Combine(size_t seed, size_t value)
+        {
+            return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+    }
+
+    TextLayout BreakLines(const std::wstring &text, const std::vector<int> &extents, int maxWidth, int lineHeight)
+    {
+        TextLayout layout;
+        layout.lineHeight = lineHeight;
+
+        size_t count = std::min(text.size(), extents.size());
+        auto extentBefore = [&extents](size_t index) { return index ? extents[index - 1] : 0; };
+        auto addLine = [&](size_t start, size_t end)
+        {
+            // Trailing spaces take no room
+            while (end > start && IsSpace(text[end - 1]))
+            {
+                --end;
+            }
+            TextLine line;
+            line.start = start;
+            line.length = end - start;
+            line.width = end > start ? extents[end - 1] - extentBefore(start) : 0;
+            layout.lines.push_back(line);
+            layout.width = std::max(layout.width, line.width);
+        };
+
+        size_t start = 0;
+        while (start < count)
+        {
+            size_t breakAt = std::wstring::npos;    // end of the line at the last space seen
+            size_t end = start;
+            bool hardBreak = false;
+
+            for (; end < count; ++end)
+            {
+                wchar_t c = text[end];
+                if (IsLineFeed(c))
+                {
+                    hardBreak = true;
+                    break;
+                }
+                if (IsSpace(c))
+                {
+                    if (end > start && !IsSpace(text[end - 1]))
+                    {
+                        breakAt = end;
+                    }
+                    continue;
+                }
+                if (extents[end] - extentBefore(start) > maxWidth && breakAt != std::wstring::npos)
+                {
+                    break;
+                }
+            }
+
+            if (hardBreak)
+            {
+                addLine(start, end);
+                // \r\n is one break
+                start = end + ((text[end] == L'\r' && end + 1 < count && text[end + 1] == L'\n') ? 2 : 1);
+                if (start >= count)
+                {
+                    addLine(start, start);
+                }
+                continue;
+            }
+
+            if (end >= count)
+            {
+                addLine(start, count);
+                break;
+            }
+
+            addLine(start, breakAt);
+            start = breakAt;
+            while (start < count && IsSpace(text[start]))
+            {
+                ++start;
+            }
+        }
+
+        layout.height = (int)layout.lines.size() * lineHeight;
+        return layout;
+    }
+
+    size_t TextLayoutKeyHash::operator()(const TextLayoutKey &key) const
+    {
+        size_t seed = std::hash<std::wstring>()(key.text);
+        seed = Combine(seed, std::hash<uintptr_t>()(key.font));
+        seed = Combine(seed, std::hash<int>()(key.maxWidth));
+        return Combine(seed, std::hash<unsigned>()(key.dpi));
+    }
+
+    TextLayoutCache::TextLayoutCache(size_t capacity)
+        : m_cache(capacity)
+    {
+    }
+
+    std::shared_ptr<const TextLayout> TextLayoutCache::Get(const TextLayoutKey &key, const LayoutFunc &layout)
+    {
+        if (std::shared_ptr<const TextLayout> *cached = m_cache.Find(key))
+        {
+            return *cached;
+        }
+        return m_cache.Insert(key, std::make_shared<const TextLayout>(layout(key)));
+    }
+
+    void TextLayoutCache::Clear()
+    {
+        m_cache.Clear();
+    }
+}
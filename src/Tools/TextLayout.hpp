@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Tools/LruCache.hpp"
+
+namespace AnyFSE::Tools
+{
+    struct TextLine
+    {
+        size_t start = 0;       // in characters of the source text
+        size_t length = 0;
+        int width = 0;
+    };
+
+    // Wrapped text, ready to draw one line after another
+    struct TextLayout
+    {
+        int width = 0;
+        int height = 0;
+        int lineHeight = 0;
+        std::vector<TextLine> lines;
+    };
+
+    // Word wrap the way DrawText(DT_WORDBREAK) does it: lines break at line feeds and at spaces, which
+    // are dropped at the break, a single word wider than the limit overflows instead of being split.
+    // extents[i] is the width of text[0..i] as GetTextExtentExPoint reports it.
+    TextLayout BreakLines(const std::wstring &text, const std::vector<int> &extents, int maxWidth, int lineHeight);
+
+    struct TextLayoutKey
+    {
+        std::wstring text;
+        uintptr_t font = 0;
+        int maxWidth = 0;
+        unsigned dpi = 0;
+
+        bool operator==(const TextLayoutKey &other) const
+        {
+            return font == other.font && maxWidth == other.maxWidth && dpi == other.dpi && text == other.text;
+        }
+    };
+
+    struct TextLayoutKeyHash
+    {
+        size_t operator()(const TextLayoutKey &key) const;
+    };
+
+    // Layouts by text, font, width and DPI. Fonts are keyed by handle, so the owner clears the cache
+    // whenever it recreates its fonts.
+    class TextLayoutCache
+    {
+    public:
+        typedef std::function<TextLayout(const TextLayoutKey &key)> LayoutFunc;
+
+        explicit TextLayoutCache(size_t capacity = 512);
+
+        // Lays the text out on a miss
+        std::shared_ptr<const TextLayout> Get(const TextLayoutKey &key, const LayoutFunc &layout);
+        void Clear();
+
+        size_t Size() const { return m_cache.Size(); }
+        uint64_t Hits() const { return m_cache.Hits(); }
+        uint64_t Misses() const { return m_cache.Misses(); }
+
+    private:
+        LruCache<TextLayoutKey, std::shared_ptr<const TextLayout>, TextLayoutKeyHash> m_cache;
+    };
+}
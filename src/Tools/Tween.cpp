@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Tools/Tween.hpp"
+
+namespace AnyFSE::Tools
+{
+    namespace Easing
+    {
+        double Linear(double t)
+        {
+            return t;
+        }
+
+        double InCubic(double t)
+        {
+            return t * t * t;
+        }
+
+        double OutCubic(double t)
+        {
+            double inverse = 1 - t;
+            return 1 - inverse * inverse * inverse;
+        }
+
+        double InOutCubic(double t)
+        {
+            if (t < 0.5)
+            {
+                return 4 * t * t * t;
+            }
+            double inverse = -2 * t + 2;
+            return 1 - inverse * inverse * inverse / 2;
+        }
+
+        double InOutSine(double t)
+        {
+            return (1 - std::cos(t * 3.14159265358979323846)) / 2;
+        }
+    }
+
+    Tween::Tween(double from, double to, double duration, Easing::Func easing)
+        : m_from(from)
+        , m_to(to)
+        , m_duration(std::max(duration, 0.0))
+        , m_reverseDuration(m_duration)
+        , m_easing(easing ? easing : Easing::Linear)
+    {}
+
+    Tween &Tween::SetRepeat(Repeat repeat, double reverseDuration)
+    {
+        m_repeat = repeat;
+        m_cycles = repeat == Repeat::None ? 1 : 0;
+        m_reverseDuration = reverseDuration > 0 ? reverseDuration : m_duration;
+        return *this;
+    }
+
+    void Tween::Start(double now)
+    {
+        m_started = true;
+        m_startTime = now;
+        m_cycles = m_repeat == Repeat::None ? 1 : 0;
+    }
+
+    void Tween::StopRepeating(double now)
+    {
+        if (m_started && m_cycles == 0)
+        {
+            m_cycles = CycleAt(now) + 1;
+        }
+    }
+
+    double Tween::CycleDuration() const
+    {
+        return m_repeat == Repeat::PingPong ? m_duration + m_reverseDuration : m_duration;
+    }
+
+    long long Tween::CycleAt(double now) const
+    {
+        double cycle = CycleDuration();
+        if (cycle <= 0 || now <= m_startTime)
+        {
+            return 0;
+        }
+        return (long long)std::floor((now - m_startTime) / cycle);
+    }
+
+    bool Tween::IsFinished(double now) const
+    {
+        if (!m_started || CycleDuration() <= 0)
+        {
+            return true;
+        }
+        return m_cycles && CycleAt(now) >= m_cycles;
+    }
+
+    double Tween::Interpolate(double progress) const
+    {
+        progress = std::clamp(progress, 0.0, 1.0);
+        return m_from + (m_to - m_from) * m_easing(progress);
+    }
+
+    double Tween::Value(double now) const
+    {
+        if (!m_started || now <= m_startTime)
+        {
+            return m_from;
+        }
+
+        if (IsFinished(now))
+        {
+            // PingPong rests where it started, the others where they were heading
+            return m_repeat == Repeat::PingPong ? m_from : m_to;
+        }
+
+        double cycle = CycleDuration();
+        double elapsed = std::fmod(now - m_startTime, cycle);
+
+        if (elapsed < m_duration)
+        {
+            return Interpolate(elapsed / m_duration);
+        }
+        // Only PingPong gets here, the way back runs the curve in reverse
+        return Interpolate(1 - (elapsed - m_duration) / m_reverseDuration);
+    }
+}
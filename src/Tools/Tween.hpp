@@ -0,0 +1,61 @@
+#pragma once
+
+namespace AnyFSE::Tools
+{
+    // Easing curves map linear progress in [0, 1] to eased progress, f(0) = 0 and f(1) = 1
+    namespace Easing
+    {
+        typedef double (*Func)(double t);
+
+        double Linear(double t);
+        double InCubic(double t);
+        double OutCubic(double t);
+        double InOutCubic(double t);
+        double InOutSine(double t);
+    }
+
+    // Time based interpolation between two values. Times are in milliseconds of the same clock,
+    // the value depends only on the time passed in, so a late frame lands where it should be.
+    class Tween
+    {
+    public:
+        enum class Repeat
+        {
+            None,       // from -> to once
+            Loop,       // from -> to, jumping back to from
+            PingPong    // from -> to -> from, the way back may take its own duration
+        };
+
+        Tween() = default;
+        Tween(double from, double to, double duration, Easing::Func easing = Easing::Linear);
+
+        Tween &SetRepeat(Repeat repeat, double reverseDuration = 0);
+
+        void Start(double now);
+        // The cycle in progress plays to its end, then the tween finishes
+        void StopRepeating(double now);
+
+        bool IsStarted() const { return m_started; }
+        bool IsFinished(double now) const;
+        double Value(double now) const;
+
+        double From() const { return m_from; }
+        double To() const { return m_to; }
+
+    private:
+        double m_from = 0;
+        double m_to = 0;
+        double m_duration = 0;
+        double m_reverseDuration = 0;
+        Easing::Func m_easing = Easing::Linear;
+        Repeat m_repeat = Repeat::None;
+
+        bool m_started = false;
+        double m_startTime = 0;
+        long long m_cycles = 1;     // 0 repeats forever
+
+        double CycleDuration() const;
+        long long CycleAt(double now) const;
+        double Interpolate(double progress) const;
+    };
+}
@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <cwctype>
+
+#include "Tools/UninstallIndex.hpp"
+
+namespace AnyFSE::Tools
+{
+    std::wstring UninstallIndex::NormalizeName(const std::wstring &displayName)
+    {
+        // Same folding as Unicode::to_lower
+        std::wstring name = displayName;
+        std::transform(name.begin(), name.end(), name.begin(), ::towlower);
+        return name;
+    }
+
+    void UninstallIndex::Build(UninstallSource &source)
+    {
+        Clear();
+        source.Scan([this](UninstallEntry &&entry)
+        {
+            m_entries[NormalizeName(entry.displayName)].push_back(std::move(entry));
+            m_count++;
+        });
+    }
+
+    void UninstallIndex::Clear()
+    {
+        m_entries.clear();
+        m_count = 0;
+    }
+
+    const std::vector<UninstallEntry> *UninstallIndex::Find(const std::wstring &displayName) const
+    {
+        auto it = m_entries.find(NormalizeName(displayName));
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AnyFSE::Tools
+{
+    // One program of an Uninstall key
+    struct UninstallEntry
+    {
+        std::wstring displayName;
+        std::wstring installLocation;
+        std::wstring uninstallString;
+        bool hasInstallLocation = false;    // An empty InstallLocation value still counts
+    };
+
+    // Where the entries come from, the registry on Windows or a synthetic hive elsewhere
+    class UninstallSource
+    {
+    public:
+        typedef std::function<void(UninstallEntry &&entry)> EntryFunc;
+
+        virtual ~UninstallSource() {}
+
+        // Calls entry for every program in scan order, the order lookups return them in
+        virtual void Scan(const EntryFunc &entry) = 0;
+    };
+
+    // Programs by lowercase display name, built with a single scan of the source
+    class UninstallIndex
+    {
+    public:
+        static std::wstring NormalizeName(const std::wstring &displayName);
+
+        void Build(UninstallSource &source);
+        void Clear();
+
+        // All programs with the display name in scan order, nullptr if none
+        const std::vector<UninstallEntry> *Find(const std::wstring &displayName) const;
+
+        size_t Count() const { return m_count; }
+
+    private:
+        std::unordered_map<std::wstring, std::vector<UninstallEntry>> m_entries;
+        size_t m_count = 0;
+    };
+}
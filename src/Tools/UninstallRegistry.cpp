@@ -0,0 +1,179 @@
+#include <windows.h>
+
+#include "Tools/UninstallRegistry.hpp"
+#include "Tools/Unicode.hpp"
+#include "Logging/LogManager.hpp"
+
+namespace AnyFSE::Tools
+{
+    static Logger log = LogManager::GetLogger("UninstallRegistry");
+
+    namespace
+    {
+        bool ReadValue(HKEY hKey, const wchar_t *valueName, std::wstring &value)
+        {
+            WCHAR buffer[1024];
+            DWORD dataSize = sizeof(buffer) - sizeof(WCHAR);
+            DWORD type;
+
+            if (RegQueryValueExW(hKey, valueName, NULL, &type, (LPBYTE)buffer, &dataSize) != ERROR_SUCCESS
+                || type != REG_SZ)
+            {
+                return false;
+            }
+
+            // Stored strings are not always terminated
+            buffer[dataSize / sizeof(WCHAR)] = L'\0';
+            value = buffer;
+            return true;
+        }
+    }
+
+    UninstallRegistry &UninstallRegistry::Instance()
+    {
+        static UninstallRegistry registry;
+        return registry;
+    }
+
+    UninstallRegistry::UninstallRegistry()
+        : m_hives {
+            { HKEY_CURRENT_USER,  L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall", NULL, NULL },
+            { HKEY_CURRENT_USER,  L"SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall", NULL, NULL },
+            { HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall", NULL, NULL },
+            { HKEY_LOCAL_MACHINE, L"SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall", NULL, NULL }
+        }
+    {
+    }
+
+    UninstallRegistry::~UninstallRegistry()
+    {
+        for (Hive &hive : m_hives)
+        {
+            if (hive.hKey)
+            {
+                RegCloseKey(hive.hKey);
+            }
+            if (hive.hChanged)
+            {
+                CloseHandle(hive.hChanged);
+            }
+        }
+    }
+
+    std::vector<UninstallEntry> UninstallRegistry::Find(const std::wstring &displayName)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        if (!m_indexed || IsChanged())
+        {
+            Rebuild();
+        }
+
+        const std::vector<UninstallEntry> *entries = m_index.Find(displayName);
+        return entries ? *entries : std::vector<UninstallEntry>();
+    }
+
+    void UninstallRegistry::Refresh()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        if (!m_indexed || IsChanged())
+        {
+            Rebuild();
+        }
+    }
+
+    bool UninstallRegistry::IsChanged() const
+    {
+        for (const Hive &hive : m_hives)
+        {
+            if (hive.hChanged && WaitForSingleObject(hive.hChanged, 0) == WAIT_OBJECT_0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void UninstallRegistry::Watch(Hive &hive)
+    {
+        if (!hive.hKey
+            && RegOpenKeyExW(hive.hRoot, hive.path, 0, KEY_READ | KEY_NOTIFY, &hive.hKey) != ERROR_SUCCESS)
+        {
+            // WOW6432Node is often missing under HKCU, a key created later is not noticed
+            hive.hKey = NULL;
+            return;
+        }
+
+        if (!hive.hChanged)
+        {
+            hive.hChanged = CreateEvent(NULL, TRUE, FALSE, NULL);
+        }
+        ResetEvent(hive.hChanged);
+
+        // Scans may run on detection workers, the watch has to outlive the thread that armed it
+        LSTATUS status = RegNotifyChangeKeyValue(hive.hKey, TRUE,
+            REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET | REG_NOTIFY_THREAD_AGNOSTIC, hive.hChanged, TRUE);
+        if (status != ERROR_SUCCESS)
+        {
+            // Without a notification every lookup scans again, as before the index
+            log.Error("Can't watch uninstall key %s: %d", Unicode::to_string(hive.path).c_str(), status);
+            SetEvent(hive.hChanged);
+        }
+    }
+
+    void UninstallRegistry::Rebuild()
+    {
+        LARGE_INTEGER frequency, start, end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        // Armed before the scan, a change made while it runs triggers the next one
+        for (Hive &hive : m_hives)
+        {
+            Watch(hive);
+        }
+
+        m_index.Build(*this);
+        m_indexed = true;
+
+        QueryPerformanceCounter(&end);
+        log.Debug("Indexed %zu installed programs in %.1f ms", m_index.Count(),
+            (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart);
+    }
+
+    void UninstallRegistry::Scan(const EntryFunc &entry)
+    {
+        for (const Hive &hive : m_hives)
+        {
+            if (!hive.hKey)
+            {
+                continue;
+            }
+
+            DWORD subkeyIndex = 0;
+            WCHAR subkeyName[255];
+            DWORD subkeyNameSize = 255;
+
+            while (RegEnumKeyExW(hive.hKey, subkeyIndex++, subkeyName, &subkeyNameSize, NULL, NULL, NULL, NULL) == ERROR_SUCCESS)
+            {
+                subkeyNameSize = 255;
+
+                HKEY hSubKey;
+                if (RegOpenKeyExW(hive.hKey, subkeyName, 0, KEY_READ, &hSubKey) != ERROR_SUCCESS)
+                {
+                    continue;
+                }
+
+                UninstallEntry program;
+                if (ReadValue(hSubKey, L"DisplayName", program.displayName))
+                {
+                    program.hasInstallLocation = ReadValue(hSubKey, L"InstallLocation", program.installLocation);
+                    ReadValue(hSubKey, L"UninstallString", program.uninstallString);
+                    entry(std::move(program));
+                }
+                RegCloseKey(hSubKey);
+            }
+        }
+    }
+}
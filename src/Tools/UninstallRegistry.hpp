@@ -0,0 +1,48 @@
+#pragma once
+
+#include <windows.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Tools/UninstallIndex.hpp"
+
+namespace AnyFSE::Tools
+{
+    // The Uninstall keys of HKCU and HKLM, native and WOW6432Node, scanned into one index. Lookups reuse it
+    // until the registry reports a change under one of the keys, then the next lookup scans again.
+    class UninstallRegistry : public UninstallSource
+    {
+    public:
+        static UninstallRegistry &Instance();
+
+        // Copies of the programs with the display name in scan order, safe from any thread
+        std::vector<UninstallEntry> Find(const std::wstring &displayName);
+
+        // Scans now unless the index is up to date, lookups after it don't wait
+        void Refresh();
+
+        void Scan(const EntryFunc &entry) override;
+
+        ~UninstallRegistry();
+
+    private:
+        struct Hive
+        {
+            HKEY hRoot;
+            const wchar_t *path;
+            HKEY hKey;
+            HANDLE hChanged;
+        };
+
+        std::mutex m_lock;
+        UninstallIndex m_index;
+        bool m_indexed = false;
+        std::vector<Hive> m_hives;
+
+        UninstallRegistry();
+
+        bool IsChanged() const;
+        void Watch(Hive &hive);
+        void Rebuild();
+    };
+}
@@ -0,0 +1,334 @@
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Updater/Downloader.hpp"
+
+namespace AnyFSE::Updater
+{
+    namespace
+    {
+        // "bytes 100-999/1000" -> start 100, total 1000 (-1 for "*")
+        bool ParseContentRange(const std::string &value, long long &start, long long &total)
+        {
+            const std::string prefix = "bytes ";
+            if (value.compare(0, prefix.size(), prefix) != 0)
+            {
+                return false;
+            }
+
+            char *end = nullptr;
+            start = std::strtoll(value.c_str() + prefix.size(), &end, 10);
+            if (!end || *end != '-')
+            {
+                return false;
+            }
+
+            size_t slash = value.find('/');
+            if (slash == std::string::npos)
+            {
+                return false;
+            }
+            total = value[slash + 1] == '*' ? -1 : std::strtoll(value.c_str() + slash + 1, nullptr, 10);
+            return true;
+        }
+
+        std::filesystem::path ValidatorPath(const std::filesystem::path &partPath)
+        {
+            std::filesystem::path path = partPath;
+            path += ".validator";
+            return path;
+        }
+
+        // If-Range needs a strong ETag, a weak one falls back to Last-Modified.
+        std::string GetValidator(const HttpResponse &response)
+        {
+            if (!response.etag.empty() && response.etag.compare(0, 2, "W/") != 0)
+            {
+                return response.etag;
+            }
+            return response.lastModified;
+        }
+
+        std::string ReadValidator(const std::filesystem::path &partPath)
+        {
+            std::ifstream file(ValidatorPath(partPath), std::ios::binary);
+            std::string validator;
+            std::getline(file, validator);
+            return validator;
+        }
+
+        void WriteValidator(const std::filesystem::path &partPath, const std::string &validator)
+        {
+            std::error_code ec;
+            if (validator.empty())
+            {
+                std::filesystem::remove(ValidatorPath(partPath), ec);
+                return;
+            }
+            std::ofstream file(ValidatorPath(partPath), std::ios::binary | std::ios::trunc);
+            file << validator;
+        }
+    }
+
+    Downloader::Downloader(IHttpClient &client)
+        : m_client(client)
+        , m_buffer(BufferSize)
+    {
+    }
+
+    Downloader &Downloader::SetMaxAttempts(int attempts)
+    {
+        m_maxAttempts = attempts > 0 ? attempts : 1;
+        return *this;
+    }
+
+    Downloader &Downloader::SetRetryDelay(std::chrono::milliseconds delay)
+    {
+        m_retryDelay = delay;
+        return *this;
+    }
+
+    long long Downloader::HashPartialFile(const std::filesystem::path &partPath)
+    {
+        m_hash.Reset();
+
+        std::ifstream file(partPath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return 0;
+        }
+
+        long long size = 0;
+        while (file.read(m_buffer.data(), (std::streamsize)m_buffer.size()) || file.gcount() > 0)
+        {
+            m_hash.Update(m_buffer.data(), (size_t)file.gcount());
+            size += file.gcount();
+        }
+        return size;
+    }
+
+    // Drops the partial file, the next request downloads everything again.
+    void Downloader::Restart(const std::filesystem::path &partPath, long long &received, long long &total)
+    {
+        received = 0;
+        total = -1;
+        m_hash.Reset();
+        m_resumed = false;
+        m_validator.clear();
+
+        std::error_code ec;
+        std::filesystem::remove(partPath, ec);
+        std::filesystem::remove(ValidatorPath(partPath), ec);
+    }
+
+    // Opens the partial file according to the response, returns 0 on success or
+    // the HTTP status which cannot be continued from.
+    int Downloader::BeginWrite(const HttpResponse &response, std::ofstream &file, const std::filesystem::path &partPath,
+                               long long &received, long long &total)
+    {
+        bool append = false;
+        if (response.status == 206 && received > 0)
+        {
+            long long start = 0;
+            if (!ParseContentRange(response.contentRange, start, total) || start != received)
+            {
+                return response.status;
+            }
+            std::string validator = GetValidator(response);
+            if (!validator.empty() && validator != m_validator)
+            {
+                return response.status;
+            }
+            append = true;
+            m_resumed = true;
+        }
+        else if (response.status == 200)
+        {
+            // A fresh download, the server ignored the Range header or If-Range did not
+            // match: the body is the whole file.
+            total = response.contentLength;
+            received = 0;
+            m_hash.Reset();
+            m_resumed = false;
+            m_validator = GetValidator(response);
+            WriteValidator(partPath, m_validator);
+        }
+        else
+        {
+            return response.status;
+        }
+
+        file.open(partPath, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open download file");
+        }
+        return 0;
+    }
+
+    bool Downloader::Transfer(const HttpRequest &baseRequest, const std::filesystem::path &partPath,
+                              long long &received, long long &total, const ProgressCallback &progress)
+    {
+        if (received > 0 && m_validator.empty())
+        {
+            // Nothing tells whether the remote file is still the same one.
+            Restart(partPath, received, total);
+        }
+
+        HttpRequest request = baseRequest;
+        if (received > 0)
+        {
+            request.headers.push_back(L"Range: bytes=" + std::to_wstring(received) + L"-");
+            request.headers.push_back(L"If-Range: " + std::wstring(m_validator.begin(), m_validator.end()));
+        }
+
+        std::ofstream file;
+        int rejectedStatus = 0;
+        bool writeFailed = false;
+
+        // The sink must not throw, the transport has handles to close.
+        HttpResponse response = m_client.Get(request, [&](const HttpResponse &head, const char *data, size_t size)
+        {
+            if (!file.is_open())
+            {
+                try
+                {
+                    rejectedStatus = BeginWrite(head, file, partPath, received, total);
+                }
+                catch (const std::runtime_error &)
+                {
+                    writeFailed = true;
+                }
+                if (rejectedStatus || writeFailed)
+                {
+                    return false;
+                }
+            }
+
+            if (!file.write(data, (std::streamsize)size))
+            {
+                writeFailed = true;
+                return false;
+            }
+            m_hash.Update(data, size);
+            received += (long long)size;
+            if (progress)
+            {
+                progress(received, total);
+            }
+            return true;
+        });
+
+        if (writeFailed)
+        {
+            throw std::runtime_error("Failed to write downloaded data");
+        }
+
+        // Empty body: nothing reached the sink, the file is opened here.
+        if (!rejectedStatus && !file.is_open())
+        {
+            rejectedStatus = BeginWrite(response, file, partPath, received, total);
+        }
+
+        if (rejectedStatus == 416 || rejectedStatus == 206)
+        {
+            // The partial file does not match the remote one any more, or the server
+            // continued from another offset, start over.
+            file.close();
+            Restart(partPath, received, total);
+            return false;
+        }
+        if (rejectedStatus)
+        {
+            throw HttpStatusError(rejectedStatus);
+        }
+
+        file.close();
+        return total < 0 || received == total;
+    }
+
+    void Downloader::Download(const std::wstring &url,
+                              const std::vector<std::wstring> &headers,
+                              const std::filesystem::path &target,
+                              const std::string &expectedSha256,
+                              const ProgressCallback &progress)
+    {
+        HttpRequest request;
+        if (!ParseUrl(url, request))
+        {
+            throw std::invalid_argument("Unsupported download url");
+        }
+        request.headers = headers;
+
+        std::filesystem::path partPath = target;
+        partPath += ".part";
+
+        // A part file without a validator cannot be resumed safely.
+        long long received = 0;
+        long long total = -1;
+        m_resumed = false;
+        m_validator = ReadValidator(partPath);
+        if (!m_validator.empty())
+        {
+            received = HashPartialFile(partPath);
+        }
+        if (received == 0)
+        {
+            Restart(partPath, received, total);
+        }
+        bool complete = false;
+
+        for (m_attempts = 1; !complete; ++m_attempts)
+        {
+            try
+            {
+                complete = Transfer(request, partPath, received, total, progress);
+            }
+            catch (const HttpStatusError &error)
+            {
+                if (error.GetStatus() < 500 || m_attempts >= m_maxAttempts)
+                {
+                    throw;
+                }
+            }
+            catch (const std::runtime_error &)
+            {
+                if (m_attempts >= m_maxAttempts)
+                {
+                    throw;
+                }
+            }
+
+            if (!complete)
+            {
+                if (m_attempts >= m_maxAttempts)
+                {
+                    throw std::runtime_error("Download incomplete");
+                }
+                std::this_thread::sleep_for(m_retryDelay);
+            }
+        }
+        --m_attempts;
+
+        m_sha256 = m_hash.HexDigest();
+        m_hash.Reset();
+
+        std::error_code ec;
+        std::filesystem::remove(ValidatorPath(partPath), ec);
+        if (!expectedSha256.empty() && expectedSha256 != m_sha256)
+        {
+            std::filesystem::remove(partPath, ec);
+            throw std::runtime_error("Downloaded file checksum mismatch");
+        }
+
+        std::filesystem::remove(target, ec);
+        std::filesystem::rename(partPath, target, ec);
+        if (ec)
+        {
+            throw std::runtime_error("Failed to move downloaded file");
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Updater/HttpClient.hpp"
+#include "Tools/Sha256.hpp"
+
+namespace AnyFSE::Updater
+{
+    // Server answered with a status the download cannot continue from, retrying won't help.
+    class HttpStatusError : public std::runtime_error
+    {
+    public:
+        explicit HttpStatusError(int status)
+            : std::runtime_error("Unexpected HTTP status " + std::to_string(status))
+            , m_status(status)
+        {
+        }
+
+        int GetStatus() const { return m_status; }
+
+    private:
+        int m_status;
+    };
+
+    // Streams a file to disk, hashing it on the fly. Data goes to "<target>.part" first,
+    // a broken transfer is continued with a Range request, and the file is renamed to
+    // the target only after the size and SHA-256 check out. The first response's ETag or
+    // Last-Modified is kept in "<target>.part.validator" and sent as If-Range on resume,
+    // so a file replaced on the server is downloaded again instead of spliced.
+    class Downloader
+    {
+    public:
+        // received / total bytes, total is -1 while unknown
+        using ProgressCallback = std::function<void(long long received, long long total)>;
+
+        explicit Downloader(IHttpClient &client);
+
+        Downloader &SetMaxAttempts(int attempts);
+        Downloader &SetRetryDelay(std::chrono::milliseconds delay);
+
+        // expectedSha256 is lowercase hex, empty to skip verification.
+        // Throws std::runtime_error when the file could not be downloaded or verified.
+        void Download(const std::wstring &url,
+                      const std::vector<std::wstring> &headers,
+                      const std::filesystem::path &target,
+                      const std::string &expectedSha256,
+                      const ProgressCallback &progress = nullptr);
+
+        const std::string &GetSha256() const { return m_sha256; }
+        int GetAttempts() const { return m_attempts; }
+
+        // True when the file was assembled from more than one response.
+        bool WasResumed() const { return m_resumed; }
+
+    private:
+        static const size_t BufferSize = 64 * 1024;
+
+        IHttpClient &m_client;
+        std::vector<char> m_buffer;
+        Tools::Sha256 m_hash;
+        std::string m_sha256;
+        int m_maxAttempts = 5;
+        int m_attempts = 0;
+        bool m_resumed = false;
+        std::string m_validator;
+        std::chrono::milliseconds m_retryDelay = std::chrono::milliseconds(1000);
+
+        long long HashPartialFile(const std::filesystem::path &partPath);
+        void Restart(const std::filesystem::path &partPath, long long &received, long long &total);
+        int BeginWrite(const HttpResponse &response, std::ofstream &file, const std::filesystem::path &partPath,
+                       long long &received, long long &total);
+        bool Transfer(const HttpRequest &baseRequest, const std::filesystem::path &partPath,
+                      long long &received, long long &total, const ProgressCallback &progress);
+    };
+}
@@ -0,0 +1,109 @@
+#include <string>
+
+#include "Updater/HttpClient.hpp"
+
+namespace AnyFSE::Updater
+{
+    void HttpCancellation::Cancel()
+    {
+        std::function<void()> abort;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_cancelled)
+            {
+                return;
+            }
+            m_cancelled = true;
+            abort.swap(m_abort);
+            m_aborted = (bool)abort;
+        }
+        if (abort)
+        {
+            abort();
+        }
+    }
+
+    bool HttpCancellation::IsCancelled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cancelled;
+    }
+
+    bool HttpCancellation::Attach(const std::function<void()> &abort)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cancelled)
+        {
+            return false;
+        }
+        m_abort = abort;
+        return true;
+    }
+
+    bool HttpCancellation::Detach()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_abort = nullptr;
+        return !m_aborted;
+    }
+
+    HttpResponse IHttpClient::Get(const HttpRequest &request)
+    {
+        std::string body;
+        HttpResponse response = Get(request, [&body](const HttpResponse &, const char *data, size_t size)
+        {
+            body.append(data, size);
+            return true;
+        });
+        response.body = std::move(body);
+        return response;
+    }
+
+    bool ParseUrl(const std::wstring &url, HttpRequest &request)
+    {
+        const std::wstring https = L"https://";
+        const std::wstring http = L"http://";
+
+        size_t hostStart = 0;
+        if (url.compare(0, https.size(), https) == 0)
+        {
+            request.secure = true;
+            request.port = 443;
+            hostStart = https.size();
+        }
+        else if (url.compare(0, http.size(), http) == 0)
+        {
+            request.secure = false;
+            request.port = 80;
+            hostStart = http.size();
+        }
+        else
+        {
+            return false;
+        }
+
+        size_t pathStart = url.find(L'/', hostStart);
+        std::wstring authority = url.substr(hostStart, pathStart == std::wstring::npos ? std::wstring::npos : pathStart - hostStart);
+        request.path = pathStart == std::wstring::npos ? L"/" : url.substr(pathStart);
+
+        size_t portStart = authority.rfind(L':');
+        if (portStart != std::wstring::npos)
+        {
+            const std::wstring port = authority.substr(portStart + 1);
+            if (port.empty() || port.size() > 5 || port.find_first_not_of(L"0123456789") != std::wstring::npos)
+            {
+                return false;
+            }
+            unsigned long value = std::stoul(port);
+            if (value == 0 || value > 65535)
+            {
+                return false;
+            }
+            request.port = (unsigned short)value;
+            authority.resize(portStart);
+        }
+
+        request.host = authority;
+        return !request.host.empty();
+    }
+}
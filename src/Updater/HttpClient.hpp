@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AnyFSE::Updater
+{
+    // Lets another thread abort a request. The transport registers how to interrupt
+    // its blocking call for the duration of the request.
+    class HttpCancellation
+    {
+    public:
+        void Cancel();
+        bool IsCancelled() const;
+
+        // Returns false if the request is already cancelled, abort is not stored then.
+        bool Attach(const std::function<void()> &abort);
+        // Returns false if abort has been invoked meanwhile.
+        bool Detach();
+
+    private:
+        mutable std::mutex m_mutex;
+        std::function<void()> m_abort;
+        bool m_cancelled = false;
+        bool m_aborted = false;
+    };
+
+    struct HttpRequest
+    {
+        std::wstring host;
+        std::wstring path;
+        unsigned short port = 443;
+        bool secure = true;
+        std::vector<std::wstring> headers;      // complete "Name: value" lines
+        HttpCancellation *cancel = nullptr;
+    };
+
+    struct HttpResponse
+    {
+        int status = 0;
+        std::string etag;
+        std::string lastModified;
+        std::string contentRange;
+        long long contentLength = -1;           // -1 when the server did not send it
+        std::string body;                       // empty when the body went to a sink
+    };
+
+    // Receives body bytes as they arrive together with the already known response
+    // status and headers. Returning false stops the transfer.
+    using HttpBodySink = std::function<bool(const HttpResponse &response, const char *data, size_t size)>;
+
+    // Transport used by the updater. Kept free of platform headers so the release
+    // and download logic can be exercised against a local stand-in server.
+    class IHttpClient
+    {
+    public:
+        virtual ~IHttpClient() = default;
+
+        // Performs a GET request and streams the body into sink. Throws std::runtime_error
+        // when no response was received or the connection broke while reading the body,
+        // any received status code (including 304 and 206) is returned to the caller.
+        virtual HttpResponse Get(const HttpRequest &request, const HttpBodySink &sink) = 0;
+
+        // Same as above, but collects the body into HttpResponse::body.
+        HttpResponse Get(const HttpRequest &request);
+    };
+
+    // Splits an absolute http(s) url into host, port, secure and path.
+    bool ParseUrl(const std::wstring &url, HttpRequest &request);
+}
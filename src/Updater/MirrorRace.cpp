@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "Updater/MirrorRace.hpp"
+
+namespace AnyFSE::Updater
+{
+    void MirrorSelector::RecordSuccess(const std::string &host, std::chrono::milliseconds latency)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MirrorStats &stats = m_stats[host];
+        stats.latencyMs = stats.samples == 0
+            ? (double)latency.count()
+            : stats.latencyMs + LatencyWeight * ((double)latency.count() - stats.latencyMs);
+        stats.samples++;
+        stats.failures = 0;
+    }
+
+    void MirrorSelector::RecordFailure(const std::string &host)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats[host].failures++;
+    }
+
+    double MirrorSelector::Score(const std::string &host) const
+    {
+        const auto it = m_stats.find(host);
+        if (it == m_stats.end())
+        {
+            return 0;
+        }
+        return it->second.latencyMs + it->second.failures * FailurePenaltyMs;
+    }
+
+    std::vector<size_t> MirrorSelector::Order(const std::vector<std::string> &hosts) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::vector<size_t> order(hosts.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+
+        // Unknown hosts score 0 and therefore go first, so they get measured.
+        std::stable_sort(order.begin(), order.end(), [this, &hosts](size_t a, size_t b)
+        {
+            return Score(hosts[a]) < Score(hosts[b]);
+        });
+        return order;
+    }
+
+    std::chrono::milliseconds MirrorSelector::HedgeDelay(const std::string &preferred) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto it = m_stats.find(preferred);
+        if (it == m_stats.end() || it->second.samples == 0 || it->second.failures > 0)
+        {
+            return std::chrono::milliseconds(0);
+        }
+
+        // Give the preferred mirror a little more than its usual answer time.
+        long long delay = (long long)(it->second.latencyMs * 1.5);
+        return std::chrono::milliseconds(std::min(delay, MaxHedgeDelayMs));
+    }
+
+    std::map<std::string, MirrorStats> MirrorSelector::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void MirrorSelector::SetStats(const std::map<std::string, MirrorStats> &stats)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = stats;
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Updater/HttpClient.hpp"
+
+namespace AnyFSE::Updater
+{
+    struct MirrorStats
+    {
+        double latencyMs = 0;       // moving average of successful queries
+        int samples = 0;
+        int failures = 0;           // consecutive failures, reset by a success
+    };
+
+    // Per-host latency and failure bookkeeping which decides the mirror order.
+    // Thread safe, race threads report into it after the caller has moved on.
+    class MirrorSelector
+    {
+    public:
+        void RecordSuccess(const std::string &host, std::chrono::milliseconds latency);
+        void RecordFailure(const std::string &host);
+
+        // Indices of hosts, most preferred first. Hosts without history keep their order.
+        std::vector<size_t> Order(const std::vector<std::string> &hosts) const;
+
+        // How long the other mirrors wait for the preferred one before joining the race.
+        std::chrono::milliseconds HedgeDelay(const std::string &preferred) const;
+
+        std::map<std::string, MirrorStats> GetStats() const;
+        void SetStats(const std::map<std::string, MirrorStats> &stats);
+
+    private:
+        static constexpr double LatencyWeight = 0.3;
+        static constexpr double FailurePenaltyMs = 5000;
+        static constexpr long long MaxHedgeDelayMs = 1500;
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, MirrorStats> m_stats;
+
+        double Score(const std::string &host) const;
+    };
+
+    // Sends query to every host and returns the first result accepted by accept.
+    // The preferred host starts at once, the rest after the hedge delay, or as soon
+    // as an earlier one fails. The remaining queries are cancelled and finish on
+    // their own threads, so selector and everything query captures must outlive them.
+    // Throws the last error when no host produced an accepted result.
+    template <typename T>
+    T RaceMirrors(MirrorSelector &selector,
+                  const std::vector<std::string> &hosts,
+                  std::function<T(size_t host, HttpCancellation &cancel)> query,
+                  std::function<bool(const T &)> accept,
+                  size_t *winner = nullptr)
+    {
+        struct RaceState
+        {
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::optional<T> result;
+            size_t winner = 0;
+            size_t failed = 0;
+            std::exception_ptr error;
+            std::vector<std::shared_ptr<HttpCancellation>> cancels;
+        };
+
+        auto state = std::make_shared<RaceState>();
+        const std::vector<size_t> order = selector.Order(hosts);
+        const std::chrono::milliseconds hedgeDelay = order.empty() ? std::chrono::milliseconds(0) : selector.HedgeDelay(hosts[order.front()]);
+
+        for (size_t i = 0; i < hosts.size(); ++i)
+        {
+            state->cancels.push_back(std::make_shared<HttpCancellation>());
+        }
+
+        for (size_t rank = 0; rank < order.size(); ++rank)
+        {
+            const size_t index = order[rank];
+            const std::string host = hosts[index];
+
+            std::thread([state, &selector, query, accept, index, host, rank, hedgeDelay]()
+            {
+                if (rank > 0)
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->changed.wait_for(lock, hedgeDelay, [&state]() { return state->result || state->failed > 0; });
+                    if (state->result)
+                    {
+                        return;
+                    }
+                }
+
+                HttpCancellation &cancel = *state->cancels[index];
+                const auto started = std::chrono::steady_clock::now();
+                std::optional<T> value;
+                std::exception_ptr error;
+                try
+                {
+                    value = query(index, cancel);
+                    if (!accept(*value))
+                    {
+                        value.reset();
+                        error = std::make_exception_ptr(std::runtime_error("Mirror response rejected"));
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                if (cancel.IsCancelled())
+                {
+                    return;     // lost the race, says nothing about the host
+                }
+
+                if (value)
+                {
+                    selector.RecordSuccess(host, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started));
+                }
+                else
+                {
+                    selector.RecordFailure(host);
+                }
+
+                std::vector<std::shared_ptr<HttpCancellation>> losers;
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (value && !state->result)
+                    {
+                        state->result = std::move(value);
+                        state->winner = index;
+                        for (size_t other = 0; other < state->cancels.size(); ++other)
+                        {
+                            if (other != index)
+                            {
+                                losers.push_back(state->cancels[other]);
+                            }
+                        }
+                    }
+                    else if (!value)
+                    {
+                        state->failed++;
+                        state->error = error;
+                    }
+                }
+                state->changed.notify_all();
+
+                for (auto &loser : losers)
+                {
+                    loser->Cancel();
+                }
+            }).detach();
+        }
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->changed.wait(lock, [&state, &order]() { return state->result || state->failed == order.size(); });
+
+        if (!state->result)
+        {
+            if (state->error)
+            {
+                std::rethrow_exception(state->error);
+            }
+            throw std::runtime_error("No mirrors to query");
+        }
+
+        if (winner)
+        {
+            *winner = state->winner;
+        }
+        return *state->result;
+    }
+}
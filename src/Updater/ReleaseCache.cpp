@@ -0,0 +1,439 @@
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Updater/ReleaseCache.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace AnyFSE::Updater
+{
+    namespace
+    {
+        bool EqualsNoCase(const std::string &a, const std::string &b)
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // GitHub publishes asset digests as "sha256:<hex>".
+        std::string ParseSha256Digest(const std::string &digest)
+        {
+            const std::string prefix = "sha256:";
+            if (digest.size() != prefix.size() + 64 || digest.compare(0, prefix.size(), prefix) != 0)
+            {
+                return std::string();
+            }
+
+            std::string hex = digest.substr(prefix.size());
+            for (char &ch : hex)
+            {
+                ch = (char)std::tolower((unsigned char)ch);
+                if (!std::isxdigit((unsigned char)ch))
+                {
+                    return std::string();
+                }
+            }
+            return hex;
+        }
+
+        // SAX filter over GitHub/Codeberg release json. Only tag_name and the
+        // installer asset url are copied, everything else is skipped by the lexer.
+        class ReleaseFilter : public json::json_sax_t
+        {
+        public:
+            ReleaseFilter(const std::string &installerName, std::vector<ReleaseInfo> &releases)
+                : m_installerName(installerName)
+                , m_releases(releases)
+            {
+            }
+
+            bool null() override { return true; }
+            bool boolean(bool) override { return true; }
+            bool number_integer(number_integer_t) override { return true; }
+            bool number_unsigned(number_unsigned_t) override { return true; }
+            bool number_float(number_float_t, const string_t &) override { return true; }
+            bool binary(binary_t &) override { return true; }
+
+            bool string(string_t &value) override
+            {
+                if (m_frames.empty())
+                {
+                    return true;
+                }
+
+                Frame &frame = m_frames.back();
+                if (frame.role == Role::Release && m_key == "tag_name")
+                {
+                    m_release.tag = value;
+                }
+                else if (frame.role == Role::Asset && m_key == "name")
+                {
+                    m_assetName = value;
+                }
+                else if (frame.role == Role::Asset && m_key == "browser_download_url")
+                {
+                    m_assetUrl = value;
+                }
+                else if (frame.role == Role::Asset && m_key == "digest")
+                {
+                    m_assetDigest = value;
+                }
+                return true;
+            }
+
+            bool key(string_t &value) override
+            {
+                m_key = value;
+                return true;
+            }
+
+            bool start_object(std::size_t) override
+            {
+                Role parent = m_frames.empty() ? Role::None : m_frames.back().role;
+                Role role = (m_frames.empty() || parent == Role::ReleaseList) ? Role::Release
+                          : (parent == Role::Assets)                          ? Role::Asset
+                                                                              : Role::Other;
+                if (role == Role::Release)
+                {
+                    m_release = ReleaseInfo();
+                }
+                else if (role == Role::Asset)
+                {
+                    m_assetName.clear();
+                    m_assetUrl.clear();
+                    m_assetDigest.clear();
+                }
+                m_frames.push_back(Frame{role});
+                m_key.clear();
+                return true;
+            }
+
+            bool end_object() override
+            {
+                Role role = m_frames.back().role;
+                m_frames.pop_back();
+
+                if (role == Role::Asset)
+                {
+                    if (m_release.installerUrl.empty() && !m_assetUrl.empty() && EqualsNoCase(m_assetName, m_installerName))
+                    {
+                        m_release.installerUrl = m_assetUrl;
+                        m_release.installerSha256 = ParseSha256Digest(m_assetDigest);
+                    }
+                }
+                else if (role == Role::Release)
+                {
+                    m_releases.push_back(m_release);
+                }
+                return true;
+            }
+
+            bool start_array(std::size_t) override
+            {
+                Role parent = m_frames.empty() ? Role::None : m_frames.back().role;
+                Role role = m_frames.empty()                               ? Role::ReleaseList
+                          : (parent == Role::Release && m_key == "assets") ? Role::Assets
+                                                                           : Role::Other;
+                if (role == Role::Assets)
+                {
+                    m_release.hasAssets = true;
+                }
+                m_frames.push_back(Frame{role});
+                return true;
+            }
+
+            bool end_array() override
+            {
+                m_frames.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+            {
+                return false;
+            }
+
+        private:
+            enum class Role
+            {
+                None,
+                ReleaseList,
+                Release,
+                Assets,
+                Asset,
+                Other
+            };
+
+            struct Frame
+            {
+                Role role;
+            };
+
+            const std::string &m_installerName;
+            std::vector<ReleaseInfo> &m_releases;
+            std::vector<Frame> m_frames;
+            std::string m_key;
+            ReleaseInfo m_release;
+            std::string m_assetName;
+            std::string m_assetUrl;
+            std::string m_assetDigest;
+        };
+    }
+
+    bool ParseReleases(std::string_view body, const std::string &installerName, std::vector<ReleaseInfo> &releases)
+    {
+        std::vector<ReleaseInfo> parsed;
+        ReleaseFilter filter(installerName, parsed);
+        if (!json::sax_parse(body.begin(), body.end(), &filter))
+        {
+            return false;
+        }
+        releases = std::move(parsed);
+        return true;
+    }
+
+    ReleaseCache::ReleaseCache(const std::filesystem::path &filePath)
+        : m_filePath(filePath)
+    {
+    }
+
+    bool ReleaseCache::Load()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return LoadFile();
+    }
+
+    bool ReleaseCache::Save() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return SaveFile();
+    }
+
+    bool ReleaseCache::LoadFile()
+    {
+        if (m_loaded)
+        {
+            return true;
+        }
+        m_loaded = true;
+
+        std::ifstream file(m_filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        try
+        {
+            json j = json::parse(file);
+            if (j.value("version", 0) != FormatVersion || !j.contains("entries") || !j["entries"].is_object())
+            {
+                return false;
+            }
+
+            for (const auto &[url, value] : j["entries"].items())
+            {
+                CachedReleases entry;
+                entry.etag = value.value("etag", "");
+                entry.lastModified = value.value("lastModified", "");
+                for (const auto &release : value.value("releases", json::array()))
+                {
+                    ReleaseInfo info;
+                    info.tag = release.value("tag", "");
+                    info.installerUrl = release.value("installer", "");
+                    info.installerSha256 = release.value("sha256", "");
+                    info.hasAssets = release.value("hasAssets", false);
+                    entry.releases.push_back(info);
+                }
+                m_entries[url] = entry;
+            }
+
+            const json mirrors = j.value("mirrors", json::object());
+            for (const auto &[host, value] : mirrors.items())
+            {
+                MirrorStats stats;
+                stats.latencyMs = value.value("latencyMs", 0.0);
+                stats.samples = value.value("samples", 0);
+                stats.failures = value.value("failures", 0);
+                m_mirrors[host] = stats;
+            }
+        }
+        catch (...)
+        {
+            m_entries.clear();
+            m_mirrors.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ReleaseCache::SaveFile() const
+    {
+        json entries = json::object();
+        for (const auto &[url, entry] : m_entries)
+        {
+            json releases = json::array();
+            for (const ReleaseInfo &info : entry.releases)
+            {
+                releases.push_back({
+                    {"tag", info.tag},
+                    {"installer", info.installerUrl},
+                    {"sha256", info.installerSha256},
+                    {"hasAssets", info.hasAssets}
+                });
+            }
+            entries[url] = {
+                {"etag", entry.etag},
+                {"lastModified", entry.lastModified},
+                {"releases", releases}
+            };
+        }
+
+        json mirrors = json::object();
+        for (const auto &[host, stats] : m_mirrors)
+        {
+            mirrors[host] = {
+                {"latencyMs", stats.latencyMs},
+                {"samples", stats.samples},
+                {"failures", stats.failures}
+            };
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_filePath.parent_path(), ec);
+
+        std::filesystem::path tempPath = m_filePath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            file << json{{"version", FormatVersion}, {"entries", entries}, {"mirrors", mirrors}}.dump(2);
+            if (!file.good())
+            {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, m_filePath, ec);
+        return !ec;
+    }
+
+    bool ReleaseCache::Find(const std::string &url, CachedReleases &entry) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_entries.find(url);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+        entry = it->second;
+        return true;
+    }
+
+    void ReleaseCache::Store(const std::string &url, const CachedReleases &entry)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[url] = entry;
+    }
+
+    FetchedReleases ReleaseCache::Fetch(IHttpClient &client, const std::string &url, HttpRequest request, const std::string &installerName)
+    {
+        CachedReleases cached;
+        bool hasCached = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            LoadFile();
+            const auto it = m_entries.find(url);
+            if (it != m_entries.end())
+            {
+                cached = it->second;
+                hasCached = true;
+            }
+        }
+
+        // Validators are ASCII, RFC 9110 leaves anything else obsolete
+        if (hasCached && !cached.etag.empty())
+        {
+            request.headers.push_back(L"If-None-Match: " + std::wstring(cached.etag.begin(), cached.etag.end()));
+        }
+        if (hasCached && !cached.lastModified.empty())
+        {
+            request.headers.push_back(L"If-Modified-Since: " + std::wstring(cached.lastModified.begin(), cached.lastModified.end()));
+        }
+
+        FetchedReleases result;
+        try
+        {
+            HttpResponse response = client.Get(request);
+            if (response.status == 304 && hasCached)
+            {
+                result.status = 304;
+                result.releases = cached.releases;
+                return result;
+            }
+            if (response.status != 200)
+            {
+                throw std::runtime_error("Unexpected HTTP status " + std::to_string(response.status));
+            }
+
+            CachedReleases entry;
+            entry.etag = response.etag;
+            entry.lastModified = response.lastModified;
+            if (!ParseReleases(response.body, installerName, entry.releases))
+            {
+                throw std::runtime_error("Invalid releases response");
+            }
+
+            if (!entry.etag.empty() || !entry.lastModified.empty())
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries[url] = entry;
+                SaveFile();
+            }
+
+            result.status = 200;
+            result.releases = std::move(entry.releases);
+            return result;
+        }
+        catch (const std::exception &error)
+        {
+            if (!hasCached || (request.cancel && request.cancel->IsCancelled()))
+            {
+                throw;
+            }
+            result.error = error.what();
+            result.releases = cached.releases;
+            return result;
+        }
+    }
+
+    std::map<std::string, MirrorStats> ReleaseCache::GetMirrorStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_mirrors;
+    }
+
+    void ReleaseCache::SetMirrorStats(const std::map<std::string, MirrorStats> &stats)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mirrors = stats;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Updater/HttpClient.hpp"
+#include "Updater/MirrorRace.hpp"
+
+namespace AnyFSE::Updater
+{
+    // The part of a release description the updater actually uses.
+    struct ReleaseInfo
+    {
+        std::string tag;
+        std::string installerUrl;   // browser_download_url of the installer asset, if any
+        std::string installerSha256;// lowercase hex from the asset "digest", if the host publishes it
+        bool hasAssets = false;
+    };
+
+    struct CachedReleases
+    {
+        std::string etag;
+        std::string lastModified;
+        std::vector<ReleaseInfo> releases;
+    };
+
+    struct FetchedReleases
+    {
+        int status = 0;             // 200, 304, or 0 when the cache answered for a failed request
+        std::string error;          // why the request failed, when the cache answered for it
+        std::vector<ReleaseInfo> releases;
+    };
+
+    // Extracts ReleaseInfo from a single release object or an array of releases
+    // without building a json document. Returns false if the body is not valid json.
+    bool ParseReleases(std::string_view body, const std::string &installerName, std::vector<ReleaseInfo> &releases);
+
+    // On-disk cache of release queries keyed by request url. Keeps the validators
+    // for conditional requests, so an unchanged release list is neither downloaded
+    // nor parsed again. Mirror statistics are kept along with it. Thread safe, the lock
+    // is not held while a request is in flight.
+    class ReleaseCache
+    {
+    public:
+        explicit ReleaseCache(const std::filesystem::path &filePath);
+
+        bool Load();
+        bool Save() const;
+
+        bool Find(const std::string &url, CachedReleases &entry) const;
+        void Store(const std::string &url, const CachedReleases &entry);
+
+        // Sends request with the validators cached for url. A 200 is parsed, stored with its validators
+        // and saved, a 304 returns the cached releases. When the request fails otherwise the cached
+        // releases answer for it. Throws when there is no entry to fall back to or the request was cancelled.
+        FetchedReleases Fetch(IHttpClient &client, const std::string &url, HttpRequest request, const std::string &installerName);
+
+        std::map<std::string, MirrorStats> GetMirrorStats() const;
+        void SetMirrorStats(const std::map<std::string, MirrorStats> &stats);
+
+    private:
+        static constexpr int FormatVersion = 2;
+
+        mutable std::mutex m_mutex;
+        std::filesystem::path m_filePath;
+        std::map<std::string, CachedReleases> m_entries;
+        std::map<std::string, MirrorStats> m_mirrors;
+        bool m_loaded = false;
+
+        // Locked
+        bool LoadFile();
+        bool SaveFile() const;
+    };
+}
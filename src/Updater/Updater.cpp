@@ -1,9 +1,9 @@
 #include <windows.h>
-#include <winhttp.h>
 #include <sstream>
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
+#include <filesystem>
 #include <thread>
 #include <mutex>
 #include <string>
@@ -11,19 +11,18 @@
 #include "Updater.hpp"
 #include "App/AppConstants.hpp"
 #include "Updater/Updater.hpp"
+#include "Updater/Downloader.hpp"
+#include "Updater/MirrorRace.hpp"
+#include "Updater/ReleaseCache.hpp"
+#include "Updater/WinHttpClient.hpp"
 #include "Tools/Unicode.hpp"
 #include "Tools/Paths.hpp"
-#include "Tools/nlohmann/json.hpp"
+#include "Tools/PhaseTracer.hpp"
 #include "Configuration/Config.hpp"
 #include "Logging/LogManager.hpp"
 #include "Tools/Process.hpp"
 #include "Updater/Updater.hpp"
 
-#pragma comment(lib, "winhttp.lib")
-#pragma comment(lib, "urlmon.lib")
-
-using json = nlohmann::json;
-
 namespace AnyFSE::Updater
 {
 
@@ -75,6 +74,11 @@ namespace AnyFSE::Updater
             : GITHUB_RELEASE_PAGE + tag;
     }
 
+    // Mirror index in MirrorHosts, alt == (mirror == CODEBERG_MIRROR)
+    const size_t GITHUB_MIRROR = 0;
+    const size_t CODEBERG_MIRROR = 1;
+    const std::vector<std::string> MirrorHosts = { "api.github.com", "codeberg.org" };
+
 
     static UINT WM_UPDATER_COMMAND = RegisterWindowMessage(AppConstants::UpdaterCommandMessage);
     static bool m_bThreadExecuted = false;
@@ -83,6 +87,10 @@ namespace AnyFSE::Updater
     static std::thread m_thread;
 
     static std::list<SUBSCRIPTION> m_subscribes;
+    static std::mutex m_cacheMutex;
+    static MirrorSelector m_mirrors;
+    static const ULONGLONG DownloadProgressInterval = 250;
+
     struct SemVer
     {
         int major = 0, minor = 0, patch = 0;
@@ -92,114 +100,105 @@ namespace AnyFSE::Updater
     static void AddSubscribe(HWND hWnd, UINT uMsg);
     static void ClearSubscriptions();
     static void NotifySubscribers();
-    static UpdateInfo CheckUpdate(std::wstring minVersion, bool includePreRelease, bool alt);
+    static UpdateInfo CheckUpdate(std::wstring minVersion, bool includePreRelease, bool alt, HttpCancellation *cancel = nullptr);
     static UpdateInfo CheckUpdate(bool includePreRelease);
     static bool Update(const std::wstring &tag, bool silentUpdate);
     static bool Update(const std::wstring &tag, bool silentUpdate, bool alt);
-    static std::string WinHttpGet(const std::wstring& path, bool alt);
+    static IHttpClient &GetHttpClient();
+    static ReleaseCache &GetReleaseCache();
+    static std::vector<ReleaseInfo> GetReleases(const std::wstring& path, bool alt, HttpCancellation *cancel = nullptr);
+    static void LoadMirrorStats();
+    static void SaveMirrorStats();
     static SemVer ParseSemVer(const std::string& tag);
     static bool SemVerGreater(const SemVer& a, const SemVer& b);
     static std::wstring GetModuleVersion();
-    static std::string PickAssetDownloadUrl(const json& release);
 
     Logger log = LogManager::GetLogger("Updater");
 
     void ShowVersion(const std::wstring &tag)
     {
-        std::string str;
+        size_t mirror = CODEBERG_MIRROR;
 
+        LoadMirrorStats();
         try
         {
-            std::string resp = WinHttpGet(GetRelease(tag, false), false);
-            auto j = json::parse(resp);
-            if (j.contains("assets") && j["assets"].is_array())
-            {
-                Process::StartProtocol(GetReleasePage(tag, false));
-                return;
-            }
+            // Both mirrors are asked, the page of the first one having the release assets is opened
+            RaceMirrors<bool>(m_mirrors, MirrorHosts,
+                [tag](size_t mirror, HttpCancellation &cancel)
+                {
+                    bool alt = mirror == CODEBERG_MIRROR;
+                    std::vector<ReleaseInfo> releases = GetReleases(GetRelease(tag, alt), alt, &cancel);
+                    return !releases.empty() && releases.front().hasAssets;
+                },
+                [](const bool &hasAssets) { return hasAssets; },
+                &mirror);
         }
         catch (...)
         {}
+        SaveMirrorStats();
 
-        Process::StartProtocol(GetReleasePage(tag, true));
+        Process::StartProtocol(GetReleasePage(tag, mirror == CODEBERG_MIRROR));
     }
 
-    std::string WinHttpGet(const std::wstring &path, bool alt)
+    IHttpClient &GetHttpClient()
     {
-        log.Debug("Getting url: %s", Unicode::to_string(path).c_str());
+        static WinHttpClient client(AppConstants::UpdaterSessionUserAgent);
+        return client;
+    }
 
-        HINTERNET hSession = WinHttpOpen(AppConstants::UpdaterSessionUserAgent,
-                                         WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                         WINHTTP_NO_PROXY_NAME,
-                                         WINHTTP_NO_PROXY_BYPASS, 0);
-        if (!hSession)
-        {
-            log.Error(log.APIError(), "WinHttpOpen failed");
-            throw std::runtime_error("WinHttpOpen failed");
-        }
+    ReleaseCache &GetReleaseCache()
+    {
+        static ReleaseCache cache(std::filesystem::path(Tools::Paths::GetDataPath()) / L"UpdateCache.json");
+        return cache;
+    }
 
-        HINTERNET hConnect = WinHttpConnect(hSession, GetHost(alt).c_str(), INTERNET_DEFAULT_HTTPS_PORT, 0);
-        if (!hConnect)
+    void LoadMirrorStats()
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        GetReleaseCache().Load();
+        if (m_mirrors.GetStats().empty())
         {
-            WinHttpCloseHandle(hSession);
-            log.Error(log.APIError(), "WinHttpConnect failed");
-            throw std::runtime_error("WinHttpConnect failed");
+            m_mirrors.SetStats(GetReleaseCache().GetMirrorStats());
         }
+    }
 
-        std::wstring wpath = path;
-        HINTERNET hRequest = WinHttpOpenRequest(hConnect, L"GET", wpath.c_str(), NULL,
-                                                WINHTTP_NO_REFERER,
-                                                WINHTTP_DEFAULT_ACCEPT_TYPES,
-                                                WINHTTP_FLAG_SECURE);
-        if (!hRequest)
-        {
-            WinHttpCloseHandle(hConnect);
-            WinHttpCloseHandle(hSession);
-            log.Error(log.APIError(), "WinHttpOpenRequest failed");
-            throw std::runtime_error("WinHttpOpenRequest failed");
-        }
+    void SaveMirrorStats()
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        GetReleaseCache().SetMirrorStats(m_mirrors.GetStats());
+        GetReleaseCache().Save();
+    }
 
+    std::vector<ReleaseInfo> GetReleases(const std::wstring &path, bool alt, HttpCancellation *cancel)
+    {
+        HttpRequest request;
+        request.host = GetHost(alt);
+        request.path = path;
+        request.cancel = cancel;
         // GitHub requires User-Agent
-        std::wstring headers = GetUserAgent(alt);
+        request.headers.push_back(GetUserAgent(alt));
 
-        BOOL bSend = WinHttpSendRequest(hRequest, headers.c_str(), (DWORD)headers.length(),
-                                        WINHTTP_NO_REQUEST_DATA, 0, 0, 0);
-        if (!bSend || !WinHttpReceiveResponse(hRequest, NULL))
+        FetchedReleases fetched;
+        try
         {
-            WinHttpCloseHandle(hRequest);
-            WinHttpCloseHandle(hConnect);
-            WinHttpCloseHandle(hSession);
-            log.Error(log.APIError(), "WinHttp request failed");
-            throw std::runtime_error("WinHttp request failed");
+            fetched = GetReleaseCache().Fetch(GetHttpClient(),
+                Unicode::to_string(request.host + request.path), request, Unicode::to_string(AppConstants::InstallerExe));
         }
-
-        std::string result;
-        DWORD dwSize = 0;
-        do
+        catch (const std::exception &error)
         {
-            dwSize = 0;
-            if (!WinHttpQueryDataAvailable(hRequest, &dwSize))
-                break;
-
-            if (dwSize == 0)
-                break;
-
-            std::vector<char> buffer(dwSize + 1);
-            DWORD dwRead = 0;
-            if (!WinHttpReadData(hRequest, buffer.data(), dwSize, &dwRead))
-                break;
-
-            buffer[dwRead] = 0;
-            result.append(buffer.data(), dwRead);
-        } while (dwSize > 0);
-
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-
-        log.Debug("Recieved %d bytes", result.size());
+            log.Error("Release query failed: %s", error.what());
+            throw;
+        }
 
-        return result;
+        if (fetched.status == 304)
+        {
+            log.Debug("Not modified, using %d cached releases", fetched.releases.size());
+        }
+        else if (fetched.status == 0)
+        {
+            log.Warn("Release query failed, using %d cached releases: %s", fetched.releases.size(), fetched.error.c_str());
+        }
+        return fetched.releases;
     }
 
     SemVer ParseSemVer(const std::string &tag)
@@ -271,71 +270,61 @@ namespace AnyFSE::Updater
         return std::wstring(buf);
     }
 
-    std::string PickAssetDownloadUrl(const json &release)
-    {
-        if (!release.contains("assets") || !release["assets"].is_array())
-            return {};
-        std::string downloadUrl;
-        for (auto &a : release["assets"])
-        {
-            std::string name = a.value("name", "");
-            std::string url = a.value("browser_download_url", "");
-            if (name.empty() || url.empty())
-                continue;
-            // Prefer exact installer filename AnyFSE.Installer.exe
-            if (!_stricmp(name.c_str(), Unicode::to_string(AppConstants::InstallerExe).c_str()))
-            {
-                log.Debug("Installer at %s", url.c_str());
-                return url;
-            }
-        }
-        return downloadUrl;
-    }
-
-
     UpdateInfo CheckUpdate(bool includePreRelease)
     {
-        UpdateInfo ui;
-        UpdateInfo ui_alt;
-        try
-        {
-            ui = CheckUpdate(GetModuleVersion(), includePreRelease, false);
-        }
-        catch(...) {}
+        Tools::PhaseTracer::Scope trace("Update check", "updater");
+        LoadMirrorStats();
 
+        size_t mirror = GITHUB_MIRROR;
+        UpdateInfo info;
         try
         {
-            ui_alt = CheckUpdate(ui.newVersion, includePreRelease, true);
+            // Mirrors publish the same releases, the first one to answer wins
+            info = RaceMirrors<UpdateInfo>(m_mirrors, MirrorHosts,
+                [includePreRelease](size_t mirror, HttpCancellation &cancel)
+                {
+                    return CheckUpdate(GetModuleVersion(), includePreRelease, mirror == CODEBERG_MIRROR, &cancel);
+                },
+                [](const UpdateInfo &) { return true; },
+                &mirror);
         }
-        catch(...)
+        catch (...)
         {
-            if (ui.newVersion.empty())
-            {
-                throw;
-            }
+            SaveMirrorStats();
+            throw;
         }
+        SaveMirrorStats();
 
-        return ui_alt.newVersion.empty() ? ui : ui_alt;
+        log.Debug("Update check answered by %s", MirrorHosts[mirror].c_str());
+        return info;
     }
 
     bool Update(const std::wstring &tag, bool silentUpdate)
     {
-        bool updated = false;
-
-        try
-        {
-            updated = Update(tag, silentUpdate, false);
-        }
-        catch(...) {}
+        // Downloads are not raced, mirrors are tried in the order of their past performance
+        LoadMirrorStats();
+        std::vector<size_t> order = m_mirrors.Order(MirrorHosts);
 
-        if (!updated)
+        for (size_t i = 0; i < order.size(); ++i)
         {
-            updated = Update(tag, silentUpdate, true);
+            try
+            {
+                return Update(tag, silentUpdate, order[i] == CODEBERG_MIRROR);
+            }
+            catch (...)
+            {
+                m_mirrors.RecordFailure(MirrorHosts[order[i]]);
+                SaveMirrorStats();
+                if (i + 1 == order.size())
+                {
+                    throw;
+                }
+            }
         }
-        return updated;
+        return false;
     }
 
-    UpdateInfo CheckUpdate(std::wstring minVersion, bool includePreRelease, bool alt)
+    UpdateInfo CheckUpdate(std::wstring minVersion, bool includePreRelease, bool alt, HttpCancellation *cancel)
     {
         // New API: return UpdateInfo with newVersion and downloadPath (browser_download_url)
         UpdateInfo info;
@@ -346,50 +335,41 @@ namespace AnyFSE::Updater
 
         if (!includePreRelease)
         {
-            std::string resp = WinHttpGet(GetReleasesLatest(alt), alt);
-            auto j = json::parse(resp);
-            std::string tag = j.value("tag_name", "");
-            if (tag.empty())
+            std::vector<ReleaseInfo> releases = GetReleases(GetReleasesLatest(alt), alt, cancel);
+            if (releases.empty() || releases.front().tag.empty())
             {
                 log.Debug("releases/latest Tag not found");
                 return info; // empty
             }
-            SemVer remote = ParseSemVer(tag);
+            const ReleaseInfo &latest = releases.front();
+            SemVer remote = ParseSemVer(latest.tag);
             if (SemVerGreater(remote, current))
             {
-                log.Debug("Found latest version %s", tag.c_str());
+                log.Debug("Found latest version %s", latest.tag.c_str());
 
-                info.newVersion = Tools::Unicode::to_wstring(tag);
-                std::string url = PickAssetDownloadUrl(j);
-                info.downloadPath = Tools::Unicode::to_wstring(url);
+                info.newVersion = Tools::Unicode::to_wstring(latest.tag);
+                info.downloadPath = Tools::Unicode::to_wstring(latest.installerUrl);
                 return info;
             }
             return info;
         }
 
-        std::string resp = WinHttpGet(GetPreReleases(alt), alt);
-        auto j = json::parse(resp);
-        if (!j.is_array())
-        {
-            log.Error(log.APIError(), "Invalid releases response");
-            throw std::runtime_error("Invalid releases response");
-        }
+        std::vector<ReleaseInfo> releases = GetReleases(GetPreReleases(alt), alt, cancel);
 
         SemVer best = current;
         std::string bestTag;
         std::string bestUrl;
 
-        for (auto &item : j)
+        for (const ReleaseInfo &item : releases)
         {
-            std::string tag = item.value("tag_name", "");
-            if (tag.empty())
+            if (item.tag.empty())
                 continue;
-            SemVer sv = ParseSemVer(tag);
+            SemVer sv = ParseSemVer(item.tag);
             if (SemVerGreater(sv, best))
             {
                 best = sv;
-                bestTag = tag;
-                bestUrl = PickAssetDownloadUrl(item);
+                bestTag = item.tag;
+                bestUrl = item.installerUrl;
             }
         }
 
@@ -433,46 +413,58 @@ namespace AnyFSE::Updater
             throw std::invalid_argument("tag is empty");
 
         // Query release by tag
-        std::string resp = WinHttpGet(GetRelease(tag, alt), alt);
-        auto j = json::parse(resp);
+        std::vector<ReleaseInfo> releases = GetReleases(GetRelease(tag, alt), alt);
 
-        // find suitable asset
-        std::string downloadUrl;
-        std::string assetName;
-        if (j.contains("assets") && j["assets"].is_array())
-        {
-            for (auto &a : j["assets"])
-            {
-                std::string name = a.value("name", "");
-                std::string url = a.value("browser_download_url", "");
-                if (name.empty() || url.empty())
-                    continue;
-                // prefer exact AnyFSE.Installer.exe
-                if (!_stricmp(name.c_str(), Unicode::to_string(AppConstants::InstallerExe).c_str()))
-                {
-                    downloadUrl = url;
-                    assetName = name;
-                    break;
-                }
-            }
-        }
+        // AnyFSE.Installer.exe asset
+        std::string downloadUrl = releases.empty() ? std::string() : releases.front().installerUrl;
+        std::string downloadSha256 = releases.empty() ? std::string() : releases.front().installerSha256;
 
         if (downloadUrl.empty())
             throw std::runtime_error("No downloadable asset found for tag");
 
-
-        // convert assetName to wstring
-        std::wstring wname = Tools::Unicode::to_wstring(assetName);
         std::wstring localPath = Tools::Paths::GetTempPath() + L"\\" + AppConstants::UpdaterTempExePrefix + tag + AppConstants::UpdaterTempExeSuffix;
 
-        // download
-        std::wstring wurl = Tools::Unicode::to_wstring(downloadUrl);
-        HRESULT hr = URLDownloadToFileW(NULL, wurl.c_str(), localPath.c_str(), 0, NULL);
-        if (FAILED(hr))
+        // download, an interrupted transfer resumes from the .part file on the next attempt
+        ULONGLONG lastNotify = 0;
+        Downloader downloader(GetHttpClient());
+        try
+        {
+            downloader.Download(
+                Tools::Unicode::to_wstring(downloadUrl),
+                { AppConstants::UpdaterUserAgentHeader },
+                localPath,
+                downloadSha256,
+                [&lastNotify](long long received, long long total)
+                {
+                    std::lock_guard<std::mutex> lock(m_readMutex);
+                    m_lastUpdateInfo.lDownloaded = received;
+                    m_lastUpdateInfo.lDownloadTotal = total;
+
+                    ULONGLONG now = GetTickCount64();
+                    if (now - lastNotify >= DownloadProgressInterval || received == total)
+                    {
+                        lastNotify = now;
+                        NotifySubscribers();
+                    }
+                });
+        }
+        catch (const std::exception &ex)
+        {
+            log.Error(ex, "Download failed");
+            throw;
+        }
+
+        log.Info("Downloaded %s, sha256 %s%s", downloadUrl.c_str(), downloader.GetSha256().c_str(),
+            downloadSha256.empty() ? " (not published, unverified)" : " (verified)");
+
+        // Without a published digest only a single response is trusted to be one file
+        if (downloadSha256.empty() && downloader.WasResumed())
         {
-            log.Error(log.APIError(), "Download failed");
-            throw std::runtime_error("Download failed");
+            log.Error("Resumed download of %s cannot be verified, not launching it", downloadUrl.c_str());
+            DeleteFile(localPath.c_str());
+            throw std::runtime_error("Resumed download cannot be verified");
         }
+
         Sleep(1000);
         {
             std::lock_guard<std::mutex> lock(m_readMutex);
@@ -579,6 +571,8 @@ namespace AnyFSE::Updater
         m_lastUpdateInfo.uiState = UpdaterState::Downloading;
         m_lastUpdateInfo.uiCommand = UpdaterState::Downloading;
         m_lastUpdateInfo.lCommandAge = GetTickCount64();
+        m_lastUpdateInfo.lDownloaded = 0;
+        m_lastUpdateInfo.lDownloadTotal = -1;
 
         NotifySubscribers();
 
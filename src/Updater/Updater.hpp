@@ -31,6 +31,8 @@ namespace AnyFSE::Updater
         std::wstring downloadPath = L"\0";
         long long lCommandAge = 0;
         UpdaterState uiCommand = UpdaterState::Idle;
+        long long lDownloaded = 0;
+        long long lDownloadTotal = -1;
     };
 
     struct SUBSCRIPTION
@@ -61,12 +63,16 @@ namespace AnyFSE::Updater
         wchar_t downloadPath[MAX_PATH] = L"\0";
         long long lCommandAge;
         UpdaterState uiCommand;
+        long long lDownloaded;
+        long long lDownloadTotal;
 
         void put(UpdateInfo i)
         {
             uiState = i.uiState;
             lCommandAge = i.lCommandAge;
             uiCommand = i.uiCommand;
+            lDownloaded = i.lDownloaded;
+            lDownloadTotal = i.lDownloadTotal;
             wcsncpy_s(newVersion, i.newVersion.c_str(), MAX_PATH - 1);
             wcsncpy_s(downloadPath, i.downloadPath.c_str(), MAX_PATH - 1);
         }
@@ -0,0 +1,180 @@
+#include <windows.h>
+#include <winhttp.h>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Updater/WinHttpClient.hpp"
+#include "Tools/Unicode.hpp"
+#include "Logging/LogManager.hpp"
+
+#pragma comment(lib, "winhttp.lib")
+
+namespace AnyFSE::Updater
+{
+    static Logger log = LogManager::GetLogger("Updater");
+
+    static const DWORD ReadBufferSize = 64 * 1024;
+
+    WinHttpClient::WinHttpClient(const std::wstring &userAgent)
+        : m_userAgent(userAgent)
+    {
+        m_hSession = WinHttpOpen(m_userAgent.c_str(),
+                                 WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                                 WINHTTP_NO_PROXY_NAME,
+                                 WINHTTP_NO_PROXY_BYPASS, 0);
+        if (!m_hSession)
+        {
+            log.Error(log.APIError(), "WinHttpOpen failed");
+        }
+    }
+
+    WinHttpClient::~WinHttpClient()
+    {
+        if (m_hSession)
+        {
+            WinHttpCloseHandle(m_hSession);
+        }
+    }
+
+    std::string WinHttpClient::QueryHeader(HINTERNET hRequest, DWORD dwInfoLevel)
+    {
+        wchar_t value[512] = {0};
+        DWORD dwSize = sizeof(value);
+        if (!WinHttpQueryHeaders(hRequest, dwInfoLevel, WINHTTP_HEADER_NAME_BY_INDEX, value, &dwSize, WINHTTP_NO_HEADER_INDEX))
+        {
+            return std::string();
+        }
+        return Unicode::to_string(value);
+    }
+
+    HttpResponse WinHttpClient::Get(const HttpRequest &request, const HttpBodySink &sink)
+    {
+        log.Debug("Getting url: %s%s", Unicode::to_string(request.host).c_str(), Unicode::to_string(request.path).c_str());
+
+        if (!m_hSession)
+        {
+            throw std::runtime_error("WinHttpOpen failed");
+        }
+
+        HINTERNET hConnect = WinHttpConnect(m_hSession, request.host.c_str(), request.port, 0);
+        if (!hConnect)
+        {
+            log.Error(log.APIError(), "WinHttpConnect failed");
+            throw std::runtime_error("WinHttpConnect failed");
+        }
+
+        HINTERNET hRequest = WinHttpOpenRequest(hConnect, L"GET", request.path.c_str(), NULL,
+                                                WINHTTP_NO_REFERER,
+                                                WINHTTP_DEFAULT_ACCEPT_TYPES,
+                                                request.secure ? WINHTTP_FLAG_SECURE : 0);
+        if (!hRequest)
+        {
+            WinHttpCloseHandle(hConnect);
+            log.Error(log.APIError(), "WinHttpOpenRequest failed");
+            throw std::runtime_error("WinHttpOpenRequest failed");
+        }
+
+        // Closing the request handle is the way to interrupt a synchronous WinHTTP call.
+        if (request.cancel && !request.cancel->Attach([hRequest]() { WinHttpCloseHandle(hRequest); }))
+        {
+            WinHttpCloseHandle(hRequest);
+            WinHttpCloseHandle(hConnect);
+            throw std::runtime_error("Request cancelled");
+        }
+
+        auto closeHandles = [&]()
+        {
+            if (!request.cancel || request.cancel->Detach())
+            {
+                WinHttpCloseHandle(hRequest);
+            }
+            WinHttpCloseHandle(hConnect);
+        };
+
+        auto isCancelled = [&]()
+        {
+            return request.cancel && request.cancel->IsCancelled();
+        };
+
+        std::wstring headers;
+        for (const std::wstring &header : request.headers)
+        {
+            headers += header;
+            if (headers.size() < 2 || headers.compare(headers.size() - 2, 2, L"\r\n") != 0)
+            {
+                headers += L"\r\n";
+            }
+        }
+
+        BOOL bSend = WinHttpSendRequest(hRequest,
+                                        headers.empty() ? WINHTTP_NO_ADDITIONAL_HEADERS : headers.c_str(),
+                                        (DWORD)headers.length(),
+                                        WINHTTP_NO_REQUEST_DATA, 0, 0, 0);
+        if (!bSend || !WinHttpReceiveResponse(hRequest, NULL))
+        {
+            closeHandles();
+            if (isCancelled())
+            {
+                log.Debug("Request to %s cancelled", Unicode::to_string(request.host).c_str());
+                throw std::runtime_error("Request cancelled");
+            }
+            log.Error(log.APIError(), "WinHttp request failed");
+            throw std::runtime_error("WinHttp request failed");
+        }
+
+        HttpResponse response;
+
+        DWORD dwStatus = 0;
+        DWORD dwStatusSize = sizeof(dwStatus);
+        WinHttpQueryHeaders(hRequest, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                            WINHTTP_HEADER_NAME_BY_INDEX, &dwStatus, &dwStatusSize, WINHTTP_NO_HEADER_INDEX);
+
+        response.status = (int)dwStatus;
+        response.etag = QueryHeader(hRequest, WINHTTP_QUERY_ETAG);
+        response.lastModified = QueryHeader(hRequest, WINHTTP_QUERY_LAST_MODIFIED);
+        response.contentRange = QueryHeader(hRequest, WINHTTP_QUERY_CONTENT_RANGE);
+
+        std::string contentLength = QueryHeader(hRequest, WINHTTP_QUERY_CONTENT_LENGTH);
+        if (!contentLength.empty())
+        {
+            response.contentLength = std::strtoll(contentLength.c_str(), nullptr, 10);
+        }
+
+        // One buffer per request, chunks are handed to the sink and never accumulated here.
+        std::vector<char> buffer(ReadBufferSize);
+        unsigned long long received = 0;
+        bool failed = false;
+        for (;;)
+        {
+            DWORD dwRead = 0;
+            if (!WinHttpReadData(hRequest, buffer.data(), (DWORD)buffer.size(), &dwRead))
+            {
+                failed = true;
+                break;
+            }
+            if (dwRead == 0 || !sink(response, buffer.data(), dwRead))
+            {
+                break;
+            }
+            received += dwRead;
+        }
+
+        if (failed && !isCancelled())
+        {
+            log.Error(log.APIError(), "WinHttpReadData failed after %llu bytes", received);
+        }
+
+        closeHandles();
+
+        if (failed)
+        {
+            throw std::runtime_error(isCancelled() ? "Request cancelled" : "WinHttp transfer interrupted");
+        }
+
+        log.Debug("Status %d, recieved %llu bytes", response.status, received);
+
+        return response;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <windows.h>
+#include <winhttp.h>
+#include <string>
+
+#include "Updater/HttpClient.hpp"
+
+namespace AnyFSE::Updater
+{
+    // IHttpClient over a single WinHTTP session, which is safe to share between threads.
+    class WinHttpClient : public IHttpClient
+    {
+    public:
+        explicit WinHttpClient(const std::wstring &userAgent);
+        ~WinHttpClient();
+
+        using IHttpClient::Get;
+        HttpResponse Get(const HttpRequest &request, const HttpBodySink &sink) override;
+
+    private:
+        std::wstring m_userAgent;
+        HINTERNET m_hSession = NULL;
+
+        static std::string QueryHeader(HINTERNET hRequest, DWORD dwInfoLevel);
+    };
+}
@@ -0,0 +1,108 @@
+// Anchor layout of 2000 controls over three frames: a full tree pass per resize against placing every
+// control on its own the way ReflowControl does, and a pass where nothing moved.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "FluentDesign/AnchorLayout.hpp"
+
+using namespace FluentDesign::AnchorLayout;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    const uint32_t Dpi = 144;
+    const Rect Frames[] = {{0, 0, 1200, 900}, {-1, -1, 1200, 900}, {100, 0, 1100, 900}};
+
+    // The frames after the pass'th resize step
+    void Build(Tree &tree, const std::vector<Node> &nodes, int pass)
+    {
+        tree.Clear();
+        for (const Rect &frame : Frames)
+        {
+            Rect resized = frame;
+            resized.right += pass % 50;
+            tree.AddFrame(resized);
+        }
+        for (const Node &node : nodes)
+        {
+            tree.Add(node);
+        }
+        tree.Measure(Dpi);
+    }
+}
+
+int main()
+{
+    const int Count = 2000;
+    const int Passes = 2000;
+
+    std::mt19937 rng(7);
+    std::vector<Node> nodes;
+    for (int i = 0; i < Count; i++)
+    {
+        Node node;
+        node.anchor = (uint8_t)((rng() % 4) << 6 | (rng() % 4) << 4 | (rng() % 3) << 2 | (rng() % 3));
+        if (!node.anchor)
+        {
+            node.anchor = 0x50;
+        }
+        node.margins = {(float)(rng() % 100), (float)(rng() % 2000), (float)(rng() % 200), (float)(rng() % 60)};
+        node.frame = (int32_t)(rng() % 3);
+        nodes.push_back(node);
+    }
+
+    Tree tree;
+    size_t changed = 0;
+    Stopwatch full;
+    for (int pass = 0; pass < Passes; pass++)
+    {
+        Build(tree, nodes, pass);
+        changed += tree.Arrange(Dpi);
+    }
+    double fullUs = full.ElapsedMs() * 1000 / Passes;
+    CHECK(changed > 0);
+
+    int32_t sink = 0;
+    Stopwatch single;
+    for (int pass = 0; pass < Passes; pass++)
+    {
+        for (const Node &node : nodes)
+        {
+            Rect frame = Frames[node.frame];
+            frame.right += pass % 50;
+            sink += Scale(Place(node.anchor, node.margins, Unscale(frame, Dpi)), Dpi).left;
+        }
+    }
+    double singleUs = single.ElapsedMs() * 1000 / Passes;
+
+    // The last pass of both ways agrees
+    for (int i = 0; i < Count; i++)
+    {
+        Rect frame = Frames[nodes[i].frame];
+        frame.right += (Passes - 1) % 50;
+        CHECK(tree[i].arranged == Scale(Place(nodes[i].anchor, nodes[i].margins, Unscale(frame, Dpi)), Dpi));
+    }
+
+    // Every control already where the pass puts it
+    for (int i = 0; i < Count; i++)
+    {
+        nodes[i].current = tree[i].arranged;
+    }
+    size_t unchanged = 0;
+    Stopwatch still;
+    for (int pass = 0; pass < Passes; pass++)
+    {
+        Build(tree, nodes, Passes - 1);
+        unchanged += tree.Arrange(Dpi);
+    }
+    double stillUs = still.ElapsedMs() * 1000 / Passes;
+    CHECK(unchanged == 0);
+
+    std::printf("%d nodes: tree pass %8.1f us (%5.1f ns/node), per control %8.1f us, no-change pass %8.1f us (%d)\n",
+        Count, fullUs, fullUs * 1000 / Count, singleUs, stillUs, sink & 1);
+
+    return AnyFSE::Tests::Result();
+}
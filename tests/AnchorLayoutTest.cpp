@@ -0,0 +1,163 @@
+// Anchor layout on plain data against the per control formulas of ReflowControl, nested nodes,
+// bad parents and change detection.
+
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "FluentDesign/AnchorLayout.hpp"
+
+using namespace FluentDesign::AnchorLayout;
+
+namespace
+{
+    // ReflowControl as it was before the tree: each control unscales its parent, applies its anchor and scales back
+    struct RectF
+    {
+        float X, Y, Width, Height;
+    };
+
+    float HorizontalSide(int side, const RectF &rect, float size)
+    {
+        switch (side)
+        {
+        case 1: return rect.X;
+        case 2: return rect.X + rect.Width;
+        case 3: return rect.X + rect.Width / 2;
+        }
+        return size;
+    }
+
+    float VerticalSide(int side, const RectF &rect, float size)
+    {
+        switch (side)
+        {
+        case 1: return rect.Y;
+        case 2: return rect.Y + rect.Height;
+        case 3: return rect.Y + rect.Height / 2;
+        }
+        return size;
+    }
+
+    Rect Reference(uint8_t anchor, const Margins &margins, const Rect &parent, uint32_t dpi)
+    {
+        auto unscale = [dpi](float value) { return value * 96 / dpi; };
+        auto scale = [dpi](float value) { return value * dpi / 96; };
+
+        RectF parentRect{unscale((float)parent.left), unscale((float)parent.top),
+            unscale((float)(parent.right - parent.left)), unscale((float)(parent.bottom - parent.top))};
+        float left = margins.left + HorizontalSide((anchor >> 6) & 3, parentRect, 0);
+        float top = margins.top + VerticalSide((anchor >> 4) & 3, parentRect, 0);
+        float right = margins.right + HorizontalSide((anchor >> 2) & 3, parentRect, left);
+        float bottom = margins.bottom + VerticalSide(anchor & 3, parentRect, top);
+        RectF control{left, top, right - left, bottom - top};
+        return Rect{(int32_t)scale(control.X), (int32_t)scale(control.Y),
+            (int32_t)scale(control.X + control.Width), (int32_t)scale(control.Y + control.Height)};
+    }
+
+    uint8_t Anchor(int left, int top, int right, int bottom)
+    {
+        return (uint8_t)(left << 6 | top << 4 | right << 2 | bottom);
+    }
+}
+
+int main()
+{
+    // Same pixels as before for every anchor, margin and DPI
+    std::mt19937 rng(7);
+    const uint32_t dpis[] = {96, 120, 144, 168, 192, 240, 288};
+    int mismatches = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        uint32_t dpi = dpis[rng() % 7];
+        uint8_t anchor = (uint8_t)(rng() % 256);
+        anchor = anchor ? anchor : 0x55;
+        Rect frame{(int32_t)(rng() % 40) - 20, (int32_t)(rng() % 40) - 20, 0, 0};
+        frame.right = frame.left + (int32_t)(rng() % 3000);
+        frame.bottom = frame.top + (int32_t)(rng() % 2000);
+        Margins margins{
+            (float)((int)(rng() % 801) - 400) / (rng() % 2 ? 1 : 3.f),
+            (float)((int)(rng() % 801) - 400),
+            (float)((int)(rng() % 801) - 400) / 7.f,
+            (float)((int)(rng() % 801) - 400)};
+
+        Tree tree;
+        tree.AddFrame(frame);
+        Node node;
+        node.anchor = anchor;
+        node.margins = margins;
+        tree.Add(node);
+        tree.Measure(dpi);
+        tree.Arrange(dpi);
+
+        Rect expected = Reference(anchor, margins, frame, dpi);
+        mismatches += tree[0].arranged != expected;
+        mismatches += Scale(Place(anchor, margins, Unscale(frame, dpi)), dpi) != expected;
+    }
+    CHECK(mismatches == 0);
+
+    // A child is placed in its parent's client coordinates, a bad parent is refused,
+    // a node without an anchor keeps its rect and only moved nodes are changed
+    Tree tree;
+    tree.AddFrame(Rect{0, 0, 800, 600});
+    Node panel;
+    panel.anchor = Anchor(1, 1, 2, 2);
+    panel.margins = {10, 10, -10, -10};
+    panel.current = Rect{10, 10, 790, 590};
+    int32_t parent = tree.Add(panel);
+
+    Node child;
+    child.anchor = Anchor(2, 2, 0, 0);
+    child.margins = {-50, -20, 40, 16};
+    child.parent = parent;
+    tree.Add(child);
+
+    Node orphan;
+    orphan.parent = 5;
+    CHECK(tree.Add(orphan) == -1);
+
+    Node fixed;
+    fixed.current = Rect{1, 2, 3, 4};
+    tree.Add(fixed);
+
+    tree.Measure(96);
+    CHECK(tree.Arrange(96) == 1);
+    CHECK(tree.Count() == 3);
+    CHECK(!tree[0].changed);
+    CHECK(tree[1].changed && tree[1].arranged == Rect({730, 560, 770, 576}));
+    CHECK(!tree[2].changed && tree[2].arranged == fixed.current);
+
+    // Rebuilding with the arranged rects as current changes nothing
+    std::vector<Node> nodes;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        Node node;
+        node.anchor = Anchor(rng() % 4, rng() % 4, rng() % 3, rng() % 3);
+        node.anchor = node.anchor ? node.anchor : 0x50;
+        node.margins = {(float)(rng() % 100), (float)(rng() % 2000), (float)(rng() % 200), (float)(rng() % 60)};
+        node.frame = (int32_t)(rng() % 3);
+        nodes.push_back(node);
+    }
+    const Rect frames[] = {{0, 0, 1200, 900}, {-1, -1, 1200, 900}, {100, 0, 1100, 900}};
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        tree.Clear();
+        for (const Rect &frame : frames)
+        {
+            tree.AddFrame(frame);
+        }
+        for (const Node &node : nodes)
+        {
+            tree.Add(node);
+        }
+        tree.Measure(144);
+        size_t changed = tree.Arrange(144);
+        CHECK(pass == 0 ? changed > 0 : changed == 0);
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].current = tree[i].arranged;
+        }
+    }
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// The few checks the portable tests need. A failed check is reported with its line and the test goes on,
+// main returns Result() so ctest sees the failure. Unlike assert it stays on in release builds.
+namespace AnyFSE::Tests
+{
+    inline int &Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline int Result()
+    {
+        if (Failures())
+        {
+            std::fprintf(stderr, "%d check(s) failed\n", Failures());
+            return 1;
+        }
+        std::printf("ok\n");
+        return 0;
+    }
+
+    // Milliseconds since the stopwatch was made, for the timings benches print
+    class Stopwatch
+    {
+    public:
+        double ElapsedMs() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+    };
+}
+
+#define CHECK(condition)                                                                        \
+    do                                                                                          \
+    {                                                                                           \
+        if (!(condition))                                                                       \
+        {                                                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);  \
+            ++AnyFSE::Tests::Failures();                                                        \
+        }                                                                                       \
+    } while (false)
@@ -0,0 +1,310 @@
+// Resumable download against a scripted http client: retries with Range and If-Range, servers
+// ignoring it, resuming a part file left by an earlier run, a file replaced between attempts,
+// digest checks and status errors. Sha256 test vectors.
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "Check.hpp"
+#include "Tools/Sha256.hpp"
+#include "Updater/Downloader.hpp"
+
+using namespace AnyFSE::Updater;
+
+namespace
+{
+    // Serves data in 1000 byte chunks, can drop the connection, ignore Range or answer
+    // the first resume from a different offset than was asked for. Range is honoured only
+    // while If-Range matches the etag; replacement swaps the file in after a disconnect.
+    struct ScriptedClient : IHttpClient
+    {
+        std::string data;
+        std::string etag = "\"v1\"";
+        std::string replacement;
+        long long lastStart = 0;
+        size_t failAfter = 0;
+        int failures = 0;
+        bool ignoreRange = false;
+        int status = 0;
+        long long shift = 0;
+        int calls = 0;
+
+        HttpResponse Get(const HttpRequest &request, const HttpBodySink &sink) override
+        {
+            calls++;
+            HttpResponse response;
+            if (status)
+            {
+                response.status = status;
+                return response;
+            }
+
+            long long start = 0;
+            std::string ifRange;
+            for (const std::wstring &header : request.headers)
+            {
+                if (header.rfind(L"Range: bytes=", 0) == 0)
+                {
+                    start = std::stoll(std::string(header.begin() + 13, header.end() - 1));
+                }
+                else if (header.rfind(L"If-Range: ", 0) == 0)
+                {
+                    ifRange = std::string(header.begin() + 10, header.end());
+                }
+            }
+            lastStart = start;
+            response.etag = etag;
+
+            const long long size = (long long)data.size();
+            if (start && !ignoreRange && ifRange == etag)
+            {
+                if (start >= size)
+                {
+                    response.status = 416;
+                    return response;
+                }
+                start -= shift;
+                shift = 0;
+                response.status = 206;
+                response.contentRange = "bytes " + std::to_string(start) + "-" + std::to_string(size - 1) + "/" + std::to_string(size);
+                response.contentLength = size - start;
+            }
+            else
+            {
+                start = 0;
+                response.status = 200;
+                response.contentLength = size;
+            }
+
+            size_t sent = 0;
+            for (size_t pos = (size_t)start; pos < data.size();)
+            {
+                if (failures > 0 && sent >= failAfter)
+                {
+                    failures--;
+                    if (!replacement.empty())
+                    {
+                        data.swap(replacement);
+                        replacement.clear();
+                        etag = "\"v2\"";
+                    }
+                    throw std::runtime_error("disconnect");
+                }
+                size_t chunk = std::min<size_t>(1000, data.size() - pos);
+                if (!sink(response, data.data() + pos, chunk))
+                {
+                    break;
+                }
+                pos += chunk;
+                sent += chunk;
+            }
+            return response;
+        }
+    };
+
+    std::string Sha256Of(const std::string &data)
+    {
+        AnyFSE::Tools::Sha256 hash;
+        hash.Update(data.data(), data.size());
+        return hash.HexDigest();
+    }
+
+    std::string ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void WriteFile(const std::filesystem::path &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+}
+
+int main()
+{
+    CHECK(Sha256Of("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(Sha256Of("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(Sha256Of("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")
+        == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // Fed in uneven chunks across block boundaries
+    AnyFSE::Tools::Sha256 million;
+    const std::string as(997, 'a');
+    for (size_t left = 1000000; left;)
+    {
+        size_t chunk = std::min(left, 1 + left % as.size());
+        million.Update(as.data(), chunk);
+        left -= chunk;
+    }
+    CHECK(million.HexDigest() == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "AnyFSE.DownloaderTest";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    const std::filesystem::path target = folder / "out.bin";
+    std::filesystem::path part = target;
+    part += ".part";
+    std::filesystem::path validator = part;
+    validator += ".validator";
+
+    ScriptedClient client;
+    for (int i = 0; i < 123457; i++)
+    {
+        client.data += char(i * 7);
+    }
+    const std::string digest = Sha256Of(client.data);
+    const long long size = (long long)client.data.size();
+
+    // Three disconnects, each attempt resumes where the last one stopped
+    client.failAfter = 30000;
+    client.failures = 3;
+    Downloader resumed(client);
+    resumed.SetRetryDelay(std::chrono::milliseconds(0));
+    long long last = 0;
+    bool monotonic = true;
+    resumed.Download(L"https://example.com:8443/file", {}, target, digest, [&](long long received, long long total)
+    {
+        monotonic = monotonic && received > last && total == size;
+        last = received;
+    });
+    CHECK(monotonic && last == size);
+    CHECK(resumed.GetAttempts() == 4);
+    CHECK(resumed.GetSha256() == digest);
+    CHECK(resumed.WasResumed());
+    CHECK(ReadFile(target) == client.data);
+    CHECK(!std::filesystem::exists(part));
+    CHECK(!std::filesystem::exists(validator));
+
+    // A server ignoring Range sends everything again
+    client.failures = 1;
+    client.ignoreRange = true;
+    Downloader restarted(client);
+    restarted.SetRetryDelay(std::chrono::milliseconds(0));
+    restarted.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(!restarted.WasResumed());
+    client.ignoreRange = false;
+
+    // A part file from an earlier run is resumed in one request
+    WriteFile(part, client.data.substr(0, 50000));
+    WriteFile(validator, client.etag);
+    client.calls = 0;
+    Downloader fromPart(client);
+    fromPart.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(client.calls == 1 && client.lastStart == 50000);
+    CHECK(fromPart.WasResumed());
+
+    // Without a saved validator the part file is dropped
+    WriteFile(part, client.data.substr(0, 50000));
+    client.calls = 0;
+    Downloader unvalidated(client);
+    unvalidated.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(client.calls == 1 && client.lastStart == 0);
+    CHECK(!unvalidated.WasResumed());
+
+    // The file was replaced on the server since the part was written: If-Range fails,
+    // the 200 reply is the whole new file
+    WriteFile(part, std::string(50000, 'x'));
+    WriteFile(validator, "\"old\"");
+    client.calls = 0;
+    Downloader replaced(client);
+    replaced.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(client.calls == 1);
+    CHECK(!replaced.WasResumed());
+
+    // Replaced between two attempts of one download
+    std::string original = client.data;
+    client.replacement = client.data.substr(1000) + "new";
+    const std::string replacementDigest = Sha256Of(client.replacement);
+    client.failAfter = 30000;
+    client.failures = 1;
+    client.calls = 0;
+    Downloader changed(client);
+    changed.SetRetryDelay(std::chrono::milliseconds(0));
+    changed.Download(L"http://x/y", {}, target, replacementDigest);
+    CHECK(ReadFile(target) == client.data && client.data != original);
+    CHECK(client.calls == 2 && client.lastStart == 30000);
+    CHECK(!changed.WasResumed());
+    client.data = original;
+    client.etag = "\"v1\"";
+
+    // A server without validators cannot be resumed, a retry starts over
+    client.etag.clear();
+    client.failures = 1;
+    client.calls = 0;
+    Downloader noValidator(client);
+    noValidator.SetRetryDelay(std::chrono::milliseconds(0));
+    noValidator.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(client.calls == 2 && client.lastStart == 0);
+    CHECK(!noValidator.WasResumed());
+    client.etag = "\"v1\"";
+
+    // A complete part file gets 416 and is downloaded again
+    WriteFile(part, client.data);
+    WriteFile(validator, client.etag);
+    Downloader complete(client);
+    complete.SetRetryDelay(std::chrono::milliseconds(0));
+    complete.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+
+    // 206 from another offset than requested drops the part file and starts over
+    WriteFile(part, client.data.substr(0, 50000));
+    WriteFile(validator, client.etag);
+    client.shift = 100;
+    client.calls = 0;
+    Downloader shifted(client);
+    shifted.SetRetryDelay(std::chrono::milliseconds(0));
+    shifted.Download(L"http://x/y", {}, target, digest);
+    CHECK(ReadFile(target) == client.data);
+    CHECK(client.calls == 2);
+
+    // Digest mismatch throws and leaves no part file behind
+    bool mismatch = false;
+    try
+    {
+        Downloader wrong(client);
+        wrong.Download(L"http://x/y", {}, target, "00");
+    }
+    catch (const std::runtime_error &)
+    {
+        mismatch = true;
+    }
+    CHECK(mismatch);
+    CHECK(!std::filesystem::exists(part));
+
+    // Client errors are not retried
+    client.status = 404;
+    client.calls = 0;
+    int status = 0;
+    try
+    {
+        Downloader missing(client);
+        missing.Download(L"http://x/y", {}, target, "");
+    }
+    catch (const HttpStatusError &error)
+    {
+        status = error.GetStatus();
+    }
+    CHECK(status == 404);
+    CHECK(client.calls == 1);
+
+    HttpRequest request;
+    CHECK(ParseUrl(L"https://github.com/a/b?x=1", request));
+    CHECK(request.host == L"github.com" && request.port == 443 && request.path == L"/a/b?x=1" && request.secure);
+    CHECK(ParseUrl(L"http://h:81", request));
+    CHECK(request.port == 81 && request.path == L"/" && !request.secure);
+    CHECK(!ParseUrl(L"ftp://h", request));
+
+    std::filesystem::remove_all(folder);
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,36 @@
+// Random walk traces through GamepadButtons on four slots: time per slot sample and how many key events
+// each SendInput batch carries.
+
+#include <cstdio>
+
+#include "Check.hpp"
+#include "GamepadTrace.hpp"
+
+using AnyFSE::Tests::GamepadButtons;
+using AnyFSE::Tests::Stopwatch;
+
+int main()
+{
+    const size_t Samples = 2000000;
+    const size_t Slots = 4;
+
+    size_t keyEvents = 0;
+    size_t batches = 0;
+    GamepadButtons pad(AnyFSE::Tests::TraceBindings(), Slots);
+    Stopwatch watch;
+    uint64_t hash = AnyFSE::Tests::ReplayTrace(pad, 1, Samples, keyEvents, batches);
+    double ns = watch.ElapsedMs() * 1000000 / (Samples * Slots);
+    CHECK(keyEvents > 0 && batches > 0 && batches <= Samples);
+
+    // The same trace gives the same keys
+    size_t againEvents = 0;
+    size_t againBatches = 0;
+    GamepadButtons again(AnyFSE::Tests::TraceBindings(), Slots);
+    CHECK(AnyFSE::Tests::ReplayTrace(again, 1, Samples, againEvents, againBatches) == hash);
+    CHECK(againEvents == keyEvents && againBatches == batches);
+
+    std::printf("%zu samples x %zu slots: %6.1f ns per slot sample, %zu key events in %zu batches (%.2f per batch)\n",
+        Samples, Slots, ns, keyEvents, batches, (double)keyEvents / batches);
+
+    return AnyFSE::Tests::Result();
+}
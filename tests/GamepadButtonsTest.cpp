@@ -0,0 +1,162 @@
+// Controller buttons to keys: repeat with acceleration, late samples, the left stick as a D-pad with deadzone,
+// threshold and hysteresis, a zero minimum interval, and the same keys for the same samples.
+
+#include <vector>
+
+#include "Check.hpp"
+#include "GamepadTrace.hpp"
+#include "AppSettings/GamepadButtons.hpp"
+
+using AnyFSE::App::AppSettings::Input::GamepadButtons;
+
+namespace
+{
+    typedef GamepadButtons Pad;
+
+    const std::vector<Pad::Binding> Bindings = {
+        {Pad::DPadUp, 0x26, true}, {Pad::DPadDown, 0x28, true}, {Pad::DPadLeft, 0x25, true},
+        {Pad::DPadRight, 0x27, true}, {Pad::A, 0x20, false}, {Pad::B, 0x1b, false}};
+
+    Pad::Sample Sample(uint16_t buttons, int x = 0, int y = 0)
+    {
+        Pad::Sample sample;
+        sample.buttons = buttons;
+        sample.thumbX = (int16_t)x;
+        sample.thumbY = (int16_t)y;
+        return sample;
+    }
+}
+
+int main()
+{
+    Pad::Options options;
+    std::vector<Pad::KeyEvent> events;
+
+    // Downs in binding order, repeats after the delay, one repeat for a late sample, ups on release
+    {
+        Pad pad({{Pad::DPadUp, 0x26, true}, {Pad::A, 0x20, false}}, 4);
+        pad.Update(0, Sample(Pad::DPadUp | Pad::A), 1000, events);
+        CHECK(events.size() == 2 && events[0].down && events[0].key == 0x26 && events[1].key == 0x20);
+        CHECK(pad.NextRepeat() == 1400);
+        events.clear();
+        pad.Update(0, Sample(Pad::DPadUp | Pad::A), 1399, events);
+        CHECK(events.empty());
+        pad.Update(0, Sample(Pad::DPadUp | Pad::A), 1400, events);
+        CHECK(events.size() == 1 && events[0].repeat && events[0].key == 0x26);
+        CHECK(pad.NextRepeat() == 1480);
+        events.clear();
+        pad.Update(0, Sample(Pad::DPadUp | Pad::A), 2000, events);
+        CHECK(events.size() == 1 && pad.NextRepeat() == 2001);
+        events.clear();
+        pad.Update(0, Sample(Pad::A), 2010, events);
+        CHECK(events.size() == 1 && !events[0].down && events[0].key == 0x26);
+        CHECK(pad.NextRepeat() == Pad::Never);
+        events.clear();
+
+        // Disconnecting lets go of what the slot holds
+        CHECK(pad.IsHeld(0));
+        pad.Release(0, events);
+        CHECK(events.size() == 1 && !events[0].down && events[0].key == 0x20);
+        CHECK(!pad.IsHeld(0));
+        events.clear();
+
+        pad.Update(1, Sample(Pad::DPadUp), 5000, events);
+        pad.Update(2, Sample(Pad::DPadUp), 5100, events);
+        CHECK(events.size() == 2 && pad.NextRepeat() == 5400);
+        events.clear();
+    }
+
+    // Repeats speed up from 80 ms down to 30 ms
+    {
+        Pad pad(Bindings, 1, options);
+        pad.Update(0, Sample(Pad::DPadDown), 0, events);
+        const uint64_t expected[] = {400, 480, 548, 605, 653, 693, 727, 757, 787, 817};
+        bool accelerated = true;
+        for (uint64_t at : expected)
+        {
+            uint64_t next = pad.NextRepeat();
+            accelerated = accelerated && next == at;
+            pad.Update(0, Sample(Pad::DPadDown), next, events);
+        }
+        CHECK(accelerated);
+        events.clear();
+        pad.Update(0, Sample(0), 900, events);
+        CHECK(events.size() == 1 && !events[0].down);
+        events.clear();
+
+        // Pressed again, the repeat starts slow
+        pad.Update(0, Sample(Pad::DPadDown), 1000, events);
+        CHECK(pad.NextRepeat() == 1400);
+        events.clear();
+    }
+
+    // Threshold to take a direction, deadzone to let go of it, the held axis wins near the diagonal
+    CHECK(Pad::StickDirection(10000, 0, 0, options) == 0);
+    CHECK(Pad::StickDirection(20000, 0, 0, options) == Pad::DPadRight);
+    CHECK(Pad::StickDirection(10000, 0, Pad::DPadRight, options) == Pad::DPadRight);
+    CHECK(Pad::StickDirection(7000, 0, Pad::DPadRight, options) == 0);
+    CHECK(Pad::StickDirection(0, -20000, 0, options) == Pad::DPadDown);
+    CHECK(Pad::StickDirection(15000, 16000, Pad::DPadRight, options) == Pad::DPadRight);
+    CHECK(Pad::StickDirection(12000, 19000, Pad::DPadRight, options) == Pad::DPadUp);
+    uint16_t corner = Pad::StickDirection(-32768, -32768, 0, options);
+    CHECK(corner == Pad::DPadDown || corner == Pad::DPadLeft);
+
+    {
+        Pad pad(Bindings, 2, options);
+        pad.Update(0, Sample(0, 0, 25000), 0, events);
+        CHECK(events.size() == 1 && events[0].key == 0x26 && events[0].down);
+        events.clear();
+        CHECK(pad.IsHeld(0));
+
+        // Turning the stick lets go of the old direction before taking the new one
+        pad.Update(0, Sample(0, 25000, 5000), 10, events);
+        CHECK(events.size() == 2 && !events[0].down && events[0].key == 0x26 && events[1].key == 0x27);
+        events.clear();
+        pad.Update(0, Sample(0, 25000, 5000), 410, events);
+        CHECK(events.size() == 1 && events[0].repeat);
+        events.clear();
+        pad.Release(0, events);
+        CHECK(events.size() == 1 && !events[0].down && events[0].key == 0x27);
+        CHECK(!pad.IsHeld(0));
+        events.clear();
+
+        // D-pad and stick the same way are one key
+        pad.Update(1, Sample(Pad::DPadUp, 0, 25000), 0, events);
+        CHECK(events.size() == 1);
+        events.clear();
+        pad.Update(1, Sample(0, 0, 25000), 5, events);
+        CHECK(events.empty());
+    }
+
+    // A repeat with no minimum interval still moves on
+    {
+        Pad::Options bad;
+        bad.stickThreshold = 100;
+        bad.minRepeatMs = 0;
+        Pad pad(Bindings, 1, bad);
+        pad.Update(0, Sample(Pad::DPadUp), 0, events);
+        uint64_t last = 0;
+        bool advancing = true;
+        for (int i = 0; i < 100; i++)
+        {
+            uint64_t next = pad.NextRepeat();
+            advancing = advancing && next != Pad::Never && next > last;
+            last = next;
+            pad.Update(0, Sample(Pad::DPadUp), next, events);
+        }
+        CHECK(advancing);
+        events.clear();
+    }
+
+    size_t firstEvents = 0;
+    size_t firstBatches = 0;
+    size_t secondEvents = 0;
+    size_t secondBatches = 0;
+    Pad first(Bindings, 4);
+    Pad second(Bindings, 4);
+    CHECK(AnyFSE::Tests::ReplayTrace(first, 7, 100000, firstEvents, firstBatches)
+        == AnyFSE::Tests::ReplayTrace(second, 7, 100000, secondEvents, secondBatches));
+    CHECK(firstEvents == secondEvents && firstBatches == secondBatches && firstEvents > 0);
+
+    return AnyFSE::Tests::Result();
+}
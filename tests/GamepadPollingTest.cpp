@@ -0,0 +1,82 @@
+// Controller slot polling: backoff for empty slots, faster reads while buttons are held or packets change,
+// device arrival, and the reads an idle minute costs against a fixed 16 ms loop.
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Check.hpp"
+#include "AppSettings/GamepadPolling.hpp"
+
+using AnyFSE::App::AppSettings::Input::GamepadPolling;
+
+int main()
+{
+    GamepadPolling polling(4);
+    bool due = true;
+    for (size_t slot = 0; slot < 4; slot++)
+    {
+        due = due && polling.IsDue(slot, 0);
+    }
+    CHECK(due);
+
+    // One empty slot doesn't hold back the others
+    polling.Disconnected(1, 0);
+    CHECK(polling.NextPoll() == 0);
+
+    // Empty slots back off 500, 1000, 2000, 4000 ms and so on up to 8 s
+    polling.Disconnected(1, 0);
+    polling.Disconnected(2, 0);
+    polling.Disconnected(3, 0);
+    polling.Disconnected(1, 500);
+    polling.Disconnected(1, 1500);
+    CHECK(!polling.IsDue(1, 5499) && polling.IsDue(1, 5500));
+    for (int i = 0; i < 10; i++)
+    {
+        polling.Disconnected(2, 0);
+    }
+    CHECK(!polling.IsDue(2, 7999) && polling.IsDue(2, 8000));
+
+    // Active after a change, faster while held, idle after two quiet seconds
+    polling.Connected(0, 10, true, false);
+    CHECK(!polling.IsDue(0, 25) && polling.IsDue(0, 26));
+    polling.Connected(0, 26, false, true);
+    CHECK(!polling.IsDue(0, 33) && polling.IsDue(0, 34));
+    polling.Connected(0, 34, false, false);
+    polling.Connected(0, 2050, false, false);
+    CHECK(!polling.IsDue(0, 2149) && polling.IsDue(0, 2150));
+
+    // A device arrival probes the empty slots at once and restarts their backoff
+    polling.DeviceArrived(3000);
+    CHECK(polling.IsDue(1, 3000) && polling.IsDue(2, 3000));
+    CHECK(polling.IsConnected(0) && !polling.IsConnected(1));
+    polling.Disconnected(2, 3000);
+    CHECK(!polling.IsDue(2, 3499) && polling.IsDue(2, 3500));
+
+    // An idle minute with one quiet controller and three empty slots
+    GamepadPolling idle(4);
+    size_t reads = 0;
+    for (uint64_t now = 0; now < 60000;)
+    {
+        for (size_t slot = 0; slot < 4; slot++)
+        {
+            if (idle.IsDue(slot, now))
+            {
+                reads++;
+                if (slot == 0)
+                {
+                    idle.Connected(slot, now, false, false);
+                }
+                else
+                {
+                    idle.Disconnected(slot, now);
+                }
+            }
+        }
+        now = std::max(idle.NextPoll(), now + 1);
+    }
+    const size_t fixedReads = 60000 / 16 * 4;
+    std::printf("idle minute: %zu reads, a fixed 16 ms loop makes %zu\n", reads, fixedReads);
+    CHECK(reads < fixedReads / 10);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "AppSettings/GamepadButtons.hpp"
+
+// Random walk traces for GamepadButtons: the stick drifts by up to 2000 a sample, buttons toggle now and then,
+// samples come every 8 to 16 ms on four slots like a polling loop with four pads connected.
+namespace AnyFSE::Tests
+{
+    typedef App::AppSettings::Input::GamepadButtons GamepadButtons;
+
+    inline const std::vector<GamepadButtons::Binding> &TraceBindings()
+    {
+        static const std::vector<GamepadButtons::Binding> bindings = {
+            {GamepadButtons::DPadUp, 0x26, true}, {GamepadButtons::DPadDown, 0x28, true},
+            {GamepadButtons::DPadLeft, 0x25, true}, {GamepadButtons::DPadRight, 0x27, true},
+            {GamepadButtons::A, 0x20, false}, {GamepadButtons::B, 0x1b, false}};
+        return bindings;
+    }
+
+    // Returns a hash of the key events in order. keyEvents counts them, batches the samples that produced
+    // any, one SendInput call each.
+    inline uint64_t ReplayTrace(GamepadButtons &pad, unsigned seed, size_t samples, size_t &keyEvents, size_t &batches)
+    {
+        std::mt19937 rng(seed);
+        std::vector<GamepadButtons::KeyEvent> events;
+        uint64_t now = 0;
+        uint64_t hash = 0;
+        int x = 0;
+        int y = 0;
+        uint16_t buttons = 0;
+        keyEvents = 0;
+        batches = 0;
+        for (size_t i = 0; i < samples; i++)
+        {
+            now += 8 + rng() % 9;
+            x = std::max(-32768, std::min(32767, x + (int)(rng() % 4001) - 2000));
+            y = std::max(-32768, std::min(32767, y + (int)(rng() % 4001) - 2000));
+            if (rng() % 50 == 0)
+            {
+                buttons ^= (uint16_t)(1u << (rng() % 4));
+            }
+            if (rng() % 200 == 0)
+            {
+                buttons ^= GamepadButtons::A;
+            }
+            for (size_t slot = 0; slot < 4; slot++)
+            {
+                GamepadButtons::Sample sample;
+                sample.buttons = buttons;
+                sample.thumbX = (int16_t)(slot & 1 ? x : -y);
+                sample.thumbY = (int16_t)(slot & 2 ? y : x);
+                pad.Update(slot, sample, now, events);
+            }
+            if (!events.empty())
+            {
+                keyEvents += events.size();
+                batches++;
+                for (const GamepadButtons::KeyEvent &event : events)
+                {
+                    hash = hash * 31 + event.key * 2 + event.down;
+                }
+                events.clear();
+            }
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,123 @@
+// The icon cache file format: lookups by key, size and stamp, replacing and merging entries,
+// pixel alignment, and damaged or truncated files reading as misses.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/IconAtlas.hpp"
+
+using namespace AnyFSE::Tools::IconAtlas;
+
+namespace
+{
+    std::vector<uint8_t> Pixels(uint32_t width, uint32_t height, uint8_t seed)
+    {
+        std::vector<uint8_t> pixels(width * height * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = (uint8_t)(i * 7 + seed);
+        }
+        return pixels;
+    }
+
+    bool Same(const Image &image, const std::vector<uint8_t> &pixels)
+    {
+        return image.width * image.height * 4 == pixels.size() && !std::memcmp(image.pixels, pixels.data(), pixels.size());
+    }
+}
+
+int main()
+{
+    const std::vector<uint8_t> large = Pixels(32, 32, 1);
+    const std::vector<uint8_t> small = Pixels(16, 16, 2);
+    const std::vector<uint8_t> package = Pixels(32, 32, 3);
+
+    Writer writer;
+    writer.Add("C:\\a.exe", 32, 100, 32, 32, large.data());
+    writer.Add("C:\\a.exe", 16, 100, 16, 16, small.data());
+    writer.Add("@Microsoft.App!App", 32, 0, 32, 32, package.data());
+
+    // Pending entries are found before they are saved
+    Image image;
+    CHECK(writer.Find("C:\\a.exe", 16, 100, image) && image.width == 16);
+    CHECK(!writer.Find("C:\\a.exe", 16, 101, image));
+
+    std::vector<uint8_t> data = writer.Serialize();
+    Reader reader;
+    CHECK(reader.Open(data.data(), data.size()));
+    CHECK(reader.Count() == 3);
+    CHECK(reader.Find("C:\\a.exe", 32, 100, image) && Same(image, large));
+    CHECK((image.pixels - data.data()) % 16 == 0);
+    CHECK(reader.Find("C:\\a.exe", 16, 100, image) && Same(image, small));
+    CHECK(reader.Find("@Microsoft.App!App", 32, 0, image) && Same(image, package));
+
+    // Another stamp, key or size is a miss
+    CHECK(!reader.Find("C:\\a.exe", 32, 99, image));
+    CHECK(!reader.Find("C:\\b.exe", 32, 100, image));
+    CHECK(!reader.Find("C:\\a.exe", 48, 100, image));
+
+    size_t visited = 0;
+    reader.ForEach([&](const std::string &key, uint32_t size, uint64_t, const Image &entry)
+    {
+        visited += !key.empty() && entry.width == size;
+    });
+    CHECK(visited == 3);
+
+    // Added entries win over the merged file
+    const std::vector<uint8_t> changed = Pixels(32, 32, 9);
+    Writer update;
+    update.Add("C:\\a.exe", 32, 200, 32, 32, changed.data());
+    update.Merge(reader);
+    CHECK(update.Count() == 3);
+    std::vector<uint8_t> updated = update.Serialize();
+    Reader merged;
+    CHECK(merged.Open(updated.data(), updated.size()));
+    CHECK(merged.Find("C:\\a.exe", 32, 200, image) && Same(image, changed));
+    CHECK(merged.Find("C:\\a.exe", 16, 100, image) && Same(image, small));
+
+    // Truncated files don't open, damaged ones may but never read out of bounds
+    bool truncated = true;
+    for (size_t size = 0; size < data.size(); size += 13)
+    {
+        Reader partial;
+        truncated = truncated && !partial.Open(data.data(), size);
+    }
+    CHECK(truncated);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        std::vector<uint8_t> damaged = data;
+        damaged[i] ^= 0x5a;
+        Reader corrupt;
+        if (corrupt.Open(damaged.data(), damaged.size()))
+        {
+            corrupt.Find("C:\\a.exe", 32, 100, image);
+            corrupt.ForEach([](const std::string &, uint32_t, uint64_t, const Image &) {});
+        }
+    }
+
+    Writer empty;
+    std::vector<uint8_t> none = empty.Serialize();
+    Reader emptyReader;
+    CHECK(emptyReader.Open(none.data(), none.size()));
+    CHECK(emptyReader.Count() == 0 && !emptyReader.Find("x", 1, 0, image));
+
+    // Enough entries for hash collisions between neighbours to matter
+    Writer many;
+    for (int i = 0; i < 2000; ++i)
+    {
+        many.Add("C:\\Games\\game" + std::to_string(i) + ".exe", 32, i, 32, 32, large.data());
+    }
+    std::vector<uint8_t> manyData = many.Serialize();
+    Reader manyReader;
+    CHECK(manyReader.Open(manyData.data(), manyData.size()));
+    int hits = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        hits += manyReader.Find("C:\\Games\\game" + std::to_string(i) + ".exe", 32, i, image) && Same(image, large);
+    }
+    CHECK(hits == 2000);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,57 @@
+// The detected launchers file: round trip with non-ASCII names, damaged files and other versions,
+// and the diff Settings uses to update only what the probes changed.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Check.hpp"
+#include "Configuration/LauncherCache.hpp"
+
+using namespace AnyFSE::Configuration;
+
+int main()
+{
+    const std::vector<CachedLauncher> cached = {
+        {L"C:\\Program Files\\Playnite\\Playnite.FullscreenApp.exe", L"", L"Playnite",
+            L"C:\\Program Files\\Playnite\\Playnite.FullscreenApp.exe", L"133812345678901234"},
+        {L"ogl://", L"", L"One Game Launcher", L"@62269AlexShats.OneGameLauncher_gghb1w55myjr2!App", L""},
+        {L"Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App", L"Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App",
+            L"Xbox \u00e9\u4e2d\U0001F3AE", L"@Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App",
+            L"C:\\Program Files\\WindowsApps\\Microsoft.GamingApp_2411.1001.3.0_x64__8wekyb3d8bbwe"}};
+
+    std::vector<CachedLauncher> launchers;
+    CHECK(LauncherCache::Parse(LauncherCache::Serialize(cached), launchers));
+    CHECK(launchers == cached);
+
+    CHECK(!LauncherCache::Parse("{", launchers));
+    CHECK(launchers.empty());
+    CHECK(!LauncherCache::Parse(R"({"Version": 2, "Launchers": []})", launchers));
+    CHECK(!LauncherCache::Parse(R"({"Version": 1, "Launchers": [1]})", launchers));
+    CHECK(launchers.empty());
+
+    // A field of the wrong type reads as empty, the entry stays
+    CHECK(LauncherCache::Parse(R"({"Version": 1, "Launchers": [{"Path": 5}]})", launchers));
+    CHECK(launchers.size() == 1 && launchers[0].path.empty());
+
+    CHECK(LauncherCache::Compare(cached, cached).Empty());
+
+    // Xbox updated, One Game Launcher uninstalled, Steam installed
+    std::vector<CachedLauncher> detected = cached;
+    detected[2].token = L"C:\\Program Files\\WindowsApps\\Microsoft.GamingApp_2412.1001.5.0_x64__8wekyb3d8bbwe";
+    detected.erase(detected.begin() + 1);
+    detected.push_back({L"D:\\Steam\\Steam.exe", L"", L"Steam", L"D:\\Steam\\Steam.exe", L"1"});
+    LauncherCacheDiff diff = LauncherCache::Compare(cached, detected);
+    CHECK(diff.changed == std::vector<size_t>({1}));
+    CHECK(diff.removed == std::vector<size_t>({1}));
+    CHECK(diff.added == std::vector<size_t>({2}));
+    CHECK(!diff.reordered);
+
+    // Same launchers in another order
+    detected = cached;
+    std::swap(detected[0], detected[2]);
+    diff = LauncherCache::Compare(cached, detected);
+    CHECK(diff.reordered && diff.added.empty() && diff.changed.empty() && diff.removed.empty());
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,65 @@
+// Display name scan of the bundled locale files against a full parse, the way the language combo used to
+// read them.
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "Check.hpp"
+#include "Tools/LocaleNameReader.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+using AnyFSE::Tools::LocaleNameReader;
+using AnyFSE::Tests::Stopwatch;
+
+int main()
+{
+    const int Rounds = 200;
+    size_t files = 0;
+
+    for (const auto &entry : std::filesystem::directory_iterator(std::filesystem::path(ANYFSE_ROOT) / "localization"))
+    {
+        if (entry.path().extension() != ".json")
+        {
+            continue;
+        }
+        files++;
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::string expected = nlohmann::json::parse(content).value("language", std::string());
+        std::string language;
+        CHECK(LocaleNameReader::Read(content, language));
+        CHECK(!language.empty() && language == expected);
+
+        Stopwatch scan;
+        for (int i = 0; i < Rounds; ++i)
+        {
+            LocaleNameReader::Read(content, language);
+        }
+        double scanUs = scan.ElapsedMs() * 1000 / Rounds;
+
+        Stopwatch parse;
+        for (int i = 0; i < Rounds; ++i)
+        {
+            expected = nlohmann::json::parse(content).value("language", std::string());
+        }
+        double parseUs = parse.ElapsedMs() * 1000 / Rounds;
+
+        std::printf("%-12s %-12s scan %8.1f us, full parse %8.1f us\n",
+            entry.path().filename().string().c_str(), language.c_str(), scanUs, parseUs);
+        CHECK(language == expected);
+    }
+    CHECK(files > 0);
+
+    // No top level "language", or one nested deeper, is not a name
+    std::string language;
+    CHECK(!LocaleNameReader::Read(R"({"settings": {"language": "Nested"}})", language));
+    CHECK(!LocaleNameReader::Read(R"({"language": 1})", language));
+    CHECK(!LocaleNameReader::Read("{\"language\": ", language));
+    CHECK(LocaleNameReader::Read(R"({"a": [1, {"language": "x"}], "language": "Top"})", language) && language == "Top");
+
+    return AnyFSE::Tests::Result();
+}
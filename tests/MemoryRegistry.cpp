@@ -0,0 +1,119 @@
+#include "MemoryRegistry.hpp"
+
+namespace AnyFSE::Tools
+{
+    void MemoryRegistry::SetValue(const std::wstring &path, const std::wstring &name, const RegistryValue &value)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_keys[path][name] = value;
+        Changed(path, false);
+    }
+
+    void MemoryRegistry::DeleteValue(const std::wstring &path, const std::wstring &name)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto key = m_keys.find(path);
+        if (key != m_keys.end() && key->second.erase(name))
+        {
+            Changed(path, false);
+        }
+    }
+
+    void MemoryRegistry::DeleteKey(const std::wstring &path)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_keys.erase(path))
+        {
+            Changed(path, true);
+        }
+    }
+
+    void MemoryRegistry::Changed(const std::wstring &path, bool deleted)
+    {
+        for (auto &handle : m_handles)
+        {
+            if (handle.second.path == path)
+            {
+                handle.second.deleted = handle.second.deleted || deleted;
+                if (handle.second.watched)
+                {
+                    handle.second.watched = false;
+                    handle.second.changed = true;
+                }
+            }
+        }
+    }
+
+    MemoryRegistry::Counters MemoryRegistry::GetCounters() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_counters;
+    }
+
+    size_t MemoryRegistry::OpenHandles() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_handles.size();
+    }
+
+    RegistryBackend::Key MemoryRegistry::Open(const std::wstring &path)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_counters.opens++;
+        if (m_keys.find(path) == m_keys.end())
+        {
+            return 0;
+        }
+
+        Key key = m_nextHandle++;
+        m_handles[key].path = path;
+        return key;
+    }
+
+    void MemoryRegistry::Close(Key key)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_handles.erase(key);
+    }
+
+    RegistryBackend::Result MemoryRegistry::Read(Key key, const std::wstring &name, RegistryValue &value)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_counters.reads++;
+
+        auto handle = m_handles.find(key);
+        if (handle == m_handles.end() || handle->second.deleted)
+        {
+            return Result::KeyDeleted;
+        }
+
+        const std::map<std::wstring, RegistryValue> &values = m_keys[handle->second.path];
+        auto it = values.find(name);
+        if (it == values.end())
+        {
+            return Result::NotFound;
+        }
+        value = it->second;
+        return Result::Found;
+    }
+
+    bool MemoryRegistry::Watch(Key key)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto handle = m_handles.find(key);
+        if (handle == m_handles.end())
+        {
+            return false;
+        }
+        handle->second.watched = true;
+        handle->second.changed = false;
+        return true;
+    }
+
+    bool MemoryRegistry::IsChanged(Key key)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto handle = m_handles.find(key);
+        return handle != m_handles.end() && handle->second.changed;
+    }
+}
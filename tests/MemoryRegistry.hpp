@@ -0,0 +1,52 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "Tools/RegistryCache.hpp"
+
+namespace AnyFSE::Tools
+{
+    // Keys and values in memory, for testing RegistryCache away from Windows. Paths are taken as normalized, changes
+    // fire the watches of the open handles to the key like RegNotifyChangeKeyValue does.
+    class MemoryRegistry : public RegistryBackend
+    {
+    public:
+        struct Counters
+        {
+            size_t opens = 0;
+            size_t reads = 0;
+        };
+
+        void SetValue(const std::wstring &path, const std::wstring &name, const RegistryValue &value);
+        void DeleteValue(const std::wstring &path, const std::wstring &name);
+        void DeleteKey(const std::wstring &path);
+
+        Counters GetCounters() const;
+        size_t OpenHandles() const;
+
+        Key Open(const std::wstring &path) override;
+        void Close(Key key) override;
+        Result Read(Key key, const std::wstring &name, RegistryValue &value) override;
+        bool Watch(Key key) override;
+        bool IsChanged(Key key) override;
+
+    private:
+        struct Handle
+        {
+            std::wstring path;
+            bool deleted = false;
+            bool watched = false;
+            bool changed = false;
+        };
+
+        mutable std::mutex m_lock;
+        std::map<std::wstring, std::map<std::wstring, RegistryValue>> m_keys;
+        std::map<Key, Handle> m_handles;
+        Key m_nextHandle = 1;
+        Counters m_counters;
+
+        // Locked
+        void Changed(const std::wstring &path, bool deleted);
+    };
+}
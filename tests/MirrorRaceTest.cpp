@@ -0,0 +1,165 @@
+// Mirror ordering, hedge delays and the release query race between mirrors.
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Check.hpp"
+#include "Updater/MirrorRace.hpp"
+
+using namespace AnyFSE::Updater;
+using namespace std::chrono_literals;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    // Queries still running on the race threads, main waits for them before its locals go
+    std::atomic<int> running{0};
+
+    // Answers value after delay unless cancelled first, a negative value fails
+    int Respond(HttpCancellation &cancel, std::chrono::milliseconds delay, int value)
+    {
+        struct Running
+        {
+            Running() { ++running; }
+            ~Running() { --running; }
+        } scope;
+
+        for (auto waited = 0ms; waited < delay; waited += 5ms)
+        {
+            if (cancel.IsCancelled())
+            {
+                throw std::runtime_error("cancelled");
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        if (value < 0)
+        {
+            throw std::runtime_error("failed " + std::to_string(value));
+        }
+        return value;
+    }
+
+    bool Any(const int &)
+    {
+        return true;
+    }
+}
+
+int main()
+{
+    const std::vector<std::string> hosts = {"github", "codeberg"};
+
+    // Unknown hosts keep their order and are not waited for
+    MirrorSelector selector;
+    CHECK(selector.Order(hosts) == std::vector<size_t>({0, 1}));
+    CHECK(selector.HedgeDelay("github") == 0ms);
+
+    selector.RecordSuccess("github", 300ms);
+    selector.RecordSuccess("codeberg", 100ms);
+    CHECK(selector.Order(hosts) == std::vector<size_t>({1, 0}));
+    CHECK(selector.HedgeDelay("codeberg") == 150ms);
+
+    // Moving average, not the last sample
+    selector.RecordSuccess("codeberg", 200ms);
+    CHECK(selector.GetStats()["codeberg"].latencyMs == 130);
+    CHECK(selector.GetStats()["codeberg"].samples == 2);
+
+    // A failure puts a host behind and the others start at once
+    selector.RecordFailure("codeberg");
+    CHECK(selector.Order(hosts) == std::vector<size_t>({0, 1}));
+    CHECK(selector.HedgeDelay("codeberg") == 0ms);
+    selector.RecordSuccess("codeberg", 100ms);
+    CHECK(selector.GetStats()["codeberg"].failures == 0);
+
+    MirrorStats slow;
+    slow.latencyMs = 10000;
+    slow.samples = 5;
+    selector.SetStats({{"github", slow}});
+    CHECK(selector.HedgeDelay("github") == 1500ms);
+
+    // Without history both start together and the faster one wins
+    {
+        MirrorSelector race;
+        size_t winner = 99;
+        int result = RaceMirrors<int>(race, hosts, [](size_t host, HttpCancellation &cancel)
+        {
+            return Respond(cancel, host == 0 ? 400ms : 20ms, (int)host);
+        }, Any, &winner);
+        CHECK(result == 1 && winner == 1);
+        // The cancelled loser says nothing about its host
+        CHECK(race.GetStats()["codeberg"].samples == 1);
+        CHECK(race.GetStats().count("github") == 0);
+    }
+
+    // A failing preferred mirror doesn't make the others sit out the hedge delay
+    {
+        MirrorStats slower = slow;
+        slower.latencyMs *= 2;
+        MirrorSelector race;
+        race.SetStats({{"github", slow}, {"codeberg", slower}});
+        CHECK(race.HedgeDelay(hosts[race.Order(hosts).front()]) == 1500ms);
+        Stopwatch stopwatch;
+        size_t winner = 99;
+        int result = RaceMirrors<int>(race, hosts, [](size_t host, HttpCancellation &cancel)
+        {
+            return Respond(cancel, 10ms, host == 0 ? -1 : 1);
+        }, Any, &winner);
+        CHECK(result == 1 && winner == 1);
+        CHECK(stopwatch.ElapsedMs() < 1000);
+        CHECK(race.GetStats()["github"].failures == 1);
+    }
+
+    // A rejected answer counts as a failure
+    {
+        MirrorSelector race;
+        size_t winner = 99;
+        int result = RaceMirrors<int>(race, hosts, [](size_t host, HttpCancellation &cancel)
+        {
+            return Respond(cancel, host == 0 ? 10ms : 50ms, (int)host);
+        }, [](const int &value) { return value != 0; }, &winner);
+        CHECK(result == 1 && winner == 1);
+    }
+
+    // Every mirror failing rethrows the last error, no mirrors at all is an error too
+    {
+        MirrorSelector race;
+        bool failed = false;
+        try
+        {
+            RaceMirrors<int>(race, hosts, [](size_t host, HttpCancellation &cancel)
+            {
+                return Respond(cancel, host == 0 ? 10ms : 100ms, -1 - (int)host);
+            }, Any);
+        }
+        catch (const std::runtime_error &error)
+        {
+            failed = std::string(error.what()) == "failed -2";
+        }
+        CHECK(failed);
+
+        bool empty = false;
+        try
+        {
+            RaceMirrors<int>(race, {}, [](size_t, HttpCancellation &) { return 0; }, Any);
+        }
+        catch (const std::runtime_error &)
+        {
+            empty = true;
+        }
+        CHECK(empty);
+    }
+
+    // Losers see the cancellation and finish soon after
+    Stopwatch drain;
+    while (running > 0 && drain.ElapsedMs() < 2000)
+    {
+        std::this_thread::sleep_for(5ms);
+    }
+    CHECK(running == 0);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,63 @@
+// Nine-slice splitting of the rounded frame skin and the LRU cache the skins are kept in.
+
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/LruCache.hpp"
+#include "Tools/NineSlice.hpp"
+
+using namespace AnyFSE::Tools;
+
+int main()
+{
+    std::vector<NineSlice::Piece> pieces;
+    CHECK(NineSlice::SkinSize(4) == 9);
+
+    // Pieces tile the target exactly, edges and center stretch the middle skin pixel
+    CHECK(NineSlice::Build(4, {10, 20, 100, 30}, pieces));
+    CHECK(pieces.size() == 9);
+    long area = 0;
+    for (const NineSlice::Piece &piece : pieces)
+    {
+        area += (long)piece.target.width * piece.target.height;
+    }
+    CHECK(area == 100 * 30);
+    CHECK(pieces[4].source.x == 4 && pieces[4].source.width == 1 && pieces[4].target.width == 92);
+    CHECK(pieces[8].target.x == 106 && pieces[8].source.x == 5);
+
+    // Exactly two corners wide and high leaves only the corners
+    CHECK(NineSlice::Build(4, {0, 0, 8, 8}, pieces));
+    CHECK(pieces.size() == 4);
+
+    CHECK(!NineSlice::Build(4, {0, 0, 7, 30}, pieces));
+
+    // No inset is a single stretched pixel
+    CHECK(NineSlice::Build(0, {0, 0, 5, 5}, pieces));
+    CHECK(pieces.size() == 1 && pieces[0].target.width == 5);
+
+    LruCache<int, std::string> cache(2);
+    cache.Insert(1, "a");
+    cache.Insert(2, "b");
+    CHECK(cache.Find(1));
+    cache.Insert(3, "c");
+    CHECK(!cache.Find(2));
+    CHECK(cache.Find(1) && *cache.Find(3) == "c");
+    CHECK(cache.Evictions() == 1 && cache.Size() == 2);
+
+    // Replacing keeps the size and refreshes the entry
+    cache.Insert(3, "d");
+    CHECK(*cache.Find(3) == "d" && cache.Size() == 2);
+    CHECK(cache.Hits() == 4 && cache.Misses() == 1);
+
+    cache.Clear();
+    CHECK(cache.Size() == 0 && !cache.Find(1));
+
+    // Zero capacity still holds one entry
+    LruCache<int, int> single(0);
+    single.Insert(1, 1);
+    single.Insert(2, 2);
+    CHECK(single.Capacity() == 1 && single.Size() == 1 && single.Find(2));
+
+    return AnyFSE::Tests::Result();
+}
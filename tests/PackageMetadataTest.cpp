@@ -0,0 +1,154 @@
+// Package metadata over a synthetic package catalog: one source call per family until Invalidate,
+// batched process queries shared within the TTL, and concurrent callers.
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/PackageMetadata.hpp"
+
+using namespace AnyFSE::Tools;
+
+namespace
+{
+    const std::wstring Xbox = L"Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App";
+    const std::wstring ArmouryCrate = L"B9ECED6F.ArmouryCrateSE_qmba6cd70vzyy";
+
+    struct SyntheticCatalog : PackageSource
+    {
+        std::map<std::wstring, std::wstring> installed{{L"Microsoft.GamingApp_8wekyb3d8bbwe", L"C:\\WindowsApps\\GamingApp_1"}};
+        std::map<std::wstring, std::vector<uint32_t>> running{{Xbox, {10, 11}}};
+        std::atomic<int> calls{0};
+        std::atomic<int> processQueries{0};
+        std::mutex mutex;
+        std::set<std::wstring> lastQuery;
+
+        std::wstring GetInstallLocation(const std::wstring &familyName) override
+        {
+            calls++;
+            auto it = installed.find(familyName);
+            return it == installed.end() ? L"" : it->second;
+        }
+
+        std::wstring GetDisplayName(const std::wstring &familyName) override
+        {
+            calls++;
+            return installed.count(familyName) ? L"Xbox" : L"";
+        }
+
+        std::vector<uint8_t> GetLogo(const std::wstring &, int size) override
+        {
+            calls++;
+            return std::vector<uint8_t>(size, 1);
+        }
+
+        std::vector<std::wstring> GetGamingApps() override
+        {
+            calls++;
+            return {Xbox};
+        }
+
+        std::map<std::wstring, std::vector<uint32_t>> GetProcessIds(const std::set<std::wstring> &appUserModelIDs) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            processQueries++;
+            lastQuery = appUserModelIDs;
+            std::map<std::wstring, std::vector<uint32_t>> result;
+            for (const std::wstring &id : appUserModelIDs)
+            {
+                if (running.count(id))
+                {
+                    result[id] = running[id];
+                }
+            }
+            return result;
+        }
+    };
+
+    void SleepMs(int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+int main()
+{
+    CHECK(PackageMetadata::GetPackageFamilyName(Xbox) == L"Microsoft.GamingApp_8wekyb3d8bbwe");
+    CHECK(PackageMetadata::GetPackageFamilyName(ArmouryCrate) == ArmouryCrate);
+
+    SyntheticCatalog catalog;
+    PackageMetadata metadata(catalog, std::chrono::milliseconds(100));
+
+    // A detection asks about the same families over and over, misses are kept too
+    for (int i = 0; i < 100; ++i)
+    {
+        metadata.GetInstallLocation(Xbox);
+        metadata.GetInstallLocation(ArmouryCrate);
+        metadata.GetDisplayName(Xbox);
+        metadata.GetLogo(Xbox, 32);
+        metadata.GetGamingApps();
+    }
+    CHECK(catalog.calls == 5);
+    CHECK(metadata.GetStats().misses == 5 && metadata.GetStats().hits == 495);
+    CHECK(metadata.GetInstallLocation(Xbox) == L"C:\\WindowsApps\\GamingApp_1");
+    CHECK(metadata.GetInstallLocation(ArmouryCrate).empty());
+
+    catalog.installed[ArmouryCrate] = L"C:\\WindowsApps\\ArmouryCrate";
+    metadata.Invalidate();
+    CHECK(metadata.GetInstallLocation(ArmouryCrate) == L"C:\\WindowsApps\\ArmouryCrate");
+
+    // Within the TTL the answer is shared, a new app is queried alone
+    CHECK(metadata.GetProcessIds(Xbox) == std::vector<uint32_t>({10, 11}));
+    CHECK(catalog.processQueries == 1);
+    metadata.GetProcessIds(Xbox);
+    CHECK(catalog.processQueries == 1);
+    metadata.GetProcessIds(L"Other!App");
+    CHECK(catalog.processQueries == 2 && catalog.lastQuery.size() == 1);
+
+    // Once stale, every app asked about lately rides along in one query
+    SleepMs(150);
+    metadata.GetProcessIds(L"Other!App");
+    CHECK(catalog.processQueries == 3 && catalog.lastQuery.size() == 2);
+    CHECK(metadata.GetProcessIds(Xbox).size() == 2);
+    CHECK(catalog.processQueries == 3);
+
+    // An app nobody asked about for eight TTLs is no longer watched
+    SleepMs(900);
+    metadata.GetProcessIds(L"Other!App");
+    CHECK(catalog.processQueries == 4 && catalog.lastQuery.size() == 1);
+    CHECK(metadata.GetStats().processQueries == 4);
+
+    // Callers on many threads, with an Invalidate in between
+    SyntheticCatalog shared;
+    PackageMetadata concurrent(shared);
+    std::vector<std::thread> threads;
+    std::atomic<int> wrong{0};
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&concurrent, &wrong, t]
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                wrong += concurrent.GetInstallLocation(Xbox) != L"C:\\WindowsApps\\GamingApp_1";
+                concurrent.GetProcessIds(L"App" + std::to_wstring(i % 4));
+                if (t == 0 && i % 500 == 0)
+                {
+                    concurrent.Invalidate();
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    CHECK(wrong == 0);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,81 @@
+// Phase tracing: scopes recorded as complete events, the ring dropping the oldest, concurrent scopes and the
+// Chrome trace file the ring is written as.
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/PhaseTracer.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+using AnyFSE::Tools::PhaseTracer;
+
+int main()
+{
+    PhaseTracer &tracer = PhaseTracer::Instance();
+    {
+        PhaseTracer::Scope scope("Scope \"quoted\"\n", "boot");
+        tracer.Instant("mark", "boot");
+    }
+    tracer.Begin("begin", "x");
+    tracer.End("begin", "x");
+
+    // A scope is one event, added when it ends
+    std::vector<PhaseTracer::Event> events = tracer.Snapshot();
+    CHECK(events.size() == 4);
+    CHECK(events[0].phase == 'i' && events[1].phase == 'X' && events[2].phase == 'B' && events[3].phase == 'E');
+
+    // Names are escaped, the process name comes first as metadata
+    nlohmann::json trace = nlohmann::json::parse(PhaseTracer::ToChromeTrace(events, 42, "AnyFSE"));
+    CHECK(trace["traceEvents"].size() == 5);
+    CHECK(trace["traceEvents"][0]["ph"] == "M" && trace["traceEvents"][0]["pid"] == 42);
+    CHECK(trace["traceEvents"][2]["name"] == "Scope \"quoted\"\n");
+    CHECK(trace["traceEvents"][2].contains("dur"));
+
+    // The ring keeps the newest
+    tracer.Clear();
+    for (int i = 0; i < 3000; i++)
+    {
+        tracer.Instant(i % 2 ? "a" : "b", "c");
+    }
+    size_t dropped = 0;
+    events = tracer.Snapshot(&dropped);
+    CHECK(events.size() == PhaseTracer::Capacity);
+    CHECK(dropped == 3000 - PhaseTracer::Capacity);
+    CHECK(events.front().timestampUs <= events.back().timestampUs);
+
+    tracer.Clear();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back([]
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                PhaseTracer::Scope scope("work", "thread");
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    events = tracer.Snapshot(&dropped);
+    CHECK(events.size() == PhaseTracer::Capacity);
+    CHECK(dropped == 80000 - PhaseTracer::Capacity);
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "AnyFSE.PhaseTracerTest";
+    std::filesystem::remove_all(folder);
+    std::filesystem::path file = folder / "AnyFSE.trace.json";
+    CHECK(tracer.Write(file.wstring(), 1, "AnyFSE"));
+    {
+        std::ifstream written(file);
+        nlohmann::json writtenTrace = nlohmann::json::parse(written, nullptr, false);
+        CHECK(!writtenTrace.is_discarded() && writtenTrace["traceEvents"].size() == PhaseTracer::Capacity + 1);
+    }
+    std::filesystem::remove_all(folder);
+
+    return AnyFSE::Tests::Result();
+}
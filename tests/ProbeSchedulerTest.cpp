@@ -0,0 +1,116 @@
+// Launcher probe scheduling: parallel workers, dependencies, failures, timeouts with a replacement worker,
+// thread hooks and cancelling.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/ProbeScheduler.hpp"
+
+using namespace AnyFSE::Tools;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    void SleepMs(int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+int main()
+{
+    // Eight 50 ms probes on four workers take two rounds, not eight
+    {
+        ProbeScheduler scheduler(4);
+        for (int i = 0; i < 8; ++i)
+        {
+            scheduler.Add("probe" + std::to_string(i), [] { SleepMs(50); });
+        }
+        int done = 0;
+        Stopwatch stopwatch;
+        scheduler.Start([&done](const ProbeScheduler::Report &report) { done += report.status == ProbeScheduler::Status::Done; });
+        CHECK(scheduler.Wait(2000));
+        CHECK(done == 8);
+        CHECK(stopwatch.ElapsedMs() < 300);
+    }
+
+    // A dependent waits for its dependency, a failing or stuck probe holds up nobody
+    {
+        auto order = std::make_shared<std::atomic<int>>(0);
+        auto indexOrder = std::make_shared<int>(-1);
+        auto steamOrder = std::make_shared<int>(-1);
+        auto enters = std::make_shared<std::atomic<int>>(0);
+        auto leaves = std::make_shared<std::atomic<int>>(0);
+
+        ProbeScheduler scheduler(2);
+        size_t index = scheduler.Add("index", [=] { SleepMs(30); *indexOrder = (*order)++; });
+        scheduler.Add("steam", [=] { *steamOrder = (*order)++; }, {index});
+        scheduler.Add("winrt", [] { SleepMs(600); }, {}, 100);
+        scheduler.Add("throws", [] { throw 1; });
+        scheduler.Add("quick", [] { SleepMs(10); });
+        CHECK(scheduler.Add("unknown", [] {}, {42}) == ProbeScheduler::npos);
+        CHECK(scheduler.Count() == 5);
+        scheduler.SetThreadHooks([=] { ++*enters; }, [=] { ++*leaves; });
+
+        std::vector<ProbeScheduler::Report> reports;
+        Stopwatch stopwatch;
+        scheduler.Start([&reports](const ProbeScheduler::Report &report) { reports.push_back(report); });
+        CHECK(scheduler.Wait(2000));
+        CHECK(stopwatch.ElapsedMs() < 400);
+        CHECK(*indexOrder >= 0 && *indexOrder < *steamOrder);
+
+        CHECK(reports.size() == 5);
+        for (const ProbeScheduler::Report &report : reports)
+        {
+            ProbeScheduler::Status expected = report.name == "winrt" ? ProbeScheduler::Status::TimedOut
+                : report.name == "throws" ? ProbeScheduler::Status::Failed
+                : ProbeScheduler::Status::Done;
+            CHECK(report.status == expected);
+        }
+
+        // Two workers and the replacement for the stuck one, each leaving once
+        Stopwatch drain;
+        while (*leaves < 3 && drain.ElapsedMs() < 2000)
+        {
+            SleepMs(10);
+        }
+        CHECK(*enters == 3 && *leaves == 3);
+    }
+
+    // Nothing is reported once the scheduler is gone
+    {
+        auto reported = std::make_shared<std::atomic<int>>(0);
+        auto scheduler = std::make_unique<ProbeScheduler>(1);
+        for (int i = 0; i < 5; ++i)
+        {
+            scheduler->Add("cancelled", [] { SleepMs(40); });
+        }
+        scheduler->Start([reported](const ProbeScheduler::Report &) { ++*reported; });
+        SleepMs(60);
+        scheduler.reset();
+        int atCancel = *reported;
+        SleepMs(200);
+        CHECK(atCancel < 5);
+        CHECK(*reported == atCancel);
+    }
+
+    // Many small probes all get reported
+    {
+        ProbeScheduler scheduler(4);
+        for (int i = 0; i < 10000; ++i)
+        {
+            scheduler.Add("empty", [] {});
+        }
+        int reported = 0;
+        scheduler.Start([&reported](const ProbeScheduler::Report &) { ++reported; });
+        CHECK(scheduler.Wait(10000));
+        CHECK(reported == 10000);
+    }
+
+    return AnyFSE::Tests::Result();
+}
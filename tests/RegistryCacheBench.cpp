@@ -0,0 +1,177 @@
+// The reads of a settings start over an in-memory registry: every read opening its key as Registry did
+// before the cache, RegistryCache keeping the handles, and RegistryCache also keeping the gaming configuration
+// values. Counts the backend opens and reads per start and times each way; in memory an open costs next to
+// nothing, the counts are what carries over to the real registry.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "MemoryRegistry.hpp"
+#include "Tools/RegistryCache.hpp"
+
+using namespace AnyFSE::Tools;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    const std::wstring GamingConfiguration = L"HKCU\\Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration";
+
+    struct Query
+    {
+        std::wstring path;
+        std::vector<std::wstring> names;
+        int times;
+    };
+
+    // Theme colors for every window, the launcher checks of the launcher page, confirmations and detection
+    const std::vector<Query> SettingsStart = {
+        {L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize", {L"AppsUseLightTheme", L"SystemUsesLightTheme"}, 3},
+        {L"HKCU\\Software\\Microsoft\\Windows\\DWM", {L"ColorPrevalence"}, 3},
+        {GamingConfiguration, {L"GamingHomeApp"}, 12},
+        {GamingConfiguration, {L"StartupToGamingHome"}, 2},
+        {GamingConfiguration + L"\\SystemDialogResults",
+            {L"EnterGamingPostureConfirmation_Config", L"EnterGamingPostureConfirmation", L"ExitGamingPostureConfirmation"}, 1},
+        {L"HKCU\\Software\\RetroBat", {L"LatestKnownInstallPath"}, 1},
+        {L"HKLM\\SOFTWARE\\Valve\\Steam", {L"InstallPath"}, 1},
+    };
+
+    RegistryValue String(const std::wstring &text)
+    {
+        RegistryValue value;
+        value.type = RegistryValue::Type::String;
+        value.text = text;
+        return value;
+    }
+
+    RegistryValue DWord(uint32_t number)
+    {
+        RegistryValue value;
+        value.type = RegistryValue::Type::DWord;
+        value.number = number;
+        return value;
+    }
+
+    // Registry::ReadValues before the cache: open, read, close on every call
+    size_t ReadDirect(MemoryRegistry &registry, const Query &query)
+    {
+        size_t found = 0;
+        RegistryBackend::Key key = registry.Open(RegistryCache::NormalizePath(query.path));
+        if (key)
+        {
+            for (const std::wstring &name : query.names)
+            {
+                RegistryValue value;
+                found += registry.Read(key, name, value) == RegistryBackend::Result::Found;
+            }
+            registry.Close(key);
+        }
+        return found;
+    }
+
+    size_t ReadCached(RegistryCache &cache, const Query &query)
+    {
+        size_t found = 0;
+        for (const RegistryValue &value : cache.Read(query.path, query.names))
+        {
+            found += value.type != RegistryValue::Type::None;
+        }
+        return found;
+    }
+
+    struct Run
+    {
+        MemoryRegistry::Counters counters;
+        size_t found = 0;
+        double us = 0;
+    };
+
+    // mode 0 without the cache, 1 with handles kept, 2 with the gaming configuration values kept as well
+    Run Measure(MemoryRegistry &registry, int mode, int starts)
+    {
+        Run run;
+        MemoryRegistry::Counters before = registry.GetCounters();
+        Stopwatch watch;
+        for (int start = 0; start < starts; start++)
+        {
+            if (mode == 0)
+            {
+                for (const Query &query : SettingsStart)
+                {
+                    for (int i = 0; i < query.times; i++)
+                    {
+                        run.found += ReadDirect(registry, query);
+                    }
+                }
+                continue;
+            }
+
+            // Every start is a new process with an empty cache
+            RegistryCache cache(registry);
+            if (mode == 2)
+            {
+                cache.CacheValues(GamingConfiguration);
+            }
+            for (const Query &query : SettingsStart)
+            {
+                for (int i = 0; i < query.times; i++)
+                {
+                    run.found += ReadCached(cache, query);
+                }
+            }
+        }
+        run.us = watch.ElapsedMs() * 1000 / starts;
+
+        MemoryRegistry::Counters after = registry.GetCounters();
+        run.counters.opens = (after.opens - before.opens) / starts;
+        run.counters.reads = (after.reads - before.reads) / starts;
+        run.found /= starts;
+        return run;
+    }
+}
+
+int main()
+{
+    const int Starts = 2000;
+
+    MemoryRegistry registry;
+    const std::wstring personalize = L"HKEY_CURRENT_USER\\software\\microsoft\\windows\\currentversion\\themes\\personalize";
+    const std::wstring gaming = RegistryCache::NormalizePath(GamingConfiguration);
+    registry.SetValue(personalize, L"AppsUseLightTheme", DWord(0));
+    registry.SetValue(personalize, L"SystemUsesLightTheme", DWord(0));
+    registry.SetValue(L"HKEY_CURRENT_USER\\software\\microsoft\\windows\\dwm", L"ColorPrevalence", DWord(1));
+    registry.SetValue(gaming, L"GamingHomeApp", String(L"Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App"));
+    registry.SetValue(gaming, L"StartupToGamingHome", DWord(1));
+    registry.SetValue(gaming + L"\\systemdialogresults", L"ExitGamingPostureConfirmation", DWord(2));
+    registry.SetValue(L"HKEY_LOCAL_MACHINE\\software\\valve\\steam", L"InstallPath", String(L"C:\\Steam"));
+
+    size_t calls = 0;
+    size_t values = 0;
+    for (const Query &query : SettingsStart)
+    {
+        calls += query.times;
+        values += query.times * query.names.size();
+    }
+
+    const char *names[] = {"no cache", "handles", "handles+values"};
+    Run runs[3];
+    for (int mode = 0; mode < 3; mode++)
+    {
+        runs[mode] = Measure(registry, mode, Starts);
+        std::printf("%-15s %8.2f us/start, backend opens %3zu reads %3zu\n",
+            names[mode], runs[mode].us, runs[mode].counters.opens, runs[mode].counters.reads);
+    }
+    CHECK(registry.OpenHandles() == 0);
+
+    // Same answers every way; the cache opens each key once and only skips reads of kept values
+    CHECK(runs[0].found == runs[1].found && runs[1].found == runs[2].found);
+    CHECK(runs[0].counters.opens == calls);
+    CHECK(runs[1].counters.opens == SettingsStart.size() - 1);     // two queries share GamingConfiguration
+    CHECK(runs[1].counters.reads == runs[0].counters.reads);
+    CHECK(runs[2].counters.opens == runs[1].counters.opens);
+    CHECK(runs[2].counters.reads == runs[1].counters.reads - (12 - 1) - (2 - 1));
+    std::printf("%zu calls, %zu values per start\n", calls, values);
+
+    return AnyFSE::Tests::Result();
+}
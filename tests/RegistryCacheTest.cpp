@@ -0,0 +1,136 @@
+// Registry reads through the key cache over an in-memory registry: path normalization, one open per key,
+// cached values dropped on change notifications, deleted and recreated keys, eviction and concurrent reads.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Check.hpp"
+#include "MemoryRegistry.hpp"
+#include "Tools/RegistryCache.hpp"
+
+using namespace AnyFSE::Tools;
+
+namespace
+{
+    RegistryValue String(const std::wstring &text)
+    {
+        RegistryValue value;
+        value.type = RegistryValue::Type::String;
+        value.text = text;
+        return value;
+    }
+
+    RegistryValue DWord(uint32_t number)
+    {
+        RegistryValue value;
+        value.type = RegistryValue::Type::DWord;
+        value.number = number;
+        return value;
+    }
+}
+
+int main()
+{
+    CHECK(RegistryCache::NormalizePath(L"Software\\Microsoft\\X") == L"HKEY_CURRENT_USER\\software\\microsoft\\x");
+    CHECK(RegistryCache::NormalizePath(L"HKCU\\Software\\X") == L"HKEY_CURRENT_USER\\software\\x");
+    CHECK(RegistryCache::NormalizePath(L"HKLM\\SOFTWARE\\Valve") == L"HKEY_LOCAL_MACHINE\\software\\valve");
+    CHECK(RegistryCache::NormalizePath(L"HKCU") == L"HKEY_CURRENT_USER");
+
+    const std::wstring gaming = L"HKEY_CURRENT_USER\\software\\microsoft\\windows\\currentversion\\gamingconfiguration";
+    const std::wstring key = L"Software\\Microsoft\\Windows\\CurrentVersion\\GamingConfiguration";
+    const std::wstring xbox = L"Microsoft.GamingApp_8wekyb3d8bbwe!Microsoft.Xbox.App";
+
+    MemoryRegistry registry;
+    registry.SetValue(gaming, L"GamingHomeApp", String(xbox));
+    registry.SetValue(gaming, L"StartupToGamingHome", DWord(1));
+    registry.SetValue(gaming + L"\\systemdialogresults", L"ExitGamingPostureConfirmation", DWord(2));
+    {
+        RegistryCache cache(registry);
+
+        // The key is opened once, its values are read every time
+        bool same = true;
+        for (int i = 0; i < 10; ++i)
+        {
+            same = same && cache.Read(key, L"GamingHomeApp").AsString() == xbox;
+        }
+        CHECK(same);
+        CHECK(registry.GetCounters().opens == 1 && registry.GetCounters().reads == 10);
+
+        std::vector<RegistryValue> values = cache.Read(key + L"\\SystemDialogResults",
+            {L"EnterGamingPostureConfirmation_Config", L"EnterGamingPostureConfirmation", L"ExitGamingPostureConfirmation"});
+        CHECK(values.size() == 3);
+        CHECK(values[0].type == RegistryValue::Type::None && values[1].AsDWORD(7) == 7 && values[2].AsDWORD() == 2);
+        CHECK(registry.GetCounters().opens == 2);
+
+        // Cached values are read once, then again after the key changes
+        CHECK(cache.CacheValues(key));
+        for (int i = 0; i < 10; ++i)
+        {
+            cache.Read(key, L"GamingHomeApp");
+        }
+        CHECK(cache.GetStats().hits == 9);
+        size_t reads = registry.GetCounters().reads;
+        registry.SetValue(gaming, L"GamingHomeApp", String(L"AnyFSE"));
+        CHECK(cache.Read(key, L"GamingHomeApp").AsString() == L"AnyFSE");
+        CHECK(cache.Read(key, L"GamingHomeApp").AsString() == L"AnyFSE");
+        CHECK(registry.GetCounters().reads == reads + 1);
+
+        // Missing values are cached too, until they appear
+        CHECK(cache.Read(key, L"Missing").type == RegistryValue::Type::None);
+        reads = registry.GetCounters().reads;
+        cache.Read(key, L"Missing");
+        CHECK(registry.GetCounters().reads == reads);
+        registry.SetValue(gaming, L"Missing", DWord(5));
+        CHECK(cache.Read(key, L"Missing").AsDWORD() == 5);
+
+        // A deleted key reads as missing and is opened again once it is back
+        registry.DeleteKey(gaming);
+        CHECK(cache.Read(key, L"GamingHomeApp").type == RegistryValue::Type::None);
+        registry.SetValue(gaming, L"GamingHomeApp", String(L"Back"));
+        CHECK(cache.Read(key, L"GamingHomeApp").AsString() == L"Back");
+
+        // More keys than the cache holds close the least recently used ones
+        {
+            RegistryCache small(registry, 4);
+            bool evicted = true;
+            for (uint32_t i = 0; i < 10; ++i)
+            {
+                std::wstring path = L"HKEY_CURRENT_USER\\key" + std::to_wstring(i);
+                registry.SetValue(path, L"value", DWord(i));
+                evicted = evicted && small.Read(path, L"value").AsDWORD() == i;
+            }
+            CHECK(evicted);
+            small.Remove(L"HKCU\\Key9");
+        }
+
+        std::vector<std::thread> threads;
+        std::atomic<int> wrong{0};
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                for (int i = 0; i < 5000; ++i)
+                {
+                    if (t == 0 && i % 100 == 0)
+                    {
+                        registry.SetValue(gaming, L"GamingHomeApp", String(i % 200 ? L"A" : L"B"));
+                    }
+                    std::wstring value = cache.Read(key, L"GamingHomeApp").AsString();
+                    wrong += value != L"A" && value != L"B" && value != L"Back";
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        CHECK(wrong == 0);
+    }
+
+    // Every handle is closed with the cache
+    CHECK(registry.OpenHandles() == 0);
+
+    return AnyFSE::Tests::Result();
+}
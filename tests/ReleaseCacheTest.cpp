@@ -0,0 +1,182 @@
+// Release list parsing, the on-disk release cache round trip and conditional release queries against
+// a scripted http client.
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Updater/ReleaseCache.hpp"
+
+using namespace AnyFSE::Updater;
+
+namespace
+{
+    // Answers with the next scripted response, or throws when there is none
+    struct ScriptedClient : IHttpClient
+    {
+        std::vector<HttpResponse> responses;
+        std::vector<std::wstring> lastHeaders;
+        int calls = 0;
+
+        HttpResponse Get(const HttpRequest &request, const HttpBodySink &sink) override
+        {
+            lastHeaders = request.headers;
+            if (calls >= (int)responses.size())
+            {
+                calls++;
+                throw std::runtime_error("connection failed");
+            }
+            HttpResponse response = responses[calls++];
+            std::string body = std::move(response.body);
+            if (!body.empty())
+            {
+                sink(response, body.data(), body.size());
+            }
+            return response;
+        }
+
+        bool Sent(const std::wstring &header) const
+        {
+            for (const std::wstring &line : lastHeaders)
+            {
+                if (line == header)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    HttpResponse Response(int status, const std::string &body = "", const std::string &etag = "", const std::string &lastModified = "")
+    {
+        HttpResponse response;
+        response.status = status;
+        response.body = body;
+        response.etag = etag;
+        response.lastModified = lastModified;
+        return response;
+    }
+}
+
+int main()
+{
+    // Nested "tag_name" keys and the asset name case don't confuse the scanner
+    const std::string digest(64, 'A');
+    std::string latest = R"({"url": "x", "tag_name": "v1.2.3", "author": {"login": "a", "tag_name": "bad"},
+        "assets": [{"name": "other.zip", "browser_download_url": "u1"},
+                   {"name": "anyfse.installer.EXE", "browser_download_url": "u2", "uploader": {"name": "z"},
+                    "digest": "sha256:)" + digest + R"("}],
+        "body": "text"})";
+
+    std::vector<ReleaseInfo> releases;
+    CHECK(ParseReleases(latest, "AnyFSE.Installer.exe", releases));
+    CHECK(releases.size() == 1);
+    CHECK(releases[0].tag == "v1.2.3");
+    CHECK(releases[0].installerUrl == "u2");
+    CHECK(releases[0].installerSha256 == std::string(64, 'a'));
+    CHECK(releases[0].hasAssets);
+
+    std::string list = "[" + latest + R"(, {"tag_name": "v2.0.0-beta", "assets": []}, {"tag_name": "v0.1"}])";
+    CHECK(ParseReleases(list, "AnyFSE.Installer.exe", releases));
+    CHECK(releases.size() == 3);
+    CHECK(releases[1].tag == "v2.0.0-beta" && releases[1].installerUrl.empty() && releases[1].hasAssets);
+    CHECK(!releases[2].hasAssets);
+
+    // Broken json leaves the previous result alone
+    CHECK(!ParseReleases("{bad", "x", releases));
+    CHECK(releases.size() == 3);
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "AnyFSE.ReleaseCacheTest";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    std::filesystem::path file = folder / "UpdateCache.json";
+
+    ReleaseCache cache(file);
+    CHECK(!cache.Load());
+    cache.Store("host/path", CachedReleases{"\"etag\"", "modified", releases});
+    cache.SetMirrorStats({{"mirror", MirrorStats{120.5, 3, 1}}});
+    CHECK(cache.Save());
+
+    ReleaseCache loaded(file);
+    CHECK(loaded.Load());
+    CachedReleases entry;
+    CHECK(loaded.Find("host/path", entry));
+    CHECK(entry.etag == "\"etag\"" && entry.lastModified == "modified");
+    CHECK(entry.releases.size() == 3 && entry.releases[0].installerUrl == "u2");
+    CHECK(entry.releases[0].installerSha256 == std::string(64, 'a'));
+    CHECK(!loaded.Find("host/other", entry));
+    CHECK(loaded.GetMirrorStats().count("mirror") && loaded.GetMirrorStats().at("mirror").samples == 3);
+
+    const std::string installer = "AnyFSE.Installer.exe";
+    HttpRequest request;
+    CHECK(ParseUrl(L"https://api.github.com/repos/a/b/releases/latest", request));
+    const std::string url = "api.github.com/repos/a/b/releases/latest";
+
+    // Nothing cached: a failure is the caller's, a 200 is stored with its validators
+    ReleaseCache fetching(folder / "Fetch.json");
+    ScriptedClient client;
+    bool thrown = false;
+    try
+    {
+        fetching.Fetch(client, url, request, installer);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    client.responses = {Response(200, latest, "\"v1\"", "Mon, 01 Jun 2026 10:00:00 GMT")};
+    client.calls = 0;
+    FetchedReleases fetched = fetching.Fetch(client, url, request, installer);
+    CHECK(fetched.status == 200 && fetched.releases.size() == 1 && fetched.releases[0].tag == "v1.2.3");
+    CHECK(client.lastHeaders.empty());
+    CHECK(fetching.Find(url, entry) && entry.etag == "\"v1\"" && entry.lastModified == "Mon, 01 Jun 2026 10:00:00 GMT");
+
+    // The validators go out with the next query, a 304 answers from the cache
+    client.responses = {Response(304)};
+    client.calls = 0;
+    fetched = fetching.Fetch(client, url, request, installer);
+    CHECK(client.Sent(L"If-None-Match: \"v1\""));
+    CHECK(client.Sent(L"If-Modified-Since: Mon, 01 Jun 2026 10:00:00 GMT"));
+    CHECK(fetched.status == 304 && fetched.releases.size() == 1 && fetched.releases[0].installerUrl == "u2");
+
+    // A broken connection, a server error or a broken body fall back to the cache
+    client.responses = {Response(503), Response(200, "{bad", "\"v2\"")};
+    client.calls = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        fetched = fetching.Fetch(client, url, request, installer);
+        CHECK(fetched.status == 0 && !fetched.error.empty() && fetched.releases.size() == 1);
+    }
+    CHECK(fetching.Find(url, entry) && entry.etag == "\"v1\"");
+
+    // The stored entry survives a restart
+    ReleaseCache restarted(folder / "Fetch.json");
+    client.responses = {Response(304)};
+    client.calls = 0;
+    fetched = restarted.Fetch(client, url, request, installer);
+    CHECK(fetched.status == 304 && fetched.releases.size() == 1);
+
+    // A cancelled query is not answered from the cache
+    HttpCancellation cancel;
+    cancel.Cancel();
+    request.cancel = &cancel;
+    client.responses.clear();
+    thrown = false;
+    try
+    {
+        fetching.Fetch(client, url, request, installer);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    std::filesystem::remove_all(folder);
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,147 @@
+// Word wrap of every string in the bundled locale files at two settings widths, timed through a cold
+// layout cache (measure and break on every key) and a warm one (lookups only).
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/TextLayout.hpp"
+#include "Tools/nlohmann/json.hpp"
+
+using namespace AnyFSE::Tools;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    // Tools::Unicode converts with Win32, locale strings are valid UTF-8
+    std::wstring FromUtf8(const std::string &text)
+    {
+        std::wstring result;
+        for (size_t i = 0; i < text.size();)
+        {
+            unsigned char c = (unsigned char)text[i];
+            int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+            unsigned code = extra ? c & (0x3F >> extra) : c;
+            for (int k = 1; k <= extra && i + k < text.size(); k++)
+            {
+                code = (code << 6) | ((unsigned char)text[i + k] & 0x3F);
+            }
+            i += extra + 1;
+
+            if (code >= 0x10000 && sizeof(wchar_t) == 2)
+            {
+                code -= 0x10000;
+                result += wchar_t(0xD800 + (code >> 10));
+                result += wchar_t(0xDC00 + (code & 0x3FF));
+            }
+            else
+            {
+                result += wchar_t(code);
+            }
+        }
+        return result;
+    }
+
+    // Fixed width fake font: every character 7 px, 'W' 12, space 3
+    TextLayout Layout(const TextLayoutKey &key)
+    {
+        std::vector<int> extents;
+        int x = 0;
+        for (wchar_t c : key.text)
+        {
+            x += c == L' ' ? 3 : c == L'W' ? 12 : 7;
+            extents.push_back(x);
+        }
+        return BreakLines(key.text, extents, key.maxWidth, 10);
+    }
+
+    bool SameLayout(const TextLayout &a, const TextLayout &b)
+    {
+        if (a.width != b.width || a.height != b.height || a.lines.size() != b.lines.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.lines.size(); i++)
+        {
+            if (a.lines[i].start != b.lines[i].start || a.lines[i].length != b.lines[i].length
+                || a.lines[i].width != b.lines[i].width)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    const int Rounds = 50;
+
+    std::vector<std::wstring> strings;
+    for (const auto &entry : std::filesystem::directory_iterator(std::filesystem::path(ANYFSE_ROOT) / "localization"))
+    {
+        if (entry.path().extension() != ".json")
+        {
+            continue;
+        }
+        std::ifstream file(entry.path(), std::ios::binary);
+        nlohmann::json locale = nlohmann::json::parse(file);
+        for (const auto &item : locale.items())
+        {
+            if (item.value().is_string())
+            {
+                strings.push_back(FromUtf8(item.value().get<std::string>()));
+            }
+        }
+    }
+    CHECK(!strings.empty());
+
+    std::vector<TextLayoutKey> keys;
+    size_t chars = 0;
+    for (const std::wstring &text : strings)
+    {
+        chars += text.size();
+        for (int width : {300, 420})
+        {
+            keys.push_back({text, 1, width, 144});
+        }
+    }
+
+    TextLayoutCache cache(keys.size());
+
+    Stopwatch cold;
+    size_t lines = 0;
+    for (const TextLayoutKey &key : keys)
+    {
+        lines += cache.Get(key, Layout)->lines.size();
+    }
+    double coldUs = cold.ElapsedMs() * 1000 / keys.size();
+    const uint64_t misses = cache.Misses();
+    CHECK(misses > 0 && misses <= keys.size());
+
+    Stopwatch warm;
+    size_t warmLines = 0;
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (const TextLayoutKey &key : keys)
+        {
+            warmLines += cache.Get(key, Layout)->lines.size();
+        }
+    }
+    double warmUs = warm.ElapsedMs() * 1000 / (keys.size() * Rounds);
+    CHECK(cache.Misses() == misses);
+    CHECK(warmLines == lines * Rounds);
+
+    for (const TextLayoutKey &key : keys)
+    {
+        CHECK(SameLayout(*cache.Get(key, Layout), Layout(key)));
+    }
+
+    std::printf("%zu strings (%zu chars), %zu keys, %zu lines\n", strings.size(), chars, keys.size(), lines);
+    std::printf("cold cache %8.3f us/key, warm cache %8.3f us/key\n", coldUs, warmUs);
+
+    return AnyFSE::Tests::Result();
+}
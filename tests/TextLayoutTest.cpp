@@ -0,0 +1,93 @@
+// Word wrap of settings texts against a fixed width fake font, and the layout cache.
+
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/TextLayout.hpp"
+
+using namespace AnyFSE::Tools;
+
+namespace
+{
+    typedef std::vector<std::wstring> Strings;
+
+    // Every character 7 px, 'W' 12, space 3
+    std::vector<int> Extents(const std::wstring &text)
+    {
+        std::vector<int> extents;
+        int x = 0;
+        for (wchar_t c : text)
+        {
+            x += c == L' ' ? 3 : c == L'W' ? 12 : 7;
+            extents.push_back(x);
+        }
+        return extents;
+    }
+
+    TextLayout Layout(const std::wstring &text, int maxWidth)
+    {
+        return BreakLines(text, Extents(text), maxWidth, 10);
+    }
+
+    Strings Lines(const std::wstring &text, int maxWidth)
+    {
+        Strings lines;
+        for (const TextLine &line : Layout(text, maxWidth).lines)
+        {
+            lines.push_back(text.substr(line.start, line.length));
+        }
+        return lines;
+    }
+}
+
+int main()
+{
+    CHECK(Lines(L"", 100).empty());
+    CHECK(Lines(L"hello", 100) == Strings({L"hello"}));
+
+    // "aaa bbb" is 45 px wide
+    CHECK(Lines(L"aaa bbb ccc", 52) == Strings({L"aaa bbb", L"ccc"}));
+    CHECK(Lines(L"aaa bbb ccc", 40) == Strings({L"aaa", L"bbb", L"ccc"}));
+    CHECK(Lines(L"aaa    bbb", 30) == Strings({L"aaa", L"bbb"}));
+
+    // A word wider than the limit overflows rather than splits
+    CHECK(Lines(L"averyveryverylongword next", 50) == Strings({L"averyveryverylongword", L"next"}));
+
+    CHECK(Lines(L"a\nb", 100) == Strings({L"a", L"b"}));
+    CHECK(Lines(L"a\r\nb", 100) == Strings({L"a", L"b"}));
+    CHECK(Lines(L"a\n\nb", 100) == Strings({L"a", L"", L"b"}));
+    CHECK(Lines(L"a\n", 100) == Strings({L"a", L""}));
+
+    TextLayout layout = Layout(L"aaa bbb ccc", 40);
+    CHECK(layout.height == 30 && layout.width == 21 && layout.lines[1].width == 21);
+
+    // Leading spaces stay, they are not a break
+    layout = Layout(L"  ab", 100);
+    CHECK(layout.lines.size() == 1 && layout.lines[0].length == 4);
+
+    // Font, width and DPI are all part of the key
+    TextLayoutCache cache(2);
+    int calls = 0;
+    auto layoutFunc = [&calls](const TextLayoutKey &key)
+    {
+        calls++;
+        return Layout(key.text, key.maxWidth);
+    };
+    auto first = cache.Get({L"x", 1, 100, 96}, layoutFunc);
+    auto second = cache.Get({L"x", 1, 100, 96}, layoutFunc);
+    CHECK(first == second && calls == 1);
+    cache.Get({L"x", 1, 100, 120}, layoutFunc);
+    cache.Get({L"x", 2, 100, 96}, layoutFunc);
+    CHECK(calls == 3 && cache.Size() == 2);
+    cache.Get({L"x", 1, 100, 96}, layoutFunc);
+    CHECK(calls == 4);
+    CHECK(cache.Hits() == 1 && cache.Misses() == 4);
+
+    // A layout handed out survives the cache dropping it
+    cache.Clear();
+    CHECK(cache.Size() == 0);
+    CHECK(first->lines.size() == 1);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,90 @@
+// Easing curves and time based tweens: single runs, loops, ping-pong with its own way back and stopping.
+
+#include <cmath>
+#include <initializer_list>
+
+#include "Check.hpp"
+#include "Tools/Tween.hpp"
+
+using namespace AnyFSE::Tools;
+
+namespace
+{
+    bool Near(double a, double b)
+    {
+        return std::fabs(a - b) < 1e-9;
+    }
+}
+
+int main()
+{
+    for (Easing::Func easing : {Easing::Linear, Easing::InCubic, Easing::OutCubic, Easing::InOutCubic, Easing::InOutSine})
+    {
+        CHECK(Near(easing(0), 0) && Near(easing(1), 1));
+        bool monotonic = true;
+        double previous = 0;
+        for (int i = 1; i <= 1000; i++)
+        {
+            double value = easing(i / 1000.0);
+            monotonic = monotonic && value >= previous - 1e-12;
+            previous = value;
+        }
+        CHECK(monotonic);
+    }
+    CHECK(Near(Easing::InOutCubic(0.5), 0.5));
+    CHECK(Near(Easing::InOutSine(0.5), 0.5));
+
+    // Not started holds the start value, after the end the target
+    Tween once(0, 100, 200);
+    CHECK(once.IsFinished(0));
+    CHECK(Near(once.Value(50), 0));
+    once.Start(1000);
+    CHECK(Near(once.Value(900), 0));
+    CHECK(Near(once.Value(1050), 25));
+    CHECK(!once.IsFinished(1199));
+    CHECK(once.IsFinished(1200));
+    CHECK(Near(once.Value(5000), 100));
+
+    // A stopped loop plays its cycle to the end
+    Tween loop(0, 360, 750);
+    loop.SetRepeat(Tween::Repeat::Loop);
+    loop.Start(0);
+    CHECK(Near(loop.Value(375), 180));
+    CHECK(Near(loop.Value(750 + 375), 180));
+    CHECK(!loop.IsFinished(1e9));
+    loop.StopRepeating(1000);
+    CHECK(!loop.IsFinished(1499));
+    CHECK(loop.IsFinished(1500));
+    CHECK(Near(loop.Value(1400), 360.0 * 650 / 750));
+    CHECK(Near(loop.Value(1600), 360));
+
+    // The pulse: quick out, slow way back
+    Tween pulse(0.94, 1.06, 240, Easing::OutCubic);
+    pulse.SetRepeat(Tween::Repeat::PingPong, 1200);
+    pulse.Start(0);
+    CHECK(Near(pulse.Value(240), 1.06));
+    CHECK(Near(pulse.Value(240 + 600), 0.94 + 0.12 * Easing::OutCubic(0.5)));
+    CHECK(Near(pulse.Value(1440), 0.94));
+    CHECK(Near(pulse.Value(1440 + 120), 0.94 + 0.12 * Easing::OutCubic(0.5)));
+    pulse.StopRepeating(1500);
+    CHECK(pulse.IsFinished(2880));
+    CHECK(Near(pulse.Value(3000), 0.94));
+
+    Tween instant(1, 2, 0);
+    instant.Start(10);
+    CHECK(instant.IsFinished(10));
+    CHECK(Near(instant.Value(11), 2));
+
+    // The value depends on the time alone, not on the frames before it
+    Tween looping(0, 1, 333, Easing::InOutCubic);
+    looping.SetRepeat(Tween::Repeat::Loop);
+    looping.Start(7);
+    double value = looping.Value(12345.6);
+    for (int i = 0; i < 100; i++)
+    {
+        looping.Value(i * 3.3);
+    }
+    CHECK(looping.Value(12345.6) == value);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,127 @@
+// A settings page of launcher detectors against 602 synthetic Uninstall entries: every detector scanning
+// the key on its own, the way they did before the index, against one UninstallIndex build and lookups.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/UninstallIndex.hpp"
+
+using namespace AnyFSE::Tools;
+using AnyFSE::Tests::Stopwatch;
+
+namespace
+{
+    struct SyntheticSource : UninstallSource
+    {
+        std::vector<UninstallEntry> entries;
+        size_t reads = 0;
+
+        void Scan(const EntryFunc &entry) override
+        {
+            for (UninstallEntry copy : entries)
+            {
+                ++reads;
+                entry(std::move(copy));
+            }
+        }
+    };
+
+    // One detector the old way: a full scan, lowercasing every name it reads
+    bool ScanFor(SyntheticSource &source, const std::wstring &name)
+    {
+        const std::wstring wanted = UninstallIndex::NormalizeName(name);
+        bool found = false;
+        source.Scan([&](UninstallEntry &&entry)
+        {
+            found = found || UninstallIndex::NormalizeName(entry.displayName) == wanted;
+        });
+        return found;
+    }
+}
+
+int main()
+{
+    // Detectors of a page, each asked for install state, the portable check and the not installed list
+    const std::vector<std::wstring> Names = {L"Playnite", L"Steam", L"Kodi", L"Razer Cortex"};
+    const int QueriesPerName = 3;
+    const int Pages = 200;
+    const int Lookups = 100000;
+
+    SyntheticSource source;
+    for (int i = 0; i < 600; ++i)
+    {
+        UninstallEntry entry;
+        entry.displayName = L"Program Number " + std::to_wstring(i);
+        entry.installLocation = L"C:\\Programs\\" + std::to_wstring(i);
+        entry.hasInstallLocation = i % 2;
+        entry.uninstallString = L"\"C:\\Programs\\uninstall.exe\"";
+        source.entries.push_back(entry);
+    }
+    UninstallEntry steam;
+    steam.displayName = L"Steam";
+    steam.uninstallString = L"C:\\Steam\\uninstall.exe";
+    source.entries.push_back(steam);
+    steam.displayName = L"STEAM";
+    source.entries.push_back(steam);
+
+    size_t scanFound = 0;
+    source.reads = 0;
+    Stopwatch scans;
+    for (int page = 0; page < Pages; page++)
+    {
+        for (int query = 0; query < QueriesPerName; query++)
+        {
+            for (const std::wstring &name : Names)
+            {
+                scanFound += ScanFor(source, name);
+            }
+        }
+    }
+    double scansUs = scans.ElapsedMs() * 1000 / Pages;
+    const size_t scanReads = source.reads / Pages;
+    CHECK(scanReads == source.entries.size() * Names.size() * QueriesPerName);
+
+    size_t indexFound = 0;
+    source.reads = 0;
+    Stopwatch indexed;
+    for (int page = 0; page < Pages; page++)
+    {
+        UninstallIndex index;
+        index.Build(source);
+        for (int query = 0; query < QueriesPerName; query++)
+        {
+            for (const std::wstring &name : Names)
+            {
+                indexFound += index.Find(name) != nullptr;
+            }
+        }
+    }
+    double indexUs = indexed.ElapsedMs() * 1000 / Pages;
+    const size_t indexReads = source.reads / Pages;
+    CHECK(indexReads == source.entries.size());
+
+    // Only Steam is installed, both ways agree
+    CHECK(scanFound == indexFound && scanFound == (size_t)(Pages * QueriesPerName));
+
+    UninstallIndex index;
+    index.Build(source);
+    size_t hits = 0;
+    Stopwatch lookup;
+    for (int i = 0; i < Lookups; i++)
+    {
+        for (const std::wstring &name : Names)
+        {
+            hits += index.Find(name) != nullptr;
+        }
+    }
+    double lookupNs = lookup.ElapsedMs() * 1000000 / (Lookups * Names.size());
+    CHECK(hits == (size_t)Lookups);
+
+    std::printf("%zu programs, %zu lookups per page\n", source.entries.size(), Names.size() * QueriesPerName);
+    std::printf("per-detector scans %8.1f us/page (%zu entries read), index build + lookups %8.1f us/page (%zu read), "
+        "lookup %5.0f ns\n", scansUs, scanReads, indexUs, indexReads, lookupNs);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,75 @@
+// Uninstall entries indexed by display name from a synthetic hive: case folding, duplicates in scan order
+// and one scan per build.
+
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "Tools/UninstallIndex.hpp"
+
+using namespace AnyFSE::Tools;
+
+namespace
+{
+    struct SyntheticSource : UninstallSource
+    {
+        std::vector<UninstallEntry> entries;
+        size_t reads = 0;
+
+        void Scan(const EntryFunc &entry) override
+        {
+            for (UninstallEntry copy : entries)
+            {
+                ++reads;
+                entry(std::move(copy));
+            }
+        }
+    };
+}
+
+int main()
+{
+    SyntheticSource source;
+    for (int i = 0; i < 600; ++i)
+    {
+        UninstallEntry entry;
+        entry.displayName = L"Program Number " + std::to_wstring(i);
+        entry.installLocation = L"C:\\Programs\\" + std::to_wstring(i);
+        entry.hasInstallLocation = i % 2;
+        entry.uninstallString = L"\"C:\\Programs\\uninstall.exe\"";
+        source.entries.push_back(entry);
+    }
+
+    // The same program registered twice, once without InstallLocation
+    UninstallEntry steam;
+    steam.displayName = L"Steam";
+    steam.uninstallString = L"C:\\Steam\\uninstall.exe";
+    source.entries.push_back(steam);
+    steam.displayName = L"STEAM";
+    steam.installLocation = L"D:\\Steam";
+    steam.hasInstallLocation = true;
+    source.entries.push_back(steam);
+
+    UninstallIndex index;
+    index.Build(source);
+    CHECK(source.reads == 602);
+    CHECK(index.Count() == 602);
+
+    const std::vector<UninstallEntry> *found = index.Find(L"steam");
+    CHECK(found && found->size() == 2);
+    CHECK(found && (*found)[0].uninstallString == L"C:\\Steam\\uninstall.exe" && !(*found)[0].hasInstallLocation);
+    CHECK(found && (*found)[1].hasInstallLocation && (*found)[1].installLocation == L"D:\\Steam");
+    CHECK(index.Find(L"PROGRAM NUMBER 7") && index.Find(L"PROGRAM NUMBER 7")->size() == 1);
+    CHECK(!index.Find(L"Kodi"));
+    CHECK(UninstallIndex::NormalizeName(L"Razer Cortex") == L"razer cortex");
+
+    // Rebuilding replaces the entries rather than adding to them
+    index.Build(source);
+    CHECK(index.Count() == 602);
+    CHECK(index.Find(L"Steam")->size() == 2);
+
+    index.Clear();
+    CHECK(index.Count() == 0 && !index.Find(L"Steam"));
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,100 @@
+// Offsets, hit testing and visible ranges of a 10000 row virtualized list with mixed and empty rows,
+// timed for the build, scroll queries and height changes near the top.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "FluentDesign/VirtualRows.hpp"
+
+using FluentDesign::VirtualRows;
+using AnyFSE::Tests::Stopwatch;
+
+int main()
+{
+    const size_t Count = 10000;
+    const int View = 900;
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> height(40, 140);
+    std::vector<int> heights(Count);
+
+    Stopwatch build;
+    VirtualRows rows;
+    rows.Reset(Count);
+    for (size_t i = 0; i < Count; i++)
+    {
+        heights[i] = i % 97 == 0 ? 0 : height(rng);     // collapsed rows take no space
+        rows.SetHeight(i, heights[i]);
+    }
+    const int content = rows.ContentHeight();
+    const double buildUs = build.ElapsedMs() * 1000;
+
+    long long top = 0;
+    bool tops = true;
+    for (size_t i = 0; i < Count; i++)
+    {
+        tops = tops && rows.Top(i) == top;
+        top += heights[i];
+    }
+    CHECK(tops);
+    CHECK(top == content);
+
+    bool hits = true;
+    for (int pos = -5; pos < content + 5; pos += 7)
+    {
+        size_t row = rows.RowAt(pos);
+        if (pos < 0)
+        {
+            hits = hits && row == 0;
+        }
+        else if (pos >= content)
+        {
+            hits = hits && row == Count;
+        }
+        else
+        {
+            hits = hits && rows.Top(row) <= pos && pos < rows.Top(row) + heights[row];
+        }
+    }
+    CHECK(hits);
+
+    // Every range starts at a row reaching into the overscan and ends past it
+    Stopwatch query;
+    size_t realized = 0;
+    int queries = 0;
+    bool ranges = true;
+    for (int pos = 0; pos < content; pos += 16)
+    {
+        VirtualRows::Range range = rows.VisibleRange(pos, View, View);
+        realized += range.last - range.first;
+        queries++;
+        ranges = ranges && range.first <= range.last;
+        if (!range.Empty())
+        {
+            ranges = ranges && (rows.Top(range.first) + heights[range.first] > std::max(0, pos - View) || heights[range.first] == 0);
+            ranges = ranges && (range.last == Count || rows.Top(range.last) >= pos + 2 * View);
+        }
+    }
+    const double queryUs = query.ElapsedMs() * 1000;
+    CHECK(ranges);
+
+    // A change near the top invalidates every offset below it
+    const int Changes = 1000;
+    Stopwatch change;
+    for (int k = 0; k < Changes; k++)
+    {
+        rows.SetHeight(k % 50, heights[k % 50] + (k & 1));
+        rows.VisibleRange(content / 2, View, View);
+    }
+    const double changeUs = change.ElapsedMs() * 1000;
+    CHECK(!rows.SetHeight(49, rows.Height(49)));
+
+    std::printf("build %zu rows: %.1f us, content %d px\n", Count, buildUs, content);
+    std::printf("%d range queries: %.3f us each, %.1f rows realized on average\n", queries, queryUs / queries, (double)realized / queries);
+    std::printf("%d height changes with a query: %.2f us each\n", Changes, changeUs / Changes);
+
+    return AnyFSE::Tests::Result();
+}
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Generate src/Tools/LocalizationKeys.hpp from localization/en_US.json.
+
+The English file is the source of truth for the key set. Every key becomes an
+entry of the Localization::KeyId enum, so Translate(KeyId::...) resolves to an
+array index and a missing or misspelled key fails to compile.
+
+Usage:
+    GenerateLocalizationKeys.py            regenerate the header
+    GenerateLocalizationKeys.py --check    verify the header is up to date and
+                                           every locale file matches en_US.json
+"""
+
+import argparse
+import json
+import pathlib
+import re
+import sys
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+LOCALIZATION_DIR = ROOT / "localization"
+BASE_LOCALE = LOCALIZATION_DIR / "en_US.json"
+HEADER = ROOT / "src" / "Tools" / "LocalizationKeys.hpp"
+
+IDENTIFIER = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+FORMAT_SPEC = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|L|z|j|t)?[diouxXeEfgGcspn%]")
+RESERVED = {"Count"}
+
+
+def load_locale(path):
+    with open(path, encoding="utf-8-sig") as file:
+        data = json.load(file, object_pairs_hook=reject_duplicates(path))
+    if not isinstance(data, dict):
+        raise ValueError(f"{path.name}: top level value must be an object")
+    return data
+
+
+def reject_duplicates(path):
+    def hook(pairs):
+        result = {}
+        for key, value in pairs:
+            if key in result:
+                raise ValueError(f"{path.name}: duplicate key '{key}'")
+            result[key] = value
+        return result
+    return hook
+
+
+def validate_keys(keys):
+    errors = []
+    for key in keys:
+        if not IDENTIFIER.match(key) or key in RESERVED:
+            errors.append(f"en_US.json: key '{key}' is not a valid C++ identifier")
+    return errors
+
+
+def cpp_narrow(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def render_header(keys):
+    lines = [
+        "// Generated by tools/GenerateLocalizationKeys.py from localization/en_US.json.",
+        "// Do not edit manually: add keys to en_US.json and rebuild.",
+        "#pragma once",
+        "",
+        "#include <cstddef>",
+        "",
+        "namespace AnyFSE::Tools::Localization",
+        "{",
+        "    enum class KeyId : int",
+        "    {",
+    ]
+    lines += [f"        {key}," for key in keys]
+    lines += [
+        "        Count",
+        "    };",
+        "",
+        "    constexpr size_t KeyCount = static_cast<size_t>(KeyId::Count);",
+        "",
+        "    // Key names indexed by KeyId.",
+        "    constexpr const char *KeyNames[KeyCount] =",
+        "    {",
+    ]
+    lines += [f"        {cpp_narrow(key)}," for key in keys]
+    lines += [
+        "    };",
+        "",
+        "    struct KeyIndexEntry",
+        "    {",
+        "        const char *name;",
+        "        KeyId id;",
+        "    };",
+        "",
+        "    // Key names sorted by strcmp order, for binary search while loading locale files.",
+        "    constexpr KeyIndexEntry KeyIndex[KeyCount] =",
+        "    {",
+    ]
+    lines += [f"        {{ {cpp_narrow(key)}, KeyId::{key} }},"
+              for key in sorted(keys, key=lambda k: k.encode("utf-8"))]
+    lines += [
+        "    };",
+        "}",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def format_specs(text):
+    return sorted(FORMAT_SPEC.findall(text)) if isinstance(text, str) else []
+
+
+def check_locales(keys, base):
+    errors = []
+    key_set = set(keys)
+    for path in sorted(LOCALIZATION_DIR.glob("*.json")):
+        if path == BASE_LOCALE:
+            continue
+        try:
+            data = load_locale(path)
+        except ValueError as error:
+            errors.append(str(error))
+            continue
+
+        for key in keys:
+            if key not in data:
+                errors.append(f"{path.name}: missing key '{key}'")
+            elif not isinstance(data[key], str):
+                errors.append(f"{path.name}: value of '{key}' is not a string")
+            elif format_specs(data[key]) != format_specs(base[key]):
+                errors.append(f"{path.name}: format specifiers of '{key}' differ from en_US.json")
+        for key in data:
+            if key not in key_set:
+                errors.append(f"{path.name}: unknown key '{key}'")
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--check", action="store_true", help="validate instead of writing the header")
+    args = parser.parse_args()
+
+    try:
+        base = load_locale(BASE_LOCALE)
+    except ValueError as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    keys = list(base.keys())
+    errors = validate_keys(keys)
+    if errors:
+        print("\n".join(errors), file=sys.stderr)
+        return 1
+
+    header = render_header(keys)
+
+    if not args.check:
+        current = HEADER.read_text(encoding="utf-8") if HEADER.exists() else None
+        if current != header:
+            HEADER.write_text(header, encoding="utf-8", newline="\n")
+            print(f"Generated {HEADER.relative_to(ROOT)} with {len(keys)} keys")
+        return 0
+
+    errors = check_locales(keys, base)
+    if not HEADER.exists() or HEADER.read_text(encoding="utf-8") != header:
+        errors.append(f"{HEADER.relative_to(ROOT)} is out of date, run tools/GenerateLocalizationKeys.py")
+
+    if errors:
+        print("\n".join(errors), file=sys.stderr)
+        return 1
+
+    print(f"{len(keys)} keys, all locale files are consistent")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())